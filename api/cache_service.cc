@@ -232,6 +232,26 @@ void set_cache_service(http_context& ctx, routes& r) {
         }, std::plus<ratio_holder>());
     });
 
+    cs::get_row_eviction_age_estimated_histogram.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return ctx.db.map_reduce0([] (database& db) {
+            return db.row_cache_tracker().get_stats().partition_eviction_age;
+        }, utils::estimated_histogram(0), utils::estimated_histogram_merge).then([] (const utils::estimated_histogram& res) {
+            utils_json::estimated_histogram h;
+            h = res;
+            return make_ready_future<json::json_return_type>(h);
+        });
+    });
+
+    cs::get_row_evictions_by_partition_rows_estimated_histogram.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return ctx.db.map_reduce0([] (database& db) {
+            return db.row_cache_tracker().get_stats().partition_evictions_by_rows;
+        }, utils::estimated_histogram(0), utils::estimated_histogram_merge).then([] (const utils::estimated_histogram& res) {
+            utils_json::estimated_histogram h;
+            h = res;
+            return make_ready_future<json::json_return_type>(h);
+        });
+    });
+
     cs::get_row_hits_moving_avrage.set(r, [&ctx] (std::unique_ptr<request> req) {
         return map_reduce_cf_raw(ctx, utils::rate_moving_average(), [](const column_family& cf) {
             return cf.get_row_cache().stats().hits.rate();
@@ -528,6 +528,18 @@ void set_column_family(http_context& ctx, routes& r) {
         }, std::plus<int64_t>());
     });
 
+    cf::get_sstables_pending_reclaim.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return map_reduce_cf(ctx, req->param["name"], int64_t(0), [](column_family& cf) {
+            return cf.sstables_pending_reclaim_count();
+        }, std::plus<int64_t>());
+    });
+
+    cf::get_all_sstables_pending_reclaim.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return map_reduce_cf(ctx, int64_t(0), [](column_family& cf) {
+            return cf.sstables_pending_reclaim_count();
+        }, std::plus<int64_t>());
+    });
+
     cf::get_live_ss_table_count.set(r, [&ctx] (std::unique_ptr<request> req) {
         return get_cf_stats(ctx, req->param["name"], &column_family::stats::live_sstable_count);
     });
@@ -792,6 +804,25 @@ void set_column_family(http_context& ctx, routes& r) {
 
     });
 
+    cf::get_row_cache_hits_by_partition_rows_estimated_histogram.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return map_reduce_cf(ctx, req->param["name"], utils::estimated_histogram(0), [](column_family& cf) {
+            return cf.get_row_cache().stats().partition_hits_by_rows;
+        },
+        utils::estimated_histogram_merge, utils_json::estimated_histogram());
+    });
+
+    cf::get_row_cache_population_from_memtable.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return map_reduce_cf(ctx, req->param["name"], uint64_t(0), [](column_family& cf) {
+            return cf.get_row_cache().stats().populations_from_memtable;
+        }, std::plus<uint64_t>());
+    });
+
+    cf::get_row_cache_population_from_read_miss.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return map_reduce_cf(ctx, req->param["name"], uint64_t(0), [](column_family& cf) {
+            return cf.get_row_cache().stats().populations_from_read_miss;
+        }, std::plus<uint64_t>());
+    });
+
     cf::get_cas_prepare.set(r, [] (std::unique_ptr<request> req) {
         //TBD
         unimplemented();
@@ -969,6 +1000,20 @@ void set_column_family(http_context& ctx, routes& r) {
                             r.error = d.error;
                             results.write.push(r);
                         }
+                        for (auto& d: topk_results.read_bytes.top(q.list_size())) {
+                            cf::toppartitions_record r;
+                            r.partition = sstring(d.item);
+                            r.count = d.count;
+                            r.error = d.error;
+                            results.read_bytes.push(r);
+                        }
+                        for (auto& d: topk_results.write_bytes.top(q.list_size())) {
+                            cf::toppartitions_record r;
+                            r.partition = sstring(d.item);
+                            r.count = d.count;
+                            r.error = d.error;
+                            results.write_bytes.push(r);
+                        }
                         return make_ready_future<json::json_return_type>(results);
                     });
                 });
@@ -49,26 +49,87 @@ static sstring validate_keyspace(http_context& ctx, const parameters& param) {
 }
 
 
-static std::vector<ss::token_range> describe_ring(const sstring& keyspace) {
-    std::vector<ss::token_range> res;
-    for (auto d : service::get_local_storage_service().describe_ring(keyspace)) {
-        ss::token_range r;
-        r.start_token = d._start_token;
-        r.end_token = d._end_token;
-        r.endpoints = d._endpoints;
-        r.rpc_endpoints = d._rpc_endpoints;
-        for (auto det : d._endpoint_details) {
-            ss::endpoint_detail ed;
-            ed.host = det._host;
-            ed.datacenter = det._datacenter;
-            if (det._rack != "") {
-                ed.rack = det._rack;
-            }
-            r.endpoint_details.push(ed);
+// Monitoring and orchestration tools poll the ring and ownership endpoints
+// every few seconds, and computing an answer walks the whole token ring and
+// the keyspace's replication strategy. The answer only changes when the
+// topology changes (tracked by the ring version) or when a schema change
+// alters replication (tracked by the node's schema version), so cache the
+// computed response and serve the polls in between from the cache.
+template <typename T>
+class ring_response_cache {
+    long _ring_version = -1;
+    utils::UUID _schema_version;
+    sstring _keyspace;
+    std::optional<T> _response;
+
+private:
+    static long current_ring_version() {
+        return service::get_local_storage_service().get_token_metadata().get_ring_version();
+    }
+
+    bool valid(http_context& ctx, const sstring& keyspace) const {
+        return _response
+                && _ring_version == current_ring_version()
+                && _schema_version == ctx.db.local().get_version()
+                && _keyspace == keyspace;
+    }
+
+public:
+    template <typename Compute>
+    T get(http_context& ctx, const sstring& keyspace, Compute&& compute) {
+        if (!valid(ctx, keyspace)) {
+            // Read the versions before computing so that a topology change
+            // racing with the computation leaves the entry invalid.
+            auto ring_version = current_ring_version();
+            auto schema_version = ctx.db.local().get_version();
+            _response = compute();
+            _ring_version = ring_version;
+            _schema_version = schema_version;
+            _keyspace = keyspace;
         }
-        res.push_back(r);
+        return *_response;
     }
-    return res;
+
+    template <typename Compute>
+    future<T> get_async(http_context& ctx, const sstring& keyspace, Compute&& compute) {
+        if (valid(ctx, keyspace)) {
+            return make_ready_future<T>(*_response);
+        }
+        auto ring_version = current_ring_version();
+        auto schema_version = ctx.db.local().get_version();
+        return compute().then([this, ring_version, schema_version, keyspace] (T response) {
+            _ring_version = ring_version;
+            _schema_version = schema_version;
+            _keyspace = keyspace;
+            _response = response;
+            return response;
+        });
+    }
+};
+
+static std::vector<ss::token_range> describe_ring(http_context& ctx, const sstring& keyspace) {
+    static thread_local ring_response_cache<std::vector<ss::token_range>> cache;
+    return cache.get(ctx, keyspace, [&keyspace] {
+        std::vector<ss::token_range> res;
+        for (auto d : service::get_local_storage_service().describe_ring(keyspace)) {
+            ss::token_range r;
+            r.start_token = d._start_token;
+            r.end_token = d._end_token;
+            r.endpoints = d._endpoints;
+            r.rpc_endpoints = d._rpc_endpoints;
+            for (auto det : d._endpoint_details) {
+                ss::endpoint_detail ed;
+                ed.host = det._host;
+                ed.datacenter = det._datacenter;
+                if (det._rack != "") {
+                    ed.rack = det._rack;
+                }
+                r.endpoint_details.push(ed);
+            }
+            res.push_back(r);
+        }
+        return res;
+    });
 }
 
 void set_storage_service(http_context& ctx, routes& r) {
@@ -158,12 +219,12 @@ void set_storage_service(http_context& ctx, routes& r) {
     });
 
     ss::describe_any_ring.set(r, [&ctx](const_req req) {
-        return describe_ring("");
+        return describe_ring(ctx, "");
     });
 
     ss::describe_ring.set(r, [&ctx](const_req req) {
         auto keyspace = validate_keyspace(ctx, req.param);
-        return describe_ring(keyspace);
+        return describe_ring(ctx, keyspace);
     });
 
     ss::get_host_id_map.set(r, [](const_req req) {
@@ -836,18 +897,30 @@ void set_storage_service(http_context& ctx, routes& r) {
         return make_ready_future<json::json_return_type>(0);
     });
 
-    ss::get_ownership.set(r, [] (std::unique_ptr<request> req) {
-        return service::get_local_storage_service().get_ownership().then([] (auto&& ownership) {
-            std::vector<storage_service_json::mapper> res;
-            return make_ready_future<json::json_return_type>(map_to_key_value(ownership, res));
+    ss::get_ownership.set(r, [&ctx] (std::unique_ptr<request> req) {
+        static thread_local ring_response_cache<std::vector<storage_service_json::mapper>> cache;
+        return cache.get_async(ctx, "", [] {
+            return service::get_local_storage_service().get_ownership().then([] (auto&& ownership) {
+                std::vector<storage_service_json::mapper> res;
+                map_to_key_value(ownership, res);
+                return res;
+            });
+        }).then([] (std::vector<storage_service_json::mapper> res) {
+            return make_ready_future<json::json_return_type>(std::move(res));
         });
     });
 
     ss::get_effective_ownership.set(r, [&ctx] (std::unique_ptr<request> req) {
         auto keyspace_name = req->param["keyspace"] == "null" ? "" : validate_keyspace(ctx, req->param);
-        return service::get_local_storage_service().effective_ownership(keyspace_name).then([] (auto&& ownership) {
-            std::vector<storage_service_json::mapper> res;
-            return make_ready_future<json::json_return_type>(map_to_key_value(ownership, res));
+        static thread_local ring_response_cache<std::vector<storage_service_json::mapper>> cache;
+        return cache.get_async(ctx, keyspace_name, [keyspace_name] {
+            return service::get_local_storage_service().effective_ownership(keyspace_name).then([] (auto&& ownership) {
+                std::vector<storage_service_json::mapper> res;
+                map_to_key_value(ownership, res);
+                return res;
+            });
+        }).then([] (std::vector<storage_service_json::mapper> res) {
+            return make_ready_future<json::json_return_type>(std::move(res));
         });
     });
 
@@ -24,6 +24,8 @@
 
 #include <seastar/http/exception.hh>
 #include "log.hh"
+#include "database.hh"
+#include "utils/memory_label.hh"
 
 namespace api {
 
@@ -65,6 +67,31 @@ void set_system(http_context& ctx, routes& r) {
         }
         return json::json_void();
     });
+
+    hs::get_memory_label_accounting.set(r, [&ctx](std::unique_ptr<request> req) {
+        using label_map = utils::memory_label_registry::map_type;
+        return ctx.db.map_reduce0([](database&) {
+            return utils::memory_label_registry::local().all();
+        }, label_map(), [](label_map sum, const label_map& shard_labels) {
+            for (auto& [label, stats] : shard_labels) {
+                auto& s = sum[label];
+                s.net_bytes += stats.net_bytes;
+                s.scopes += stats.scopes;
+            }
+            return sum;
+        }).then([](label_map merged) {
+            std::vector<hs::memory_label_accounting> res;
+            res.reserve(merged.size());
+            for (auto& [label, stats] : merged) {
+                hs::memory_label_accounting val;
+                val.label = label;
+                val.net_bytes = stats.net_bytes;
+                val.scopes = stats.scopes;
+                res.push_back(std::move(val));
+            }
+            return make_ready_future<json::json_return_type>(std::move(res));
+        });
+    });
 }
 
 }
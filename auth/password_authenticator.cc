@@ -87,7 +87,16 @@ password_authenticator::~password_authenticator() {
 password_authenticator::password_authenticator(cql3::query_processor& qp, ::service::migration_manager& mm)
     : _qp(qp)
     , _migration_manager(mm)
-    , _stopped(make_ready_future<>()) {
+    , _stopped(make_ready_future<>())
+    // There are no dedicated configuration options for the credentials cache:
+    // it protects the same tables as the permissions cache, so it reuses the
+    // permissions cache settings.
+    , _credentials_cache(
+            qp.db().get_config().permissions_cache_max_entries(),
+            std::chrono::milliseconds(qp.db().get_config().permissions_validity_in_ms()),
+            std::chrono::milliseconds(qp.db().get_config().permissions_update_interval_in_ms()),
+            plogger,
+            [this](const sstring& role_name) { return read_salted_hash(role_name); }) {
 }
 
 static bool has_salted_hash(const cql3::untyped_result_set_row& row) {
@@ -182,7 +191,37 @@ future<> password_authenticator::start() {
 
 future<> password_authenticator::stop() {
     _as.request_abort();
-    return _stopped.handle_exception_type([] (const sleep_aborted&) { }).handle_exception_type([](const abort_requested_exception&) {});
+    return _credentials_cache.stop().then([this] {
+        return _stopped.handle_exception_type([] (const sleep_aborted&) { }).handle_exception_type([](const abort_requested_exception&) {});
+    });
+}
+
+future<sstring> password_authenticator::read_salted_hash(const sstring& role_name) const {
+    // Here was a thread local, explicit cache of prepared statement. In normal execution this is
+    // fine, but since we in testing set up and tear down system over and over, we'd start using
+    // obsolete prepared statements pretty quickly.
+    // Rely on query processing caching statements instead, and lets assume
+    // that a map lookup string->statement is not gonna kill us much.
+    static const sstring query = format("SELECT {} FROM {} WHERE {} = ?",
+            SALTED_HASH,
+            meta::roles_table::qualified_name(),
+            meta::roles_table::role_col_name);
+
+    return _qp.process(
+            query,
+            consistency_for_user(role_name),
+            internal_distributed_timeout_config(),
+            {role_name},
+            true).then([](::shared_ptr<cql3::untyped_result_set> res) {
+        auto salted_hash = std::optional<sstring>();
+        if (!res->empty()) {
+            salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
+        }
+        if (!salted_hash) {
+            throw exceptions::authentication_exception("Username and/or password are incorrect");
+        }
+        return make_ready_future<sstring>(std::move(*salted_hash));
+    });
 }
 
 db::consistency_level password_authenticator::consistency_for_user(std::string_view role_name) {
@@ -220,36 +259,23 @@ future<authenticated_user> password_authenticator::authenticate(
     auto& username = credentials.at(USERNAME_KEY);
     auto& password = credentials.at(PASSWORD_KEY);
 
-    // Here was a thread local, explicit cache of prepared statement. In normal execution this is
-    // fine, but since we in testing set up and tear down system over and over, we'd start using
-    // obsolete prepared statements pretty quickly.
-    // Rely on query processing caching statements instead, and lets assume
-    // that a map lookup string->statement is not gonna kill us much.
-    return futurize_apply([this, username, password] {
-        static const sstring query = format("SELECT {} FROM {} WHERE {} = ?",
-                SALTED_HASH,
-                meta::roles_table::qualified_name(),
-                meta::roles_table::role_col_name);
-
-        return _qp.process(
-                query,
-                consistency_for_user(username),
-                internal_distributed_timeout_config(),
-                {username},
-                true);
-    }).then_wrapped([=](future<::shared_ptr<cql3::untyped_result_set>> f) {
+    // The salted hash is served from a shard-local cache so that handshakes
+    // don't read the roles table on every new connection. A hash read through
+    // the cache may be stale by up to the update period after a password
+    // change; the password itself is still checked on every attempt.
+    return futurize_apply([this, username] {
+        return _credentials_cache.get(username);
+    }).then_wrapped([=](future<sstring> f) {
         try {
-            auto res = f.get0();
-            auto salted_hash = std::optional<sstring>();
-            if (!res->empty()) {
-                salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
-            }
-            if (!salted_hash || !passwords::check(password, *salted_hash)) {
+            auto salted_hash = f.get0();
+            if (!passwords::check(password, salted_hash)) {
                 throw exceptions::authentication_exception("Username and/or password are incorrect");
             }
             return make_ready_future<authenticated_user>(username);
         } catch (std::system_error &) {
             std::throw_with_nested(exceptions::authentication_exception("Could not verify password"));
+        } catch (exceptions::authentication_exception&) {
+            throw;
         } catch (exceptions::request_execution_exception& e) {
             std::throw_with_nested(exceptions::authentication_exception(e.what()));
         } catch (...) {
@@ -280,11 +306,15 @@ future<> password_authenticator::alter(std::string_view role_name, const authent
             SALTED_HASH,
             meta::roles_table::role_col_name);
 
+    // Drop the locally cached hash right away. Other shards (and nodes) serve
+    // the old hash for up to the update period of the cache.
     return _qp.process(
             query,
             consistency_for_user(role_name),
             internal_distributed_timeout_config(),
-            {passwords::hash(*options.password, rng_for_salt), sstring(role_name)}).discard_result();
+            {passwords::hash(*options.password, rng_for_salt), sstring(role_name)}).then([this, role_name = sstring(role_name)](auto&&) {
+        _credentials_cache.remove(role_name);
+    });
 }
 
 future<> password_authenticator::drop(std::string_view name) const {
@@ -296,7 +326,9 @@ future<> password_authenticator::drop(std::string_view name) const {
     return _qp.process(
             query, consistency_for_user(name),
             internal_distributed_timeout_config(),
-            {sstring(name)}).discard_result();
+            {sstring(name)}).then([this, name = sstring(name)](auto&&) {
+        _credentials_cache.remove(name);
+    });
 }
 
 future<custom_options> password_authenticator::query_custom_options(std::string_view role_name) const {
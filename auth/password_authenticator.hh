@@ -45,6 +45,7 @@
 
 #include "auth/authenticator.hh"
 #include "cql3/query_processor.hh"
+#include "utils/loading_cache.hh"
 
 namespace service {
 class migration_manager;
@@ -60,6 +61,13 @@ class password_authenticator : public authenticator {
     future<> _stopped;
     seastar::abort_source _as;
 
+    // Shard-local cache of the salted hash of each role, so that a storm of
+    // new connections doesn't turn into a storm of roles-table reads. Only
+    // the hash lookup is amortized - the password is checked against the hash
+    // on every authentication attempt, and the outcome of a verification is
+    // never cached. Mutable because serving a cached value touches the LRU.
+    mutable utils::loading_cache<sstring, sstring, utils::loading_cache_reload_enabled::yes> _credentials_cache;
+
 public:
     static db::consistency_level consistency_for_user(std::string_view role_name);
 
@@ -99,6 +107,8 @@ private:
     future<> migrate_legacy_metadata() const;
 
     future<> create_default_if_missing() const;
+
+    future<sstring> read_salted_hash(const sstring& role_name) const;
 };
 
 }
@@ -21,6 +21,8 @@
 
 #include "auth/permissions_cache.hh"
 
+#include <seastar/core/metrics.hh>
+
 #include "auth/authorizer.hh"
 #include "auth/common.hh"
 #include "auth/service.hh"
@@ -32,6 +34,39 @@ permissions_cache::permissions_cache(const permissions_cache_config& c, service&
               log.debug("Refreshing permissions for {}", k.first);
               return ser.get_uncached_permissions(k.first, k.second);
           }) {
+    namespace sm = seastar::metrics;
+
+    _metrics.add_group("auth", {
+        sm::make_derive(
+                "permissions_cache_hits",
+                [] { return shard_stats().hits; },
+                sm::description("Counts permissions cache reads served from a fresh cached value.")),
+
+        sm::make_derive(
+                "permissions_cache_stale_hits",
+                [] { return shard_stats().stale_hits; },
+                sm::description("Counts permissions cache reads served from a stale cached value while it was being refreshed in the background.")),
+
+        sm::make_derive(
+                "permissions_cache_misses",
+                [] { return shard_stats().misses; },
+                sm::description("Counts permissions cache reads which had to load the permissions in the foreground.")),
+
+        sm::make_derive(
+                "permissions_cache_blocks",
+                [] { return shard_stats().blocks; },
+                sm::description("Counts permissions cache reads which had to wait for a load to complete.")),
+
+        sm::make_derive(
+                "permissions_cache_evictions",
+                [] { return shard_stats().evictions; },
+                sm::description("Counts evictions from the permissions cache.")),
+
+        sm::make_gauge(
+                "permissions_cache_size",
+                [this] { return _cache.size(); },
+                sm::description("A number of entries in the permissions cache.")),
+    });
 }
 
 future<permission_set> permissions_cache::get(const role_or_anonymous& maybe_role, const resource& r) {
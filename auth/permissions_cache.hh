@@ -29,6 +29,7 @@
 #include <utility>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 
@@ -64,17 +65,44 @@ struct permissions_cache_config final {
 };
 
 class permissions_cache final {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t stale_hits = 0;
+        uint64_t misses = 0;
+        uint64_t blocks = 0;
+        uint64_t evictions = 0;
+    };
+
+    static stats& shard_stats() {
+        static thread_local stats _stats;
+        return _stats;
+    }
+
+    struct permissions_cache_stats_updater {
+        static void inc_hits() noexcept { ++shard_stats().hits; }
+        static void inc_misses() noexcept { ++shard_stats().misses; }
+        static void inc_blocks() noexcept { ++shard_stats().blocks; }
+        static void inc_evictions() noexcept { ++shard_stats().evictions; }
+        static void inc_stale_hits() noexcept { ++shard_stats().stale_hits; }
+    };
+
+private:
     using cache_type = utils::loading_cache<
             std::pair<role_or_anonymous, resource>,
             permission_set,
             utils::loading_cache_reload_enabled::yes,
             utils::simple_entry_size<permission_set>,
-            utils::tuple_hash>;
+            utils::tuple_hash,
+            std::equal_to<std::pair<role_or_anonymous, resource>>,
+            permissions_cache_stats_updater>;
 
     using key_type = typename cache_type::key_type;
 
     cache_type _cache;
 
+    seastar::metrics::metric_groups _metrics;
+
 public:
     explicit permissions_cache(const permissions_cache_config&, service&, logging::logger&);
 
@@ -475,16 +475,32 @@ static future<> collect_roles(
         std::string_view grantee_name,
         bool recurse,
         role_set& roles) {
-    return require_record(qp, grantee_name).then([&qp, &roles, recurse](record r) {
-        return do_with(std::move(r.member_of), [&qp, &roles, recurse](const role_set& memberships) {
-            return do_for_each(memberships.begin(), memberships.end(), [&qp, &roles, recurse](const sstring& role_name) {
-                roles.insert(role_name);
+    // The role graph is resolved breadth-first so that all the records of one
+    // level are read in parallel rather than one query at a time. `roles`
+    // doubles as the visited set, so a role reachable through multiple paths
+    // is only queried once.
+    return do_with(
+            std::vector<sstring>{sstring(grantee_name)},
+            std::vector<sstring>(),
+            [&qp, recurse, &roles](std::vector<sstring>& current_level, std::vector<sstring>& next_level) {
+        return repeat([&qp, recurse, &roles, &current_level, &next_level] {
+            if (current_level.empty()) {
+                return make_ready_future<stop_iteration>(stop_iteration::yes);
+            }
 
-                if (recurse) {
-                    return collect_roles(qp, role_name, true, roles);
-                }
+            next_level.clear();
 
-                return make_ready_future<>();
+            return parallel_for_each(current_level, [&qp, recurse, &roles, &next_level](const sstring& role_name) {
+                return require_record(qp, role_name).then([recurse, &roles, &next_level](record r) {
+                    for (auto& member_of : r.member_of) {
+                        if (roles.insert(member_of).second && recurse) {
+                            next_level.emplace_back(member_of);
+                        }
+                    }
+                });
+            }).then([&current_level, &next_level] {
+                std::swap(current_level, next_level);
+                return stop_iteration::no;
             });
         });
     });
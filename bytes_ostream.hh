@@ -27,6 +27,8 @@
 #include <seastar/core/unaligned.hh>
 #include "hashing.hh"
 #include <seastar/core/simple-stream.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/core/deleter.hh>
 /**
  * Utility for writing data into a buffer when its final size is not known up front.
  *
@@ -293,8 +295,26 @@ public:
         return _size == 0;
     }
 
+    // Pre-allocates a single chunk able to hold size bytes, so that a writer
+    // which knows the serialized size in advance produces contiguous,
+    // exactly-sized storage instead of a chain of doubling chunks which
+    // reduce_chunk_count() would then copy into one. Only has an effect on an
+    // empty stream; the chunk is capped at max_chunk_size() to keep large
+    // allocations fragmented as usual.
     void reserve(size_t size) {
-        // FIXME: implement
+        if (_current || !size) {
+            return;
+        }
+        auto alloc_size = std::min(size + sizeof(chunk), size_t(max_chunk_size()));
+        auto space = malloc(alloc_size);
+        if (!space) {
+            throw std::bad_alloc();
+        }
+        auto new_chunk = std::unique_ptr<chunk>(new (space) chunk());
+        new_chunk->offset = 0;
+        new_chunk->size = alloc_size - sizeof(chunk);
+        _begin = std::move(new_chunk);
+        _current = _begin.get();
     }
 
     void append(const bytes_ostream& o) {
@@ -407,6 +427,36 @@ public:
         return !(*this == other);
     }
 
+    // Transfers ownership of the written data out of this instance as a
+    // sequence of buffers, without copying. Each buffer keeps its backing
+    // chunk alive through its deleter, so the result can be fed directly
+    // into scatter-gather interfaces (scattered_message, net::packet,
+    // output_stream) which take temporary_buffer, avoiding linearize().
+    //
+    // Leaves this instance empty.
+    std::vector<seastar::temporary_buffer<char>> release() && {
+        std::vector<seastar::temporary_buffer<char>> fragments;
+        size_t nr_fragments = 0;
+        for (auto c = _begin.get(); c; c = c->next.get()) {
+            nr_fragments += bool(c->offset);
+        }
+        // Reserve up front so that nothing throws once we start detaching chunks.
+        fragments.reserve(nr_fragments);
+        auto c = std::move(_begin);
+        while (c) {
+            auto next = std::move(c->next);
+            if (c->offset) {
+                auto data = reinterpret_cast<char*>(c->data);
+                auto size = c->offset;
+                fragments.emplace_back(data, size, seastar::make_object_deleter(std::move(c)));
+            }
+            c = std::move(next);
+        }
+        _current = nullptr;
+        _size = 0;
+        return fragments;
+    }
+
     // Makes this instance empty.
     //
     // The first buffer is not deallocated, so callers may rely on the
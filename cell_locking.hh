@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <boost/intrusive/unordered_set.hpp>
 
 #include "utils/small_vector.hh"
@@ -269,6 +271,7 @@ private:
         ~partition_entry() {
             if (is_linked()) {
                 _parent._partition_count--;
+                _parent._contention_hints[_parent.contention_hint_slot(_key)]--;
             }
         }
 
@@ -325,15 +328,37 @@ private:
     size_t _rehash_at_size = compute_rehash_at_size(initial_bucket_count);
     schema_ptr _schema;
 
+    // Bloom-filter-style contention hints. Each slot counts the live
+    // partition entries whose token hashes to it, so a zero slot proves that
+    // no locks are held in the partition being locked and lock_cells() can
+    // skip walking the hash structures altogether. A false positive (another
+    // partition sharing the slot) merely takes the full path.
+    static constexpr size_t contention_hint_count = 1024;
+    static_assert(!(contention_hint_count & (contention_hint_count - 1)), "contention_hint_count must be a power of two");
+    std::array<uint32_t, contention_hint_count> _contention_hints = {};
+
     // partitions_type uses equality comparator which keeps a reference to the
     // original schema, we must ensure that it doesn't die.
     schema_ptr _original_schema;
     cell_locker_stats& _stats;
 
     friend class locked_cell;
+public:
+    // Per-table statistics for the optimistic fast path in lock_cells().
+    struct single_locker_stats {
+        uint64_t lock_cells_fast_path = 0;   // contention hint clear, hash walk skipped
+        uint64_t lock_cells_false_hints = 0; // hint set, but the walk found no locks
+        uint64_t lock_cells_contended = 0;   // locks were held in the partition
+    };
+private:
+    single_locker_stats _table_stats;
 private:
     struct locker;
 
+    size_t contention_hint_slot(const dht::decorated_key& dk) const {
+        return std::hash<dht::token>()(dk.token()) & (contention_hint_count - 1);
+    }
+
     static constexpr size_t compute_rehash_at_size(size_t bucket_count) {
         return bucket_count * max_load_factor::num / max_load_factor::den;
     }
@@ -369,6 +394,10 @@ public:
         return _schema;
     }
 
+    single_locker_stats& table_stats() {
+        return _table_stats;
+    }
+
     // partition_cells_range is required to be in cell_locker::schema()
     future<std::vector<locked_cell>> lock_cells(const dht::decorated_key& dk, partition_cells_range&& range,
                                                 db::timeout_clock::time_point timeout);
@@ -443,17 +472,30 @@ public:
 
 inline
 future<std::vector<locked_cell>> cell_locker::lock_cells(const dht::decorated_key& dk, partition_cells_range&& range, db::timeout_clock::time_point timeout) {
-    partition_entry::hasher pe_hash;
-    partition_entry::equal_compare pe_eq(*_schema);
-
-    auto it = _partitions.find(dk, pe_hash, pe_eq);
     std::unique_ptr<partition_entry> partition;
-    if (it == _partitions.end()) {
+    auto it = _partitions.end();
+    if (!_contention_hints[contention_hint_slot(dk)]) {
+        // The common case: no partition entry can exist for this key, so
+        // there is no point in walking the hash structures looking for one.
+        _table_stats.lock_cells_fast_path++;
         partition = std::make_unique<partition_entry>(_schema, *this, dk);
-    } else if (!it->upgrade(_schema)) {
-        partition = std::unique_ptr<partition_entry>(&*it);
-        _partition_count--;
-        _partitions.erase(it);
+    } else {
+        partition_entry::hasher pe_hash;
+        partition_entry::equal_compare pe_eq(*_schema);
+
+        it = _partitions.find(dk, pe_hash, pe_eq);
+        if (it == _partitions.end()) {
+            _table_stats.lock_cells_false_hints++;
+            partition = std::make_unique<partition_entry>(_schema, *this, dk);
+        } else {
+            _table_stats.lock_cells_contended++;
+            if (!it->upgrade(_schema)) {
+                partition = std::unique_ptr<partition_entry>(&*it);
+                _partition_count--;
+                _contention_hints[contention_hint_slot(dk)]--;
+                _partitions.erase(it);
+            }
+        }
     }
 
     if (partition) {
@@ -473,6 +515,7 @@ future<std::vector<locked_cell>> cell_locker::lock_cells(const dht::decorated_ke
         if (!locks.empty()) {
             _partitions.insert(*partition.release());
             _partition_count++;
+            _contention_hints[contention_hint_slot(dk)]++;
             maybe_rehash();
         }
         return make_ready_future<std::vector<locked_cell>>(std::move(locks));
@@ -63,6 +63,11 @@ public:
 
     compaction_descriptor get_major_compaction_job(column_family& cf, std::vector<shared_sstable> candidates);
 
+    // Like get_major_compaction_job(), but a strategy whose major work falls
+    // apart into jobs over disjoint sets of sstables (e.g. one per TWCS time
+    // window) may return several, which are safe to run in parallel.
+    std::vector<compaction_descriptor> get_major_compaction_jobs(column_family& cf, std::vector<shared_sstable> candidates);
+
     std::vector<resharding_descriptor> get_resharding_jobs(column_family& cf, std::vector<shared_sstable> candidates);
 
     // Some strategies may look at the compacted and resulting sstables to
@@ -34,6 +34,8 @@ public:
 
     size_t uncompress(const char* input, size_t input_len, char* output,
                     size_t output_len) const override;
+    size_t uncompress_partial(const char* input, size_t input_len, char* output,
+                    size_t output_len, size_t target_len) const override;
     size_t compress(const char* input, size_t input_len, char* output,
                     size_t output_len) const override;
     size_t compress_max_size(size_t input_len) const override;
@@ -56,6 +58,8 @@ public:
 
     size_t uncompress(const char* input, size_t input_len, char* output,
                     size_t output_len) const override;
+    size_t uncompress_partial(const char* input, size_t input_len, char* output,
+                    size_t output_len, size_t target_len) const override;
     size_t compress(const char* input, size_t input_len, char* output,
                     size_t output_len) const override;
     size_t compress_max_size(size_t input_len) const override;
@@ -237,6 +241,23 @@ size_t lz4_processor::uncompress(const char* input, size_t input_len,
     return ret;
 }
 
+size_t lz4_processor::uncompress_partial(const char* input, size_t input_len,
+                char* output, size_t output_len, size_t target_len) const {
+    // Skip the uncompressed length Cassandra's LZ4Compressor prepends to the
+    // chunk, as in uncompress() above.
+    input += 4;
+    input_len -= 4;
+
+    // LZ4_decompress_safe_partial() stops on the first match which takes the
+    // output past target_len, so it may write up to output_len bytes; the
+    // extra bytes are valid decompressed data.
+    auto ret = LZ4_decompress_safe_partial(input, output, input_len, target_len, output_len);
+    if (ret < 0) {
+        throw std::runtime_error("LZ4 uncompression failure");
+    }
+    return ret;
+}
+
 size_t lz4_processor::compress(const char* input, size_t input_len,
                 char* output, size_t output_len) const {
     if (output_len < LZ4_COMPRESSBOUND(input_len) + 4) {
@@ -287,6 +308,34 @@ size_t deflate_processor::uncompress(const char* input,
     }
 }
 
+size_t deflate_processor::uncompress_partial(const char* input,
+                size_t input_len, char* output, size_t output_len, size_t target_len) const {
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+    zs.avail_in = 0;
+    zs.next_in = Z_NULL;
+    if (inflateInit(&zs) != Z_OK) {
+        throw std::runtime_error("deflate uncompression init failure");
+    }
+    zs.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(input));
+    zs.avail_in = input_len;
+    zs.next_out = reinterpret_cast<unsigned char*>(output);
+    // Exposing only target_len of the output buffer makes inflate() stop
+    // once that much has been produced, instead of decoding the whole block.
+    zs.avail_out = target_len;
+    auto res = inflate(&zs, Z_SYNC_FLUSH);
+    inflateEnd(&zs);
+    // Z_OK with a full output buffer means decoding stopped at target_len
+    // with input left over, which is exactly the partial result we want.
+    if (res == Z_STREAM_END || (res == Z_OK && zs.avail_out == 0)) {
+        return target_len - zs.avail_out;
+    } else {
+        throw std::runtime_error("deflate uncompression failure");
+    }
+}
+
 size_t deflate_processor::compress(const char* input,
                 size_t input_len, char* output, size_t output_len) const {
     z_stream zs;
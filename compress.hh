@@ -44,6 +44,19 @@ public:
      */
     virtual size_t uncompress(const char* input, size_t input_len, char* output,
                     size_t output_len) const = 0;
+    /**
+     * Like uncompress, but stops decompressing as soon as at least target_len
+     * bytes of output have been produced, saving the work of decompressing the
+     * rest of the block when only a prefix is needed. The output buffer must
+     * still be able to hold the full uncompressed data (output_len), since
+     * implementations are allowed to overshoot target_len. Returns the number
+     * of bytes actually written. Implementations without partial support fall
+     * back to decompressing the whole block.
+     */
+    virtual size_t uncompress_partial(const char* input, size_t input_len, char* output,
+                    size_t output_len, size_t target_len) const {
+        return uncompress(input, input_len, output, output_len);
+    }
     /**
      * Packs data in "input" to output. If output_len is of insufficient size,
      * exception is thrown. Maximum required size is obtained via "compress_max_size"
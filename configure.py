@@ -280,7 +280,9 @@ scylla_tests = [
     'tests/perf/perf_hash',
     'tests/perf/perf_cql_parser',
     'tests/perf/perf_simple_query',
+    'tests/perf/perf_write_path',
     'tests/perf/perf_fast_forward',
+    'tests/perf/perf_read_amplification',
     'tests/perf/perf_cache_eviction',
     'tests/cache_flat_mutation_reader_test',
     'tests/row_cache_stress_test',
@@ -326,10 +328,13 @@ scylla_tests = [
     'tests/logalloc_test',
     'tests/log_heap_test',
     'tests/managed_vector_test',
+    'tests/bptree_test',
+    'tests/object_pool_test',
     'tests/crc_test',
     'tests/checksum_utils_test',
     'tests/flush_queue_test',
     'tests/dynamic_bitset_test',
+    'tests/bloom_filter_test',
     'tests/auth_test',
     'tests/idl_test',
     'tests/range_tombstone_list_test',
@@ -810,6 +815,8 @@ pure_boost_tests = set([
     'tests/crc_test',
     'tests/checksum_utils_test',
     'tests/managed_vector_test',
+    'tests/bptree_test',
+    'tests/object_pool_test',
     'tests/dynamic_bitset_test',
     'tests/idl_test',
     'tests/cartesian_product_test',
@@ -844,7 +851,9 @@ tests_not_using_seastar_test_framework = set([
     'tests/perf/perf_cql_parser',
     'tests/message',
     'tests/perf/perf_simple_query',
+    'tests/perf/perf_write_path',
     'tests/perf/perf_fast_forward',
+    'tests/perf/perf_read_amplification',
     'tests/perf/perf_cache_eviction',
     'tests/row_cache_stress_test',
     'tests/memory_footprint',
@@ -40,9 +40,36 @@
  */
 
 #include "cql3/attributes.hh"
+#include "cql3/constants.hh"
 
 namespace cql3 {
 
+static int64_t read_and_validate_timestamp(bytes_view val) {
+    try {
+        data_type_for<int64_t>()->validate(val);
+    } catch (marshal_exception& e) {
+        throw exceptions::invalid_request_exception("Invalid timestamp value");
+    }
+    return value_cast<int64_t>(data_type_for<int64_t>()->deserialize(val));
+}
+
+static int32_t read_and_validate_time_to_live(bytes_view val) {
+    try {
+        data_type_for<int32_t>()->validate(val);
+    } catch (marshal_exception& e) {
+        throw exceptions::invalid_request_exception("Invalid TTL value");
+    }
+    auto ttl = value_cast<int32_t>(data_type_for<int32_t>()->deserialize(val));
+    if (ttl < 0) {
+        throw exceptions::invalid_request_exception("A TTL must be greater or equal to 0");
+    }
+    if (ttl > max_ttl.count()) {
+        throw exceptions::invalid_request_exception("ttl is too large. requested (" + std::to_string(ttl) +
+            ") maximum (" + std::to_string(max_ttl.count()) + ")");
+    }
+    return ttl;
+}
+
 std::unique_ptr<attributes> attributes::none() {
     return std::unique_ptr<attributes>{new attributes{{}, {}}};
 }
@@ -50,7 +77,21 @@ std::unique_ptr<attributes> attributes::none() {
 attributes::attributes(::shared_ptr<term>&& timestamp, ::shared_ptr<term>&& time_to_live)
     : _timestamp{std::move(timestamp)}
     , _time_to_live{std::move(time_to_live)}
-{ }
+{
+    // In the overwhelmingly common case the attributes are literals, which
+    // prepare into a constants::value whose content cannot change between
+    // executions. Fold those once instead of evaluating the term for every
+    // write. Null and unset values keep taking the term path, which handles
+    // them (null: invalid request, unset: as if not provided).
+    if (auto v = dynamic_pointer_cast<constants::value>(_timestamp); v && !v->_bytes.is_null() && !v->_bytes.is_unset_value()) {
+        auto view = v->_bytes.to_view();
+        _folded_timestamp = with_linearized(*view, read_and_validate_timestamp);
+    }
+    if (auto v = dynamic_pointer_cast<constants::value>(_time_to_live); v && !v->_bytes.is_null() && !v->_bytes.is_unset_value()) {
+        auto view = v->_bytes.to_view();
+        _folded_time_to_live = with_linearized(*view, read_and_validate_time_to_live);
+    }
+}
 
 bool attributes::uses_function(const sstring& ks_name, const sstring& function_name) const {
     return (_timestamp && _timestamp->uses_function(ks_name, function_name))
@@ -66,6 +107,9 @@ bool attributes::is_time_to_live_set() const {
 }
 
 int64_t attributes::get_timestamp(int64_t now, const query_options& options) {
+    if (_folded_timestamp) {
+        return *_folded_timestamp;
+    }
     if (!_timestamp) {
         return now;
     }
@@ -77,17 +121,13 @@ int64_t attributes::get_timestamp(int64_t now, const query_options& options) {
     if (tval.is_unset_value()) {
         return now;
     }
-  return with_linearized(*tval, [] (bytes_view val) {
-    try {
-        data_type_for<int64_t>()->validate(val);
-    } catch (marshal_exception& e) {
-        throw exceptions::invalid_request_exception("Invalid timestamp value");
-    }
-    return value_cast<int64_t>(data_type_for<int64_t>()->deserialize(val));
-  });
+    return with_linearized(*tval, read_and_validate_timestamp);
 }
 
 int32_t attributes::get_time_to_live(const query_options& options) {
+    if (_folded_time_to_live) {
+        return *_folded_time_to_live;
+    }
     if (!_time_to_live)
         return 0;
 
@@ -98,26 +138,7 @@ int32_t attributes::get_time_to_live(const query_options& options) {
     if (tval.is_unset_value()) {
         return 0;
     }
-  auto ttl = with_linearized(*tval, [] (bytes_view val) {
-    try {
-        data_type_for<int32_t>()->validate(val);
-    }
-    catch (marshal_exception& e) {
-        throw exceptions::invalid_request_exception("Invalid TTL value");
-    }
-
-    return value_cast<int32_t>(data_type_for<int32_t>()->deserialize(val));
-  });
-    if (ttl < 0) {
-        throw exceptions::invalid_request_exception("A TTL must be greater or equal to 0");
-    }
-
-    if (ttl > max_ttl.count()) {
-        throw exceptions::invalid_request_exception("ttl is too large. requested (" + std::to_string(ttl) +
-            ") maximum (" + std::to_string(max_ttl.count()) + ")");
-    }
-
-    return ttl;
+    return with_linearized(*tval, read_and_validate_time_to_live);
 }
 
 void attributes::collect_marker_specification(::shared_ptr<variable_specifications> bound_names) {
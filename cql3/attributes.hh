@@ -54,6 +54,12 @@ class attributes final {
 private:
     const ::shared_ptr<term> _timestamp;
     const ::shared_ptr<term> _time_to_live;
+    // Values of literal USING TIMESTAMP/TTL, folded once at prepare time so
+    // that execution reads a plain integer instead of evaluating the term
+    // against the options for every write. Disengaged when the attribute is
+    // a bind marker or was not provided.
+    std::optional<int64_t> _folded_timestamp;
+    std::optional<int32_t> _folded_time_to_live;
 public:
     static std::unique_ptr<attributes> none();
 private:
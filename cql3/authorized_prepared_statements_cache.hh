@@ -85,6 +85,7 @@ public:
         static void inc_evictions() noexcept {
             ++shard_stats().authorized_prepared_statements_cache_evictions;
         }
+        static void inc_stale_hits() noexcept {}
     };
 
 private:
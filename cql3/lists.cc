@@ -118,16 +118,18 @@ lists::literal::to_string() const {
 lists::value
 lists::value::from_serialized(const fragmented_temporary_buffer::view& val, list_type type, cql_serialization_format sf) {
     try {
-        // Collections have this small hack that validate cannot be called on a serialized object,
-        // but compose does the validation (so we're fine).
-        // FIXME: deserializeForNativeProtocol()?!
       return with_linearized(val, [&] (bytes_view v) {
-        auto l = value_cast<list_type_impl::native_type>(type->deserialize(v, sf));
+        // Walk the serialized form directly: validate each element in place
+        // and keep its serialized bytes, instead of deserializing everything
+        // into boxed data_values only to re-serialize them again.
+        auto nr = read_collection_size(v, sf);
         std::vector<bytes_opt> elements;
-        elements.reserve(l.size());
-        for (auto&& element : l) {
-            // elements can be null in lists that represent a set of IN values
-            elements.push_back(element.is_null() ? bytes_opt() : bytes_opt(type->get_elements_type()->decompose(element)));
+        elements.reserve(nr);
+        auto element_type = type->get_elements_type();
+        for (int i = 0; i != nr; ++i) {
+            auto e = read_collection_value(v, sf);
+            element_type->validate(e);
+            elements.emplace_back(bytes(e.begin(), e.end()));
         }
         return value(std::move(elements));
       });
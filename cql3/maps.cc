@@ -155,15 +155,20 @@ maps::literal::to_string() const {
 maps::value
 maps::value::from_serialized(const fragmented_temporary_buffer::view& fragmented_value, map_type type, cql_serialization_format sf) {
     try {
-        // Collections have this small hack that validate cannot be called on a serialized object,
-        // but compose does the validation (so we're fine).
-        // FIXME: deserialize_for_native_protocol?!
       return with_linearized(fragmented_value, [&] (bytes_view value) {
-        auto m = value_cast<map_type_impl::native_type>(type->deserialize(value, sf));
-        std::map<bytes, bytes, serialized_compare> map(type->get_keys_type()->as_less_comparator());
-        for (auto&& e : m) {
-            map.emplace(type->get_keys_type()->decompose(e.first),
-                        type->get_values_type()->decompose(e.second));
+        // Walk the serialized form directly: validate each key and value in
+        // place and keep their serialized bytes, instead of deserializing
+        // everything into boxed data_values only to re-serialize them again.
+        auto nr = read_collection_size(value, sf);
+        auto keys_type = type->get_keys_type();
+        auto values_type = type->get_values_type();
+        std::map<bytes, bytes, serialized_compare> map(keys_type->as_less_comparator());
+        for (int i = 0; i != nr; ++i) {
+            auto k = read_collection_value(value, sf);
+            keys_type->validate(k);
+            auto v = read_collection_value(value, sf);
+            values_type->validate(v);
+            map.emplace(bytes(k.begin(), k.end()), bytes(v.begin(), v.end()));
         }
         return maps::value { std::move(map) };
       });
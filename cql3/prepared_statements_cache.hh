@@ -96,6 +96,7 @@ public:
         static void inc_evictions() noexcept {
             ++shard_stats().prepared_cache_evictions;
         }
+        static void inc_stale_hits() noexcept {}
     };
 
 private:
@@ -94,7 +94,8 @@ api::timestamp_type query_processor::next_timestamp() {
     return _internal_state->next_timestamp();
 }
 
-query_processor::query_processor(service::storage_proxy& proxy, database& db, query_processor::memory_config mcfg)
+query_processor::query_processor(service::storage_proxy& proxy, database& db, query_processor::memory_config mcfg,
+            seastar::scheduling_group parse_scheduling_group)
         : _migration_subscriber{std::make_unique<migration_subscriber>(this)}
         , _proxy(proxy)
         , _db(db)
@@ -103,7 +104,8 @@ query_processor::query_processor(service::storage_proxy& proxy, database& db, qu
         , _authorized_prepared_cache(std::min(std::chrono::milliseconds(_db.get_config().permissions_validity_in_ms()),
                                               std::chrono::duration_cast<std::chrono::milliseconds>(prepared_statements_cache::entry_expiry)),
                                      std::chrono::milliseconds(_db.get_config().permissions_update_interval_in_ms()),
-                                     mcfg.authorized_prepared_cache_size, authorized_prepared_statements_cache_log) {
+                                     mcfg.authorized_prepared_cache_size, authorized_prepared_statements_cache_log)
+        , _parse_scheduling_group(parse_scheduling_group) {
     namespace sm = seastar::metrics;
 
     _metrics.add_group(
@@ -274,20 +276,22 @@ future<::shared_ptr<result_message>>
 query_processor::process(const sstring_view& query_string, service::query_state& query_state, query_options& options) {
     log.trace("process: \"{}\"", query_string);
     tracing::trace(query_state.get_trace_state(), "Parsing a statement");
-    auto p = get_statement(query_string, query_state.get_client_state());
-    auto cql_statement = p->statement;
-    if (cql_statement->get_bound_terms() != options.get_values_count()) {
-        throw exceptions::invalid_request_exception("Invalid amount of bind variables");
-    }
-    options.prepare(p->bound_names);
+    return get_statement_async(query_string, query_state.get_client_state()).then(
+            [this, &query_state, &options] (std::unique_ptr<prepared_statement> p) {
+        auto cql_statement = p->statement;
+        if (cql_statement->get_bound_terms() != options.get_values_count()) {
+            throw exceptions::invalid_request_exception("Invalid amount of bind variables");
+        }
+        options.prepare(p->bound_names);
 
-    warn(unimplemented::cause::METRICS);
+        warn(unimplemented::cause::METRICS);
 #if 0
         if (!queryState.getClientState().isInternal)
             metrics.regularStatementsExecuted.inc();
 #endif
-    tracing::trace(query_state.get_trace_state(), "Processing a statement");
-    return process_statement_unprepared(std::move(cql_statement), query_state, options);
+        tracing::trace(query_state.get_trace_state(), "Processing a statement");
+        return process_statement_unprepared(std::move(cql_statement), query_state, options);
+    });
 }
 
 future<::shared_ptr<result_message>>
@@ -425,6 +429,27 @@ query_processor::get_statement(const sstring_view& query, const service::client_
     return statement->prepare(_db, _cql_stats);
 }
 
+// Statements longer than this are parsed through _parse_scheduling_group.
+// Anything smaller parses quickly enough for the reactor stall not to
+// matter, and the common case stays free of the extra scheduling points.
+static constexpr size_t parse_offload_threshold = 4 * 1024;
+
+future<std::unique_ptr<prepared_statement>>
+query_processor::get_statement_async(const sstring_view& query, const service::client_state& client_state) {
+    if (query.size() < parse_offload_threshold) {
+        return make_ready_future<std::unique_ptr<prepared_statement>>(get_statement(query, client_state));
+    }
+    // The limiter admits one parse at a time, so during a storm of large
+    // unprepared statements the waiters queue up here while the shard keeps
+    // serving everybody else. The query is copied since not every caller
+    // keeps the underlying buffer alive once we defer.
+    return with_semaphore(_parse_limiter, 1, [this, query = sstring(query), &client_state] () mutable {
+        return with_scheduling_group(_parse_scheduling_group, [this, query = std::move(query), &client_state] {
+            return get_statement(query, client_state);
+        });
+    });
+}
+
 ::shared_ptr<raw::parsed_statement>
 query_processor::parse_statement(const sstring_view& query) {
     try {
@@ -496,6 +521,17 @@ query_processor::execute_internal(const sstring& query_string, const std::initia
     return execute_internal(prepare_internal(query_string), values);
 }
 
+future<::shared_ptr<untyped_result_set>>
+query_processor::execute_internal(internal_statement& stmt, const std::initializer_list<data_value>& values) {
+    if (log.is_enabled(logging::log_level::trace)) {
+        log.trace("execute_internal: \"{}\" ({})", stmt._query_string, ::join(", ", values));
+    }
+    if (!stmt._prepared) {
+        stmt._prepared = prepare_internal(stmt._query_string);
+    }
+    return execute_internal(stmt._prepared->checked_weak_from_this(), values);
+}
+
 struct internal_query_state {
     sstring query_string;
     std::unique_ptr<query_options> opts;
@@ -46,6 +46,8 @@
 
 #include <seastar/core/distributed.hh>
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include "cql3/prepared_statements_cache.hh"
@@ -124,6 +126,12 @@ private:
     prepared_statements_cache _prepared_cache;
     authorized_prepared_statements_cache _authorized_prepared_cache;
 
+    // Large unprepared statements are parsed in this scheduling group, one
+    // at a time, so that a storm of them cannot monopolize the shard at the
+    // expense of the other connections. See get_statement_async().
+    seastar::scheduling_group _parse_scheduling_group;
+    seastar::semaphore _parse_limiter{1};
+
     // A map for prepared statements used internally (which we don't want to mix with user statement, in particular we
     // don't bother with expiration on those.
     std::unordered_map<sstring, std::unique_ptr<statements::prepared_statement>> _internal_statements;
@@ -141,7 +149,8 @@ public:
 
     static ::shared_ptr<statements::raw::parsed_statement> parse_statement(const std::string_view& query);
 
-    query_processor(service::storage_proxy& proxy, database& db, memory_config mcfg);
+    query_processor(service::storage_proxy& proxy, database& db, memory_config mcfg,
+            seastar::scheduling_group parse_scheduling_group = seastar::scheduling_group());
 
     ~query_processor();
 
@@ -208,6 +217,31 @@ public:
     future<::shared_ptr<untyped_result_set>>
     execute_internal(statements::prepared_statement::checked_weak_ptr p, const std::initializer_list<data_value>& = { });
 
+    /// A per-shard handle to a statement prepared with prepare_internal().
+    /// The first execution parses and prepares the statement; subsequent ones
+    /// go straight to the prepared statement, skipping the string-keyed map
+    /// lookup that execute_internal(const sstring&, ...) pays on every call.
+    /// Keep one in a static thread_local at the call site of a recurring
+    /// internal query.
+    class internal_statement {
+        sstring _query_string;
+        statements::prepared_statement::checked_weak_ptr _prepared;
+
+        friend class query_processor;
+
+    public:
+        explicit internal_statement(sstring query_string)
+                : _query_string(std::move(query_string)) {
+        }
+
+        const sstring& query_string() const noexcept {
+            return _query_string;
+        }
+    };
+
+    future<::shared_ptr<untyped_result_set>>
+    execute_internal(internal_statement& stmt, const std::initializer_list<data_value>& = { });
+
     /*!
      * \brief iterate over all cql results using paging
      *
@@ -326,6 +360,14 @@ public:
             const std::string_view& query,
             const service::client_state& client_state);
 
+    /// Like get_statement(), but large statements are parsed in
+    /// _parse_scheduling_group instead of the current one, one at a time.
+    /// The ANTLR parser cannot yield, so a storm of big unprepared batches
+    /// parsed in-line would stall every other connection on the shard.
+    future<std::unique_ptr<statements::prepared_statement>> get_statement_async(
+            const std::string_view& query,
+            const service::client_state& client_state);
+
     friend class migration_subscriber;
 
 private:
@@ -435,6 +477,10 @@ private:
         return ::make_shared<ResultMsgType>(id_getter(cache_key), *it);
     }
 
+public:
+    /// Returns the already-prepared statement for the given query, or an
+    /// empty pointer if it is not in the cache. Unlike prepare(), never
+    /// parses the statement.
     ::shared_ptr<cql_transport::messages::result_message::prepared>
     get_stored_prepared_statement(
             const std::string_view& query_string,
@@ -298,6 +298,104 @@ statement_restrictions::statement_restrictions(database& db,
     if (_uses_secondary_indexing && !(for_view || allow_filtering)) {
         validate_secondary_index_selections(selects_only_static_columns);
     }
+
+    compile_clustering_bounds();
+}
+
+void statement_restrictions::compile_clustering_bounds() {
+    // Compile the two shapes which cover the vast majority of prepared
+    // statements: an EQ restriction on each clustering column of a prefix,
+    // optionally followed by a slice on the next column. Everything else
+    // (IN, CONTAINS, multi-column relations, shapes needing filtering) keeps
+    // using the generic restriction tree walk.
+    if (_clustering_columns_restrictions->empty()
+            || _clustering_columns_restrictions->needs_filtering(*_schema)) {
+        return;
+    }
+    auto single_ck_restrictions = dynamic_pointer_cast<single_column_clustering_key_restrictions>(_clustering_columns_restrictions);
+    if (!single_ck_restrictions) {
+        return;
+    }
+    std::vector<::shared_ptr<single_column_restriction>> eq_restrictions;
+    eq_restrictions.reserve(single_ck_restrictions->restrictions().size());
+    ::shared_ptr<single_column_restriction> slice_restriction;
+    for (auto&& e : single_ck_restrictions->restrictions()) {
+        auto&& r = e.second;
+        if (slice_restriction) {
+            // Shouldn't happen when needs_filtering() is false, but stay on
+            // the safe side and leave such shapes to the generic path.
+            return;
+        }
+        if (r->is_slice()) {
+            slice_restriction = r;
+        } else if (r->is_EQ()) {
+            eq_restrictions.emplace_back(r);
+        } else {
+            return;
+        }
+    }
+
+    auto read_eq_components = [] (const schema& s,
+            const std::vector<::shared_ptr<single_column_restriction>>& eq, const query_options& options) {
+        std::vector<bytes_opt> components;
+        components.reserve(eq.size() + 1);
+        for (auto&& r : eq) {
+            auto&& val = r->value(options);
+            if (!val) {
+                throw exceptions::invalid_request_exception(
+                        format("Invalid null value for clustering key part {}", r->get_column_def().name_as_text()));
+            }
+            components.emplace_back(std::move(*val));
+        }
+        return components;
+    };
+
+    if (!slice_restriction) {
+        _compiled_clustering_bounds = [s = _schema, eq = std::move(eq_restrictions), read_eq_components] (const query_options& options) {
+            std::vector<query::clustering_range> ranges;
+            ranges.reserve(1);
+            ranges.emplace_back(query::clustering_range::make_singular(
+                    clustering_key_prefix::from_optional_exploded(*s, read_eq_components(*s, eq, options))));
+            return ranges;
+        };
+        return;
+    }
+
+    const bool reversed = slice_restriction->get_column_def().type->is_reversed();
+    _compiled_clustering_bounds = [s = _schema, eq = std::move(eq_restrictions), sr = std::move(slice_restriction),
+            reversed, read_eq_components] (const query_options& options) -> std::vector<query::clustering_range> {
+        auto prefix = read_eq_components(*s, eq, options);
+        auto read_bound = [&] (statements::bound b) -> std::optional<query::clustering_range::bound> {
+            if (!sr->has_bound(b)) {
+                if (prefix.empty()) {
+                    return {};
+                }
+                return query::clustering_range::bound(clustering_key_prefix::from_optional_exploded(*s, prefix));
+            }
+            auto value = std::move(sr->bounds(b, options)[0]);
+            if (!value) {
+                throw exceptions::invalid_request_exception(
+                        format("Invalid null value for clustering key part {}", sr->get_column_def().name_as_text()));
+            }
+            prefix.emplace_back(std::move(value));
+            auto val = clustering_key_prefix::from_optional_exploded(*s, prefix);
+            prefix.pop_back();
+            return query::clustering_range::bound(std::move(val), sr->is_inclusive(b));
+        };
+        query::range<clustering_key_prefix> range(read_bound(statements::bound::START), read_bound(statements::bound::END));
+        if (reversed) {
+            range.reverse();
+        }
+        auto bounds = bound_view::from_range(range);
+        if (bound_view::compare(*s)(bounds.second, bounds.first)) {
+            // Empty range, e.g. WHERE ck > 5 AND ck < 3.
+            return {};
+        }
+        std::vector<query::clustering_range> ranges;
+        ranges.reserve(1);
+        ranges.emplace_back(query::clustering_range(std::move(range)));
+        return ranges;
+    };
 }
 
 void statement_restrictions::add_restriction(::shared_ptr<restriction> restriction, bool for_view, bool allow_filtering) {
@@ -465,6 +563,9 @@ dht::partition_range_vector statement_restrictions::get_partition_key_ranges(con
 }
 
 std::vector<query::clustering_range> statement_restrictions::get_clustering_bounds(const query_options& options) const {
+    if (_compiled_clustering_bounds) {
+        return _compiled_clustering_bounds(options);
+    }
     if (_clustering_columns_restrictions->empty()) {
         return {query::clustering_range::make_open_ended_both_sides()};
     }
@@ -42,6 +42,7 @@
 #pragma once
 
 #include <vector>
+#include <functional>
 #include "to_string.hh"
 #include "schema.hh"
 #include "cql3/restrictions/restrictions.hh"
@@ -101,6 +102,16 @@ private:
      */
     bool _is_key_range = false;
 
+    /**
+     * Bound-extraction closure compiled at prepare time for the common
+     * clustering restriction shapes (an EQ prefix, optionally followed by a
+     * slice). It goes straight from the bind variables to the clustering
+     * range vector, skipping the per-execution restriction tree walk.
+     * Disengaged when the shape is not compilable, in which case
+     * get_clustering_bounds() falls back to the generic path.
+     */
+    std::function<std::vector<query::clustering_range>(const query_options&)> _compiled_clustering_bounds;
+
 public:
     /**
      * Creates a new empty <code>StatementRestrictions</code>.
@@ -122,6 +133,7 @@ public:
 private:
     void add_restriction(::shared_ptr<restriction> restriction, bool for_view, bool allow_filtering);
     void add_single_column_restriction(::shared_ptr<single_column_restriction> restriction, bool for_view, bool allow_filtering);
+    void compile_clustering_bounds();
 public:
     bool uses_function(const sstring& ks_name, const sstring& function_name) const;
 
@@ -23,6 +23,7 @@
 
 #include "selection/selection.hh"
 #include "stats.hh"
+#include "utils/small_vector.hh"
 
 namespace cql3 {
 
@@ -37,7 +38,10 @@ private:
     class query_result_visitor {
         const schema& _schema;
         std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Views into the clustering key passed to accept_new_row(), which
+        // result_view::consume() deserializes as a temporary; they are only
+        // used within that call, so no copy of the components is needed.
+        utils::small_vector<bytes_view, 8> _clustering_key;
         uint32_t _partition_row_count = 0;
         uint32_t _total_row_count = 0;
         Visitor& _visitor;
@@ -66,7 +70,10 @@ private:
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            _clustering_key.clear();
+            for (bytes_view component : key.components(_schema)) {
+                _clustering_key.push_back(component);
+            }
             accept_new_row(static_row, row);
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
@@ -80,7 +87,7 @@ private:
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(query::result_bytes_view(bytes_view(_clustering_key[def->component_index()])));
+                        _visitor.accept_value(query::result_bytes_view(_clustering_key[def->component_index()]));
                     } else {
                         _visitor.accept_value({});
                     }
@@ -134,6 +141,13 @@ public:
         query::result_view::consume(*_result, _command->slice, v);
         _stats->rows_read += v.rows_read();
     }
+
+    // The serialized rows closely follow the underlying query result
+    // buffer in size, so use it as an estimate. Zero when no result is
+    // attached.
+    size_t serialized_size_hint() const {
+        return _result ? _result->buf().size() : 0;
+    }
 };
 
 }
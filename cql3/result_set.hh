@@ -250,6 +250,13 @@ public:
     { }
 
     const cql3::metadata& get_metadata() const { return *_metadata; }
+
+    // Rough size of the rows once serialized to the CQL wire format, for
+    // pre-sizing output buffers. Zero when unknown.
+    size_t serialized_size_hint() const {
+        return _result_set ? 0 : _result_generator.serialized_size_hint();
+    }
+
     cql3::result_set result_set() const {
         if (_result_set) {
             return *_result_set;
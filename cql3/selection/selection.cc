@@ -265,6 +265,7 @@ selection::collect_metadata(schema_ptr schema, const std::vector<::shared_ptr<ra
 result_set_builder::result_set_builder(const selection& s, gc_clock::time_point now, cql_serialization_format sf)
     : _result_set(std::make_unique<result_set>(::make_shared<metadata>(*(s.get_result_metadata()))))
     , _selectors(s.new_selectors())
+    , _column_count(s._columns.size())
     , _now(now)
     , _cql_serialization_format(sf)
 {
@@ -324,6 +325,11 @@ void result_set_builder::new_row() {
         //        call to new_row() does not end a previous row.
         current.emplace();
     }
+    // One exactly-sized allocation per row. For non-aggregate selections the
+    // vector is moved out wholesale into the result set, so the row starts
+    // from zero capacity every time; without this it would grow through a
+    // series of reallocations as the cells are added.
+    current->reserve(_column_count);
 }
 
 std::unique_ptr<result_set> result_set_builder::build() {
@@ -352,7 +358,9 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
 
     auto static_row_iterator = static_row.iterator();
     auto row_iterator = row.iterator();
-    auto non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
+    // The restriction maps are owned by _restrictions and stable for the
+    // duration of the query; bind them by reference, this runs for every row.
+    const auto& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
     for (auto&& cdef : selection.get_columns()) {
         switch (cdef->kind) {
         case column_kind::static_column:
@@ -391,7 +399,7 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_pk_restrictions) {
                 continue;
             }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
+            const auto& partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
             auto restr_it = partition_key_restrictions_map.find(cdef);
             if (restr_it == partition_key_restrictions_map.end()) {
                 continue;
@@ -409,7 +417,7 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_ck_restrictions) {
                 continue;
             }
-            auto clustering_key_restrictions_map = _restrictions->get_single_column_clustering_key_restrictions();
+            const auto& clustering_key_restrictions_map = _restrictions->get_single_column_clustering_key_restrictions();
             auto restr_it = clustering_key_restrictions_map.find(cdef);
             if (restr_it == clustering_key_restrictions_map.end()) {
                 continue;
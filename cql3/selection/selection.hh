@@ -244,6 +244,9 @@ class result_set_builder {
 private:
     std::unique_ptr<result_set> _result_set;
     std::unique_ptr<selectors> _selectors;
+    // Number of values in an input row, used to size each row's vector
+    // exactly once instead of letting it grow through push_back.
+    size_t _column_count;
 public:
     std::optional<std::vector<bytes_opt>> current;
 private:
@@ -314,6 +317,12 @@ public:
         std::vector<bytes> _partition_key;
         std::vector<bytes> _clustering_key;
         Filter _filter;
+        // Exploding the clustering key allocates a vector<bytes> per row. It
+        // is only needed when the selection reads clustering-key components
+        // or when rows are post-filtered (the filter inspects the exploded
+        // keys). Aggregates like count(*) need neither, so we skip it and
+        // feed the selectors directly as rows stream by.
+        const bool _explode_clustering_key;
     public:
         visitor(cql3::selection::result_set_builder& builder, const schema& s,
                 const selection& selection, Filter filter = Filter())
@@ -322,6 +331,7 @@ public:
             , _selection(selection)
             , _row_count(0)
             , _filter(filter)
+            , _explode_clustering_key(!std::is_same_v<Filter, nop_filter> || uses_clustering_key(selection))
         {}
         visitor(visitor&&) = default;
 
@@ -355,7 +365,9 @@ public:
         }
 
         void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row) {
-            _clustering_key = key.explode(_schema);
+            if (_explode_clustering_key) {
+                _clustering_key = key.explode(_schema);
+            }
             accept_new_row(static_row, row);
         }
 
@@ -406,6 +418,16 @@ public:
             }
             return _filter.get_rows_dropped();
         }
+
+    private:
+        static bool uses_clustering_key(const selection& selection) {
+            for (auto&& def : selection.get_columns()) {
+                if (def->is_clustering_key()) {
+                    return true;
+                }
+            }
+            return false;
+        }
     };
 
 private:
@@ -124,14 +124,17 @@ sets::literal::to_string() const {
 sets::value
 sets::value::from_serialized(const fragmented_temporary_buffer::view& val, set_type type, cql_serialization_format sf) {
     try {
-        // Collections have this small hack that validate cannot be called on a serialized object,
-        // but compose does the validation (so we're fine).
-        // FIXME: deserializeForNativeProtocol?!
       return with_linearized(val, [&] (bytes_view v) {
-        auto s = value_cast<set_type_impl::native_type>(type->deserialize(v, sf));
-        std::set<bytes, serialized_compare> elements(type->get_elements_type()->as_less_comparator());
-        for (auto&& element : s) {
-            elements.insert(elements.end(), type->get_elements_type()->decompose(element));
+        // Walk the serialized form directly: validate each element in place
+        // and keep its serialized bytes, instead of deserializing everything
+        // into boxed data_values only to re-serialize them again.
+        auto nr = read_collection_size(v, sf);
+        auto element_type = type->get_elements_type();
+        std::set<bytes, serialized_compare> elements(element_type->as_less_comparator());
+        for (int i = 0; i != nr; ++i) {
+            auto e = read_collection_value(v, sf);
+            element_type->validate(e);
+            elements.insert(elements.end(), bytes(e.begin(), e.end()));
         }
         return value(std::move(elements));
       });
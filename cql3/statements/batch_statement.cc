@@ -83,6 +83,7 @@ batch_statement::batch_statement(int bound_terms, type type_,
     , _bound_terms(bound_terms), _type(type_), _statements(std::move(statements))
     , _attrs(std::move(attrs))
     , _has_conditions(boost::algorithm::any_of(_statements, [] (auto&& s) { return s.statement->has_conditions(); }))
+    , _single_table(!_statements.empty() && boost::algorithm::all_of(_statements, [this] (auto&& s) { return s.statement->s->id() == _statements.front().statement->s->id(); }))
     , _stats(stats)
 {
 }
@@ -194,6 +195,25 @@ const std::vector<batch_statement::single_statement>& batch_statement::get_state
 
 future<std::vector<mutation>> batch_statement::get_mutations(service::storage_proxy& storage, const query_options& options, db::timeout_clock::time_point timeout, bool local, api::timestamp_type now, tracing::trace_state_ptr trace_state) {
     // Do not process in parallel because operations like list append/prepend depend on execution order.
+    if (_single_table) {
+        // All statements target the same table; apply each one directly into
+        // the per-partition mutations instead of building a mutation per
+        // statement and merging through a hash set.
+        return do_with(std::vector<mutation>(), [this, &storage, &options, timeout, now, local, trace_state] (auto& result) {
+            _stats.statements_in_batches += _statements.size();
+            return do_for_each(boost::make_counting_iterator<size_t>(0),
+                               boost::make_counting_iterator<size_t>(_statements.size()),
+                               [this, &storage, &options, now, local, &result, timeout, trace_state] (size_t i) {
+                auto&& statement = _statements[i].statement;
+                statement->inc_cql_stats();
+                auto&& statement_options = options.for_statement(i);
+                auto timestamp = _attrs->get_timestamp(now, statement_options);
+                return statement->apply_updates(storage, statement_options, timeout, local, timestamp, trace_state, result);
+            }).then([&result] {
+                return make_ready_future<std::vector<mutation>>(std::move(result));
+            });
+        });
+    }
     using mutation_set_type = std::unordered_set<mutation, mutation_hash_by_key, mutation_equals_by_key>;
     return do_with(mutation_set_type(), [this, &storage, &options, timeout, now, local, trace_state] (auto& result) {
         result.reserve(_statements.size());
@@ -86,6 +86,11 @@ private:
     std::vector<single_statement> _statements;
     std::unique_ptr<attributes> _attrs;
     bool _has_conditions;
+    // True when all inner statements modify the same table. Such batches
+    // (typically many writes to one partition) take a fast path which builds
+    // one mutation per partition directly, skipping the per-statement
+    // mutation objects and the hash-based merge.
+    bool _single_table;
     cql_stats& _stats;
 public:
     /**
@@ -163,22 +163,40 @@ future<> modification_statement::check_access(const service::client_state& state
 
 future<std::vector<mutation>>
 modification_statement::get_mutations(service::storage_proxy& proxy, const query_options& options, db::timeout_clock::time_point timeout, bool local, int64_t now, tracing::trace_state_ptr trace_state) {
+    return do_with(std::vector<mutation>(), [this, &proxy, &options, timeout, local, now, trace_state = std::move(trace_state)] (auto& mutations) mutable {
+        return apply_updates(proxy, options, timeout, local, now, std::move(trace_state), mutations).then([&mutations] {
+            return make_ready_future<std::vector<mutation>>(std::move(mutations));
+        });
+    });
+}
+
+future<>
+modification_statement::apply_updates(service::storage_proxy& proxy, const query_options& options, db::timeout_clock::time_point timeout, bool local, int64_t now, tracing::trace_state_ptr trace_state, std::vector<mutation>& result) {
     auto json_cache = maybe_prepare_json_cache(options);
     auto keys = make_lw_shared(build_partition_keys(options, json_cache));
     auto ranges = make_lw_shared(create_clustering_ranges(options, json_cache));
     return make_update_parameters(proxy, keys, ranges, options, timeout, local, now, std::move(trace_state)).then(
-            [this, keys, ranges, now, json_cache = std::move(json_cache)] (auto params_ptr) {
-                std::vector<mutation> mutations;
-                mutations.reserve(keys->size());
+            [this, keys, ranges, now, &result, json_cache = std::move(json_cache)] (auto params_ptr) {
+                result.reserve(result.size() + keys->size());
                 for (auto key : *keys) {
                     // We know key.start() must be defined since we only allow EQ relations on the partition key.
-                    mutations.emplace_back(s, std::move(*key.start()->value().key()));
-                    auto& m = mutations.back();
+                    auto pkey = std::move(*key.start()->value().key());
+                    // Search backwards: batches overwhelmingly hit the same
+                    // partition repeatedly, so a match is typically at the back.
+                    auto it = std::find_if(result.rbegin(), result.rend(), [this, &pkey] (const mutation& m) {
+                        return m.key().equal(*s, pkey);
+                    });
+                    mutation* m;
+                    if (it == result.rend()) {
+                        result.emplace_back(s, std::move(pkey));
+                        m = &result.back();
+                    } else {
+                        m = &*it;
+                    }
                     for (auto&& r : *ranges) {
-                        this->add_update_for_key(m, r, *params_ptr, json_cache);
+                        this->add_update_for_key(*m, r, *params_ptr, json_cache);
                     }
                 }
-                return make_ready_future<decltype(mutations)>(std::move(mutations));
             });
 }
 
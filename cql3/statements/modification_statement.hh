@@ -350,6 +350,13 @@ public:
      */
     future<std::vector<mutation>> get_mutations(service::storage_proxy& proxy, const query_options& options, db::timeout_clock::time_point timeout, bool local, int64_t now, tracing::trace_state_ptr trace_state);
 
+    // Like get_mutations(), but applies the updates in place into `result`,
+    // merging with an existing mutation when one targets the same partition.
+    // All mutations in `result` must be for this statement's schema. Used by
+    // single-table batches to build one mutation per partition directly,
+    // without intermediate per-statement mutation objects.
+    future<> apply_updates(service::storage_proxy& proxy, const query_options& options, db::timeout_clock::time_point timeout, bool local, int64_t now, tracing::trace_state_ptr trace_state, std::vector<mutation>& result);
+
 public:
     future<std::unique_ptr<update_parameters>> make_update_parameters(
                 service::storage_proxy& proxy,
@@ -144,6 +144,20 @@ select_statement::select_statement(schema_ptr schema,
 {
     _opts = _selection->get_query_options();
     _opts.set_if<query::partition_slice::option::bypass_cache>(_parameters->bypass_cache());
+    _opts.set_if<query::partition_slice::option::distinct>(_parameters->is_distinct());
+    _opts.set_if<query::partition_slice::option::reversed>(_is_reversed && !_parameters->is_distinct());
+
+    if (_selection->contains_static_columns()) {
+        _static_columns.reserve(_selection->get_column_count());
+    }
+    _regular_columns.reserve(_selection->get_column_count());
+    for (auto&& col : _selection->get_columns()) {
+        if (col->is_static()) {
+            _static_columns.push_back(col->id);
+        } else if (col->is_regular()) {
+            _regular_columns.push_back(col->id);
+        }
+    }
 }
 
 bool select_statement::uses_function(const sstring& ks_name, const sstring& function_name) const {
@@ -195,37 +209,21 @@ const sstring& select_statement::column_family() const {
 query::partition_slice
 select_statement::make_partition_slice(const query_options& options)
 {
-    query::column_id_vector static_columns;
-    query::column_id_vector regular_columns;
-
-    if (_selection->contains_static_columns()) {
-        static_columns.reserve(_selection->get_column_count());
-    }
-
-    regular_columns.reserve(_selection->get_column_count());
-
-    for (auto&& col : _selection->get_columns()) {
-        if (col->is_static()) {
-            static_columns.push_back(col->id);
-        } else if (col->is_regular()) {
-            regular_columns.push_back(col->id);
-        }
-    }
-
+    // The queried columns and the slice options were all resolved when the
+    // statement was prepared; only the clustering bounds can depend on the
+    // bound variables.
     if (_parameters->is_distinct()) {
-        _opts.set(query::partition_slice::option::distinct);
         return query::partition_slice({ query::clustering_range::make_open_ended_both_sides() },
-            std::move(static_columns), {}, _opts, nullptr, options.get_cql_serialization_format());
+            _static_columns, {}, _opts, nullptr, options.get_cql_serialization_format());
     }
 
     auto bounds = _restrictions->get_clustering_bounds(options);
     if (_is_reversed) {
-        _opts.set(query::partition_slice::option::reversed);
         std::reverse(bounds.begin(), bounds.end());
         ++_stats.reverse_queries;
     }
     return query::partition_slice(std::move(bounds),
-        std::move(static_columns), std::move(regular_columns), _opts, nullptr, options.get_cql_serialization_format());
+        _static_columns, _regular_columns, _opts, nullptr, options.get_cql_serialization_format());
 }
 
 int32_t select_statement::get_limit(const query_options& options) const {
@@ -481,7 +479,7 @@ indexed_table_select_statement::execute_base_query(
                 command->slice.set_range(*_schema, base_pk,
                         std::vector<query::clustering_range>{query::clustering_range::make_starting_with(range_bound<clustering_key>(base_ck, false))});
             }
-            return proxy.query(_schema, command, std::move(prange), options.get_consistency(), {timeout, state.get_trace_state()})
+            return proxy.query(_schema, command, std::move(prange), options.get_consistency(), {timeout, state.get_trace_state(), { }, { }, state.get_abort_source()})
             .then([&range_it, range_it_end = std::move(range_it_end), &ranges, &merger] (service::storage_proxy::coordinator_query_result qr) {
                 bool is_short_read = qr.query_result->is_short_read();
                 merger(std::move(qr.query_result));
@@ -499,11 +497,10 @@ indexed_table_select_statement::execute_base_query(
 // Function for fetching the selected columns from a list of clustering rows.
 // It is currently used only in our Secondary Index implementation - ordinary
 // CQL SELECT statements do not have the syntax to request a list of rows.
-// FIXME: The current implementation is very inefficient - it requests each
-// row separately (and, incrementally, in parallel). Even multiple rows from a single
-// partition are requested separately. This last case can be easily improved,
-// but to implement the general case (multiple rows from multiple partitions)
-// efficiently, we will need more support from other layers.
+// FIXME: The current implementation requests each partition separately (and,
+// incrementally, in parallel); rows of the same partition are fetched with a
+// single command. To implement the general case (multiple rows from multiple
+// partitions) as one read, we will need more support from other layers.
 // Keys are ordered in token order (see #3423)
 future<shared_ptr<cql_transport::messages::result_message>>
 indexed_table_select_statement::execute_base_query(
@@ -538,22 +535,38 @@ indexed_table_select_statement::execute_base_query(
             // Starting with 1 key, we check if the result was a short read, and if not,
             // we continue exponentially, asking for 2x more key than before
             auto key_it_end = std::min(key_it + std::distance(keys.begin(), key_it) + 1, keys.end());
-            auto command = ::make_lw_shared<query::read_command>(*cmd);
 
-            query::result_merger oneshot_merger(cmd->row_limit, query::max_partitions);
-            return map_reduce(key_it, key_it_end, [this, &proxy, &state, &options, cmd, timeout] (auto& key) {
-                auto command = ::make_lw_shared<query::read_command>(*cmd);
-                // for each partition, read just one clustering row (TODO: can
-                // get all needed rows of one partition at once.)
-                command->slice._row_ranges.clear();
-                if (key.clustering) {
-                    command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
+            // The keys are in token order, so rows of the same base partition
+            // are adjacent; fetch each partition with a single command
+            // carrying all of its requested rows instead of a point read per
+            // row.
+            struct partition_fetch {
+                dht::partition_range range;
+                std::vector<query::clustering_range> rows;
+            };
+            std::vector<partition_fetch> fetches;
+            const primary_key* last = nullptr;
+            for (auto it = key_it; it != key_it_end; ++it) {
+                if (!last || !it->partition.equal(*_schema, last->partition)) {
+                    fetches.push_back(partition_fetch{dht::partition_range::make_singular(it->partition), {}});
                 }
-                return proxy.query(_schema, command, {dht::partition_range::make_singular(key.partition)}, options.get_consistency(), {timeout, state.get_trace_state()})
-                .then([] (service::storage_proxy::coordinator_query_result qr) {
-                    return std::move(qr.query_result);
-                });
-            }, std::move(oneshot_merger)).then([&key_it, key_it_end = std::move(key_it_end), &keys, &merger] (foreign_ptr<lw_shared_ptr<query::result>> result) {
+                if (it->clustering) {
+                    fetches.back().rows.push_back(query::clustering_range::make_singular(it->clustering));
+                }
+                last = &*it;
+            }
+
+            return do_with(std::move(fetches), [this, &proxy, &state, &options, cmd, timeout] (std::vector<partition_fetch>& fetches) {
+                query::result_merger oneshot_merger(cmd->row_limit, query::max_partitions);
+                return map_reduce(fetches.begin(), fetches.end(), [this, &proxy, &state, &options, cmd, timeout] (partition_fetch& fetch) {
+                    auto command = ::make_lw_shared<query::read_command>(*cmd);
+                    command->slice._row_ranges = std::move(fetch.rows);
+                    return proxy.query(_schema, command, {std::move(fetch.range)}, options.get_consistency(), {timeout, state.get_trace_state(), { }, { }, state.get_abort_source()})
+                    .then([] (service::storage_proxy::coordinator_query_result qr) {
+                        return std::move(qr.query_result);
+                    });
+                }, std::move(oneshot_merger));
+            }).then([&key_it, key_it_end = std::move(key_it_end), &keys, &merger] (foreign_ptr<lw_shared_ptr<query::result>> result) {
                 bool is_short_read = result->is_short_read();
                 merger(std::move(result));
                 key_it = key_it_end;
@@ -591,7 +604,7 @@ select_statement::execute(service::storage_proxy& proxy,
                         command,
                         std::move(prange),
                         options.get_consistency(),
-                        {timeout, state.get_trace_state()}).then([] (service::storage_proxy::coordinator_query_result qr) {
+                        {timeout, state.get_trace_state(), { }, { }, state.get_abort_source()}).then([] (service::storage_proxy::coordinator_query_result qr) {
                     return std::move(qr.query_result);
                 });
             }, std::move(merger));
@@ -599,7 +612,7 @@ select_statement::execute(service::storage_proxy& proxy,
             return this->process_results(std::move(result), cmd, options, now);
         });
     } else {
-        return proxy.query(_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_trace_state()})
+        return proxy.query(_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_trace_state(), { }, { }, state.get_abort_source()})
             .then([this, &options, now, cmd] (service::storage_proxy::coordinator_query_result qr) {
                 return this->process_results(std::move(qr.query_result), cmd, options, now);
             });
@@ -946,7 +959,7 @@ read_posting_list(service::storage_proxy& proxy,
 
     int32_t page_size = options.get_page_size();
     if (page_size <= 0 || !service::pager::query_pagers::may_need_paging(*view_schema, page_size, *cmd, partition_ranges)) {
-        return proxy.query(view_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_trace_state()})
+        return proxy.query(view_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_trace_state(), { }, { }, state.get_abort_source()})
         .then([base_schema, view_schema, now, &options, selection = std::move(selection), partition_slice = std::move(partition_slice)] (service::storage_proxy::coordinator_query_result qr) {
             cql3::selection::result_set_builder builder(*selection, now, options.get_cql_serialization_format());
             query::result_view::consume(*qr.query_result,
@@ -89,6 +89,11 @@ protected:
     ordering_comparator_type _ordering_comparator;
 
     query::partition_slice::option_set _opts;
+    // The columns the selection reads, resolved once at prepare time so
+    // that building the per-execution partition slice copies them instead
+    // of re-scanning the selection.
+    query::column_id_vector _static_columns;
+    query::column_id_vector _regular_columns;
     cql_stats& _stats;
 protected :
     virtual future<::shared_ptr<cql_transport::messages::result_message>> do_execute(service::storage_proxy& proxy,
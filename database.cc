@@ -192,8 +192,12 @@ database::database(const db::config& cfg, database_config dbcfg)
     , _cfg(std::make_unique<db::config>(cfg))
     // Allow system tables a pool of 10 MB memory to write, but never block on other regions.
     , _system_dirty_memory_manager(*this, 10 << 20, cfg.virtual_dirty_soft_limit(), default_scheduling_group())
-    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.45, cfg.virtual_dirty_soft_limit(), dbcfg.statement_scheduling_group)
-    , _streaming_dirty_memory_manager(*this, dbcfg.available_memory * 0.10, cfg.virtual_dirty_soft_limit(), dbcfg.streaming_scheduling_group)
+    // The statement and streaming quotas below add up to more than this, so a
+    // bulk load cannot fill its whole quota when statement memtables are
+    // already large - the combined limit throttles it first.
+    , _dirty_memory_manager_group(dbcfg.available_memory * 0.50, cfg.virtual_dirty_soft_limit(), default_scheduling_group())
+    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.45, cfg.virtual_dirty_soft_limit(), dbcfg.statement_scheduling_group, &_dirty_memory_manager_group)
+    , _streaming_dirty_memory_manager(*this, dbcfg.available_memory * 0.10, cfg.virtual_dirty_soft_limit(), dbcfg.streaming_scheduling_group, &_dirty_memory_manager_group)
     , _dbcfg(dbcfg)
     , _memtable_controller(make_flush_controller(*_cfg, dbcfg.memtable_scheduling_group, service::get_local_memtable_flush_priority(), [this, limit = float(_dirty_memory_manager.throttle_threshold())] {
         auto backlog = (_dirty_memory_manager.virtual_dirty_memory()) / limit;
@@ -213,11 +217,16 @@ database::database(const db::config& cfg, database_config dbcfg)
     // Trust the caller to limit concurrency.
     , _streaming_concurrency_sem(max_count_streaming_concurrent_reads, max_memory_streaming_concurrent_reads())
     , _system_read_concurrency_sem(max_count_system_concurrent_reads, max_memory_system_concurrent_reads())
+    , _sstable_load_concurrency_sem(cfg.sstable_load_concurrency())
     , _data_query_stage("data_query", &column_family::query)
     , _mutation_query_stage()
     , _apply_stage("db_apply", &database::do_apply)
     , _version(empty_version)
     , _compaction_manager(make_compaction_manager(*_cfg, dbcfg))
+    , _system_maintenance_timer([this] { on_system_maintenance_timer(); })
+    , _cache_summary_timer([this] { on_cache_summary_timer(); })
+    , _read_concurrency_tuning_timer([this] { tune_read_concurrency(); })
+    , _cache_tombstone_purge_timer([this] { purge_cache_tombstones(); })
     , _enable_incremental_backups(cfg.incremental_backups())
     , _querier_cache(_read_concurrency_sem, dbcfg.available_memory * 0.04)
     , _large_data_handler(std::make_unique<db::cql_table_large_data_handler>(_cfg->compaction_large_partition_warning_threshold_mb()*1024*1024,
@@ -229,6 +238,16 @@ database::database(const db::config& cfg, database_config dbcfg)
     local_schema_registry().init(*this); // TODO: we're never unbound.
     setup_metrics();
 
+    _querier_cache.set_prefetch_enabled(_cfg->enable_paged_read_prefetch());
+
+    if (_cfg->read_concurrency_latency_target_in_ms()) {
+        _read_concurrency_tuning_timer.arm_periodic(std::chrono::seconds(1));
+    }
+
+    if (_cfg->enable_cache_tombstone_purge()) {
+        _cache_tombstone_purge_timer.arm_periodic(std::chrono::seconds(1));
+    }
+
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
 
     dblog.debug("Row: max_vector_size: {}, internal_count: {}", size_t(row::max_vector_size), size_t(row::internal_count));
@@ -342,6 +361,15 @@ database::setup_metrics() {
                        sm::description(seastar::format("Holds the current number of requests blocked due to reaching the memory quota ({}B). "
                                        "Non-zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"database\" component.", _dirty_memory_manager.throttle_threshold()))),
 
+        sm::make_derive("mutation_fragment_pool_allocations", [] { return mutation_fragment::data_pool_stats().allocations; },
+                       sm::description("Counts mutation fragment payload blocks acquired from the per-shard fragment pool.")),
+
+        sm::make_derive("mutation_fragment_pool_hits", [] { return mutation_fragment::data_pool_stats().hits; },
+                       sm::description("Counts mutation fragment payload acquisitions served from the pool freelist instead of the allocator.")),
+
+        sm::make_gauge("mutation_fragment_pool_size", [] { return mutation_fragment::data_pool_size(); },
+                       sm::description("Holds the number of idle mutation fragment payload blocks currently pooled on this shard.")),
+
         sm::make_derive("clustering_filter_count", _cf_stats.clustering_filter_count,
                        sm::description("Counts bloom filter invocations.")),
 
@@ -402,6 +430,13 @@ database::setup_metrics() {
                        sm::description("Counts querier cache entries that were evicted because the memory usage "
                                        "of the cached queriers were above the limit.")),
 
+        sm::make_derive("querier_cache_prefetches", _querier_cache.get_stats().prefetches,
+                       sm::description("Counts page prefetches started on behalf of cached queriers.")),
+
+        sm::make_derive("querier_cache_prefetch_failures", _querier_cache.get_stats().prefetch_failures,
+                       sm::description("Counts page prefetches that failed. The affected querier is dropped "
+                                       "and the next page recreates it.")),
+
         sm::make_gauge("querier_cache_population", _querier_cache.get_stats().population,
                        sm::description("The number of entries currently in the querier cache.")),
 
@@ -409,10 +444,14 @@ database::setup_metrics() {
                        sm::description("Counts the number of times the sstable read queue was overloaded. "
                                        "A non-zero value indicates that we have to drop read requests because they arrive faster than we can serve them.")),
 
-        sm::make_gauge("active_reads", [this] { return max_count_concurrent_reads - _read_concurrency_sem.available_resources().count; },
+        sm::make_gauge("active_reads", [this] { return _read_concurrency_sem.count_limit() - _read_concurrency_sem.available_resources().count; },
                        sm::description("Holds the number of currently active read operations. "),
                        {user_label_instance}),
 
+        sm::make_gauge("read_concurrency_limit", [this] { return _read_concurrency_sem.count_limit(); },
+                       sm::description("The current limit on concurrently executing reads. Static unless read_concurrency_latency_target_in_ms is set."),
+                       {user_label_instance}),
+
         sm::make_gauge("active_reads_memory_consumption", [this] { return max_memory_concurrent_reads() - _read_concurrency_sem.available_resources().memory; },
                        sm::description(seastar::format("Holds the amount of memory consumed by currently active read operations. "
                                                        "If this value gets close to {} we are likely to start dropping new read requests. "
@@ -509,6 +548,9 @@ database::setup_metrics() {
         sm::make_queue_length("counter_cell_lock_pending", _cl_stats->operations_waiting_for_lock,
                              sm::description("The number of counter updates waiting for a lock.")),
 
+        sm::make_derive("counter_updates_coalesced", _stats->counter_updates_coalesced,
+                       sm::description("The number of counter updates served under another update's lock acquisition and counter state read.")),
+
         sm::make_counter("large_partition_exceeding_threshold", [this] { return _large_data_handler->stats().partitions_bigger_than_threshold; },
             sm::description("Number of large partitions exceeding compaction_large_partition_warning_threshold_mb. "
                 "Large partitions have performance impact and should be avoided, check the documentation for details.")),
@@ -869,6 +911,7 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.enable_cache = _config.enable_cache;
     cfg.enable_dangerous_direct_import_of_cassandra_counters = _config.enable_dangerous_direct_import_of_cassandra_counters;
     cfg.compaction_enforce_min_threshold = _config.compaction_enforce_min_threshold;
+    cfg.compaction_output_segment_size = _config.compaction_output_segment_size;
     cfg.dirty_memory_manager = _config.dirty_memory_manager;
     cfg.streaming_dirty_memory_manager = _config.streaming_dirty_memory_manager;
     cfg.read_concurrency_semaphore = _config.read_concurrency_semaphore;
@@ -881,6 +924,7 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.memtable_to_cache_scheduling_group = _config.memtable_to_cache_scheduling_group;
     cfg.streaming_scheduling_group = _config.streaming_scheduling_group;
     cfg.statement_scheduling_group = _config.statement_scheduling_group;
+    cfg.view_update_scheduling_group = _config.view_update_scheduling_group;
     cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
 
     // avoid self-reporting
@@ -1214,11 +1258,96 @@ std::ostream& operator<<(std::ostream& out, const database& db) {
     return out;
 }
 
+// Checks whether all cells written by a counter update are covered by the
+// partition slice of an earlier update to the same partition, i.e. whether
+// the counter state read for that update is sufficient to transform this one
+// as well.
+static bool counter_update_covered_by_slice(const mutation& m, const query::partition_slice& slice) {
+    bool covered = true;
+    m.partition().static_row().for_each_cell([&] (auto id, auto&&) {
+        covered = covered && boost::find(slice.static_columns, id) != slice.static_columns.end();
+    });
+    if (!covered) {
+        return false;
+    }
+    for (auto&& cr : m.partition().clustered_rows()) {
+        auto covers_row = [&] (const query::clustering_range& range) {
+            return range.is_singular() && range.start()->value().representation() == cr.key().representation();
+        };
+        if (boost::find_if(slice.default_row_ranges(), covers_row) == slice.default_row_ranges().end()) {
+            return false;
+        }
+        cr.row().cells().for_each_cell([&] (auto id, auto&&) {
+            covered = covered && std::binary_search(slice.regular_columns.begin(), slice.regular_columns.end(), id);
+        });
+        if (!covered) {
+            return false;
+        }
+    }
+    return covered;
+}
+
+future<> database::drain_pending_counter_updates(column_family& cf, const counter_batch_key& key, mutation state) {
+    // Serve the updates that queued up while we were holding the counter
+    // cell locks, transforming each of them against the counter state we
+    // keep evolving in memory instead of re-reading it from the table.
+    return do_with(std::move(state), [this, &cf, &key] (mutation& state) {
+        return repeat([this, &cf, &key, &state] {
+            auto it = _pending_counter_updates.find(key);
+            if (it->second.waiters.empty()) {
+                // Erase the entry before yielding so that updates arriving
+                // from now on acquire the locks and read on their own.
+                _pending_counter_updates.erase(it);
+                return make_ready_future<stop_iteration>(stop_iteration::yes);
+            }
+            auto w = std::move(it->second.waiters.front());
+            it->second.waiters.pop_front();
+            return do_with(std::move(w), [this, &cf, &state] (pending_counter_update& w) {
+                transform_counter_updates_to_shards(w.m, &state, cf.failed_counter_applies_to_memtable());
+                return this->apply_with_commitlog(cf, w.m, w.timeout).then_wrapped([&state, &w] (future<> f) {
+                    if (f.failed()) {
+                        w.result.set_exception(f.get_exception());
+                    } else {
+                        state.apply(w.m);
+                        w.result.set_value(std::move(w.m));
+                    }
+                    return stop_iteration::no;
+                });
+            });
+        });
+    });
+}
+
+void database::abort_pending_counter_updates(const counter_batch_key& key, std::exception_ptr ep) {
+    auto it = _pending_counter_updates.find(key);
+    if (it == _pending_counter_updates.end()) {
+        return;
+    }
+    for (auto& w : it->second.waiters) {
+        w.result.set_exception(ep);
+    }
+    _pending_counter_updates.erase(it);
+}
+
 future<mutation> database::do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema,
                                                    db::timeout_clock::time_point timeout,tracing::trace_state_ptr trace_state) {
     auto m = fm.unfreeze(m_schema);
     m.upgrade(cf.schema());
 
+    // If another update of this partition is already holding the counter
+    // cell locks and the state it has read covers all cells we are about to
+    // write, there is no point in acquiring the locks and reading the state
+    // again. Queue behind it instead; the lock holder will transform and
+    // apply this update too before releasing the locks.
+    auto batch_key = counter_batch_key(cf.schema()->id(), m.decorated_key());
+    if (auto it = _pending_counter_updates.find(batch_key); it != _pending_counter_updates.end()
+            && it->second.s == m.schema() && counter_update_covered_by_slice(m, *it->second.slice)) {
+        tracing::trace(trace_state, "Joining in-flight counter lock and read");
+        ++_stats->counter_updates_coalesced;
+        auto& w = it->second.waiters.emplace_back(pending_counter_update{std::move(m), timeout, promise<mutation>()});
+        return w.result.get_future();
+    }
+
     // prepare partition slice
     query::column_id_vector static_columns;
     static_columns.reserve(m.partition().static_row().size());
@@ -1245,10 +1374,14 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     auto slice = query::partition_slice(std::move(cr_ranges), std::move(static_columns),
         std::move(regular_columns), { }, { }, cql_serialization_format::internal(), query::max_rows);
 
-    return do_with(std::move(slice), std::move(m), std::vector<locked_cell>(),
-                   [this, &cf, timeout, trace_state = std::move(trace_state), op = cf.write_in_progress()] (const query::partition_slice& slice, mutation& m, std::vector<locked_cell>& locks) mutable {
+    return do_with(std::move(slice), std::move(m), std::vector<locked_cell>(), std::move(batch_key),
+                   [this, &cf, timeout, trace_state = std::move(trace_state), op = cf.write_in_progress()] (const query::partition_slice& slice, mutation& m, std::vector<locked_cell>& locks, const counter_batch_key& batch_key) mutable {
+        // Unless an uncoverable update of this partition is in flight already
+        // we become the batch leader and will serve updates queueing behind
+        // us while we hold the locks.
+        const bool leader = _pending_counter_updates.emplace(batch_key, counter_update_batch{m.schema(), &slice, {}}).second;
         tracing::trace(trace_state, "Acquiring counter locks");
-        return cf.lock_counter_cells(m, timeout).then([&, m_schema = cf.schema(), trace_state = std::move(trace_state), timeout, this] (std::vector<locked_cell> lcs) mutable {
+        auto f = cf.lock_counter_cells(m, timeout).then([&, m_schema = cf.schema(), trace_state, timeout, this, leader] (std::vector<locked_cell> lcs) mutable {
             locks = std::move(lcs);
 
             // Before counter update is applied it needs to be transformed from
@@ -1257,17 +1390,32 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
 
             tracing::trace(trace_state, "Reading counter values from the CF");
             return counter_write_query(m_schema, cf.as_mutation_source(), m.decorated_key(), slice, trace_state)
-                    .then([this, &cf, &m, m_schema, timeout, trace_state] (auto mopt) {
+                    .then([this, &cf, &m, &batch_key, m_schema, timeout, trace_state, leader] (auto mopt) {
                 // ...now, that we got existing state of all affected counter
                 // cells we can look for our shard in each of them, increment
                 // its clock and apply the delta.
                 transform_counter_updates_to_shards(m, mopt ? &*mopt : nullptr, cf.failed_counter_applies_to_memtable());
                 tracing::trace(trace_state, "Applying counter update");
-                return this->apply_with_commitlog(cf, m, timeout);
-            }).then([&m] {
-                return std::move(m);
+                auto f = this->apply_with_commitlog(cf, m, timeout);
+                if (!leader) {
+                    return f;
+                }
+                return f.then([this, &cf, &m, &batch_key, m_schema, mopt = std::move(mopt)] () mutable {
+                    auto state = mopt ? std::move(*mopt) : mutation(m_schema, m.decorated_key());
+                    state.apply(m);
+                    return this->drain_pending_counter_updates(cf, batch_key, std::move(state));
+                });
             });
         });
+        if (leader) {
+            f = f.handle_exception([this, &batch_key] (std::exception_ptr ep) {
+                this->abort_pending_counter_updates(batch_key, ep);
+                return make_exception_future<>(std::move(ep));
+            });
+        }
+        return f.then([&m] {
+            return std::move(m);
+        });
     });
 }
 
@@ -1320,6 +1468,55 @@ future<> dirty_memory_manager::flush_one(memtable_list& mtlist, flush_permit&& p
     });
 }
 
+void dirty_memory_manager::flush_group_by_commitlog_retention(memtable& fallback, flush_permit&& permit) {
+    // One entry per memtable_list, keyed by the oldest commitlog segment its
+    // active memtable pins. Only active memtables are considered; sealed ones
+    // are already being flushed and release their segments when that completes.
+    std::vector<std::pair<db::segment_id_type, memtable_list*>> candidates;
+    _virtual_region_group.for_each_region([&] (logalloc::region* r) {
+        memtable& mt = memtable::from_region(*r);
+        auto* mtlist = mt.get_memtable_list();
+        if (!mtlist || !mtlist->may_flush() || mtlist->back().get() != &mt || mt.empty()) {
+            return;
+        }
+        auto& usage = mt.rp_set().usage();
+        if (usage.empty()) {
+            return;
+        }
+        auto oldest = std::min_element(usage.begin(), usage.end(), [] (auto& a, auto& b) {
+            return a.first < b.first;
+        })->first;
+        candidates.emplace_back(oldest, mtlist);
+    });
+    if (candidates.empty()) {
+        // No memtable holds commitlog replay state (e.g. commitlog disabled).
+        flush_one(*fallback.get_memtable_list(), std::move(permit));
+        return;
+    }
+    auto oldest = std::min_element(candidates.begin(), candidates.end(), [] (auto& a, auto& b) {
+        return a.first < b.first;
+    })->first;
+    // Cap the batch so one decision doesn't queue hundreds of flushes. If the
+    // cap doesn't unpin the segment, the next decision picks it again.
+    static constexpr unsigned max_group_flush = 16;
+    unsigned initiated = 0;
+    std::optional<flush_permit> first_permit = std::move(permit);
+    for (auto&& [seg, mtlist] : candidates) {
+        if (seg != oldest) {
+            continue;
+        }
+        if (++initiated > max_group_flush) {
+            break;
+        }
+        if (first_permit) {
+            flush_one(*mtlist, std::move(*first_permit));
+            first_permit = std::nullopt;
+        } else {
+            mtlist->request_flush();
+        }
+    }
+}
+
 future<> dirty_memory_manager::flush_when_needed() {
     if (!_db) {
         return make_ready_future<>();
@@ -1354,6 +1551,17 @@ future<> dirty_memory_manager::flush_when_needed() {
                     return sleep(1ms);
                 }
 
+                // With many small tables (e.g. schema-per-tenant) even the largest memtable is
+                // tiny, so largest-first order neither frees much memory per decision nor
+                // releases commitlog segments: a segment is recycled only once every table
+                // which dirtied it has flushed. When that happens, switch to commitlog
+                // retention order and flush the whole group of memtables pinning the oldest
+                // dirty segment in one decision.
+                if (candidate_memtable.occupancy().total_space() < this->throttle_threshold() / 32) {
+                    this->flush_group_by_commitlog_retention(candidate_memtable, std::move(permit));
+                    return make_ready_future<>();
+                }
+
                 // Do not wait. The semaphore will protect us against a concurrent flush. But we
                 // want to start a new one as soon as the permits are destroyed and the semaphore is
                 // made ready again, not when we are done with the current one.
@@ -1375,6 +1583,14 @@ void dirty_memory_manager::start_reclaiming() noexcept {
     _should_flush.signal();
 }
 
+void dirty_memory_manager_group::start_reclaiming() noexcept {
+    // We don't know which member is responsible for the shared pressure, so
+    // wake all of them; each flushes only if it sees pressure itself.
+    for (auto&& m : _managers) {
+        m->notify_group_pressure();
+    }
+}
+
 future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
     auto& cf = find_column_family(m.column_family_id());
 
@@ -1533,6 +1749,7 @@ database::make_keyspace_config(const keyspace_metadata& ksm) {
     }
     cfg.enable_dangerous_direct_import_of_cassandra_counters = _cfg->enable_dangerous_direct_import_of_cassandra_counters();
     cfg.compaction_enforce_min_threshold = _cfg->compaction_enforce_min_threshold();
+    cfg.compaction_output_segment_size = _cfg->compaction_output_segment_size_mb() << 20;
     cfg.dirty_memory_manager = &_dirty_memory_manager;
     cfg.streaming_dirty_memory_manager = &_streaming_dirty_memory_manager;
     cfg.read_concurrency_semaphore = &_read_concurrency_sem;
@@ -1546,6 +1763,7 @@ database::make_keyspace_config(const keyspace_metadata& ksm) {
     cfg.memtable_to_cache_scheduling_group = _dbcfg.memtable_to_cache_scheduling_group;
     cfg.streaming_scheduling_group = _dbcfg.streaming_scheduling_group;
     cfg.statement_scheduling_group = _dbcfg.statement_scheduling_group;
+    cfg.view_update_scheduling_group = _dbcfg.view_update_scheduling_group;
     cfg.enable_metrics_reporting = _cfg->enable_keyspace_column_family_metrics();
 
     cfg.view_update_concurrency_semaphore = &_view_update_concurrency_sem;
@@ -1641,12 +1859,24 @@ future<>
 database::stop() {
     assert(_large_data_handler->stopped());
 
-    return _compaction_manager->stop().then([this] {
+    _system_maintenance_timer.cancel();
+    _cache_summary_timer.cancel();
+    _read_concurrency_tuning_timer.cancel();
+    _cache_tombstone_purge_timer.cancel();
+    return std::exchange(_cache_warmup_done, make_ready_future<>()).then([this] {
+        return std::exchange(_system_maintenance_done, make_ready_future<>());
+    }).then([this] {
+        return _compaction_manager->stop();
+    }).then([this] {
         // try to ensure that CL has done disk flushing
         if (_commitlog != nullptr) {
             return _commitlog->shutdown();
         }
         return make_ready_future<>();
+    }).then([this] {
+        // Wait for in-flight page prefetches before stopping the tables
+        // their readers belong to.
+        return _querier_cache.stop();
     }).then([this] {
         return parallel_for_each(_column_families, [this] (auto& val_pair) {
             return val_pair.second->stop();
@@ -1664,6 +1894,8 @@ database::stop() {
         return _dirty_memory_manager.shutdown();
     }).then([this] {
         return _streaming_dirty_memory_manager.shutdown();
+    }).then([this] {
+        return _dirty_memory_manager_group.shutdown();
     }).then([this] {
         return _memtable_controller.shutdown();
     });
@@ -1675,6 +1907,155 @@ future<> database::flush_all_memtables() {
     });
 }
 
+void database::start_system_keyspace_maintenance() {
+    auto hours = _cfg->system_keyspace_maintenance_interval_in_hours();
+    if (!hours) {
+        return;
+    }
+    _system_maintenance_timer.arm(std::chrono::hours(hours));
+}
+
+void database::on_system_maintenance_timer() {
+    // The point of the maintenance pass is to use quiet periods, not to
+    // compete with user compactions; when any are running or queued,
+    // retry soon instead of waiting for the whole interval.
+    auto& stats = _compaction_manager->get_stats();
+    if (stats.pending_tasks || stats.active_tasks) {
+        _system_maintenance_timer.arm(std::chrono::minutes(10));
+        return;
+    }
+    start_system_keyspace_maintenance();
+    _system_maintenance_done = _system_maintenance_done.then([this] {
+        return compact_system_tables();
+    }).handle_exception([] (std::exception_ptr ep) {
+        dblog.warn("System keyspace maintenance failed: {}", ep);
+    });
+}
+
+future<> database::compact_system_tables() {
+    dblog.debug("Starting system keyspace maintenance");
+    return parallel_for_each(_column_families, [] (auto& cfp) {
+        lw_shared_ptr<column_family> cf = cfp.second;
+        if (!is_system_keyspace(cf->schema()->ks_name()) || !cf->sstables_count()) {
+            return make_ready_future<>();
+        }
+        return cf->compact_all_sstables();
+    }).then([] {
+        dblog.debug("Finished system keyspace maintenance");
+    });
+}
+
+// Per table, per shard. At typical key sizes this keeps the whole summary
+// within a few MB per shard.
+static constexpr size_t max_cache_summary_keys = 4096;
+static constexpr std::chrono::minutes cache_summary_interval{10};
+
+void database::start_cache_warmup() {
+    if (!_cfg->enable_cache_warmup()) {
+        return;
+    }
+    _cache_warmup_done = _cache_warmup_done.then([this] {
+        return warm_caches_from_summary();
+    }).handle_exception([] (std::exception_ptr ep) {
+        dblog.warn("Cache warming failed: {}", ep);
+    });
+    _cache_summary_timer.arm(cache_summary_interval);
+}
+
+void database::on_cache_summary_timer() {
+    _cache_summary_timer.arm(cache_summary_interval);
+    _cache_warmup_done = _cache_warmup_done.then([this] {
+        return persist_cache_summaries();
+    }).handle_exception([] (std::exception_ptr ep) {
+        dblog.warn("Persisting cache summaries failed: {}", ep);
+    });
+}
+
+static std::vector<lw_shared_ptr<column_family>> non_system_tables(const std::unordered_map<utils::UUID, lw_shared_ptr<column_family>>& column_families) {
+    std::vector<lw_shared_ptr<column_family>> tables;
+    tables.reserve(column_families.size());
+    for (auto& p : column_families) {
+        if (!is_system_keyspace(p.second->schema()->ks_name())) {
+            tables.push_back(p.second);
+        }
+    }
+    return tables;
+}
+
+future<> database::persist_cache_summaries() {
+    return do_with(non_system_tables(_column_families), [] (std::vector<lw_shared_ptr<column_family>>& tables) {
+        return do_for_each(tables, [] (lw_shared_ptr<column_family>& cf) {
+            // An empty sample still clears this shard's previous rows, so a
+            // table whose cache went cold does not get rewarmed forever.
+            return db::system_keyspace::save_cache_summary(cf->schema()->id(), cf->cache_key_sample(max_cache_summary_keys));
+        });
+    });
+}
+
+future<> database::warm_caches_from_summary() {
+    return do_with(non_system_tables(_column_families), [] (std::vector<lw_shared_ptr<column_family>>& tables) {
+        dblog.info("Warming caches from the persisted summary");
+        return do_for_each(tables, [] (lw_shared_ptr<column_family>& cf) {
+            return db::system_keyspace::load_cache_summary(cf->schema()->id()).then([cf] (std::vector<bytes> keys) {
+                // run_async() keeps the table from stopping under the reads.
+                return cf->run_async([cf, keys = std::move(keys)] () mutable {
+                    return do_with(std::move(cf), std::move(keys), [] (lw_shared_ptr<column_family>& cf, std::vector<bytes>& keys) {
+                        return do_for_each(keys, [&cf] (bytes& key) {
+                            return cf->warm_cache_for_key(std::move(key));
+                        });
+                    });
+                });
+            });
+        }).then([] {
+            dblog.info("Finished warming caches from the persisted summary");
+        });
+    });
+}
+
+// Feedback controller for the statement read concurrency limit, in the
+// spirit of the backlog controllers: the static max_count_concurrent_reads
+// is right for some disk and working set, but the effective concurrency a
+// disk sustains at acceptable latency differs several-fold between
+// cache-hot and cache-cold periods. Instead of retuning per hardware
+// generation, grow the limit while measured read I/O latency stays below
+// the configured target (additive, and only while the limit is actually
+// binding, so idle periods don't inflate it) and back off multiplicatively
+// when latency exceeds the target.
+void database::tune_read_concurrency() {
+    auto latency = _read_concurrency_sem.measured_io_latency();
+    if (latency == std::chrono::microseconds(0)) {
+        // No disk read sampled yet (e.g. everything is served from cache).
+        return;
+    }
+    const auto target = std::chrono::milliseconds(_cfg->read_concurrency_latency_target_in_ms());
+    const int min_limit = std::max<int>(max_count_concurrent_reads / 4, 2);
+    const int max_limit = max_count_concurrent_reads * 8;
+    auto limit = _read_concurrency_sem.count_limit();
+    auto new_limit = limit;
+    if (latency > target) {
+        new_limit = std::max(limit * 3 / 4, min_limit);
+    } else if (latency < target * 3 / 4
+            && (_read_concurrency_sem.waiters() || _read_concurrency_sem.available_resources().count <= 0)) {
+        new_limit = std::min(limit + std::max(limit / 8, 1), max_limit);
+    }
+    if (new_limit != limit) {
+        dblog.debug("Adjusting read concurrency limit {} -> {} (measured I/O latency {}us, target {}us)",
+                limit, new_limit, latency.count(), std::chrono::duration_cast<std::chrono::microseconds>(target).count());
+        _read_concurrency_sem.set_count_limit(new_limit);
+    }
+}
+
+// A full pass over a table's cache would stall the shard, so each tick
+// examines a small bounded number of rows per table; row_cache keeps a
+// per-table resume position, so successive ticks cover the whole cache.
+static constexpr size_t cache_tombstone_purge_rows_per_tick = 256;
+
+void database::purge_cache_tombstones() {
+    for (auto& p : _column_families) {
+        p.second->get_row_cache().purge_expired_tombstones(cache_tombstone_purge_rows_per_tick);
+    }
+}
+
 future<> database::truncate(sstring ksname, sstring cfname, timestamp_func tsf) {
     auto& ks = find_keyspace(ksname);
     auto& cf = find_column_family(ksname, cfname);
@@ -40,6 +40,7 @@
 #include <cstdint>
 #include <unordered_map>
 #include <map>
+#include <deque>
 #include <set>
 #include <iosfwd>
 #include <boost/functional/hash.hpp>
@@ -50,6 +51,8 @@
 #include "compound.hh"
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/abort_source.hh>
 #include "cql3/column_specification.hh"
 #include "db/commitlog/replay_position.hh"
 #include <limits>
@@ -61,6 +64,7 @@
 #include "query-request.hh"
 #include "keys.hh"
 #include "mutation.hh"
+#include "utils/chunked_vector.hh"
 #include "memtable.hh"
 #include <list>
 #include "mutation_reader.hh"
@@ -72,6 +76,7 @@
 #include "sstables/sstable_set.hh"
 #include "sstables/progress_monitor.hh"
 #include "sstables/version.hh"
+#include <seastar/core/circular_buffer.hh>
 #include <seastar/core/rwlock.hh>
 #include <seastar/core/shared_future.hh>
 #include <seastar/core/metrics_registration.hh>
@@ -307,6 +312,9 @@ public:
         bool enable_commitlog = true;
         bool enable_incremental_backups = false;
         bool compaction_enforce_min_threshold = false;
+        // When non-zero, unbounded compaction outputs are sealed in segments
+        // of roughly this many bytes. See compaction_output_segment_size_mb.
+        uint64_t compaction_output_segment_size = 0;
         bool enable_dangerous_direct_import_of_cassandra_counters = false;
         ::dirty_memory_manager* dirty_memory_manager = &default_dirty_memory_manager;
         ::dirty_memory_manager* streaming_dirty_memory_manager = &default_dirty_memory_manager;
@@ -319,6 +327,7 @@ public:
         seastar::scheduling_group memory_compaction_scheduling_group;
         seastar::scheduling_group statement_scheduling_group;
         seastar::scheduling_group streaming_scheduling_group;
+        seastar::scheduling_group view_update_scheduling_group;
         bool enable_metrics_reporting = false;
         db::large_data_handler* large_data_handler;
         db::timeout_semaphore* view_update_concurrency_semaphore;
@@ -340,10 +349,16 @@ public:
         utils::timed_rate_moving_average_and_histogram writes{256};
         utils::estimated_histogram estimated_read;
         utils::estimated_histogram estimated_write;
+        // Serialized size of mutations applied to the table's memtables.
+        utils::estimated_histogram estimated_write_size;
         utils::estimated_histogram estimated_sstable_per_read{35};
         utils::timed_rate_moving_average_and_histogram tombstone_scanned;
         utils::timed_rate_moving_average_and_histogram live_scanned;
         utils::estimated_histogram estimated_coordinator_read;
+        // Exponentially-weighted moving average of data query result sizes
+        // on this table, used to pre-size result buffers. Zero until the
+        // first data query completes.
+        size_t ewma_result_size = 0;
     };
 
     struct snapshot_details {
@@ -438,6 +453,14 @@ private:
     std::unordered_map<uint64_t, sstables::shared_sstable> _sstables_staging;
     // Control background fibers waiting for sstables to be deleted
     seastar::gate _sstable_deletion_gate;
+    // sstables discarded by truncate whose on-disk components still await
+    // unlinking by the background reclaim fiber.
+    std::deque<sstables::shared_sstable> _sstables_pending_reclaim;
+    bool _sstable_reclaim_active = false;
+    uint64_t _sstables_reclaimed = 0;
+    // Aborts the pacing sleep of the reclaim fiber on stop(), so shutdown
+    // doesn't have to wait out the remaining pauses.
+    seastar::abort_source _sstable_reclaim_abort;
     // This semaphore ensures that an operation like snapshot won't have its selected
     // sstables deleted by compaction in parallel, a race condition which could
     // easily result in failure.
@@ -451,6 +474,22 @@ private:
     db::replay_position _highest_rp;
     db::replay_position _lowest_allowed_rp;
 
+    // Encoding stats of the most recent memtable flushes. Long-lived tables
+    // tend to have stable timestamp distributions, so the aggregate of the
+    // last few flushes is a much better delta-encoding base than the global
+    // epoch defaults for sstables written from mutation streams whose minima
+    // are not known up front (streaming, repair).
+    static constexpr size_t encoding_stats_history_size = 8;
+    seastar::circular_buffer<encoding_stats> _flush_encoding_stats_history;
+
+    void record_flush_encoding_stats(const encoding_stats&);
+
+    // Grows whenever content is applied to this table on this shard -
+    // mutations, streamed writes, newly added sstables or truncation.
+    // Repair uses it to tell whether a range checksum computed earlier
+    // can still be valid (see checksum_range() in repair/repair.cc).
+    uint64_t _content_epoch = 0;
+
     // Provided by the database that owns this commitlog
     db::commitlog* _commitlog;
     compaction_manager& _compaction_manager;
@@ -551,6 +590,10 @@ private:
 
     void rebuild_statistics();
 
+    // Starts the background fiber that unlinks the components of sstables
+    // discarded by truncate, if it isn't already running.
+    void reclaim_discarded_sstables();
+
     // This function replaces new sstables by their ancestors, which are sstables that needed resharding.
     void replace_ancestors_needed_rewrite(std::unordered_set<uint64_t> ancestors, std::vector<sstables::shared_sstable> new_sstables);
     void remove_ancestors_needed_rewrite(std::unordered_set<uint64_t> ancestors);
@@ -599,6 +642,10 @@ public:
         return _failed_counter_applies_to_memtable;
     }
 
+    uint64_t content_epoch() const {
+        return _content_epoch;
+    }
+
     // This function should be called when this column family is ready for writes, IOW,
     // to produce SSTables. Extensive details about why this is important can be found
     // in Scylla's Github Issue #1014
@@ -647,6 +694,16 @@ public:
         return make_reader(std::move(schema), range, full_slice);
     }
 
+    // Serialized keys of up to max partitions currently in cache, feeding
+    // the persisted cache summary (system.cache_warmup).
+    std::vector<bytes> cache_key_sample(size_t max) const;
+    // Reads the head of the given partition through the normal read path at
+    // streaming priority, populating the cache. Used for cache warming after
+    // a restart; the key comes from the persisted summary and is ignored if
+    // this shard no longer owns it or it no longer parses under the current
+    // schema.
+    future<> warm_cache_for_key(bytes serialized_key);
+
     // The streaming mutation reader differs from the regular mutation reader in that:
     //  - Reflects all writes accepted by replica prior to creation of the
     //    reader and a _bounded_ amount of writes which arrive later.
@@ -659,6 +716,12 @@ public:
     flat_mutation_reader make_streaming_reader(schema_ptr schema, const dht::partition_range& range,
             mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no) const;
 
+    // Aggregate of the encoding stats of the last few memtable flushes, for
+    // seeding the writers of sstables built from mutation streams (streaming,
+    // repair) whose timestamp minima cannot be collected up front. Falls back
+    // to the encoding_stats epoch defaults until the table has flushed.
+    encoding_stats get_streaming_encoding_stats() const;
+
     sstables::shared_sstable make_streaming_sstable_for_write(std::optional<sstring> subdir = {});
     sstables::shared_sstable make_streaming_staging_sstable() {
         return make_streaming_sstable_for_write("staging");
@@ -708,6 +771,11 @@ public:
     // The mutation is always upgraded to current schema.
     void apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& = {});
     void apply(const mutation& m, db::rp_handle&& = {});
+    // Applies a batch of mutations pre-sorted by ring position (duplicates
+    // allowed) in a single pass over the active memtable's partition tree.
+    // The mutations are upgraded to current schema. Throws
+    // std::invalid_argument if the batch is not sorted.
+    void apply_batch(const utils::chunked_vector<mutation>& ms, db::rp_handle&& = {});
     void apply_streaming_mutation(schema_ptr, utils::UUID plan_id, const frozen_mutation&, bool fragmented);
 
     // Returns at most "cmd.limit" rows
@@ -729,6 +797,12 @@ public:
     future<> clear(); // discards memtable(s) without flushing them to disk.
     future<db::replay_position> discard_sstables(db_clock::time_point);
 
+    // Number of sstables discarded by truncate whose on-disk components
+    // still await removal by the background reclaim fiber, and the number
+    // of sstables the fiber has reclaimed so far.
+    size_t sstables_pending_reclaim_count() const { return _sstables_pending_reclaim.size(); }
+    uint64_t sstables_reclaimed_count() const { return _sstables_reclaimed; }
+
     // Important warning: disabling writes will only have an effect in the current shard.
     // The other shards will keep writing tables at will. Therefore, you very likely need
     // to call this separately in all shards first, to guarantee that none of them are writing
@@ -795,6 +869,10 @@ public:
         return _config.compaction_enforce_min_threshold;
     }
 
+    uint64_t compaction_output_segment_size() const {
+        return _config.compaction_output_segment_size;
+    }
+
     /*!
      * \brief get sstables by key
      * Return a set of the sstables names that contain the given
@@ -1074,6 +1152,7 @@ public:
         bool enable_cache = true;
         bool enable_incremental_backups = false;
         bool compaction_enforce_min_threshold = false;
+        uint64_t compaction_output_segment_size = 0;
         bool enable_dangerous_direct_import_of_cassandra_counters = false;
         ::dirty_memory_manager* dirty_memory_manager = &default_dirty_memory_manager;
         ::dirty_memory_manager* streaming_dirty_memory_manager = &default_dirty_memory_manager;
@@ -1086,6 +1165,7 @@ public:
         seastar::scheduling_group memory_compaction_scheduling_group;
         seastar::scheduling_group statement_scheduling_group;
         seastar::scheduling_group streaming_scheduling_group;
+        seastar::scheduling_group view_update_scheduling_group;
         bool enable_metrics_reporting = false;
         db::timeout_semaphore* view_update_concurrency_semaphore = nullptr;
         size_t view_update_concurrency_semaphore_limit;
@@ -1158,6 +1238,7 @@ struct database_config {
     seastar::scheduling_group memory_compaction_scheduling_group;
     seastar::scheduling_group statement_scheduling_group;
     seastar::scheduling_group streaming_scheduling_group;
+    seastar::scheduling_group view_update_scheduling_group;
     size_t available_memory;
 };
 
@@ -1178,13 +1259,13 @@ private:
     size_t max_memory_streaming_concurrent_reads() { return _dbcfg.available_memory * 0.02; }
     static const size_t max_count_system_concurrent_reads{10};
     size_t max_memory_system_concurrent_reads() { return _dbcfg.available_memory * 0.02; };
-    static constexpr size_t max_concurrent_sstable_loads() { return 3; }
     size_t max_memory_pending_view_updates() const { return _dbcfg.available_memory * 0.1; }
 
     struct db_stats {
         uint64_t total_writes = 0;
         uint64_t total_writes_failed = 0;
         uint64_t total_writes_timedout = 0;
+        uint64_t counter_updates_coalesced = 0;
         uint64_t total_reads = 0;
         uint64_t total_reads_failed = 0;
         uint64_t sstable_read_queue_overloaded = 0;
@@ -1204,6 +1285,10 @@ private:
     std::unique_ptr<db::config> _cfg;
 
     dirty_memory_manager _system_dirty_memory_manager;
+    // Shared ceiling for the combined dirty memory of the statement and
+    // streaming managers below. The system manager stays out of it so that
+    // writes to system tables never block on user workloads.
+    dirty_memory_manager_group _dirty_memory_manager_group;
     dirty_memory_manager _dirty_memory_manager;
     dirty_memory_manager _streaming_dirty_memory_manager;
 
@@ -1214,7 +1299,7 @@ private:
     reader_concurrency_semaphore _streaming_concurrency_sem;
     reader_concurrency_semaphore _system_read_concurrency_sem;
 
-    semaphore _sstable_load_concurrency_sem{max_concurrent_sstable_loads()};
+    semaphore _sstable_load_concurrency_sem;
 
     db::timeout_semaphore _view_update_concurrency_sem{max_memory_pending_view_updates()};
 
@@ -1248,6 +1333,24 @@ private:
     utils::UUID _version;
     // compaction_manager object is referenced by all column families of a database.
     std::unique_ptr<compaction_manager> _compaction_manager;
+    // Periodically major-compacts the system tables during quiet periods.
+    // They see almost no writes (and hence no regular compactions) once the
+    // node is up, so without this their expired and superseded rows are
+    // never purged and startup reads of them get slower over the node's
+    // lifetime. See system_keyspace_maintenance_interval_in_hours.
+    timer<lowres_clock> _system_maintenance_timer;
+    future<> _system_maintenance_done = make_ready_future<>();
+    // Periodically snapshots the set of cached partition keys per table into
+    // system.cache_warmup; replayed through the read path after a restart.
+    // See enable_cache_warmup.
+    timer<lowres_clock> _cache_summary_timer;
+    future<> _cache_warmup_done = make_ready_future<>();
+    // Periodically adjusts the statement read concurrency limit from the
+    // measured sstable read I/O latency. See read_concurrency_latency_target_in_ms.
+    timer<lowres_clock> _read_concurrency_tuning_timer;
+    // Periodically evicts gc_grace-expired dead rows from the row caches,
+    // a bounded amount of work per tick. See enable_cache_tombstone_purge.
+    timer<lowres_clock> _cache_tombstone_purge_timer;
     seastar::metrics::metric_groups _metrics;
     bool _enable_incremental_backups = false;
 
@@ -1262,6 +1365,13 @@ private:
     std::unique_ptr<db::data_listeners> _data_listeners;
 
     future<> init_commitlog();
+    void on_system_maintenance_timer();
+    future<> compact_system_tables();
+    void on_cache_summary_timer();
+    future<> persist_cache_summaries();
+    future<> warm_caches_from_summary();
+    void tune_read_concurrency();
+    void purge_cache_tombstones();
     future<> apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&&, db::timeout_clock::time_point timeout);
     future<> apply_in_memory(const mutation& m, column_family& cf, db::rp_handle&&, db::timeout_clock::time_point timeout);
 private:
@@ -1280,6 +1390,41 @@ private:
     future<mutation> do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema, db::timeout_clock::time_point timeout,
                                              tracing::trace_state_ptr trace_state);
 
+    // In-flight counter update batches, keyed by table id and partition key.
+    // While a counter update holds the counter cell locks of a partition and
+    // reads the current state of the cells, later updates whose cells are
+    // covered by that read queue up here and are served under the same lock
+    // acquisition and read. See do_apply_counter_update().
+    struct pending_counter_update {
+        mutation m;
+        db::timeout_clock::time_point timeout;
+        promise<mutation> result;
+    };
+    struct counter_update_batch {
+        schema_ptr s;
+        const query::partition_slice* slice;
+        std::deque<pending_counter_update> waiters;
+    };
+    using counter_batch_key = std::pair<utils::UUID, dht::decorated_key>;
+    struct counter_batch_key_hash {
+        size_t operator()(const counter_batch_key& key) const {
+            return std::hash<utils::UUID>()(key.first) ^ std::hash<dht::token>()(key.second.token());
+        }
+    };
+    // Compares keys by their serialized representation so that no schema is
+    // needed. Keys that this considers unequal merely miss the batching
+    // opportunity and take the unbatched path.
+    struct counter_batch_key_equal {
+        bool operator()(const counter_batch_key& a, const counter_batch_key& b) const {
+            return a.first == b.first && a.second.token() == b.second.token()
+                    && a.second.key().representation() == b.second.key().representation();
+        }
+    };
+    std::unordered_map<counter_batch_key, counter_update_batch, counter_batch_key_hash, counter_batch_key_equal> _pending_counter_updates;
+
+    future<> drain_pending_counter_updates(column_family& cf, const counter_batch_key& key, mutation state);
+    void abort_pending_counter_updates(const counter_batch_key& key, std::exception_ptr ep);
+
     template<typename Future>
     Future update_write_metrics(Future&& f);
 public:
@@ -1310,6 +1455,10 @@ public:
     seastar::scheduling_group get_streaming_scheduling_group() const { return _dbcfg.streaming_scheduling_group; }
     size_t get_available_memory() const { return _dbcfg.available_memory; }
 
+    reader_concurrency_semaphore& read_concurrency_sem() {
+        return _read_concurrency_sem;
+    }
+
     compaction_manager& get_compaction_manager() {
         return *_compaction_manager;
     }
@@ -1413,6 +1562,16 @@ public:
 
     future<> flush_all_memtables();
 
+    // Starts the periodic system keyspace maintenance; a no-op when
+    // system_keyspace_maintenance_interval_in_hours is 0. Must be called
+    // after the compaction manager has been started.
+    void start_system_keyspace_maintenance();
+    // Kicks off post-restart cache warming from the persisted summary in
+    // the background and arms the periodic summary persistence. No-op
+    // unless enable_cache_warmup is set. Must be called after the system
+    // keyspace is set up and sstables are loaded.
+    void start_cache_warmup();
+
     // See #937. Truncation now requires a callback to get a time stamp
     // that must be guaranteed to be the same for all shards.
     typedef std::function<future<db_clock::time_point>()> timestamp_func;
@@ -234,6 +234,7 @@ public:
         uint64_t bytes_slack = 0;
         uint64_t segments_created = 0;
         uint64_t segments_destroyed = 0;
+        uint64_t segments_recycled = 0;
         uint64_t pending_flushes = 0;
         uint64_t flush_limit_exceeded = 0;
         uint64_t total_size = 0;
@@ -304,6 +305,7 @@ public:
 
     future<> delete_segments(std::vector<sstring>);
 
+    void notify_segment_sealed(segment&);
     void discard_unused_segments();
     void discard_completed_segments(const cf_id_type&);
     void discard_completed_segments(const cf_id_type&, const rp_set&);
@@ -430,6 +432,18 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
     buffer_type _buffer;
     fragmented_temporary_buffer::ostream _buffer_ostream;
+    // Entries whose checksum fields have been left blank by allocate() and
+    // are filled in by cycle() in one batched pass over the sealed buffer.
+    // The streams are cursors into _buffer; the fragment vector is fixed
+    // once the buffer is allocated, so they stay valid until the buffer is
+    // written out.
+    struct pending_entry_crc {
+        uint32_t size;
+        buffer_type::ostream head_out; // positioned at the header checksum field
+        seastar::memory_input_stream<std::vector<temporary_buffer<char>>::iterator> data;
+        buffer_type::ostream tail_out; // positioned at the entry checksum field
+    };
+    std::vector<pending_entry_crc> _pending_entry_crcs;
     std::unordered_map<cf_id_type, uint64_t> _cf_dirty;
     time_point _sync_time;
     seastar::gate _gate;
@@ -599,6 +613,9 @@ public:
                     new_buffer(0);
                 }
                 return cycle(true, true);
+            }).then([](sseg_ptr s) {
+                s->_segment_manager->notify_segment_sealed(*s);
+                return make_ready_future<sseg_ptr>(std::move(s));
             });
         }
 
@@ -676,6 +693,18 @@ public:
         _buffer_ostream = { };
         _num_allocs = 0;
 
+        // Fill in the checksum fields allocate() left blank, in one
+        // sequential pass over the sealed buffer.
+        for (auto& e : std::exchange(_pending_entry_crcs, {})) {
+            crc32_nbo crc;
+            crc.process(e.size);
+            write<uint32_t>(e.head_out, crc.checksum());
+            e.data.with_stream([&] (auto data_str) {
+                crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
+            });
+            write<uint32_t>(e.tail_out, crc.checksum());
+        }
+
         auto me = shared_from_this();
         assert(me.use_count() > 1);
 
@@ -773,7 +802,13 @@ public:
          */
         auto me = shared_from_this();
         auto fp = _file_pos;
-        return _pending_ops.wait_for_pending(timeout).then([me, fp, timeout] {
+        // Yield once before cutting the sync, so allocations that are already
+        // runnable in this reactor poll land in the buffer and join the group.
+        // The added delay is bounded by the tasks queued ahead of us, while
+        // each additional entry in the group saves a whole device flush.
+        return seastar::later().then([me, timeout] {
+            return me->_pending_ops.wait_for_pending(timeout);
+        }).then([me, fp, timeout] {
             if (fp != me->_file_pos) {
                 // some other request already wrote this buffer.
                 // If so, wait for the operation at our intended file offset
@@ -853,21 +888,22 @@ public:
         rp_handle h(static_pointer_cast<cf_holder>(shared_from_this()), std::move(id), rp);
 
         auto out = _buffer_ostream.write_substream(s);
-        crc32_nbo crc;
 
         write<uint32_t>(out, s);
-        crc.process(uint32_t(s));
-        write<uint32_t>(out, crc.checksum());
+        auto head_out = out.write_substream(sizeof(uint32_t));
 
         // actual data
         auto entry_out = out.write_substream(size);
         auto entry_data = entry_out.to_input_stream();
         writer->write(*this, entry_out);
-        entry_data.with_stream([&] (auto data_str) {
-            crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
-        });
 
-        write<uint32_t>(out, crc.checksum());
+        // The two checksum fields are not computed here but batched in
+        // cycle(): checksumming at seal time runs over the whole buffer
+        // sequentially, which is friendlier to the interleaved crc32
+        // kernel than doing it entry by entry on the foreground write
+        // path. After the data substream above, out has exactly the
+        // entry checksum field left.
+        _pending_entry_crcs.push_back(pending_entry_crc{uint32_t(s), std::move(head_out), std::move(entry_data), std::move(out)});
 
         ++_segment_manager->totals.allocation_count;
         ++_num_allocs;
@@ -1178,6 +1214,11 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
 
         sm::make_gauge("memory_buffer_bytes", totals.buffer_list_bytes,
                        sm::description("Holds the total number of bytes in internal memory buffers.")),
+
+        sm::make_derive("segments_recycled", totals.segments_recycled,
+                       sm::description("Counts a number of segments that were returned to the recycled pool for reuse instead of being deleted. "
+                                       "In steady state this should track segment turnover; a zero value with ongoing writes indicates segments are "
+                                       "being deleted and re-created, paying file allocation costs on the write path.")),
     });
 }
 
@@ -1284,6 +1325,17 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
     return allocate_segment_ex(d, dst, open_flags::wo|open_flags::create, active);
 }
 
+void db::commitlog::segment_manager::notify_segment_sealed(segment& s) {
+    if (cfg.extensions == nullptr) {
+        return;
+    }
+    // the checkpoint is one past the last entry of the sealed segment
+    replay_position checkpoint(s._desc.id, position_type(s._file_pos));
+    for (auto* ext : cfg.extensions->commitlog_tail_extensions()) {
+        ext->on_segment_sealed(s._file_name, checkpoint);
+    }
+}
+
 future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::new_segment() {
     if (_shutdown) {
         throw std::runtime_error("Commitlog has been shut down. Cannot add data");
@@ -1498,6 +1550,7 @@ future<> db::commitlog::segment_manager::delete_segments(std::vector<sstring> fi
                 // cause header ID to be invalid in the file -> ignored
                 return rename_file(filename, dst).then([=] {
                     _recycled_segments.emplace_back(dst);
+                    ++totals.segments_recycled;
                     return make_ready_future<>();
                 }).handle_exception([this, filename](auto&&) {
                     return commit_io_check(&seastar::remove_file, filename);
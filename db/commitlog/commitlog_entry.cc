@@ -57,10 +57,26 @@ void commitlog_entry_writer::write(typename seastar::memory_output_stream<std::v
     serialize(out);
 }
 
+// The entry payload is a writable IDL type, so its fields can be skipped
+// without being parsed. The mutation field is the frozen_mutation
+// representation behind a length prefix, and deserializing it copies the
+// bytes from the segment buffer directly into the frozen_mutation with no
+// intermediate allocation. The column mapping, which is expensive to parse
+// (per-column names and type lookups), is skipped here and only extracted
+// by get_column_mapping() when the schema version is actually unknown.
 commitlog_entry_reader::commitlog_entry_reader(const fragmented_temporary_buffer& buffer)
-    : _ce([&] {
+    : _buffer(buffer)
+    , _mutation([&] {
     auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buffer).begin(), buffer.size_bytes());
-    return ser::deserialize(in, boost::type<commitlog_entry>());
+    ser::skip(in, boost::type<ser::size_type>());
+    ser::skip(in, boost::type<std::optional<column_mapping>>());
+    return ser::deserialize(in, boost::type<frozen_mutation>());
 }())
 {
 }
+
+std::optional<column_mapping> commitlog_entry_reader::get_column_mapping() const {
+    auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(_buffer).begin(), _buffer.size_bytes());
+    ser::skip(in, boost::type<ser::size_type>());
+    return ser::deserialize(in, boost::type<std::optional<column_mapping>>());
+}
@@ -75,11 +75,16 @@ public:
 };
 
 class commitlog_entry_reader {
-    commitlog_entry _ce;
+    const fragmented_temporary_buffer& _buffer;
+    frozen_mutation _mutation;
 public:
     commitlog_entry_reader(const fragmented_temporary_buffer& buffer);
 
-    const std::optional<column_mapping>& get_column_mapping() const { return _ce.mapping(); }
-    const frozen_mutation& mutation() const & { return _ce.mutation(); }
-    frozen_mutation&& mutation() && { return std::move(_ce).mutation(); }
+    // The column mapping is only needed when an entry carries a schema
+    // version we have not seen yet, which is rare at replay. It is parsed
+    // on demand, straight from the segment buffer, instead of eagerly for
+    // every entry. The buffer must still be alive when this is called.
+    std::optional<column_mapping> get_column_mapping() const;
+    const frozen_mutation& mutation() const & { return _mutation; }
+    frozen_mutation&& mutation() && { return std::move(_mutation); }
 };
@@ -34,5 +34,27 @@ namespace db {
         virtual future<file> wrap_file(const sstring& filename, file, open_flags flags) = 0;
         virtual future<> before_delete(const sstring& filename) = 0;
     };
+
+    /**
+     * Consumer interface for tailing the commitlog as a change feed.
+     *
+     * on_segment_sealed is called once for every segment the commitlog
+     * seals, i.e. terminates and stops appending to. The checkpoint is the
+     * replay position just past the last entry of the segment; persisting
+     * it once a segment has been consumed makes the tail resumable across
+     * restarts.
+     *
+     * Like a commitlog flush_handler this is called from the flush path,
+     * so implementations must not block - instigate the actual export in
+     * the background instead, typically one sequential pass over the file
+     * with commitlog::read_log_file(), decoding each buffer view with
+     * commitlog_entry_reader. Pair with a commitlog_file_extension whose
+     * before_delete() delays removal of segments not yet consumed.
+     */
+    class commitlog_tail_extension {
+    public:
+        virtual ~commitlog_tail_extension() {}
+        virtual void on_segment_sealed(const sstring& filename, const replay_position& checkpoint) = 0;
+    };
 }
 
@@ -46,6 +46,7 @@
 #include <boost/range/adaptor/map.hpp>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
 
 #include "commitlog.hh"
@@ -63,6 +64,13 @@
 
 static logging::logger rlogger("commitlog_replayer");
 
+// How many segments each shard reads and replays concurrently. Mutations in
+// the log carry their own timestamps, so the order in which segments are
+// applied to memtables does not affect the end result; the limit only keeps
+// memory use and mutation congestion in check while letting the disk see
+// enough sequential streams to stay busy.
+static constexpr size_t max_concurrent_replay_segments = 4;
+
 class db::commitlog_replayer::impl {
     struct column_mappings {
         std::unordered_map<table_schema_version, column_mapping> map;
@@ -244,6 +252,14 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
 
 future<> db::commitlog_replayer::impl::process(stats* s, fragmented_temporary_buffer buf, replay_position rp) const {
     try {
+        auto shard_id = rp.shard_id();
+        if (rp < min_pos(shard_id)) {
+            // Cheap rejection: the position alone tells us the entry was
+            // flushed, so don't bother deserializing it at all.
+            rlogger.trace("entry {} is less than global min position. skipping", rp);
+            s->skipped_mutations++;
+            return make_ready_future<>();
+        }
 
         commitlog_entry_reader cer(buf);
         auto& fm = cer.mutation();
@@ -251,21 +267,15 @@ future<> db::commitlog_replayer::impl::process(stats* s, fragmented_temporary_bu
         auto& local_cm = _column_mappings.local().map;
         auto cm_it = local_cm.find(fm.schema_version());
         if (cm_it == local_cm.end()) {
-            if (!cer.get_column_mapping()) {
+            auto mapping = cer.get_column_mapping();
+            if (!mapping) {
                 throw std::runtime_error(format("unknown schema version {{}}", fm.schema_version()));
             }
             rlogger.debug("new schema version {} in entry {}", fm.schema_version(), rp);
-            cm_it = local_cm.emplace(fm.schema_version(), *cer.get_column_mapping()).first;
+            cm_it = local_cm.emplace(fm.schema_version(), std::move(*mapping)).first;
         }
         const column_mapping& src_cm = cm_it->second;
 
-        auto shard_id = rp.shard_id();
-        if (rp < min_pos(shard_id)) {
-            rlogger.trace("entry {} is less than global min position. skipping", rp);
-            s->skipped_mutations++;
-            return make_ready_future<>();
-        }
-
         auto uuid = fm.column_family_id();
         auto cf_rp = cf_min_pos(uuid, shard_id);
         if (rp <= cf_rp) {
@@ -275,8 +285,9 @@ future<> db::commitlog_replayer::impl::process(stats* s, fragmented_temporary_bu
         }
 
         auto shard = _db.local().shard_of(fm);
-        return _db.invoke_on(shard, [this, cer = std::move(cer), &src_cm, rp, shard, s] (database& db) -> future<> {
-            auto& fm = cer.mutation();
+        // Only the frozen_mutation crosses shards; the reader must not
+        // outlive this frame, as it refers to the segment buffer.
+        return _db.invoke_on(shard, [this, fm = std::move(cer).mutation(), &src_cm, rp, shard, s] (database& db) -> future<> {
             // TODO: might need better verification that the deserialized mutation
             // is schema compatible. My guess is that just applying the mutation
             // will not do this.
@@ -361,12 +372,10 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
             return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
                 return smp::submit_to(id, [this, id, map, &fname_prefix] () {
                     auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
+                    auto sem = ::make_lw_shared<semaphore>(max_concurrent_replay_segments);
                     auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
-                        auto&f = p.second;
+                    return parallel_for_each(range.first, range.second, [this, total, sem, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
+                      return with_semaphore(*sem, 1, [this, total, &fname_prefix, f = p.second] {
                         rlogger.debug("Replaying {}", f);
                         return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
                             if (stats.corrupt_bytes != 0) {
@@ -380,7 +389,8 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
                             );
                             *total += stats;
                         });
-                    }).then([total] {
+                      });
+                    }).then([total, sem] {
                         return make_ready_future<impl::stats>(*total);
                     });
                 });
@@ -128,6 +128,9 @@ public:
     val(compaction_enforce_min_threshold, bool, false, Used, \
             "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold" \
     )   \
+    val(compaction_output_segment_size_mb, uint64_t, 0, Used, \
+            "When set, compactions that would otherwise write one unbounded output sstable seal it in segments of roughly this size, in MB. The segments of a compaction share a run identifier and count as a single sstable for size-tiered bucketing, and input sstables the compaction has fully passed over are released right away, bounding the transient space of large compactions to roughly the segment size once the inputs are themselves segmented. 0 (the default) keeps single-file outputs" \
+    )   \
     /* Initialization properties */             \
     /* The minimal properties needed for configuring a cluster. */  \
     val(cluster_name, sstring, "", Used,   \
@@ -231,6 +234,9 @@ public:
     val(compaction_large_row_warning_threshold_mb, uint32_t, 10, Used, \
             "Log a warning when writing rows larger than this value"   \
     )                                               \
+    val(system_keyspace_maintenance_interval_in_hours, uint32_t, 24, Used, \
+            "Interval between background major compactions of the system tables. System tables are rarely written once a node is up, so without this their expired and superseded rows are never purged and reads of them at startup get slower over the node's lifetime. The maintenance pass waits for a moment when no other compactions are running. Set to 0 to disable."   \
+    )                                               \
     /* Common memtable settings */  \
     val(memtable_total_space_in_mb, uint32_t, 0, Invalid,     \
             "Specifies the total memory used for all memtables on a node. This replaces the per-table storage settings memtable_operations_in_millions and memtable_throughput_in_mb."  \
@@ -306,6 +312,7 @@ public:
             "When compacting, the replacement opens SSTables before they are completely written and uses in place of the prior SSTables for any range previously written. This setting helps to smoothly transfer reads between the SSTables by reducing page cache churn and keeps hot rows hot."  \
     )                                                   \
     val(defragment_memory_on_idle, bool, false, Used, "When set to true, will defragment memory when the cpu is idle.  This reduces the amount of work Scylla performs when processing client requests.") \
+    val(defragment_memory_target_occupancy, double, 1.0, Used, "Occupancy fraction at which idle memory defragmentation stops. Once overall LSA occupancy is at or above this fraction, the shard is considered defragmented enough. 1.0 defragments as much as possible.") \
     /* Memtable settings */ \
     val(memtable_allocation_type, sstring, "heap_buffers", Invalid,     \
             "Specify the way Cassandra allocates and manages memtable memory. See Off-heap memtables in Cassandra 2.1. Options are:\n"  \
@@ -717,6 +724,8 @@ public:
     val(api_doc_dir, sstring, "api/api-doc/", Used, "The API definition file directory") \
     val(load_balance, sstring, "none", Used, "CQL request load balancing: 'none' or round-robin'") \
     val(consistent_rangemovement, bool, true, Used, "When set to true, range movements will be consistent. It means: 1) it will refuse to bootstrap a new node if other bootstrapping/leaving/moving nodes detected. 2) data will be streamed to a new node only from the node which is no longer responsible for the token range. Same as -Dcassandra.consistent.rangemovement in cassandra") \
+    val(range_streamer_nodes_in_parallel, uint32_t, 16, Used, "Number of peer nodes to stream ranges from or to in parallel during operations like bootstrap, rebuild, decommission and removenode. Higher values saturate the network with fewer peers at the cost of more memory for in-flight streams.") \
+    val(range_streamer_ranges_percentage, uint32_t, 10, Used, "Percentage of the ranges to be streamed with a given peer that are grouped into a single stream plan. Ranges from already completed stream plans are not streamed again when a failed operation is retried, so smaller plans lose less work to an interruption, at the cost of more stream plan setup round trips.") \
     val(join_ring, bool, true, Used, "When set to true, a node will join the token ring. When set to false, a node will not join the token ring. User can use nodetool join to initiate ring joinging later. Same as -Dcassandra.join_ring in cassandra.") \
     val(load_ring_state, bool, true, Used, "When set to true, load tokens and host_ids previously saved. Same as -Dcassandra.load_ring_state in cassandra.") \
     val(replace_node, sstring, "", Used, "The UUID of the node to replace. Same as -Dcassandra.replace_node in cssandra.") \
@@ -741,6 +750,14 @@ public:
     val(virtual_dirty_soft_limit, double, 0.6, Used, "Soft limit of virtual dirty memory expressed as a portion of the hard limit") \
     val(sstable_summary_ratio, double, 0.0005, Used, "Enforces that 1 byte of summary is written for every N (2000 by default) " \
         "bytes written to data file. Value must be between 0 and 1.") \
+    val(sstable_load_concurrency, uint32_t, 16, Used, "Maximum number of sstables whose components are loaded concurrently on each shard, during startup and refresh. " \
+        "Raising it increases the I/O queue depth of cold boot; nodes with many small sstables on fast storage boot faster with higher values.") \
+    val(bloom_filter_memory_budget_mb, uint64_t, 0, Used, "Per-shard budget, in MB, for sstable bloom filters kept in memory. When set, filters are loaded lazily on the first key lookup " \
+        "and the least recently loaded ones are dropped to stay within the budget; a dropped filter reports all keys as possibly present until it is reloaded. " \
+        "0 (the default) loads every filter eagerly and keeps it resident. Useful for nodes holding mostly-cold data, e.g. time series archives.") \
+    val(sstable_file_descriptor_budget, uint64_t, 0, Used, "Per-shard budget for open sstable Data and Index file descriptors. When set, the descriptors of the least recently read sstables " \
+        "are closed once the budget is exceeded and transparently reopened on the next read, at the cost of an open() on the first read of a cold sstable. " \
+        "0 (the default) keeps every sstable file open. Useful for nodes holding tens of thousands of sstables, where open descriptors approach the process fd limit.") \
     val(large_memory_allocation_warning_threshold, size_t, size_t(1) << 20, Used, "Warn about memory allocations above this size; set to zero to disable") \
     val(enable_deprecated_partitioners, bool, false, Used, "Enable the byteordered and murmurs partitioners. These partitioners are deprecated and will be removed in a future version.") \
     val(enable_keyspace_column_family_metrics, bool, false, Used, "Enable per keyspace and per column family metrics reporting") \
@@ -749,6 +766,10 @@ public:
     val(cpu_scheduler, bool, true, Used, "Enable cpu scheduling") \
     val(view_building, bool, true, Used, "Enable view building; should only be set to false when the node is experience issues due to view building") \
     val(enable_sstables_mc_format, bool, true, Used, "Enable SSTables 'mc' format to be used as the default file format") \
+    val(enable_paged_read_prefetch, bool, false, Used, "Speculatively read the next page of a paged query while the client's next page request is in flight. Reduces effective page latency of sequential scans at the cost of wasted reads for clients which abandon paged queries early.") \
+    val(enable_cache_warmup, bool, false, Used, "Periodically persist a summary of each table's cache contents (partition keys) into system.cache_warmup, and replay it through the read path after a restart, restoring cache hit rates without waiting for the workload to re-learn the hot set.") \
+    val(read_concurrency_latency_target_in_ms, uint32_t, 0, Used, "Auto-tune the limit on concurrently executing statement reads from the measured sstable read I/O latency: the limit is raised while latency stays below this target and lowered when it exceeds it, keeping the disk queues full but below the latency knee. 0 (the default) keeps the static limit.") \
+    val(enable_cache_tombstone_purge, bool, true, Used, "Periodically evict rows from the row cache which carry no live data and whose tombstones expired gc_grace_seconds ago, keeping cache memory for live rows and reads free of tombstone skipping. Only affects the cache; the tombstones in sstables are purged by regular compaction.") \
     val(enable_dangerous_direct_import_of_cassandra_counters, bool, false, Used, "Only turn this option on if you want to import tables from Cassandra containing counters, and you are SURE that no counters in that table were created in a version earlier than Cassandra 2.1." \
         " It is not enough to have ever since upgraded to newer versions of Cassandra. If you EVER used a version earlier than 2.1 in the cluster where these SSTables come from, DO NOT TURN ON THIS OPTION! You will corrupt your data. You have been warned.") \
     /* done! */
@@ -78,16 +78,76 @@ future<> toppartitions_data_listener::stop() {
     return make_ready_future<>();
 }
 
+// Wraps the read stream of a monitored table: counts each partition entered
+// and attributes the size of the fragments to the partition they belong to.
+class toppartitions_reader : public flat_mutation_reader::impl {
+    flat_mutation_reader _rd;
+    toppartitions_data_listener& _listener;
+    std::optional<dht::decorated_key> _key;
+    size_t _bytes = 0;
+private:
+    // Called on partition boundaries and after each batch of fragments, so
+    // the hot path pays one sketch update per partition per buffer fill
+    // instead of one per fragment.
+    void flush_bytes() {
+        if (_key && _bytes) {
+            _listener._top_k_read_bytes.append(toppartitons_item_key{_schema, *_key}, _bytes);
+            _bytes = 0;
+        }
+    }
+public:
+    toppartitions_reader(flat_mutation_reader rd, toppartitions_data_listener& listener)
+        : impl(rd.schema())
+        , _rd(std::move(rd))
+        , _listener(listener) {
+    }
+    virtual future<> fill_buffer(db::timeout_clock::time_point timeout) override {
+        return do_until([this] { return is_buffer_full() || is_end_of_stream(); }, [this, timeout] {
+            return _rd.fill_buffer(timeout).then([this] {
+                while (!_rd.is_buffer_empty()) {
+                    auto mf = _rd.pop_mutation_fragment();
+                    if (mf.is_partition_start()) {
+                        flush_bytes();
+                        _key = mf.as_partition_start().key();
+                        _listener._top_k_read.append(toppartitons_item_key{_schema, *_key});
+                    }
+                    _bytes += mf.memory_usage(*_schema);
+                    push_mutation_fragment(std::move(mf));
+                }
+                _end_of_stream = _rd.is_end_of_stream();
+                flush_bytes();
+            });
+        });
+    }
+    virtual void next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            _end_of_stream = false;
+            _rd.next_partition();
+        }
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr, db::timeout_clock::time_point timeout) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(pr, timeout);
+    }
+    virtual future<> fast_forward_to(position_range pr, db::timeout_clock::time_point timeout) override {
+        forward_buffer_to(pr.start());
+        _end_of_stream = false;
+        return _rd.fast_forward_to(std::move(pr), timeout);
+    }
+    virtual size_t buffer_size() const override {
+        return flat_mutation_reader::impl::buffer_size() + _rd.buffer_size();
+    }
+};
+
 flat_mutation_reader toppartitions_data_listener::on_read(const schema_ptr& s, const dht::partition_range& range,
         const query::partition_slice& slice, flat_mutation_reader&& rd) {
     if (s->ks_name() != _ks || s->cf_name() != _cf) {
         return std::move(rd);
     }
     dblog.trace("toppartitions_data_listener::on_read: {}.{}", s->ks_name(), s->cf_name());
-    return make_filtering_reader(std::move(rd), [this, &range, &slice, s = std::move(s)] (const dht::decorated_key& dk) {
-        _top_k_read.append(toppartitons_item_key{s, dk});
-        return true;
-    });
+    return make_flat_mutation_reader<toppartitions_reader>(std::move(rd), *this);
 }
 
 void toppartitions_data_listener::on_write(const schema_ptr& s, const frozen_mutation& m) {
@@ -95,7 +155,9 @@ void toppartitions_data_listener::on_write(const schema_ptr& s, const frozen_mut
         return;
     }
     dblog.trace("toppartitions_data_listener::on_write: {}.{}", _ks, _cf);
-    _top_k_write.append(toppartitons_item_key{s, m.decorated_key(*s)});
+    auto key = toppartitons_item_key{s, m.decorated_key(*s)};
+    _top_k_write.append(key);
+    _top_k_write_bytes.append(std::move(key), m.representation().size());
 }
 
 toppartitions_query::toppartitions_query(distributed<database>& xdb, sstring ks, sstring cf,
@@ -117,11 +179,15 @@ future<toppartitions_query::results> toppartitions_query::gather(unsigned res_si
         dblog.trace("toppartitions_query::map_reduce with listener {}", &listener);
         top_t rd = listener._top_k_read.top(res_size);
         top_t wr = listener._top_k_write.top(res_size);
-        return std::tuple<top_t, top_t>{std::move(rd), std::move(wr)};
+        top_t rd_bytes = listener._top_k_read_bytes.top(res_size);
+        top_t wr_bytes = listener._top_k_write_bytes.top(res_size);
+        return std::tuple<top_t, top_t, top_t, top_t>{std::move(rd), std::move(wr), std::move(rd_bytes), std::move(wr_bytes)};
     };
-    auto reduce = [this] (results res, std::tuple<top_t, top_t> rd_wr) {
+    auto reduce = [this] (results res, std::tuple<top_t, top_t, top_t, top_t> rd_wr) {
         res.read.append(std::get<0>(rd_wr));
         res.write.append(std::get<1>(rd_wr));
+        res.read_bytes.append(std::get<2>(rd_wr));
+        res.write_bytes.append(std::get<3>(rd_wr));
         return std::move(res);
     };
     return _query.map_reduce0(map, results{res_size}, reduce)
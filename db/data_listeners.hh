@@ -99,6 +99,7 @@ struct toppartitons_item_key {
 
 class toppartitions_data_listener : public data_listener {
     friend class toppartitions_query;
+    friend class toppartitions_reader;
 
     database& _db;
     sstring _ks;
@@ -109,6 +110,11 @@ public:
 private:
     top_k _top_k_read;
     top_k _top_k_write;
+    // Same keys, weighted by the size of the data read from/written to the
+    // partition instead of by operation count, so that heavy hitters hiding
+    // behind few-but-large operations are visible too.
+    top_k _top_k_read_bytes;
+    top_k _top_k_write_bytes;
 
 public:
     toppartitions_data_listener(database& db, sstring ks, sstring cf);
@@ -138,8 +144,10 @@ public:
     struct results {
         toppartitions_data_listener::top_k read;
         toppartitions_data_listener::top_k write;
+        toppartitions_data_listener::top_k read_bytes;
+        toppartitions_data_listener::top_k write_bytes;
 
-        results(size_t capacity) : read(capacity), write(capacity) {}
+        results(size_t capacity) : read(capacity), write(capacity), read_bytes(capacity), write_bytes(capacity) {}
     };
 
     std::chrono::milliseconds duration() const { return _duration; }
@@ -50,6 +50,15 @@ db::extensions::commitlog_file_extensions() const {
             | boost::adaptors::transformed(std::mem_fn(&std::unique_ptr<etype>::get)));
 }
 
+std::vector<db::commitlog_tail_extension*>
+db::extensions::commitlog_tail_extensions() const {
+    using etype = db::commitlog_tail_extension;
+    return boost::copy_range<std::vector<etype*>>(
+            _commitlog_tail_extensions
+            | boost::adaptors::map_values
+            | boost::adaptors::transformed(std::mem_fn(&std::unique_ptr<etype>::get)));
+}
+
 std::set<sstring>
 db::extensions::schema_extension_keywords() const {
     return boost::copy_range<std::set<sstring>>(
@@ -64,6 +73,10 @@ void db::extensions::add_commitlog_file_extension(sstring n, commitlog_file_exte
     _commitlog_file_extensions[n] = std::move(f);
 }
 
+void db::extensions::add_commitlog_tail_extension(sstring n, commitlog_tail_extension_ptr f) {
+    _commitlog_tail_extensions[n] = std::move(f);
+}
+
 void db::extensions::add_extension_to_schema(schema_ptr s, const sstring& name, shared_ptr<schema_extension> ext) {
     const_cast<schema *>(s.get())->extensions()[name] = std::move(ext);
 }
@@ -63,6 +63,7 @@ class file_io_extension;
 
 namespace db {
 class commitlog_file_extension;
+class commitlog_tail_extension;
 
 class extensions {
 public:
@@ -74,6 +75,7 @@ public:
     using schema_ext_create_func = std::function<seastar::shared_ptr<schema_extension>(schema_ext_config)>;
     using sstable_file_io_extension = std::unique_ptr<sstables::file_io_extension>;
     using commitlog_file_extension_ptr = std::unique_ptr<db::commitlog_file_extension>;
+    using commitlog_tail_extension_ptr = std::unique_ptr<db::commitlog_tail_extension>;
 
     /**
      * Registered extensions
@@ -93,6 +95,12 @@ public:
      */
     std::vector<db::commitlog_file_extension*> commitlog_file_extensions() const;
 
+    /**
+     * Returns iterable range of registered commitlog tail extensions (see commitlog_extensions.hh#commitlog_tail_extension)
+     * Notified by the commitlog whenever a segment is sealed...
+     */
+    std::vector<db::commitlog_tail_extension*> commitlog_tail_extensions() const;
+
     /**
      * Registered extensions keywords, i.e. custom properties/propery sets
      * for schema extensions
@@ -113,6 +121,10 @@ public:
      * Init time method to add sstable extension
      */
     void add_commitlog_file_extension(sstring n, commitlog_file_extension_ptr);
+    /**
+     * Init time method to add commitlog tail extension
+     */
+    void add_commitlog_tail_extension(sstring n, commitlog_tail_extension_ptr);
 
     /**
      * Allows forcible modification of schema extensions of a schema. This should
@@ -125,5 +137,6 @@ private:
     std::map<sstring, schema_ext_create_func> _schema_extensions;
     std::map<sstring, sstable_file_io_extension> _sstable_file_io_extensions;
     std::map<sstring, commitlog_file_extension_ptr> _commitlog_file_extensions;
+    std::map<sstring, commitlog_tail_extension_ptr> _commitlog_tail_extensions;
 };
 }
@@ -442,12 +442,13 @@ frozen_mutation_and_schema manager::end_point_hints_manager::sender::get_mutatio
 const column_mapping& manager::end_point_hints_manager::sender::get_column_mapping(lw_shared_ptr<send_one_file_ctx> ctx_ptr, const frozen_mutation& fm, const hint_entry_reader& hr) {
     auto cm_it = ctx_ptr->schema_ver_to_column_mapping.find(fm.schema_version());
     if (cm_it == ctx_ptr->schema_ver_to_column_mapping.end()) {
-        if (!hr.get_column_mapping()) {
+        auto mapping = hr.get_column_mapping();
+        if (!mapping) {
             throw no_column_mapping(fm.schema_version());
         }
 
         manager_logger.debug("new schema version {}", fm.schema_version());
-        cm_it = ctx_ptr->schema_ver_to_column_mapping.emplace(fm.schema_version(), *hr.get_column_mapping()).first;
+        cm_it = ctx_ptr->schema_ver_to_column_mapping.emplace(fm.schema_version(), std::move(*mapping)).first;
     }
 
     return cm_it->second;
@@ -649,7 +650,10 @@ future<> manager::end_point_hints_manager::sender::send_one_mutation(frozen_muta
 }
 
 future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
-    return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
+    // The window unit throttles the hints in flight towards this particular destination,
+    // the send units below bound the total memory of hints in flight on this shard.
+    return get_units(_send_window, 1).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto window_unit) mutable {
+        return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr, window_unit = std::move(window_unit)] (auto units) mutable {
         with_gate(ctx_ptr->file_send_gate, [this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
             try {
                 try {
@@ -675,8 +679,10 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
                 return this->send_one_mutation(std::move(m)).then([this, rp, ctx_ptr] {
                     ctx_ptr->rps_set.erase(rp);
                     ++this->shard_stats().sent;
+                    this->on_hint_send_success();
                 }).handle_exception([this, ctx_ptr] (auto eptr) {
                     manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
+                    this->on_hint_send_failure();
                     ctx_ptr->state.set(send_state::segment_replay_failed);
                 });
 
@@ -692,7 +698,8 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
                 ++this->shard_stats().discarded;
             }
             return make_ready_future<>();
-        }).finally([units = std::move(units), ctx_ptr] {});
+        }).finally([units = std::move(units), window_unit = std::move(window_unit), ctx_ptr] {});
+        });
     }).handle_exception([this, ctx_ptr] (auto eptr) {
         manager_logger.trace("send_one_file(): Hmmm. Something bad had happend: {}", eptr);
         ctx_ptr->state.set(send_state::segment_replay_failed);
@@ -131,6 +131,17 @@ public:
             gms::gossiper& _gossiper;
             seastar::shared_mutex& _file_update_mutex;
 
+            // Adaptive per-destination send window: the number of hints that
+            // may be in flight towards this end point at any time. The window
+            // tracks the destination's observed acknowledgment rate - it
+            // grows additively with every acknowledged hint and shrinks
+            // multiplicatively when a send fails, so that draining a long
+            // backlog doesn't flatten a node that has just recovered.
+            static constexpr size_t min_send_window_size = 1;
+            static constexpr size_t max_send_window_size = resource_manager::max_hints_send_queue_length;
+            size_t _send_window_size = max_send_window_size;
+            seastar::semaphore _send_window{max_send_window_size};
+
         public:
             sender(end_point_hints_manager& parent, service::storage_proxy& local_storage_proxy, database& local_db, gms::gossiper& local_gossiper) noexcept;
 
@@ -248,6 +259,21 @@ public:
             /// \return future that resolves when the mutation sending processing is complete.
             future<> send_one_mutation(frozen_mutation_and_schema m);
 
+            /// \brief Account a hint acknowledged by the destination - additively widen the send window.
+            void on_hint_send_success() noexcept {
+                if (_send_window_size < max_send_window_size) {
+                    ++_send_window_size;
+                    _send_window.signal();
+                }
+            }
+
+            /// \brief Account a failed hint delivery - multiplicatively shrink the send window.
+            void on_hint_send_failure() noexcept {
+                size_t new_size = std::max(_send_window_size / 2, min_send_window_size);
+                _send_window.consume(_send_window_size - new_size);
+                _send_window_size = new_size;
+            }
+
             /// \brief Get the last modification time stamp for a given file.
             /// \param fname File name
             /// \return The last modification time stamp for \param fname.
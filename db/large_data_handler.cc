@@ -23,6 +23,7 @@
 #include "db/query_context.hh"
 #include "db/system_keyspace.hh"
 #include "db/large_data_handler.hh"
+#include "frozen_mutation.hh"
 #include "sstables/sstables.hh"
 
 namespace db {
@@ -90,4 +91,9 @@ void cql_table_large_data_handler::log_large_row(const sstables::sstable& sst, c
                 partition_key.to_partition_key(s).with_schema(s), row_size);
     }
 }
+
+void cql_table_large_data_handler::log_large_write(const schema& s, const frozen_mutation& m, uint64_t size) const {
+    large_data_logger.warn("Applying large mutation {}/{}: {} ({} bytes)", s.ks_name(), s.cf_name(),
+            m.decorated_key(s).key().with_schema(s), size);
+}
 }
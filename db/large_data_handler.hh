@@ -22,8 +22,11 @@
 #pragma once
 
 #include <cstdint>
+#include <seastar/core/lowres_clock.hh>
 #include "schema.hh"
 
+class frozen_mutation;
+
 namespace sstables {
 class sstable;
 class key;
@@ -35,13 +38,19 @@ class large_data_handler {
 public:
     struct stats {
         int64_t partitions_bigger_than_threshold = 0; // number of large partition updates exceeding threshold_bytes
+        int64_t writes_bigger_than_threshold = 0; // number of write-path mutations exceeding the row threshold
     };
 
 private:
+    // An oversized writer typically produces a stream of oversized mutations,
+    // so warnings about them are time-limited. The stats counter is not.
+    static constexpr std::chrono::seconds write_warning_interval{10};
+
     bool _stopped = false;
     uint64_t _partition_threshold_bytes;
     uint64_t _row_threshold_bytes;
     mutable large_data_handler::stats _stats;
+    mutable seastar::lowres_clock::time_point _last_write_warning;
 
 public:
     explicit large_data_handler(uint64_t partition_threshold_bytes, uint64_t row_threshold_bytes)
@@ -64,6 +73,21 @@ public:
         }
     }
 
+    // Invoked on the write path with the serialized size of a mutation about
+    // to be applied to a memtable, so oversized writes are flagged while the
+    // writer is still running, not when the data is eventually flushed or
+    // compacted. In the common case this is a single comparison.
+    void maybe_log_large_write(const schema_ptr& s, const frozen_mutation& m, uint64_t size) const {
+        if (__builtin_expect(size > _row_threshold_bytes, false)) {
+            ++_stats.writes_bigger_than_threshold;
+            const auto now = seastar::lowres_clock::now();
+            if (now - _last_write_warning >= write_warning_interval) {
+                _last_write_warning = now;
+                log_large_write(*s, m, size);
+            }
+        }
+    }
+
     future<> maybe_update_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size) const;
     future<> maybe_delete_large_partitions_entry(const sstables::sstable& sst) const;
 
@@ -71,6 +95,7 @@ public:
 
 protected:
     virtual void log_large_row(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const = 0;
+    virtual void log_large_write(const schema& s, const frozen_mutation& m, uint64_t size) const = 0;
     virtual future<> update_large_partitions(const schema& s, const sstring& sstable_name, const sstables::key& partition_key, uint64_t partition_size) const = 0;
     virtual future<> delete_large_partitions_entry(const schema& s, const sstring& sstable_name) const = 0;
 };
@@ -87,6 +112,7 @@ protected:
     virtual future<> update_large_partitions(const schema& s, const sstring& sstable_name, const sstables::key& partition_key, uint64_t partition_size) const override;
     virtual future<> delete_large_partitions_entry(const schema& s, const sstring& sstable_name) const override;
     virtual void log_large_row(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const override;
+    virtual void log_large_write(const schema& s, const frozen_mutation& m, uint64_t size) const override;
 };
 
 class nop_large_data_handler : public large_data_handler {
@@ -103,6 +129,8 @@ public:
 
     virtual void log_large_row(const sstables::sstable& sst, const sstables::key& partition_key,
                                const clustering_key_prefix* clustering_key, uint64_t row_size) const override {}
+
+    virtual void log_large_write(const schema& s, const frozen_mutation& m, uint64_t size) const override {}
 };
 
 }
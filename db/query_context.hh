@@ -42,6 +42,11 @@ struct query_context {
     future<::shared_ptr<cql3::untyped_result_set>> execute_cql(sstring req, Args&&... args) {
         return this->_qp.local().execute_internal(req, { data_value(std::forward<Args>(args))... });
     }
+
+    template <typename... Args>
+    future<::shared_ptr<cql3::untyped_result_set>> execute_cql(cql3::query_processor::internal_statement& stmt, Args&&... args) {
+        return this->_qp.local().execute_internal(stmt, { data_value(std::forward<Args>(args))... });
+    }
     database& db() {
         return _db.local();
     }
@@ -69,4 +74,12 @@ static future<::shared_ptr<cql3::untyped_result_set>> execute_cql(sstring text,
     return qctx->execute_cql(text, std::forward<Args>(args)...);
 }
 
+// Overload for recurring internal queries which keep their statement handle
+// in a static thread_local at the call site.
+template <typename... Args>
+static future<::shared_ptr<cql3::untyped_result_set>> execute_cql(cql3::query_processor::internal_statement& stmt, Args&&... args) {
+    assert(qctx);
+    return qctx->execute_cql(stmt, std::forward<Args>(args)...);
+}
+
 }
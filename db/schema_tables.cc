@@ -790,15 +790,24 @@ static
 std::map<utils::UUID, schema_mutations>
 read_tables_for_keyspaces(distributed<service::storage_proxy>& proxy, const std::set<sstring>& keyspace_names, schema_ptr s)
 {
+    // Issue the reads for all keyspaces and all their tables in parallel;
+    // a schema merge reads every affected table twice (before and after
+    // applying the mutations), so doing them one by one dominates merge
+    // time once there are many tables. Single shard, so concurrent
+    // emplaces into the result map need no synchronization.
     std::map<utils::UUID, schema_mutations> result;
-    for (auto&& keyspace_name : keyspace_names) {
-        for (auto&& table_name : read_table_names_of_keyspace(proxy, keyspace_name, s).get0()) {
-            auto qn = qualified_name(keyspace_name, table_name);
-            auto muts = read_table_mutations(proxy, qn, s).get0();
-            auto id = table_id_from_mutations(muts);
-            result.emplace(std::move(id), std::move(muts));
-        }
-    }
+    parallel_for_each(keyspace_names, [&proxy, s, &result] (const sstring& keyspace_name) {
+        return read_table_names_of_keyspace(proxy, keyspace_name, s).then([&proxy, s, &result, &keyspace_name] (std::vector<sstring> table_names) {
+            return parallel_for_each(std::move(table_names), [&proxy, s, &result, &keyspace_name] (const sstring& table_name) {
+                return do_with(qualified_name(keyspace_name, table_name), [&proxy, s, &result] (const qualified_name& qn) {
+                    return read_table_mutations(proxy, qn, s).then([&result] (schema_mutations muts) {
+                        auto id = table_id_from_mutations(muts);
+                        result.emplace(std::move(id), std::move(muts));
+                    });
+                });
+            });
+        });
+    }).get();
     return result;
 }
 
@@ -844,11 +853,15 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
            delete_schema_version(mutation);
        }
 
-       // current state of the schema
-       auto&& old_keyspaces = read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces).get0();
+       // current state of the schema. Start the keyspace and type reads
+       // first so they proceed while the (parallelized, but thread-blocking)
+       // table and view reads run.
+       auto old_keyspaces_fut = read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces);
+       auto old_types_fut = read_schema_for_keyspaces(proxy, TYPES, keyspaces);
        auto&& old_column_families = read_tables_for_keyspaces(proxy, keyspaces, tables());
-       auto&& old_types = read_schema_for_keyspaces(proxy, TYPES, keyspaces).get0();
        auto&& old_views = read_tables_for_keyspaces(proxy, keyspaces, views());
+       auto&& old_keyspaces = old_keyspaces_fut.get0();
+       auto&& old_types = old_types_fut.get0();
 #if 0 // not in 2.1.8
        /*auto& old_functions = */read_schema_for_keyspaces(proxy, FUNCTIONS, keyspaces).get0();
        /*auto& old_aggregates = */read_schema_for_keyspaces(proxy, AGGREGATES, keyspaces).get0();
@@ -866,10 +879,12 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
        }
 
        // with new data applied
-       auto&& new_keyspaces = read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces).get0();
+       auto new_keyspaces_fut = read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces);
+       auto new_types_fut = read_schema_for_keyspaces(proxy, TYPES, keyspaces);
        auto&& new_column_families = read_tables_for_keyspaces(proxy, keyspaces, tables());
-       auto&& new_types = read_schema_for_keyspaces(proxy, TYPES, keyspaces).get0();
        auto&& new_views = read_tables_for_keyspaces(proxy, keyspaces, views());
+       auto&& new_keyspaces = new_keyspaces_fut.get0();
+       auto&& new_types = new_types_fut.get0();
 #if 0 // not in 2.1.8
        /*auto& new_functions = */read_schema_for_keyspaces(proxy, FUNCTIONS, keyspaces).get0();
        /*auto& new_aggregates = */read_schema_for_keyspaces(proxy, AGGREGATES, keyspaces).get0();
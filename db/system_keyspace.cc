@@ -479,6 +479,32 @@ schema_ptr size_estimates() {
     return large_partitions;
 }
 
+/*static*/ schema_ptr cache_warmup() {
+    static thread_local auto cache_warmup = [] {
+        schema_builder builder(make_lw_shared(schema(generate_legacy_id(NAME, CACHE_WARMUP), NAME, CACHE_WARMUP,
+        // partition key
+        {{"table_id", uuid_type}},
+        // clustering key
+        {
+            {"shard", int32_type},
+            {"partition_key", bytes_type}
+        },
+        // regular columns
+        {},
+        // static columns
+        {},
+        // regular column name type
+        utf8_type,
+        // comment
+        "partition keys recently held in cache, for cache warming after restart"
+        )));
+        builder.set_gc_grace_seconds(0);
+        builder.with_version(generate_schema_version(builder.uuid()));
+        return builder.build(schema_builder::compact_storage::no);
+    }();
+    return cache_warmup;
+}
+
 namespace v3 {
 
 schema_ptr batches() {
@@ -1186,6 +1212,31 @@ future<> remove_truncation_record(utils::UUID id) {
     });
 }
 
+future<> save_cache_summary(utils::UUID table_id, std::vector<bytes> keys) {
+    sstring del = format("DELETE FROM system.{} WHERE table_id = ? AND shard = ?", CACHE_WARMUP);
+    auto shard = int32_t(engine().cpu_id());
+    return qctx->qp().execute_internal(del, {table_id, shard}).discard_result().then([table_id, shard, keys = std::move(keys)] () mutable {
+        return do_with(std::move(keys), [table_id, shard] (std::vector<bytes>& keys) {
+            sstring ins = format("INSERT INTO system.{} (table_id, shard, partition_key) VALUES (?, ?, ?)", CACHE_WARMUP);
+            return do_for_each(keys, [table_id, shard, ins = std::move(ins)] (bytes& key) {
+                return qctx->qp().execute_internal(ins, {table_id, shard, data_value(key)}).discard_result();
+            });
+        });
+    });
+}
+
+future<std::vector<bytes>> load_cache_summary(utils::UUID table_id) {
+    sstring req = format("SELECT partition_key FROM system.{} WHERE table_id = ?", CACHE_WARMUP);
+    return qctx->qp().execute_internal(req, {table_id}).then([] (::shared_ptr<cql3::untyped_result_set> rs) {
+        std::vector<bytes> keys;
+        keys.reserve(rs->size());
+        for (const cql3::untyped_result_set_row& row : *rs) {
+            keys.push_back(row.get_blob("partition_key"));
+        }
+        return keys;
+    });
+}
+
 static future<truncation_record> get_truncation_record(utils::UUID cf_id) {
     sstring req = format("SELECT * from system.{} WHERE table_uuid = ?", TRUNCATED);
     return qctx->qp().execute_internal(req, {cf_id}).then([cf_id](::shared_ptr<cql3::untyped_result_set> rs) {
@@ -1539,8 +1590,9 @@ template future<> update_peer_info<net::ipv4_address>(gms::inet_address ep, sstr
 
 future<> update_hints_dropped(gms::inet_address ep, utils::UUID time_period, int value) {
     // with 30 day TTL
-    sstring req = format("UPDATE system.{} USING TTL 2592000 SET hints_dropped[ ? ] = ? WHERE peer = ?", PEER_EVENTS);
-    return execute_cql(req, time_period, value, ep.addr()).discard_result();
+    static thread_local cql3::query_processor::internal_statement stmt{
+            format("UPDATE system.{} USING TTL 2592000 SET hints_dropped[ ? ] = ? WHERE peer = ?", PEER_EVENTS)};
+    return execute_cql(stmt, time_period, value, ep.addr()).discard_result();
 }
 
 future<> update_schema_version(utils::UUID version) {
@@ -1672,7 +1724,7 @@ std::vector<schema_ptr> all_tables() {
     r.insert(r.end(), { built_indexes(), hints(), batchlog(), paxos(), local(),
                     peers(), peer_events(), range_xfers(),
                     compactions_in_progress(), compaction_history(),
-                    sstable_activity(), size_estimates(), large_partitions(), v3::views_builds_in_progress(), v3::built_views(),
+                    sstable_activity(), size_estimates(), large_partitions(), cache_warmup(), v3::views_builds_in_progress(), v3::built_views(),
                     v3::scylla_views_builds_in_progress(),
                     v3::truncated(),
     });
@@ -1849,10 +1901,11 @@ future<> update_compaction_history(sstring ksname, sstring cfname, int64_t compa
 
     auto map_type = map_type_impl::get_instance(int32_type, long_type, true);
 
-    sstring req = format("INSERT INTO system.{} (id, keyspace_name, columnfamily_name, compacted_at, bytes_in, bytes_out, rows_merged) VALUES (?, ?, ?, ?, ?, ?, ?)"
-                    , COMPACTION_HISTORY);
+    static thread_local cql3::query_processor::internal_statement stmt{
+            format("INSERT INTO system.{} (id, keyspace_name, columnfamily_name, compacted_at, bytes_in, bytes_out, rows_merged) VALUES (?, ?, ?, ?, ?, ?, ?)"
+                    , COMPACTION_HISTORY)};
 
-    return execute_cql(req, utils::UUID_gen::get_time_UUID(), ksname, cfname, compacted_at, bytes_in, bytes_out,
+    return execute_cql(stmt, utils::UUID_gen::get_time_UUID(), ksname, cfname, compacted_at, bytes_in, bytes_out,
                        make_map_value(map_type, prepare_rows_merged(rows_merged))).discard_result().handle_exception([] (auto ep) {
         slogger.error("update compaction history failed: {}: ignored", ep);
     });
@@ -1927,10 +1980,11 @@ mutation make_size_estimates_mutation(const sstring& ks, std::vector<range_estim
 }
 
 future<> register_view_for_building(sstring ks_name, sstring view_name, const dht::token& token) {
-    sstring req = format("INSERT INTO system.{} (keyspace_name, view_name, generation_number, cpu_id, first_token) VALUES (?, ?, ?, ?, ?)",
-            v3::SCYLLA_VIEWS_BUILDS_IN_PROGRESS);
+    static thread_local cql3::query_processor::internal_statement stmt{
+            format("INSERT INTO system.{} (keyspace_name, view_name, generation_number, cpu_id, first_token) VALUES (?, ?, ?, ?, ?)",
+                    v3::SCYLLA_VIEWS_BUILDS_IN_PROGRESS)};
     return execute_cql(
-            std::move(req),
+            stmt,
             std::move(ks_name),
             std::move(view_name),
             0,
@@ -1939,10 +1993,11 @@ future<> register_view_for_building(sstring ks_name, sstring view_name, const dh
 }
 
 future<> update_view_build_progress(sstring ks_name, sstring view_name, const dht::token& token) {
-    sstring req = format("INSERT INTO system.{} (keyspace_name, view_name, next_token, cpu_id) VALUES (?, ?, ?, ?)",
-            v3::SCYLLA_VIEWS_BUILDS_IN_PROGRESS);
+    static thread_local cql3::query_processor::internal_statement stmt{
+            format("INSERT INTO system.{} (keyspace_name, view_name, next_token, cpu_id) VALUES (?, ?, ?, ?)",
+                    v3::SCYLLA_VIEWS_BUILDS_IN_PROGRESS)};
     return execute_cql(
-            std::move(req),
+            stmt,
             std::move(ks_name),
             std::move(view_name),
             dht::global_partitioner().to_sstring(token),
@@ -1957,8 +2012,10 @@ future<> remove_view_build_progress_across_all_shards(sstring ks_name, sstring v
 }
 
 future<> remove_view_build_progress(sstring ks_name, sstring view_name) {
+    static thread_local cql3::query_processor::internal_statement stmt{
+            format("DELETE FROM system.{} WHERE keyspace_name = ? AND view_name = ? AND cpu_id = ?", v3::SCYLLA_VIEWS_BUILDS_IN_PROGRESS)};
     return execute_cql(
-            format("DELETE FROM system.{} WHERE keyspace_name = ? AND view_name = ? AND cpu_id = ?", v3::SCYLLA_VIEWS_BUILDS_IN_PROGRESS),
+            stmt,
             std::move(ks_name),
             std::move(view_name),
             int32_t(engine().cpu_id())).discard_result();
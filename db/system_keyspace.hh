@@ -88,6 +88,7 @@ static constexpr auto COMPACTION_HISTORY = "compaction_history";
 static constexpr auto SSTABLE_ACTIVITY = "sstable_activity";
 static constexpr auto SIZE_ESTIMATES = "size_estimates";
 static constexpr auto LARGE_PARTITIONS = "large_partitions";
+static constexpr auto CACHE_WARMUP = "cache_warmup";
 
 namespace v3 {
 static constexpr auto BATCHES = "batches";
@@ -383,6 +384,14 @@ enum class bootstrap_state {
     future<db::replay_position> get_truncated_position(utils::UUID, uint32_t shard);
     future<db_clock::time_point> get_truncated_at(utils::UUID);
 
+    // Replaces the calling shard's persisted cache summary for the given
+    // table with the given serialized partition keys.
+    future<> save_cache_summary(utils::UUID table_id, std::vector<bytes> keys);
+    // Loads the persisted cache summary for the given table, from all
+    // shards; the caller filters by current shard ownership, which may have
+    // changed since the summary was written.
+    future<std::vector<bytes>> load_cache_summary(utils::UUID table_id);
+
 #if 0
 
     /**
@@ -152,14 +152,23 @@ namespace db {
 
 namespace view {
 
+// The view filter restrictions are evaluated against the base row itself and
+// never reference bind variables, so a single empty set of options serves all
+// of them. Constructing query_options is not free and the filter runs for
+// every (base row, view) pair on the write path, so share one instance.
+static const cql3::query_options& internal_query_options() {
+    static thread_local const cql3::query_options opts({ });
+    return opts;
+}
+
 bool partition_key_matches(const schema& base, const view_info& view, const dht::decorated_key& key) {
     return view.select_statement().get_restrictions()->get_partition_key_restrictions()->is_satisfied_by(
-            base, key.key(), clustering_key_prefix::make_empty(), row(), cql3::query_options({ }), gc_clock::now());
+            base, key.key(), clustering_key_prefix::make_empty(), row(), internal_query_options(), gc_clock::now());
 }
 
 bool clustering_prefix_matches(const schema& base, const view_info& view, const partition_key& key, const clustering_key_prefix& ck) {
     return view.select_statement().get_restrictions()->get_clustering_columns_restrictions()->is_satisfied_by(
-            base, key, ck, row(), cql3::query_options({ }), gc_clock::now());
+            base, key, ck, row(), internal_query_options(), gc_clock::now());
 }
 
 bool may_be_affected_by(const schema& base, const view_info& view, const dht::decorated_key& key, const rows_entry& update) {
@@ -185,17 +194,16 @@ static bool update_requires_read_before_write(const schema& base,
 
 static bool is_partition_key_empty(
         const schema& base,
-        const schema& view_schema,
+        const column_definition* base_col,
         const partition_key& base_key,
         const clustering_row& update) {
     // Empty partition keys are not supported on normal tables - they cannot
     // be inserted or queried, so enforce those rules here.
-    if (view_schema.partition_key_columns().size() > 1) {
+    if (!base_col) {
         // Composite partition keys are different: all components
         // are then allowed to be empty.
         return false;
     }
-    auto* base_col = base.get_column_definition(view_schema.partition_key_columns().front().name());
     switch (base_col->kind) {
     case column_kind::partition_key:
         return base_key.get_component(base, base_col->position()).empty();
@@ -213,7 +221,7 @@ bool matches_view_filter(const schema& base, const view_info& view, const partit
             && boost::algorithm::all_of(
                 view.select_statement().get_restrictions()->get_non_pk_restriction() | boost::adaptors::map_values,
                 [&] (auto&& r) {
-                    return r->is_satisfied_by(base, key, update.key(), update.cells(), cql3::query_options({ }), now);
+                    return r->is_satisfied_by(base, key, update.key(), update.cells(), internal_query_options(), now);
                 });
 }
 
@@ -221,6 +229,11 @@ class view_updates final {
     view_ptr _view;
     const view_info& _view_info;
     schema_ptr _base;
+    // The base column making up the view's single-component partition key,
+    // cached since the empty-key check runs for every base row. Remains
+    // nullptr for composite view partition keys, whose components are all
+    // allowed to be empty.
+    const column_definition* _base_col_for_view_pk = nullptr;
     std::unordered_map<partition_key, mutation_partition, partition_key::hashing, partition_key::equality> _updates;
 public:
     explicit view_updates(view_ptr view, schema_ptr base)
@@ -228,6 +241,9 @@ public:
             , _view_info(*_view->view_info())
             , _base(std::move(base))
             , _updates(8, partition_key::hashing(*_view), partition_key::equality(*_view)) {
+        if (_view->partition_key_columns().size() == 1) {
+            _base_col_for_view_pk = _base->get_column_definition(_view->partition_key_columns().front().name());
+        }
     }
 
     void move_to(std::vector<frozen_mutation_and_schema>& mutations) && {
@@ -475,7 +491,7 @@ static void add_cells_to_view(const schema& base, const schema& view, row base_c
  * This method checks that the base row does match the view filter before applying anything.
  */
 void view_updates::create_entry(const partition_key& base_key, const clustering_row& update, gc_clock::time_point now) {
-    if (is_partition_key_empty(*_base, *_view, base_key, update) || !matches_view_filter(*_base, _view_info, base_key, update, now)) {
+    if (is_partition_key_empty(*_base, _base_col_for_view_pk, base_key, update) || !matches_view_filter(*_base, _view_info, base_key, update, now)) {
         return;
     }
     deletable_row& r = get_view_row(base_key, update);
@@ -492,7 +508,7 @@ void view_updates::create_entry(const partition_key& base_key, const clustering_
 void view_updates::delete_old_entry(const partition_key& base_key, const clustering_row& existing, const clustering_row& update, gc_clock::time_point now) {
     // Before deleting an old entry, make sure it was matching the view filter
     // (otherwise there is nothing to delete)
-    if (!is_partition_key_empty(*_base, *_view, base_key, existing) && matches_view_filter(*_base, _view_info, base_key, existing, now)) {
+    if (!is_partition_key_empty(*_base, _base_col_for_view_pk, base_key, existing) && matches_view_filter(*_base, _view_info, base_key, existing, now)) {
         do_delete_old_entry(base_key, existing, update, now);
     }
 }
@@ -531,11 +547,11 @@ void view_updates::do_delete_old_entry(const partition_key& base_key, const clus
 void view_updates::update_entry(const partition_key& base_key, const clustering_row& update, const clustering_row& existing, gc_clock::time_point now) {
     // While we know update and existing correspond to the same view entry,
     // they may not match the view filter.
-    if (is_partition_key_empty(*_base, *_view, base_key, existing) || !matches_view_filter(*_base, _view_info, base_key, existing, now)) {
+    if (is_partition_key_empty(*_base, _base_col_for_view_pk, base_key, existing) || !matches_view_filter(*_base, _view_info, base_key, existing, now)) {
         create_entry(base_key, update, now);
         return;
     }
-    if (is_partition_key_empty(*_base, *_view, base_key, update) || !matches_view_filter(*_base, _view_info, base_key, update, now)) {
+    if (is_partition_key_empty(*_base, _base_col_for_view_pk, base_key, update) || !matches_view_filter(*_base, _view_info, base_key, update, now)) {
         do_delete_old_entry(base_key, existing, update, now);
         return;
     }
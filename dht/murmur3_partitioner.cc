@@ -100,6 +100,35 @@ murmur3_partitioner::get_token(const schema& s, partition_key_view key) {
     return get_token(hash[0]);
 }
 
+std::vector<decorated_key>
+murmur3_partitioner::decorate_keys(const schema& s, std::vector<partition_key> keys) {
+    std::vector<decorated_key> ret;
+    ret.reserve(keys.size());
+
+    // Hash four keys at a time; see hash3_x64_128_batch(). The legacy forms
+    // are synthesized views, so linearize them into reusable buffers first.
+    std::array<bytes, 4> bufs;
+    std::array<bytes_view, 4> views;
+    size_t i = 0;
+    for (; i + 4 <= keys.size(); i += 4) {
+        for (size_t lane = 0; lane < 4; lane++) {
+            auto&& legacy = keys[i + lane].legacy_form(s);
+            bufs[lane] = bytes(bytes::initialized_later(), legacy.size());
+            std::copy(legacy.begin(), legacy.end(), bufs[lane].begin());
+            views[lane] = bufs[lane];
+        }
+        std::array<std::array<uint64_t, 2>, 4> hashes;
+        utils::murmur_hash::hash3_x64_128_batch(views, 0, hashes);
+        for (size_t lane = 0; lane < 4; lane++) {
+            ret.emplace_back(get_token(hashes[lane][0]), std::move(keys[i + lane]));
+        }
+    }
+    for (; i < keys.size(); i++) {
+        ret.push_back(decorate_key(s, std::move(keys[i])));
+    }
+    return ret;
+}
+
 token murmur3_partitioner::get_random_token() {
     auto rand = dht::get_random_number<uint64_t>();
     return get_token(rand);
@@ -243,6 +272,16 @@ murmur3_partitioner::get_token_validator() {
     return long_type;
 }
 
+// The token->shard mapping below is a static function of the shard count
+// and the ignore-msb setting, and the whole node relies on that: commitlog
+// segments, memtables, sstable ownership, the row cache and the querier
+// cache are all shard-private and populated under the assumption that a
+// token is only ever served by this one shard. Serving a hot sub-range
+// from several shards at once would need replicated or shared versions of
+// all that state, so a skewed workload pinning one shard cannot be spread
+// out here; it can only be diluted across nodes (see speculative retry and
+// cache-hit-rate read balancing) or diagnosed with the toppartitions
+// sampler (db/data_listeners.hh).
 unsigned
 murmur3_partitioner::shard_of(const token& t) const {
     switch (t._kind) {
@@ -56,6 +56,17 @@ logging::logger logger("range_streamer");
 
 using inet_address = gms::inet_address;
 
+range_streamer::range_streamer(distributed<database>& db, token_metadata& tm, std::unordered_set<token> tokens, inet_address address, sstring description, streaming::stream_reason reason)
+    : _db(db)
+    , _metadata(tm)
+    , _tokens(std::move(tokens))
+    , _address(address)
+    , _description(std::move(description))
+    , _reason(reason)
+    , _stream_plan(_description)
+    , _limiter(db.local().get_config().range_streamer_nodes_in_parallel()) {
+}
+
 std::unordered_map<inet_address, dht::token_range_vector>
 range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, std::vector<inet_address>>& ranges_with_sources,
                                     const std::unordered_set<std::unique_ptr<i_source_filter>>& source_filters,
@@ -300,7 +311,11 @@ future<> range_streamer::do_stream_async() {
                 unsigned sp_index = 0;
                 unsigned nr_ranges_streamed = 0;
                 size_t nr_ranges_total = range_vec.size();
-                size_t nr_ranges_per_stream_plan = nr_ranges_total / 10;
+                // Ranges of already executed stream plans are dropped from
+                // range_vec, so when stream_async() retries after a failure
+                // only the remaining ranges are streamed again. Smaller
+                // plans thus lose less work to an interruption.
+                size_t nr_ranges_per_stream_plan = nr_ranges_total * _db.local().get_config().range_streamer_ranges_percentage() / 100;
                 dht::token_range_vector ranges_to_stream;
                 auto do_streaming = [&] {
                     auto sp = stream_plan(format("{}-{}-index-{:d}", description, keyspace, sp_index++), _reason);
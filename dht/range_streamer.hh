@@ -102,15 +102,7 @@ public:
         }
     };
 
-    range_streamer(distributed<database>& db, token_metadata& tm, std::unordered_set<token> tokens, inet_address address, sstring description, streaming::stream_reason reason)
-        : _db(db)
-        , _metadata(tm)
-        , _tokens(std::move(tokens))
-        , _address(address)
-        , _description(std::move(description))
-        , _reason(reason)
-        , _stream_plan(_description) {
-    }
+    range_streamer(distributed<database>& db, token_metadata& tm, std::unordered_set<token> tokens, inet_address address, sstring description, streaming::stream_reason reason);
 
     range_streamer(distributed<database>& db, token_metadata& tm, inet_address address, sstring description, streaming::stream_reason reason)
         : range_streamer(db, tm, std::unordered_set<token>(), address, description, reason) {
@@ -179,7 +171,8 @@ private:
     unsigned _nr_tx_added = 0;
     unsigned _nr_rx_added = 0;
     // Limit the number of nodes to stream in parallel to reduce memory pressure with large cluster.
-    seastar::semaphore _limiter{16};
+    // Initialized from the range_streamer_nodes_in_parallel config option.
+    seastar::semaphore _limiter;
 };
 
 } // dht
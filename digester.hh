@@ -36,7 +36,7 @@ struct noop_hasher {
 };
 
 class digester final {
-    std::variant<noop_hasher, md5_hasher, xx_hasher> _impl;
+    std::variant<noop_hasher, md5_hasher, xx_hasher_wide> _impl;
 
 public:
     explicit digester(digest_algorithm algo) {
@@ -45,7 +45,10 @@ public:
             _impl = md5_hasher();
             break;
         case digest_algorithm::xxHash:
-            _impl = xx_hasher();
+            // Produces the same digest as xx_hasher, only with the updates
+            // staged in larger chunks, so it can be swapped in without a
+            // cluster feature.
+            _impl = xx_hasher_wide();
             break;
         case digest_algorithm ::none:
             _impl = noop_hasher();
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/intrusive/parent_from_member.hpp>
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/future.hh>
@@ -71,6 +72,35 @@ public:
     future<flush_permit> reacquire_sstable_write_permit() &&;
 };
 
+// Ties several dirty_memory_managers together under one shared limit for
+// their combined dirty memory, layered on top of each manager's own quota.
+// Memory accounted in a member manager's region groups also counts against
+// the shared limit, so a write source which is within its own quota is still
+// throttled when the combined total grows too high. When the shared soft
+// limit is crossed, all member managers are asked to flush, so that the
+// pressure is relieved by whichever managers hold the most dirty memory.
+class dirty_memory_manager_group : public logalloc::region_group_reclaimer {
+    std::vector<dirty_memory_manager*> _managers;
+    logalloc::region_group _region_group;
+
+    virtual void start_reclaiming() noexcept override;
+public:
+    dirty_memory_manager_group(size_t threshold, double soft_limit, scheduling_group deferred_work_sg)
+        : logalloc::region_group_reclaimer(threshold, threshold * soft_limit)
+        , _region_group(*this, deferred_work_sg) {
+    }
+
+    size_t total_dirty_memory() const {
+        return _region_group.memory_used();
+    }
+
+    future<> shutdown() {
+        return _region_group.shutdown();
+    }
+
+    friend class dirty_memory_manager;
+};
+
 class dirty_memory_manager: public logalloc::region_group_reclaimer {
     logalloc::region_group_reclaimer _real_dirty_reclaimer;
     // We need a separate boolean, because from the LSA point of view, pressure may still be
@@ -78,6 +108,9 @@ class dirty_memory_manager: public logalloc::region_group_reclaimer {
     bool _db_shutdown_requested = false;
 
     database* _db;
+    // The group this manager is a member of, if any. Shared pressure makes
+    // this manager flush just like its own pressure does.
+    dirty_memory_manager_group* _group = nullptr;
     // The _real_region_group protects against actual dirty memory usage hitting the maximum. Usage
     // for this group is the real dirty memory usage of the system.
     logalloc::region_group _real_region_group;
@@ -108,7 +141,7 @@ class dirty_memory_manager: public logalloc::region_group_reclaimer {
     virtual void start_reclaiming() noexcept override;
 
     bool has_pressure() const {
-        return over_soft_limit();
+        return over_soft_limit() || (_group && _group->over_soft_limit());
     }
 
     unsigned _extraneous_flushes = 0;
@@ -151,14 +184,24 @@ public:
     //
     // We then set the soft limit to 80 % of the virtual dirty hard limit, which is equal to 40 % of
     // the user-supplied threshold.
-    dirty_memory_manager(database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg)
+    //
+    // When a group is supplied, the real dirty memory of this manager also
+    // counts against the group's shared limit, in addition to this manager's
+    // own threshold.
+    dirty_memory_manager(database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg,
+            dirty_memory_manager_group* group = nullptr)
         : logalloc::region_group_reclaimer(threshold / 2, threshold * soft_limit / 2)
         , _real_dirty_reclaimer(threshold)
         , _db(&db)
-        , _real_region_group(_real_dirty_reclaimer, deferred_work_sg)
+        , _group(group)
+        , _real_region_group(group ? &group->_region_group : nullptr, _real_dirty_reclaimer, deferred_work_sg)
         , _virtual_region_group(&_real_region_group, *this, deferred_work_sg)
         , _flush_serializer(1)
-        , _waiting_flush(flush_when_needed()) {}
+        , _waiting_flush(flush_when_needed()) {
+        if (_group) {
+            _group->_managers.push_back(this);
+        }
+    }
 
     dirty_memory_manager() : logalloc::region_group_reclaimer()
         , _db(nullptr)
@@ -167,6 +210,19 @@ public:
         , _flush_serializer(1)
         , _waiting_flush(make_ready_future<>()) {}
 
+    ~dirty_memory_manager() {
+        if (_group) {
+            auto& ms = _group->_managers;
+            ms.erase(std::remove(ms.begin(), ms.end(), this), ms.end());
+        }
+    }
+
+    // Called by the dirty_memory_manager_group this manager is a member of
+    // when the shared soft limit is crossed.
+    void notify_group_pressure() noexcept {
+        _should_flush.signal();
+    }
+
     static dirty_memory_manager& from_region_group(logalloc::region_group *rg) {
         return *(boost::intrusive::get_parent_from_member(rg, &dirty_memory_manager::_virtual_region_group));
     }
@@ -209,6 +265,18 @@ public:
 
     future<> flush_one(memtable_list& cf, flush_permit&& permit);
 
+    // Group flush for deployments with many small tables. Picks the
+    // commitlog segment which has been pinned dirty the longest, and
+    // initiates flushes for all memtables pinning it in one decision, so
+    // the segment can actually be recycled; with the largest-memtable rule
+    // each decision flushes one tiny memtable and the segment stays pinned
+    // until the last of its tables happens to come up. The first flush
+    // consumes the given permit, the others go through the regular
+    // coalescing flush request and serialize on the write permit behind it.
+    // Falls back to flushing the fallback memtable when no memtable holds
+    // commitlog replay state (e.g. commitlog disabled).
+    void flush_group_by_commitlog_retention(memtable& fallback, flush_permit&& permit);
+
     future<flush_permit> get_flush_permit() {
         return get_units(_background_work_flush_serializer, 1).then([this] (auto&& units) {
             return this->get_flush_permit(std::move(units));
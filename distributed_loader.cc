@@ -35,7 +35,12 @@
 #include "tracing/trace_keyspace_helper.hh"
 #include "db/view/view_update_checks.hh"
 #include <unordered_map>
+#include <algorithm>
+#include <cmath>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/algorithm/sort.hpp>
+#include <boost/range/irange.hpp>
+#include <boost/range/numeric.hpp>
 #include "db/view/view_update_generator.hh"
 
 extern logging::logger dblog;
@@ -290,9 +295,54 @@ future<> distributed_loader::open_sstable(distributed<database>& db, sstables::e
     });
 }
 
+// Returns the current compaction backlog of every shard, as seen by each
+// shard's backlog controller.
+static future<std::vector<double>> get_all_shards_compaction_backlog(distributed<database>& db, global_column_family_ptr cf) {
+    return do_with(std::vector<double>(smp::count), [&db, cf] (std::vector<double>& backlogs) {
+        return parallel_for_each(boost::irange(0u, smp::count), [&db, cf, &backlogs] (unsigned shard) {
+            return db.invoke_on(shard, [cf] (database& db) {
+                auto b = cf->get_compaction_manager().backlog();
+                // A disabled backlog controller reports infinity; treat it as
+                // no information rather than an infinitely loaded shard.
+                return std::isfinite(b) ? double(b) : 0.0;
+            }).then([&backlogs, shard] (double b) {
+                backlogs[shard] = b;
+            });
+        }).then([&backlogs] {
+            return make_ready_future<std::vector<double>>(std::move(backlogs));
+        });
+    });
+}
+
+// The strategy assigns reshard_at in a round-robin fashion, blind to how busy
+// each shard already is, so after an unbalanced load one shard can queue a deep
+// pile of work while others idle. Reassign the jobs, biggest first, each to the
+// shard with the least load - its compaction backlog plus the input bytes of
+// the jobs placed on it here. The jobs are self-contained (input sstables are
+// forwarded to the target shard and outputs collected by the caller), and the
+// resharding backlog tracker registers with the compaction manager of the
+// shard running the job, so borrowed capacity shows up in the backlog
+// controller of the shard lending it.
+static void place_resharding_jobs(std::vector<sstables::resharding_descriptor>& jobs, std::vector<double> backlogs) {
+    auto job_size = [] (const sstables::resharding_descriptor& job) {
+        return boost::accumulate(job.sstables | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::bytes_on_disk)), uint64_t(0));
+    };
+    boost::sort(jobs, [&] (const sstables::resharding_descriptor& a, const sstables::resharding_descriptor& b) {
+        return job_size(a) > job_size(b);
+    });
+    for (auto& job : jobs) {
+        auto target = std::min_element(backlogs.begin(), backlogs.end()) - backlogs.begin();
+        job.reshard_at = target;
+        backlogs[target] += job_size(job);
+    }
+}
+
 // invokes each descriptor at its target shard, which involves forwarding sstables too.
-static future<> invoke_all_resharding_jobs(global_column_family_ptr cf, sstring directory, std::vector<sstables::resharding_descriptor> jobs,
+static future<> invoke_all_resharding_jobs(distributed<database>& db, global_column_family_ptr cf, sstring directory,
+        std::vector<sstables::resharding_descriptor> jobs,
         std::function<future<> (std::vector<sstables::shared_sstable>, uint32_t level, uint64_t max_sstable_bytes)> func) {
+    auto backlogs = get_all_shards_compaction_backlog(db, cf).get0();
+    place_resharding_jobs(jobs, std::move(backlogs));
     return parallel_for_each(std::move(jobs), [cf, func, &directory] (sstables::resharding_descriptor& job) mutable {
         return forward_sstables_to(job.reshard_at, directory, std::move(job.sstables), cf,
                 [cf, func, level = job.level, max_sstable_bytes = job.max_sstable_bytes] (auto sstables) {
@@ -316,12 +366,20 @@ static std::vector<sstables::shared_sstable> sstables_for_shard(const std::vecto
 }
 
 static future<> populate(distributed<database>& db, sstring datadir) {
-    return lister::scan_dir(datadir, { directory_entry_type::directory }, [&db] (fs::path datadir, directory_entry de) {
-        auto& ks_name = de.name;
-        if (is_system_keyspace(ks_name)) {
+    return do_with(std::vector<future<>>(), [&db, datadir] (std::vector<future<>>& futures) {
+        return lister::scan_dir(datadir, { directory_entry_type::directory }, [&db, &futures] (fs::path datadir, directory_entry de) {
+            auto& ks_name = de.name;
+            if (is_system_keyspace(ks_name)) {
+                return make_ready_future<>();
+            }
+            // Populate keyspaces in parallel rather than one at a time;
+            // per-sstable load concurrency is bounded by
+            // sstable_load_concurrency_sem() on each shard.
+            futures.push_back(distributed_loader::populate_keyspace(db, datadir.native(), ks_name));
             return make_ready_future<>();
-        }
-        return distributed_loader::populate_keyspace(db, datadir.native(), ks_name);
+        }).then([&futures] {
+            return when_all_succeed(futures.begin(), futures.end());
+        });
     });
 }
 
@@ -353,7 +411,7 @@ void distributed_loader::reshard(distributed<database>& db, sstring ks_name, sst
                 auto jobs = cf->get_compaction_strategy().get_resharding_jobs(*cf, std::move(candidates));
                 dblog.debug("{} resharding jobs for {}.{}", jobs.size(), cf->schema()->ks_name(), cf->schema()->cf_name());
 
-                return invoke_all_resharding_jobs(cf, directory, std::move(jobs), [directory, &cf] (auto sstables, auto level, auto max_sstable_bytes) {
+                return invoke_all_resharding_jobs(db, cf, directory, std::move(jobs), [directory, &cf] (auto sstables, auto level, auto max_sstable_bytes) {
                     auto creator = [&cf, directory] (shard_id shard) mutable {
                         // we need generation calculated by instance of cf at requested shard,
                         // or resource usage wouldn't be fairly distributed among shards.
@@ -559,6 +617,11 @@ future<> distributed_loader::populate_column_family(distributed<database>& db, s
                         entry.format, component_type::TemporaryStatistics));
                 }
 
+                if (entry.component == component_type::TemporarySummary) {
+                    return remove_file(sstables::sstable::filename(sstdir.native(), entry.ks, entry.cf, entry.version, entry.generation,
+                        entry.format, component_type::TemporarySummary));
+                }
+
                 if (verifier->count(entry.generation)) {
                     if (verifier->at(entry.generation).status == component_status::has_toc_file) {
                         fs::path file_path(sstdir / de.name);
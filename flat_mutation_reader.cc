@@ -332,6 +332,55 @@ flat_mutation_reader make_nonforwardable(flat_mutation_reader r, bool single_par
     return make_flat_mutation_reader<reader>(std::move(r), single_partition);
 }
 
+flat_mutation_reader make_prefetching_reader(flat_mutation_reader r) {
+    class reader : public flat_mutation_reader::impl {
+        // The background fill continuation keeps the underlying reader alive
+        // through this shared pointer, so it is safe to destroy this reader
+        // while a fill is still in flight.
+        lw_shared_ptr<flat_mutation_reader> _underlying;
+        std::optional<future<>> _fill;
+
+        void maybe_prefetch(db::timeout_clock::time_point timeout) {
+            if (!_fill && !_underlying->is_end_of_stream()) {
+                _fill = _underlying->fill_buffer(timeout).then([u = _underlying] {});
+            }
+        }
+    public:
+        explicit reader(flat_mutation_reader r)
+            : impl(r.schema())
+            , _underlying(make_lw_shared<flat_mutation_reader>(std::move(r)))
+        { }
+        virtual future<> fill_buffer(db::timeout_clock::time_point timeout) override {
+            maybe_prefetch(timeout);
+            auto fill = _fill ? std::move(*std::exchange(_fill, std::nullopt)) : make_ready_future<>();
+            return fill.then([this, timeout] {
+                while (!_underlying->is_buffer_empty()) {
+                    push_mutation_fragment(_underlying->pop_mutation_fragment());
+                }
+                _end_of_stream = _underlying->is_end_of_stream();
+                // Start producing the next batch before handing this one
+                // over to the consumer.
+                maybe_prefetch(timeout);
+            });
+        }
+        virtual void next_partition() override {
+            // Would have to synchronize with the pending background fill.
+            // This reader is only meant for consuming the whole stream.
+            throw std::bad_function_call();
+        }
+        virtual future<> fast_forward_to(const dht::partition_range&, db::timeout_clock::time_point timeout) override {
+            throw std::bad_function_call();
+        }
+        virtual future<> fast_forward_to(position_range, db::timeout_clock::time_point timeout) override {
+            throw std::bad_function_call();
+        }
+        virtual size_t buffer_size() const override {
+            return flat_mutation_reader::impl::buffer_size() + _underlying->buffer_size();
+        }
+    };
+    return make_flat_mutation_reader<reader>(std::move(r));
+}
+
 class empty_flat_reader final : public flat_mutation_reader::impl {
 public:
     empty_flat_reader(schema_ptr s) : impl(std::move(s)) { _end_of_stream = true; }
@@ -91,7 +91,11 @@ public:
         circular_buffer<mutation_fragment> _buffer;
         size_t _buffer_size = 0;
         bool _consume_done = false;
+        bool _last_fill_was_full = false;
+        bool _max_buffer_size_pinned = false;
     protected:
+        // Cap for adaptive growth, see fill_buffer_for_consumer().
+        static constexpr size_t max_adaptive_buffer_size_in_bytes = 128 * 1024;
         size_t max_buffer_size_in_bytes = 8 * 1024;
         bool _end_of_stream = false;
         schema_ptr _schema;
@@ -128,6 +132,23 @@ public:
         virtual future<> fill_buffer(db::timeout_clock::time_point) = 0;
         virtual void next_partition() = 0;
 
+        // Refills the buffer on behalf of a consumer which has drained it.
+        // A consumer which empties a full buffer and immediately asks for more
+        // is throughput-bound and benefits from fewer, larger fills, so each
+        // such fill doubles the buffer size, up to
+        // max_adaptive_buffer_size_in_bytes. Consumers which stop early -- in
+        // particular point reads satisfied by the first fill -- never trigger
+        // growth and stay at the initial size. Sizes set explicitly with
+        // set_max_buffer_size() are pinned and not adapted.
+        future<> fill_buffer_for_consumer(db::timeout_clock::time_point timeout) {
+            if (!_max_buffer_size_pinned && _last_fill_was_full && is_buffer_empty()) {
+                max_buffer_size_in_bytes = std::min(max_buffer_size_in_bytes * 2, max_adaptive_buffer_size_in_bytes);
+            }
+            return fill_buffer(timeout).then([this] {
+                _last_fill_was_full = is_buffer_full();
+            });
+        }
+
         bool is_end_of_stream() const { return _end_of_stream; }
         bool is_buffer_empty() const { return _buffer.empty(); }
         bool is_buffer_full() const { return _buffer_size >= max_buffer_size_in_bytes; }
@@ -150,7 +171,7 @@ public:
                 if (is_end_of_stream()) {
                     return make_ready_future<mutation_fragment_opt>();
                 }
-                return fill_buffer(timeout).then([this, timeout] { return operator()(timeout); });
+                return fill_buffer_for_consumer(timeout).then([this, timeout] { return operator()(timeout); });
             }
             return make_ready_future<mutation_fragment_opt>(pop_mutation_fragment());
         }
@@ -166,7 +187,7 @@ public:
             return do_until([this] { return (is_end_of_stream() && is_buffer_empty()) || _consume_done; },
                             [this, consumer = std::move(consumer), timeout] () mutable {
                 if (is_buffer_empty()) {
-                    return fill_buffer(timeout);
+                    return fill_buffer_for_consumer(timeout);
                 }
 
                 _consume_done = consumer(pop_mutation_fragment()) == stop_iteration::yes;
@@ -192,7 +213,7 @@ public:
                     if (is_end_of_stream()) {
                         return;
                     }
-                    fill_buffer(timeout).get();
+                    fill_buffer_for_consumer(timeout).get();
                     continue;
                 }
                 auto mf = pop_mutation_fragment();
@@ -388,7 +409,7 @@ public:
     // `operator()()` calls.
     void next_partition() { _impl->next_partition(); }
 
-    future<> fill_buffer(db::timeout_clock::time_point timeout) { return _impl->fill_buffer(timeout); }
+    future<> fill_buffer(db::timeout_clock::time_point timeout) { return _impl->fill_buffer_for_consumer(timeout); }
 
     // Changes the range of partitions to pr. The range can only be moved
     // forwards. pr.begin() needs to be larger than pr.end() of the previousl
@@ -431,6 +452,7 @@ public:
     const schema_ptr& schema() const { return _impl->_schema; }
     void set_max_buffer_size(size_t size) {
         _impl->max_buffer_size_in_bytes = size;
+        _impl->_max_buffer_size_pinned = true;
     }
     // Resolves with a pointer to the next fragment in the stream without consuming it from the stream,
     // or nullptr if there are no more fragments.
@@ -607,6 +629,13 @@ flat_mutation_reader make_forwardable(flat_mutation_reader m);
 
 flat_mutation_reader make_nonforwardable(flat_mutation_reader, bool);
 
+// Creates a reader which refills the underlying reader's buffer in the
+// background while the previously produced batch of fragments is being
+// consumed. This overlaps the cost of producing fragments with whatever the
+// consumer does in between, e.g. sstable I/O during a memtable flush.
+// The resulting reader doesn't support fast-forwarding or partition skips.
+flat_mutation_reader make_prefetching_reader(flat_mutation_reader);
+
 flat_mutation_reader make_empty_flat_reader(schema_ptr s);
 
 flat_mutation_reader flat_mutation_reader_from_mutations(std::vector<mutation>, const dht::partition_range& pr = query::full_partition_range, streamed_mutation::forwarding fwd = streamed_mutation::forwarding::no);
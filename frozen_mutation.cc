@@ -95,6 +95,22 @@ frozen_mutation::frozen_mutation(const mutation& m)
 {
     mutation_partition_serializer part_ser(*m.schema(), m.partition());
 
+    // Two-phase encoding: a measuring pass first computes the exact
+    // serialized size, so the write pass below fills a single buffer of
+    // exactly that size. Without it the writer chains doubling chunks
+    // which reduce_chunk_count() then copies into one contiguous buffer
+    // anyway; the measuring pass is pure arithmetic and cheaper than
+    // that copy plus the intermediate allocations.
+    seastar::measuring_output_stream ms;
+    ser::writer_of_mutation<seastar::measuring_output_stream> measure(ms);
+    std::move(measure).write_table_id(m.schema()->id())
+                  .write_schema_version(m.schema()->version())
+                  .write_key(m.key())
+                  .partition([&] (auto wr) {
+                      part_ser.write(std::move(wr));
+                  }).end_mutation();
+    _bytes.reserve(ms.size());
+
     ser::writer_of_mutation<bytes_ostream> wom(_bytes);
     std::move(wom).write_table_id(m.schema()->id())
                   .write_schema_version(m.schema()->version())
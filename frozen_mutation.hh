@@ -44,6 +44,23 @@ class mutation_view;
 // the schema. Data can be wrapped in frozen_mutation without schema
 // information, the schema is only needed to access some of the fields.
 //
+// A batch container packing many frozen mutations into one shared buffer
+// with an offset table has been considered and rejected:
+//
+//  - Data mutations of a batch target different partitions and therefore
+//    different replica sets; the coordinator sends each one in its own
+//    MUTATION message, so there is no message in which the batch could
+//    travel as a unit.
+//  - The one write path which does ship several mutations to a single node
+//    in one message - counter updates forwarded to their leader - already
+//    sends a std::vector<frozen_mutation>, which the IDL serializes back
+//    to back into the single output stream of that message. A dedicated
+//    batch type would not change what goes on the wire.
+//  - On the receiving side, deserialized mutations are applied on the
+//    shards owning their tokens, so per-mutation ownership of the bytes is
+//    needed anyway; views into one shared receive buffer would pin it until
+//    the last shard is done with its slice.
+//
 class frozen_mutation final {
 private:
     bytes_ostream _bytes;
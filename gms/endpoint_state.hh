@@ -63,6 +63,10 @@ private:
     clk::time_point _update_timestamp;
     bool _is_alive;
     bool _is_normal = false;
+    // Highest version among _application_state values, maintained on
+    // updates so that building gossip digests does not have to rescan
+    // the whole map for every endpoint on every round.
+    int _max_application_state_version = 0;
 
 public:
     bool operator==(const endpoint_state& other) const {
@@ -93,6 +97,7 @@ public:
         , _update_timestamp(clk::now())
         , _is_alive(true) {
         update_is_normal();
+        update_max_application_state_version();
     }
 
     // Valid only on shard 0
@@ -127,11 +132,17 @@ public:
     void add_application_state(application_state key, versioned_value value) {
         _application_state[key] = std::move(value);
         update_is_normal();
+        update_max_application_state_version();
     }
 
     void add_application_state(const endpoint_state& es) {
         _application_state = es._application_state;
         update_is_normal();
+        update_max_application_state_version();
+    }
+
+    int max_application_state_version() const {
+        return _max_application_state_version;
     }
 
     /* getters and setters */
@@ -190,6 +201,18 @@ public:
         _is_normal = get_status() == sstring(versioned_value::STATUS_NORMAL);
     }
 
+    // A full rescan rather than taking the maximum with the new value: a
+    // state can in principle be replaced with an older version, and an
+    // overestimated digest version would make peers believe we already
+    // have states we are missing. Updates are rare; digests are built
+    // every round, so the scan belongs here.
+    void update_max_application_state_version() {
+        _max_application_state_version = 0;
+        for (auto& entry : _application_state) {
+            _max_application_state_version = std::max(_max_application_state_version, entry.second.version);
+        }
+    }
+
     bool is_cql_ready() const;
 
     friend std::ostream& operator<<(std::ostream& os, const endpoint_state& x);
@@ -73,10 +73,18 @@ static clk::duration get_min_interval() {
     return gossiper::INTERVAL;
 }
 
+double arrival_window::adaptive_max_interval() {
+    if (_arrival_intervals.size() < MIN_SAMPLES_FOR_ADAPTIVE_INTERVAL) {
+        return 0;
+    }
+    return _arrival_intervals.mean() + 4 * _arrival_intervals.stddev();
+}
+
 void arrival_window::add(clk::time_point value, const gms::inet_address& ep) {
     if (_tlast > clk::time_point::min()) {
         auto inter_arrival_time = value - _tlast;
-        if (inter_arrival_time <= get_max_interval() && inter_arrival_time >= get_min_interval()) {
+        if (inter_arrival_time >= get_min_interval() &&
+                (inter_arrival_time <= get_max_interval() || inter_arrival_time.count() <= adaptive_max_interval())) {
             _arrival_intervals.add(inter_arrival_time.count());
         } else  {
             logger.debug("failure_detector: Ignoring interval time of {} for {}, mean={}, size={}", inter_arrival_time.count(), ep, mean(), size());
@@ -212,7 +220,7 @@ void failure_detector::interpret(inet_address ep) {
     arrival_window& hb_wnd = it->second;
     auto now = clk::now();
     if (!_last_interpret) {
-        *_last_interpret = now;
+        _last_interpret = now;
     }
     auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - *_last_interpret);
     *_last_interpret = now;
@@ -69,6 +69,18 @@ private:
     // change.
     static constexpr double PHI_FACTOR{M_LOG10El};
 
+    // minimum number of samples before we trust the window's own statistics
+    // enough to widen the acceptance bound beyond the configured maximum
+    static constexpr int MIN_SAMPLES_FOR_ADAPTIVE_INTERVAL = 16;
+
+    // Endpoints in a remote, congested datacenter can legitimately exhibit
+    // inter-arrival times above fd_max_interval_ms for long stretches. Once
+    // the window holds enough samples we also accept intervals up to
+    // mean + 4 * stddev of this endpoint's own distribution, so the window
+    // keeps tracking the endpoint's real latency instead of starving and
+    // convicting it on the next hiccup.
+    double adaptive_max_interval();
+
 public:
     arrival_window(int size)
         : _arrival_intervals(size) {
@@ -213,47 +225,40 @@ inline distributed<failure_detector>& get_failure_detector() {
     return _the_failure_detector;
 }
 
+// Endpoint state is replicated to all shards by the gossiper (see
+// gossiper::replicate()), so state reads are served from the local replica
+// instead of funnelling all monitoring traffic to shard 0. Only the arrival
+// samples live solely on shard 0, where the gossip loop reports heartbeats.
+
 inline future<> set_phi_convict_threshold(double phi) {
-    return smp::submit_to(0, [phi] {
-        get_local_failure_detector().set_phi_convict_threshold(phi);
+    // Keep every shard's copy current so that reads can stay local.
+    return get_failure_detector().invoke_on_all([phi] (failure_detector& fd) {
+        fd.set_phi_convict_threshold(phi);
     });
 }
 
 inline future<double> get_phi_convict_threshold() {
-    return smp::submit_to(0, [] {
-        return get_local_failure_detector().get_phi_convict_threshold();
-    });
+    return make_ready_future<double>(get_local_failure_detector().get_phi_convict_threshold());
 }
 
 inline future<sstring> get_all_endpoint_states() {
-    return smp::submit_to(0, [] {
-        return get_local_failure_detector().get_all_endpoint_states();
-    });
+    return make_ready_future<sstring>(get_local_failure_detector().get_all_endpoint_states());
 }
 
 inline future<sstring> get_endpoint_state(sstring address) {
-    return smp::submit_to(0, [address] {
-        return get_local_failure_detector().get_endpoint_state(address);
-    });
+    return make_ready_future<sstring>(get_local_failure_detector().get_endpoint_state(address));
 }
 
 inline future<std::map<sstring, sstring>> get_simple_states() {
-    return smp::submit_to(0, [] {
-        return get_local_failure_detector().get_simple_states();
-    });
+    return make_ready_future<std::map<sstring, sstring>>(get_local_failure_detector().get_simple_states());
 }
 
 inline future<int> get_down_endpoint_count() {
-    return smp::submit_to(0, [] {
-        return get_local_failure_detector().get_down_endpoint_count();
-    });
+    return make_ready_future<int>(get_local_failure_detector().get_down_endpoint_count());
 }
 
-
 inline future<int> get_up_endpoint_count() {
-    return smp::submit_to(0, [] {
-        return get_local_failure_detector().get_up_endpoint_count();
-    });
+    return make_ready_future<int>(get_local_failure_detector().get_up_endpoint_count());
 }
 
 inline future<std::map<inet_address, arrival_window>> get_arrival_samples() {
@@ -286,7 +286,7 @@ future<> gossiper::handle_ack_msg(msg_addr id, gossip_digest_ack ack_msg) {
             inet_address addr = g_digest.get_endpoint();
             auto local_ep_state_ptr = this->get_state_for_version_bigger_than(addr, g_digest.get_max_version());
             if (local_ep_state_ptr) {
-                delta_ep_state_map.emplace(addr, *local_ep_state_ptr);
+                delta_ep_state_map.emplace(addr, std::move(*local_ep_state_ptr));
             }
         }
         gms::gossip_digest_ack2 ack2_msg(std::move(delta_ep_state_map));
@@ -856,13 +856,9 @@ std::set<inet_address> gossiper::get_unreachable_members() {
     return ret;
 }
 
-int gossiper::get_max_endpoint_state_version(endpoint_state state) {
-    int max_version = state.get_heart_beat_state().get_heart_beat_version();
-    for (auto& entry : state.get_application_state_map()) {
-        auto& value = entry.second;
-        max_version = std::max(max_version, value.version);
-    }
-    return max_version;
+int gossiper::get_max_endpoint_state_version(const endpoint_state& state) const {
+    return std::max(state.get_heart_beat_state().get_heart_beat_version(),
+                    state.max_application_state_version());
 }
 
 // Runs inside seastar::async context
@@ -1535,7 +1531,7 @@ void gossiper::send_all(gossip_digest& g_digest,
     logger.trace("send_all(): ep={}, version > {}", ep, max_remote_version);
     auto local_ep_state_ptr = get_state_for_version_bigger_than(ep, max_remote_version);
     if (local_ep_state_ptr) {
-        delta_ep_state_map[ep] = *local_ep_state_ptr;
+        delta_ep_state_map.emplace(ep, std::move(*local_ep_state_ptr));
     }
 }
 
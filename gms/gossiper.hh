@@ -289,7 +289,7 @@ public:
      * @param ep_state
      * @return
      */
-    int get_max_endpoint_state_version(endpoint_state state);
+    int get_max_endpoint_state_version(const endpoint_state& state) const;
 
 
 private:
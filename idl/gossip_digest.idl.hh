@@ -69,6 +69,13 @@ class gossip_digest_syn {
     utils::chunked_vector<gms::gossip_digest> get_gossip_digests();
 };
 
+// Note that the endpoint_state maps in the ack and ack2 messages carry
+// deltas, not full states: the sender includes only the versioned_values
+// whose version is greater than the max version advertised in the peer's
+// digest for that endpoint (plus the heart beat state, which the receiver
+// discards if redundant). Full states are only shipped when the generations
+// differ, i.e. when the peer restarted. See
+// gossiper::get_state_for_version_bigger_than().
 class gossip_digest_ack {
     utils::chunked_vector<gms::gossip_digest> get_gossip_digest_list();
     std::map<gms::inet_address, gms::endpoint_state> get_endpoint_state_map();
@@ -72,20 +72,25 @@ void abstract_replication_strategy::validate_replication_strategy(const sstring&
     }
 }
 
+// The per-vnode endpoint lists are materialized into _cached_endpoints,
+// a flat array indexed by the position of the owning vnode token in the
+// sorted token list, so the per-request work is one binary search plus
+// one array load and never a full ring walk. There is no locking to go
+// with it: token_metadata and the strategies are per-shard objects, so a
+// topology change does not block readers - it mutates this shard's copy
+// and bumps the ring version, which makes get_cached_endpoints() drop
+// the stale table and refill it lazily, one vnode at a time, as requests
+// touch them. Refilling lazily rather than walking all vnodes at once
+// keeps topology changes from stalling the reactor on large rings.
 std::vector<inet_address> abstract_replication_strategy::get_natural_endpoints(const token& search_token) {
-    const token& key_token = _token_metadata.first_token(search_token);
     auto& cached_endpoints = get_cached_endpoints();
-    auto res = cached_endpoints.find(key_token);
-
-    if (res == cached_endpoints.end()) {
-        auto endpoints = calculate_natural_endpoints(search_token, _token_metadata);
-        cached_endpoints.emplace(key_token, endpoints);
-
-        return std::move(endpoints);
+    auto& entry = cached_endpoints[_token_metadata.first_token_index(search_token)];
+    if (!entry) {
+        entry = calculate_natural_endpoints(search_token, _token_metadata);
+    } else {
+        ++_cache_hits_count;
     }
-
-    ++_cache_hits_count;
-    return res->second;
+    return *entry;
 }
 
 void abstract_replication_strategy::validate_replication_factor(sstring rf) const
@@ -101,12 +106,15 @@ void abstract_replication_strategy::validate_replication_factor(sstring rf) cons
     }
 }
 
-inline std::unordered_map<token, std::vector<inet_address>>&
+inline std::vector<std::optional<std::vector<inet_address>>>&
 abstract_replication_strategy::get_cached_endpoints() {
     if (_last_invalidated_ring_version != _token_metadata.get_ring_version()) {
         _cached_endpoints.clear();
         _last_invalidated_ring_version = _token_metadata.get_ring_version();
     }
+    // A no-op except right after an invalidation (the sorted token list
+    // cannot change size without bumping the ring version).
+    _cached_endpoints.resize(_token_metadata.sorted_tokens().size());
 
     return _cached_endpoints;
 }
@@ -47,12 +47,15 @@ enum class replication_strategy_type {
 class abstract_replication_strategy {
 private:
     long _last_invalidated_ring_version = 0;
-    std::unordered_map<token, std::vector<inet_address>> _cached_endpoints;
+    // Natural endpoints per vnode, indexed by the position of the owning
+    // vnode token in token_metadata's sorted token list. A disengaged
+    // entry has not been computed since the last ring change.
+    std::vector<std::optional<std::vector<inet_address>>> _cached_endpoints;
     uint64_t _cache_hits_count = 0;
 
     static logging::logger logger;
 
-    std::unordered_map<token, std::vector<inet_address>>&
+    std::vector<std::optional<std::vector<inet_address>>>&
     get_cached_endpoints();
 protected:
     sstring _ks_name;
@@ -591,16 +591,21 @@ std::vector<gms::inet_address> token_metadata::pending_endpoints_for(const token
         return {};
     }
 
+    // This runs on every write, so hash the keyspace name only once and
+    // don't let operator[] plant empty entries for keyspaces that have no
+    // pending ranges.
+    auto ks_it = _pending_ranges_interval_map.find(keyspace_name);
+
     // Fast path 1: no pending ranges for this keyspace_name
-    if (_pending_ranges_interval_map[keyspace_name].empty()) {
+    if (ks_it == _pending_ranges_interval_map.end() || ks_it->second.empty()) {
         return {};
     }
 
     // Slow path: lookup pending ranges
     std::vector<gms::inet_address> endpoints;
     auto interval = range_to_interval(range<dht::token>(token));
-    auto it = _pending_ranges_interval_map[keyspace_name].find(interval);
-    if (it != _pending_ranges_interval_map[keyspace_name].end()) {
+    auto it = ks_it->second.find(interval);
+    if (it != ks_it->second.end()) {
         // interval_map does not work with std::vector, convert to std::vector of ips
         endpoints = std::vector<gms::inet_address>(it->second.begin(), it->second.end());
     }
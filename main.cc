@@ -532,6 +532,7 @@ int main(int ac, char** av) {
             dbcfg.statement_scheduling_group = make_sched_group("statement", 1000);
             dbcfg.memtable_scheduling_group = make_sched_group("memtable", 1000);
             dbcfg.memtable_to_cache_scheduling_group = make_sched_group("memtable_to_cache", 200);
+            dbcfg.view_update_scheduling_group = make_sched_group("view_update", 200);
             dbcfg.available_memory = memory::stats().total_memory();
             db.start(std::ref(*cfg), dbcfg).get();
             engine().at_exit([&db, &return_value] {
@@ -653,7 +654,8 @@ int main(int ac, char** av) {
             // engine().at_exit([&mm] { return mm.stop(); });
             supervisor::notify("starting query processor");
             cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
-            qp.start(std::ref(proxy), std::ref(db), qp_mcfg).get();
+            auto cql_parser_scheduling_group = make_sched_group("cql_parser", 200);
+            qp.start(std::ref(proxy), std::ref(db), qp_mcfg, cql_parser_scheduling_group).get();
             // #293 - do not stop anything
             // engine().at_exit([&qp] { return qp.stop(); });
             supervisor::notify("initializing batchlog manager");
@@ -737,6 +739,8 @@ int main(int ac, char** av) {
                     column_family& cf = *(x.second);
                     cf.trigger_compaction();
                 }
+                db.start_system_keyspace_maintenance();
+                db.start_cache_warmup();
             }).get();
             api::set_server_gossip(ctx).get();
             api::set_server_snitch(ctx).get();
@@ -840,7 +844,8 @@ int main(int ac, char** av) {
                 }).get();
             }
             if (cfg->defragment_memory_on_idle()) {
-                smp::invoke_on_all([] () {
+                smp::invoke_on_all([target = cfg->defragment_memory_target_occupancy()] () {
+                    logalloc::shard_tracker().set_idle_compaction_target_occupancy(target);
                     engine().set_idle_cpu_handler([] (reactor::work_waiting_on_reactor check_for_work) {
                         return logalloc::shard_tracker().compact_on_idle(check_for_work);
                     });
@@ -247,8 +247,22 @@ memtable::slice(const dht::partition_range& range) const {
     }
 }
 
+bool
+memtable::contains_partition(const dht::ring_position& key) {
+    return _read_section(*this, [&] {
+        // The stored keys may be fragmented by the LSA, in which case the
+        // comparison has to linearize them, just like in make_flat_reader().
+        managed_bytes::linearization_context_guard lcg;
+        return partitions.find(key, memtable_entry::compare(_schema)) != partitions.end();
+    });
+}
+
 class iterator_reader {
     lw_shared_ptr<memtable> _memtable;
+    // Pins the region contents for the reader's lifetime, so that fill
+    // rounds don't have to re-position the iterators and row cursors after
+    // every deferring point. Writers keep allocating into new segments.
+    std::optional<logalloc::region_pin> _pin;
     schema_ptr _schema;
     const dht::partition_range* _range;
     std::optional<dht::decorated_key> _last;
@@ -293,6 +307,7 @@ protected:
                     lw_shared_ptr<memtable> m,
                     const dht::partition_range& range)
         : _memtable(std::move(m))
+        , _pin(std::in_place, _memtable->region())
         , _schema(std::move(s))
         , _range(&range)
     { }
@@ -346,6 +361,7 @@ protected:
                                     streamed_mutation::forwarding fwd,
                                     mutation_reader::forwarding fwd_mr) {
         auto ret = _memtable->_underlying->make_reader(_schema, delegate, slice, pc, nullptr, fwd, fwd_mr);
+        _pin.reset();
         _memtable = {};
         _last = {};
         return ret;
@@ -705,14 +721,45 @@ memtable::update(db::rp_handle&& h) {
 
 future<>
 memtable::apply(memtable& mt) {
-    return do_with(mt.make_flat_reader(_schema), [this] (auto&& rd) mutable {
-        return consume_partitions(rd, [self = this->shared_from_this(), &rd] (mutation&& m) {
-            self->apply(m);
+    return do_with(mt.make_flat_reader(_schema), std::vector<mutation>(), [this, self = shared_from_this()] (flat_mutation_reader& rd, std::vector<mutation>& batch) {
+        // Entering the allocating section is not free: it refills memory
+        // reserves every time. Applying each mutation on its own pays that
+        // cost per partition, so stage mutations in a batch and apply the
+        // whole batch in a single section entry. Re-application after an
+        // allocation failure is safe because mutation merging is idempotent.
+        static constexpr size_t max_batch_size = 32;
+        auto apply_batch = [this, &batch] {
+            with_allocator(allocator(), [&] {
+                _allocating_section(*this, [&] {
+                  with_linearized_managed_bytes([&] {
+                    for (auto&& m : batch) {
+                        auto& p = find_or_create_partition(m.decorated_key());
+                        _stats_collector.update(*m.schema(), m.partition());
+                        p.apply(*_schema, m.partition(), *m.schema());
+                    }
+                  });
+                });
+            });
+            batch.clear();
+        };
+        return consume_partitions(rd, [&batch, apply_batch] (mutation&& m) {
+            batch.emplace_back(std::move(m));
+            if (batch.size() >= max_batch_size) {
+                apply_batch();
+            }
             return stop_iteration::no;
-        }, db::no_timeout);
+        }, db::no_timeout).then([apply_batch] {
+            apply_batch();
+        });
     });
 }
 
+// Maximum length of the version chain a write may grow in a partition.
+// Overwrites are inserted as new versions and merged lazily, on read or at
+// flush, converting repeated tree merges on the write path into one merge
+// pass. The cap bounds the memory overhead of unmerged duplicates.
+static constexpr size_t max_delayed_apply_versions = 8;
+
 void
 memtable::apply(const mutation& m, db::rp_handle&& h) {
     with_allocator(allocator(), [this, &m] {
@@ -720,7 +767,7 @@ memtable::apply(const mutation& m, db::rp_handle&& h) {
           with_linearized_managed_bytes([&] {
             auto& p = find_or_create_partition(m.decorated_key());
             _stats_collector.update(*m.schema(), m.partition());
-            p.apply(*_schema, m.partition(), *m.schema());
+            p.apply_delayed(*_schema, m.partition(), *m.schema(), max_delayed_apply_versions);
           });
         });
     });
@@ -737,7 +784,41 @@ memtable::apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_han
             partition_builder pb(*m_schema, mp);
             m.partition().accept(*m_schema, pb);
             _stats_collector.update(*m_schema, mp);
-            p.apply(*_schema, std::move(mp), *m_schema);
+            p.apply_delayed(*_schema, std::move(mp), *m_schema, max_delayed_apply_versions);
+          });
+        });
+    });
+    update(std::move(h));
+}
+
+void
+memtable::apply(const utils::chunked_vector<mutation>& ms, db::rp_handle&& h) {
+    if (ms.empty()) {
+        update(std::move(h));
+        return;
+    }
+    with_allocator(allocator(), [this, &ms] {
+        _allocating_section(*this, [&, this] {
+          with_linearized_managed_bytes([&] {
+            auto cmp = memtable_entry::compare(_schema);
+            // The batch is sorted, so each mutation's slot is at or past the
+            // previous one's; resume the traversal from there instead of
+            // descending from the root for every mutation.
+            auto i = partitions.lower_bound(ms.front().decorated_key(), cmp);
+            for (auto&& m : ms) {
+                while (i != partitions.end() && cmp(*i, m.decorated_key())) {
+                    ++i;
+                }
+                if (i == partitions.end() || !m.decorated_key().equal(*_schema, i->key())) {
+                    memtable_entry* entry = current_allocator().construct<memtable_entry>(
+                        _schema, dht::decorated_key(m.decorated_key()), mutation_partition(_schema));
+                    i = partitions.insert_before(i, *entry);
+                } else {
+                    upgrade_entry(*i);
+                }
+                _stats_collector.update(*m.schema(), m.partition());
+                i->partition().apply_delayed(*_schema, m.partition(), *m.schema(), max_delayed_apply_versions);
+            }
           });
         });
     });
@@ -779,6 +860,14 @@ stop_iteration memtable_entry::clear_gently() noexcept {
     return _pe.clear_gently(no_cache_tracker);
 }
 
+void memtable::on_flush_start() noexcept {
+    set_compaction_enabled(false);
+}
+
+void memtable::on_flush_failed() noexcept {
+    set_compaction_enabled(true);
+}
+
 void memtable::mark_flushed(mutation_source underlying) noexcept {
     _underlying = std::move(underlying);
 }
@@ -33,6 +33,7 @@
 #include "db/commitlog/rp_set.hh"
 #include "utils/extremum_tracking.hh"
 #include "utils/logalloc.hh"
+#include "utils/chunked_vector.hh"
 #include "partition_version.hh"
 #include "flat_mutation_reader.hh"
 #include "mutation_cleaner.hh"
@@ -197,6 +198,11 @@ public:
     void apply(const mutation& m, db::rp_handle&& = {});
     // The mutation is upgraded to current schema.
     void apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& = {});
+    // Applies a batch of mutations sorted by ring position (duplicates
+    // allowed) in a single pass over the partition tree, instead of a
+    // tree search per mutation. The mutations are upgraded to current
+    // schema. The caller must guarantee the sort order.
+    void apply(const utils::chunked_vector<mutation>& ms, db::rp_handle&& = {});
 
     static memtable& from_region(logalloc::region& r) {
         return static_cast<memtable&>(r);
@@ -260,6 +266,20 @@ public:
     mutation_source as_data_source();
 
     bool empty() const { return partitions.empty(); }
+    // Returns true iff this memtable contains an entry for the given
+    // partition. A cheap tree lookup, meant for skipping reader
+    // construction over memtables which cannot contribute to a
+    // single-partition read. Absence is authoritative; presence says
+    // nothing about other data sources.
+    bool contains_partition(const dht::ring_position& key);
+    // Called when a flush of this memtable starts. Disables LSA compaction
+    // of the region: a sealed memtable receives no more writes and its whole
+    // region is freed once the flush completes, so moving its objects around
+    // only wastes CPU and invalidates the flush reader's position.
+    void on_flush_start() noexcept;
+    // Called when a flush attempt fails and the memtable stays around.
+    // Makes the region compactable again.
+    void on_flush_failed() noexcept;
     void mark_flushed(mutation_source) noexcept;
     bool is_flushed() const;
     void on_detach_from_region_group() noexcept;
@@ -175,13 +175,20 @@ constexpr int32_t messaging_service::current_version;
 
 distributed<messaging_service> _the_messaging_service;
 
+// The cpu_id is ignored in the comparators below since we do not really
+// support shard to shard connections: the receiving side distributes
+// accepted connections over its shards on its own and a client has no way
+// to land a connection on a chosen remote shard. Keying clients by cpu_id
+// would only multiply connections per peer without affecting where the
+// handlers run. Until the listener can route a connection to the shard
+// the client asks for, verbs that care about the destination shard carry
+// an explicit dst_cpu_id in the payload and submit_to() it on the replica
+// (see the streaming verbs), or hop shards locally (see mutate_locally()).
 bool operator==(const msg_addr& x, const msg_addr& y) {
-    // Ignore cpu id for now since we do not really support shard to shard connections
     return x.addr == y.addr;
 }
 
 bool operator<(const msg_addr& x, const msg_addr& y) {
-    // Ignore cpu id for now since we do not really support shard to shard connections
     if (x.addr < y.addr) {
         return true;
     } else {
@@ -194,7 +201,6 @@ std::ostream& operator<<(std::ostream& os, const msg_addr& x) {
 }
 
 size_t msg_addr::hash::operator()(const msg_addr& id) const {
-    // Ignore cpu id for now since we do not really support // shard to shard connections
     return std::hash<uint32_t>()(id.addr.raw_addr());
 }
 
@@ -430,6 +436,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::MIGRATION_REQUEST:
     case messaging_verb::SCHEMA_CHECK:
     case messaging_verb::COUNTER_MUTATION:
+    case messaging_verb::MUTATION_VECTOR:
         return 0;
     // GET_SCHEMA_VERSION is sent from read/mutate verbs so should be
     // sent on a different connection to avoid potential deadlocks
@@ -894,6 +901,16 @@ future<> messaging_service::send_mutation(msg_addr id, clock_type::time_point ti
         std::move(reply_to), std::move(shard), std::move(response_id), std::move(trace_info));
 }
 
+void messaging_service::register_mutation_vector(std::function<future<> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms, std::optional<tracing::trace_info> trace_info)>&& func) {
+    register_handler(this, netw::messaging_verb::MUTATION_VECTOR, std::move(func));
+}
+void messaging_service::unregister_mutation_vector() {
+    _rpc->unregister_handler(netw::messaging_verb::MUTATION_VECTOR);
+}
+future<> messaging_service::send_mutation_vector(msg_addr id, clock_type::time_point timeout, std::vector<frozen_mutation> fms, std::optional<tracing::trace_info> trace_info) {
+    return send_message_timeout<void>(this, messaging_verb::MUTATION_VECTOR, std::move(id), timeout, std::move(fms), std::move(trace_info));
+}
+
 void messaging_service::register_counter_mutation(std::function<future<> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms, db::consistency_level cl, std::optional<tracing::trace_info> trace_info)>&& func) {
     register_handler(this, netw::messaging_verb::COUNTER_MUTATION, std::move(func));
 }
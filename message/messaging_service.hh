@@ -130,7 +130,8 @@ enum class messaging_verb : int32_t {
     REPAIR_GET_ESTIMATED_PARTITIONS= 33,
     REPAIR_SET_ESTIMATED_PARTITIONS= 34,
     REPAIR_GET_DIFF_ALGORITHMS = 35,
-    LAST = 36,
+    MUTATION_VECTOR = 36,
+    LAST = 37,
 };
 
 } // namespace netw
@@ -379,6 +380,12 @@ public:
     future<> send_mutation(msg_addr id, clock_type::time_point timeout, const frozen_mutation& fm, std::vector<inet_address> forward,
         inet_address reply_to, unsigned shard, response_id_type response_id, std::optional<tracing::trace_info> trace_info = std::nullopt);
 
+    // Wrapper for MUTATION_VECTOR. Applies a batch of unrelated mutations on
+    // the receiver and replies once; used for read repair write-back.
+    void register_mutation_vector(std::function<future<> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms, std::optional<tracing::trace_info> trace_info)>&& func);
+    void unregister_mutation_vector();
+    future<> send_mutation_vector(msg_addr id, clock_type::time_point timeout, std::vector<frozen_mutation> fms, std::optional<tracing::trace_info> trace_info = std::nullopt);
+
     // Wrapper for COUNTER_MUTATION
     void register_counter_mutation(std::function<future<> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms, db::consistency_level cl, std::optional<tracing::trace_info> trace_info)>&& func);
     void unregister_counter_mutation();
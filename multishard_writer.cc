@@ -27,20 +27,27 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/queue.hh>
 
+// Mutation fragments are handed off to the shard queues in chunks rather than
+// one queue operation per fragment, to amortize the queue signalling overhead.
+// An empty chunk marks the end of the stream.
+using fragment_chunk = std::vector<mutation_fragment>;
+
 class queue_reader final : public flat_mutation_reader::impl {
-    seastar::queue<mutation_fragment_opt>& _mq;
+    seastar::queue<fragment_chunk>& _mq;
 public:
-    queue_reader(schema_ptr s, seastar::queue<mutation_fragment_opt>& mq)
+    queue_reader(schema_ptr s, seastar::queue<fragment_chunk>& mq)
         : impl(std::move(s))
         , _mq(mq) {
     }
     virtual future<> fill_buffer(db::timeout_clock::time_point) override {
         return do_until([this] { return is_end_of_stream() || is_buffer_full(); }, [this] {
-            return _mq.pop_eventually().then([this] (mutation_fragment_opt mopt) {
-                if (!mopt) {
+            return _mq.pop_eventually().then([this] (fragment_chunk chunk) {
+                if (chunk.empty()) {
                     _end_of_stream = true;
                 } else {
-                    push_mutation_fragment(std::move(*mopt));
+                    for (auto& mf : chunk) {
+                        push_mutation_fragment(std::move(mf));
+                    }
                 }
             });
         });
@@ -78,9 +85,23 @@ class multishard_writer {
 private:
     schema_ptr _s;
     dht::i_partitioner& _partitioner;
+    // The chunk a shard's fragments are collected into before being pushed to
+    // that shard's queue. The fragment limit starts small, to keep the handoff
+    // latency low, and is doubled whenever the queue is found full at flush
+    // time - the consumer is lagging, so a deeper backlog should cost fewer
+    // queue operations.
+    struct chunk_builder {
+        fragment_chunk fragments;
+        size_t bytes = 0;
+        size_t fragment_limit = initial_chunk_fragments;
+    };
+    static constexpr size_t initial_chunk_fragments = 8;
+    static constexpr size_t max_chunk_fragments = 128;
+    static constexpr size_t max_chunk_bytes = 8 * 1024;
     std::vector<foreign_ptr<std::unique_ptr<shard_writer>>> _shard_writers;
     std::vector<future<>> _pending_consumers;
-    std::vector<seastar::queue<mutation_fragment_opt>> _queues;
+    std::vector<seastar::queue<fragment_chunk>> _queues;
+    std::vector<chunk_builder> _chunks;
     unsigned _current_shard = -1;
     uint64_t _consumed_partitions = 0;
     flat_mutation_reader _producer;
@@ -90,6 +111,7 @@ private:
         return _partitioner.shard_of(mf.as_partition_start().key().token());
     }
     future<> make_shard_writer(unsigned shard);
+    future<> flush_chunk(unsigned shard);
     future<stop_iteration> handle_mutation_fragment(mutation_fragment mf);
     future<stop_iteration> handle_end_of_stream();
     future<> consume(unsigned shard);
@@ -133,8 +155,9 @@ multishard_writer::multishard_writer(
     _shard_writers.resize(_partitioner.shard_count());
     _queues.reserve(_partitioner.shard_count());
     for (unsigned shard = 0; shard < _partitioner.shard_count(); shard++) {
-        _queues.push_back(seastar::queue<mutation_fragment_opt>{2});
+        _queues.push_back(seastar::queue<fragment_chunk>{2});
     }
+    _chunks.resize(_partitioner.shard_count());
 }
 
 future<> multishard_writer::make_shard_writer(unsigned shard) {
@@ -150,20 +173,46 @@ future<> multishard_writer::make_shard_writer(unsigned shard) {
     });
 }
 
+future<> multishard_writer::flush_chunk(unsigned shard) {
+    auto& chunk = _chunks[shard];
+    if (chunk.fragments.empty()) {
+        return make_ready_future<>();
+    }
+    if (_queues[shard].full()) {
+        chunk.fragment_limit = std::min(chunk.fragment_limit * 2, max_chunk_fragments);
+    }
+    chunk.bytes = 0;
+    return _queues[shard].push_eventually(std::exchange(chunk.fragments, {}));
+}
+
 future<stop_iteration> multishard_writer::handle_mutation_fragment(mutation_fragment mf) {
     auto f = make_ready_future<>();
     if (mf.is_partition_start()) {
         _consumed_partitions++;
         if (unsigned shard = shard_for_mf(mf); shard != _current_shard) {
+            // Flush the previous shard's partial chunk so its consumer is not
+            // left waiting for the tail of a partition while we produce for
+            // other shards.
+            if (_current_shard != -1u) {
+                f = flush_chunk(_current_shard);
+            }
             _current_shard = shard;
             if (!bool(_shard_writers[shard])) {
-                f = make_shard_writer(shard);
+                f = f.then([this, shard] {
+                    return make_shard_writer(shard);
+                });
             }
         }
     }
     return f.then([this, mf = std::move(mf)] () mutable {
         assert(_current_shard != -1u);
-        return _queues[_current_shard].push_eventually(mutation_fragment_opt(std::move(mf)));
+        auto& chunk = _chunks[_current_shard];
+        chunk.bytes += mf.memory_usage(*_s);
+        chunk.fragments.push_back(std::move(mf));
+        if (chunk.fragments.size() >= chunk.fragment_limit || chunk.bytes >= max_chunk_bytes) {
+            return flush_chunk(_current_shard);
+        }
+        return make_ready_future<>();
     }).then([] {
         return stop_iteration::no;
     });
@@ -172,7 +221,9 @@ future<stop_iteration> multishard_writer::handle_mutation_fragment(mutation_frag
 future<stop_iteration> multishard_writer::handle_end_of_stream() {
     return parallel_for_each(boost::irange(0u, _partitioner.shard_count()), [this] (unsigned shard) {
         if (bool(_shard_writers[shard])) {
-            return _queues[shard].push_eventually(mutation_fragment_opt());
+            return flush_chunk(shard).then([this, shard] {
+                return _queues[shard].push_eventually(fragment_chunk());
+            });
         } else {
             return make_ready_future<>();
         }
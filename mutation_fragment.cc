@@ -76,32 +76,49 @@ std::ostream& operator<<(std::ostream& out, const position_range& range) {
     return out << "{" << range.start() << ", " << range.end() << "}";
 }
 
+utils::object_pool<mutation_fragment::data>& mutation_fragment::data_pool() {
+    static thread_local utils::object_pool<data> pool(1024);
+    return pool;
+}
+
+void mutation_fragment::data_deleter::operator()(data* d) const noexcept {
+    data_pool().put(d);
+}
+
+const utils::object_pool_stats& mutation_fragment::data_pool_stats() {
+    return data_pool().stats();
+}
+
+size_t mutation_fragment::data_pool_size() {
+    return data_pool().pooled();
+}
+
 mutation_fragment::mutation_fragment(static_row&& r)
-    : _kind(kind::static_row), _data(std::make_unique<data>())
+    : _kind(kind::static_row), _data(data_ptr(data_pool().get()))
 {
     new (&_data->_static_row) static_row(std::move(r));
 }
 
 mutation_fragment::mutation_fragment(clustering_row&& r)
-    : _kind(kind::clustering_row), _data(std::make_unique<data>())
+    : _kind(kind::clustering_row), _data(data_ptr(data_pool().get()))
 {
     new (&_data->_clustering_row) clustering_row(std::move(r));
 }
 
 mutation_fragment::mutation_fragment(range_tombstone&& r)
-    : _kind(kind::range_tombstone), _data(std::make_unique<data>())
+    : _kind(kind::range_tombstone), _data(data_ptr(data_pool().get()))
 {
     new (&_data->_range_tombstone) range_tombstone(std::move(r));
 }
 
 mutation_fragment::mutation_fragment(partition_start&& r)
-        : _kind(kind::partition_start), _data(std::make_unique<data>())
+        : _kind(kind::partition_start), _data(data_ptr(data_pool().get()))
 {
     new (&_data->_partition_start) partition_start(std::move(r));
 }
 
 mutation_fragment::mutation_fragment(partition_end&& r)
-        : _kind(kind::partition_end), _data(std::make_unique<data>())
+        : _kind(kind::partition_end), _data(data_ptr(data_pool().get()))
 {
     new (&_data->_partition_end) partition_end(std::move(r));
 }
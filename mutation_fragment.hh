@@ -31,6 +31,7 @@
 #include "seastar/core/future-util.hh"
 
 #include "db/timeout_clock.hh"
+#include "utils/object_pool.hh"
 
 // mutation_fragments are the objects that streamed_mutation are going to
 // stream. They can represent:
@@ -314,6 +315,10 @@ private:
         data() { }
         ~data() { }
 
+        // For the per-shard data pool; the union payload is destroyed by
+        // destroy_data() before the block is released.
+        void reset() noexcept { _size_in_bytes = std::nullopt; }
+
         std::optional<size_t> _size_in_bytes;
         union {
             static_row _static_row;
@@ -323,9 +328,19 @@ private:
             partition_end _partition_end;
         };
     };
+    // Fragments are created and destroyed at a very high rate by the read
+    // and compaction paths, so their payload blocks come from a per-shard
+    // pool instead of the allocator. The pool is resolved when the block is
+    // released, not captured in the deleter, so blocks always return to the
+    // releasing shard's pool.
+    static utils::object_pool<data>& data_pool();
+    struct data_deleter {
+        void operator()(data* d) const noexcept;
+    };
+    using data_ptr = std::unique_ptr<data, data_deleter>;
 private:
     kind _kind;
-    std::unique_ptr<data> _data;
+    data_ptr _data;
 
     mutation_fragment() = default;
     explicit operator bool() const noexcept { return bool(_data); }
@@ -339,7 +354,7 @@ public:
     template<typename... Args>
     mutation_fragment(clustering_row_tag_t, Args&&... args)
         : _kind(kind::clustering_row)
-        , _data(std::make_unique<data>())
+        , _data(data_ptr(data_pool().get()))
     {
         new (&_data->_clustering_row) clustering_row(std::forward<Args>(args)...);
     }
@@ -350,8 +365,18 @@ public:
     mutation_fragment(partition_start&& r);
     mutation_fragment(partition_end&& r);
 
+    // Fragments are move-only within a shard; this deep copy exists for the
+    // cases where the payload must genuinely change owner: fragments filled
+    // on another shard (foreign_reader, shard_reader, the multishard query
+    // buffer replay), whose memory belongs to that shard's allocator, and
+    // population of LSA-managed stores. Anything that merely forwards
+    // fragments between pipeline stages - reader merging, the compactor,
+    // the writers - consumes them by rvalue and must keep doing so; sharing
+    // cell blobs across shards instead of copying would tie the lifetime of
+    // one shard's memory to another shard's readers and break per-shard
+    // memory accounting, so don't try to "optimize" these copies away.
     mutation_fragment(const schema& s, const mutation_fragment& o)
-        : _kind(o._kind), _data(std::make_unique<data>()) {
+        : _kind(o._kind), _data(data_ptr(data_pool().get())) {
         switch(_kind) {
             case kind::static_row:
                 new (&_data->_static_row) static_row(s, o._data->_static_row);
@@ -520,6 +545,10 @@ public:
         return _kind == mf._kind && _kind != kind::range_tombstone;
     }
 
+    // Stats of this shard's fragment payload pool, for metrics.
+    static const utils::object_pool_stats& data_pool_stats();
+    static size_t data_pool_size();
+
     class printer {
         const schema& _schema;
         const mutation_fragment& _mutation_fragment;
@@ -702,7 +702,13 @@ struct appending_hash<row> {
                     } else {
                         query::default_hasher cellh;
                         feed_hash(cellh, cell_and_hash->cell.as_atomic_cell(def), def);
-                        feed_hash(h, cellh.finalize_uint64());
+                        // Remember the cell hash so that subsequent digest
+                        // reads of an unchanged cell - hot rows see many of
+                        // them between writes - do not re-hash its value.
+                        // The field is a mutable cache, dropped whenever the
+                        // cell is updated.
+                        cell_and_hash->hash = cell_hash{cellh.finalize_uint64()};
+                        feed_hash(h, *cell_and_hash->hash);
                     }
                 } else {
                     feed_hash(h, cell_and_hash->cell.as_atomic_cell(def), def);
@@ -717,7 +723,8 @@ struct appending_hash<row> {
                     } else {
                         query::default_hasher cellh;
                         feed_hash(cellh, cm, def);
-                        feed_hash(h, cellh.finalize_uint64());
+                        cell_and_hash->hash = cell_hash{cellh.finalize_uint64()};
+                        feed_hash(h, *cell_and_hash->hash);
                     }
                 } else {
                     feed_hash(h, cm, def);
@@ -189,15 +189,30 @@ private:
     // end, a call to next_partition() or a call to
     // fast_forward_to(dht::partition_range).
     reader_and_last_fragment_kind _single_reader;
+    // Optimisation for the case where a single reader keeps producing the
+    // smallest fragment round after round. Once a reader has won
+    // gallop_mode_entering_threshold rounds outright we stop cycling its
+    // fragments through _fragment_heap and instead compare each of them
+    // against the heap front only, streaming them for as long as they stay
+    // smaller. The galloping reader's next fragment stays in the reader's
+    // own buffer, so falling back to the heap is just a matter of putting
+    // the reader back into _next.
+    static constexpr int gallop_mode_entering_threshold = 3;
+    reader_and_last_fragment_kind _galloping_reader;
+    int _gallop_mode_hits = 0;
     const schema_ptr _schema;
     streamed_mutation::forwarding _fwd_sm;
     mutation_reader::forwarding _fwd_mr;
 private:
     void maybe_add_readers(const std::optional<dht::ring_position_view>& pos);
     void add_readers(std::vector<flat_mutation_reader> new_readers);
+    bool in_gallop_mode() const;
+    // Hand the galloping reader back to the normal merging path.
+    void leave_gallop_mode();
     future<> prepare_next(db::timeout_clock::time_point timeout);
     // Collect all forwardable readers into _next, and remove them from
-    // their previous containers (_halted_readers and _fragment_heap).
+    // their previous containers (_halted_readers, _fragment_heap and the
+    // galloping reader slot).
     void prepare_forwardable_readers();
 public:
     mutation_reader_merger(schema_ptr schema,
@@ -273,6 +288,16 @@ void mutation_reader_merger::add_readers(std::vector<flat_mutation_reader> new_r
     }
 }
 
+bool mutation_reader_merger::in_gallop_mode() const {
+    return _gallop_mode_hits >= gallop_mode_entering_threshold;
+}
+
+void mutation_reader_merger::leave_gallop_mode() {
+    _next.emplace_back(_galloping_reader);
+    _galloping_reader.reader = nullptr;
+    _gallop_mode_hits = 0;
+}
+
 struct mutation_reader_merger::reader_heap_compare {
     const schema& s;
 
@@ -346,6 +371,9 @@ void mutation_reader_merger::prepare_forwardable_readers() {
     if (_single_reader.reader) {
         _next.emplace_back(std::exchange(_single_reader.reader, {}), _single_reader.last_kind);
     }
+    if (in_gallop_mode()) {
+        leave_gallop_mode();
+    }
     for (auto& df : _fragment_heap) {
         _next.emplace_back(df.reader, df.fragment.mutation_fragment_kind());
     }
@@ -389,6 +417,34 @@ future<mutation_reader_merger::mutation_fragment_batch> mutation_reader_merger::
         return prepare_next(timeout).then([this, timeout] { return (*this)(timeout); });
     }
 
+    if (in_gallop_mode()) {
+        // The galloping reader's next fragment is still sitting in the
+        // reader's own buffer.
+        if (_galloping_reader.reader->is_buffer_empty()) {
+            if (!_galloping_reader.reader->is_end_of_stream()) {
+                return _galloping_reader.reader->fill_buffer(timeout).then([this, timeout] { return operator()(timeout); });
+            }
+            // Reader is out of data, let prepare_next() do the end-of-stream
+            // bookkeeping.
+            leave_gallop_mode();
+            return operator()(timeout);
+        }
+        position_in_partition::less_compare cmp(*_schema);
+        if (!_fragment_heap.empty() && !cmp(_galloping_reader.reader->peek_buffer().position(), _fragment_heap.front().fragment.position())) {
+            // The galloping reader no longer has the smallest fragment,
+            // merge through the heap again.
+            leave_gallop_mode();
+            return operator()(timeout);
+        }
+        _current.clear();
+        _current.emplace_back(_galloping_reader.reader->pop_mutation_fragment());
+        _galloping_reader.last_kind = _current.back().mutation_fragment_kind();
+        if (_current.back().is_end_of_partition()) {
+            leave_gallop_mode();
+        }
+        return make_ready_future<mutation_fragment_batch>(_current);
+    }
+
     _current.clear();
 
     // If we ran out of fragments for the current partition, select the
@@ -429,6 +485,17 @@ future<mutation_reader_merger::mutation_fragment_batch> mutation_reader_merger::
     }
     while (!_fragment_heap.empty() && equal(_current.back().position(), _fragment_heap.front().fragment.position()));
 
+    if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
+        ++_gallop_mode_hits;
+        if (in_gallop_mode()) {
+            _galloping_reader.last_kind = _next.front().last_kind;
+            _next.clear();
+        }
+    } else {
+        _galloping_reader.reader = _next.size() == 1 ? _next.front().reader : nullptr;
+        _gallop_mode_hits = _next.size() == 1 ? 1 : 0;
+    }
+
     return make_ready_future<mutation_fragment_batch>(_current);
 }
 
@@ -442,6 +509,8 @@ void mutation_reader_merger::next_partition() {
 
 future<> mutation_reader_merger::fast_forward_to(const dht::partition_range& pr, db::timeout_clock::time_point timeout) {
     _single_reader = { };
+    _galloping_reader = { };
+    _gallop_mode_hits = 0;
     _next.clear();
     _halted_readers.clear();
     _fragment_heap.clear();
@@ -925,7 +994,8 @@ class shard_reader : public enable_lw_shared_from_this<shard_reader>, public fla
                 const io_priority_class& pc,
                 tracing::trace_state_ptr trace_state,
                 mutation_reader::forwarding fwd_mr);
-        future<fill_buffer_result> fill_buffer(const dht::partition_range& pr, bool pending_next_partition, db::timeout_clock::time_point timeout);
+        future<fill_buffer_result> fill_buffer(const dht::partition_range& pr, bool pending_next_partition, size_t max_buffer_size,
+                db::timeout_clock::time_point timeout);
         future<> fast_forward_to(const dht::partition_range& pr, db::timeout_clock::time_point timeout);
         reader_concurrency_semaphore::inactive_read_handle inactive_read_handle() && {
             return std::move(_irh);
@@ -990,6 +1060,13 @@ public:
     bool is_read_ahead_in_progress() const {
         return _read_ahead.has_value();
     }
+    // Raise the amount of data a single remote fill is allowed to produce.
+    // Takes effect from the next fill; an already started fill (read ahead)
+    // uses the previous size. Only ever grows, so that a buffer that was found
+    // to be too small stays large for the rest of the scan.
+    void grow_max_buffer_size(size_t size) {
+        max_buffer_size_in_bytes = std::max(max_buffer_size_in_bytes, size);
+    }
 };
 
 void shard_reader::stop() noexcept {
@@ -1138,13 +1215,14 @@ shard_reader::remote_reader::remote_reader(
 }
 
 future<shard_reader::fill_buffer_result> shard_reader::remote_reader::fill_buffer(const dht::partition_range& pr, bool pending_next_partition,
-        db::timeout_clock::time_point timeout) {
+        size_t max_buffer_size, db::timeout_clock::time_point timeout) {
     // We could have missed a `fast_forward_to()` if the reader wasn't created yet.
     _pr = &pr;
     if (pending_next_partition) {
         _last_position_in_partition = position_in_partition(position_in_partition::end_of_partition_tag_t{});
     }
-    return do_with(resume_or_create_reader(), [this, pending_next_partition, timeout] (flat_mutation_reader& reader) {
+    return do_with(resume_or_create_reader(), [this, pending_next_partition, max_buffer_size, timeout] (flat_mutation_reader& reader) {
+        reader.set_max_buffer_size(max_buffer_size);
         if (pending_next_partition) {
             reader.next_partition();
         }
@@ -1212,10 +1290,11 @@ future<> shard_reader::remote_reader::fast_forward_to(const dht::partition_range
 future<> shard_reader::do_fill_buffer(db::timeout_clock::time_point timeout) {
     auto fill_buf_fut = make_ready_future<fill_buffer_result>();
     const auto pending_next_partition = std::exchange(_pending_next_partition, false);
+    const auto max_buffer_size = max_buffer_size_in_bytes;
     if (!_reader) {
-        fill_buf_fut = smp::submit_to(_shard, [this, gs = global_schema_ptr(_schema), pending_next_partition, timeout] {
+        fill_buf_fut = smp::submit_to(_shard, [this, gs = global_schema_ptr(_schema), pending_next_partition, max_buffer_size, timeout] {
             auto rreader = make_foreign(std::make_unique<remote_reader>(gs.get(), *_lifecycle_policy, *_pr, _ps, _pc, _trace_state, _fwd_mr));
-            auto f = rreader->fill_buffer(*_pr, pending_next_partition, timeout);
+            auto f = rreader->fill_buffer(*_pr, pending_next_partition, max_buffer_size, timeout);
             return f.then([rreader = std::move(rreader)] (fill_buffer_result res) mutable {
                 return make_ready_future<foreign_ptr<std::unique_ptr<remote_reader>>, fill_buffer_result>(std::move(rreader), std::move(res));
             });
@@ -1224,8 +1303,8 @@ future<> shard_reader::do_fill_buffer(db::timeout_clock::time_point timeout) {
             return std::move(res);
         });
     } else {
-        fill_buf_fut = smp::submit_to(_shard, [this, pending_next_partition, timeout] () mutable {
-            return _reader->fill_buffer(*_pr, pending_next_partition, timeout);
+        fill_buf_fut = smp::submit_to(_shard, [this, pending_next_partition, max_buffer_size, timeout] () mutable {
+            return _reader->fill_buffer(*_pr, pending_next_partition, max_buffer_size, timeout);
         });
     }
 
@@ -1310,6 +1389,16 @@ class multishard_combining_reader : public flat_mutation_reader::impl {
     unsigned _current_shard;
     bool _crossed_shards;
     unsigned _concurrency = 1;
+    // The buffer size each shard reader fills per cross-shard round trip.
+    // Doubled together with `_concurrency` when the merge is found starving
+    // on an empty shard buffer, so that hot shards (where most of the data
+    // lives) transfer their fragments in fewer, larger batches. Shards that
+    // don't fill their buffer are unaffected, so skewed distributions only
+    // pay for the shards that need it.
+    size_t _shard_reader_buffer_size = shard_reader_initial_buffer_size;
+
+    static constexpr size_t shard_reader_initial_buffer_size = 8 * 1024;
+    static constexpr size_t shard_reader_max_buffer_size = 512 * 1024;
 
     void on_partition_range_change(const dht::partition_range& pr);
     bool maybe_move_to_next_shard(const dht::token* const t = nullptr);
@@ -1395,15 +1484,21 @@ future<> multishard_combining_reader::handle_empty_reader_buffer(db::timeout_clo
     } else {
         // If we crossed shards and the next reader has an empty buffer we
         // double concurrency so the next time we cross shards we will have
-        // more chances of hitting the reader's buffer.
+        // more chances of hitting the reader's buffer. We also double the
+        // per-fill buffer size so each cross-shard round trip moves more data
+        // and a single hot shard cannot starve the merge with tiny fills.
         if (_crossed_shards) {
             _concurrency = std::min(_concurrency * 2, _partitioner.shard_count());
+            _shard_reader_buffer_size = std::min(_shard_reader_buffer_size * 2, shard_reader_max_buffer_size);
+            reader.grow_max_buffer_size(_shard_reader_buffer_size);
 
             // If concurrency > 1 we kick-off concurrency-1 read-aheads in the
             // background. They will be brought to the foreground when we move
             // to their respective shard.
             for (unsigned i = 1; i < _concurrency; ++i) {
-                _shard_readers[(_current_shard + i) % _partitioner.shard_count()]->read_ahead(timeout);
+                auto& next_reader = *_shard_readers[(_current_shard + i) % _partitioner.shard_count()];
+                next_reader.grow_max_buffer_size(_shard_reader_buffer_size);
+                next_reader.read_ahead(timeout);
             }
         }
         return reader.fill_buffer(timeout);
@@ -1530,3 +1625,81 @@ flat_mutation_reader make_multishard_combining_reader(
     return make_flat_mutation_reader<multishard_combining_reader>(std::move(lifecycle_policy), partitioner, std::move(schema), pr, ps, pc,
             std::move(trace_state), fwd_mr);
 }
+
+namespace {
+
+// Reads a sequence of non-overlapping partition ranges, sorted in ring
+// order, with a single underlying reader. The underlying reader is created
+// over the first range and fast-forwarded to each subsequent one, so
+// per-sstable index and filter lookups are amortized across all ranges
+// instead of being paid by each of them separately.
+class flat_multi_range_mutation_reader : public flat_mutation_reader::impl {
+    std::unique_ptr<const dht::partition_range_vector> _ranges;
+    dht::partition_range_vector::const_iterator _current;
+    flat_mutation_reader _reader;
+public:
+    flat_multi_range_mutation_reader(
+            schema_ptr s,
+            mutation_source source,
+            std::unique_ptr<const dht::partition_range_vector> ranges,
+            const query::partition_slice& slice,
+            const io_priority_class& pc,
+            tracing::trace_state_ptr trace_state)
+        : impl(s)
+        , _ranges(std::move(ranges))
+        , _current(_ranges->begin())
+        , _reader(source.make_reader(std::move(s), *_current, slice, pc, std::move(trace_state),
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::yes))
+    {
+        assert(!_ranges->empty());
+    }
+
+    virtual future<> fill_buffer(db::timeout_clock::time_point timeout) override {
+        return do_until([this] { return is_end_of_stream() || is_buffer_full(); }, [this, timeout] {
+            return fill_buffer_from(_reader, timeout).then([this, timeout] (bool underlying_finished) {
+                if (!underlying_finished) {
+                    return make_ready_future<>();
+                }
+                if (std::next(_current) == _ranges->end()) {
+                    _end_of_stream = true;
+                    return make_ready_future<>();
+                }
+                ++_current;
+                return _reader.fast_forward_to(*_current, timeout);
+            });
+        });
+    }
+
+    virtual void next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty() && !is_end_of_stream()) {
+            _reader.next_partition();
+        }
+    }
+
+    virtual future<> fast_forward_to(const dht::partition_range& pr, db::timeout_clock::time_point timeout) override {
+        throw std::bad_function_call();
+    }
+
+    virtual future<> fast_forward_to(position_range pr, db::timeout_clock::time_point timeout) override {
+        throw std::bad_function_call();
+    }
+
+    virtual size_t buffer_size() const override {
+        return flat_mutation_reader::impl::buffer_size() + _reader.buffer_size();
+    }
+};
+
+}
+
+flat_mutation_reader make_flat_multi_range_reader(
+        schema_ptr schema,
+        mutation_source source,
+        dht::partition_range_vector ranges,
+        const query::partition_slice& slice,
+        const io_priority_class& pc,
+        tracing::trace_state_ptr trace_state) {
+    auto owned_ranges = std::make_unique<const dht::partition_range_vector>(std::move(ranges));
+    return make_flat_mutation_reader<flat_multi_range_mutation_reader>(std::move(schema), std::move(source),
+            std::move(owned_ranges), slice, pc, std::move(trace_state));
+}
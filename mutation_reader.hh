@@ -83,6 +83,19 @@ flat_mutation_reader make_combined_reader(schema_ptr schema,
         streamed_mutation::forwarding fwd_sm = streamed_mutation::forwarding::no,
         mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::yes);
 
+// Creates a reader which reads the given non-overlapping partition ranges,
+// sorted in ring order, with a single pass of one underlying reader. The
+// underlying reader is created over the first range and fast-forwarded to
+// each subsequent one, so per-sstable index and filter lookups are shared
+// between the ranges instead of being paid by each of them separately.
+flat_mutation_reader make_flat_multi_range_reader(
+        schema_ptr schema,
+        mutation_source source,
+        dht::partition_range_vector ranges,
+        const query::partition_slice& slice,
+        const io_priority_class& pc = default_priority_class(),
+        tracing::trace_state_ptr trace_state = nullptr);
+
 template <typename MutationFilter>
 GCC6_CONCEPT(
     requires requires(MutationFilter mf, const dht::decorated_key& dk) {
@@ -284,8 +284,32 @@ public:
     // May be called when cursor is not valid.
     // The cursor is valid after the call.
     // Must be called under reclaim lock.
-    // When throws, the cursor is invalidated and its position is not changed.
+    // When throws, the cursor is invalidated; its position may be left
+    // anywhere between the original position and lower_bound.
     bool advance_to(position_in_partition_view lower_bound) {
+        position_in_partition::tri_compare cmp(_schema);
+        // Seeks within a wide cached partition are usually short: the next
+        // clustering range of a multi-range slice starts a few rows past the
+        // previous one. When the iterators are still valid and the target
+        // lies ahead of the current row, step the existing heap forward a
+        // bounded number of rows instead of re-descending every version's
+        // rows tree from the root.
+        if (iterators_valid() && !_current_row.empty() && cmp(lower_bound, _position) > 0) {
+            static constexpr unsigned max_steps = 8;
+            try {
+                for (unsigned i = 0; i < max_steps; ++i) {
+                    if (!next()) {
+                        return false;
+                    }
+                    if (cmp(lower_bound, _position) <= 0) {
+                        return no_clustering_row_between(_schema, lower_bound, _position);
+                    }
+                }
+            } catch (...) {
+                _change_mark = {};
+                throw;
+            }
+        }
         prepare_heap(lower_bound);
         _change_mark = _snp.get_change_mark();
         bool found = no_clustering_row_between(_schema, lower_bound, _heap[0].it->position());
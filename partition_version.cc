@@ -360,6 +360,34 @@ void partition_entry::apply(const schema& s, mutation_partition&& mp, const sche
     set_version(new_version);
 }
 
+void partition_entry::apply_delayed(const schema& s, const mutation_partition& mp, const schema& mp_schema, size_t max_versions)
+{
+    apply_delayed(s, mutation_partition(s, mp), mp_schema, max_versions);
+}
+
+void partition_entry::apply_delayed(const schema& s, mutation_partition&& mp, const schema& mp_schema, size_t max_versions)
+{
+    // Merging into a single empty version is cheap, no point in growing the
+    // chain for it.
+    if (!_snapshot && !_version->next() && _version->partition().empty()) {
+        apply(s, std::move(mp), mp_schema);
+        return;
+    }
+    size_t versions = 0;
+    for (auto v = &*_version; v; v = v->next()) {
+        if (++versions >= max_versions) {
+            apply(s, std::move(mp), mp_schema);
+            return;
+        }
+    }
+    if (s.version() != mp_schema.version()) {
+        mp.upgrade(mp_schema, s);
+    }
+    auto new_version = current_allocator().construct<partition_version>(std::move(mp));
+    new_version->insert_before(*_version);
+    set_version(new_version);
+}
+
 // Iterates over all rows in mutation represented by partition_entry.
 // It abstracts away the fact that rows may be spread across multiple versions.
 class partition_entry::rows_iterator final {
@@ -509,6 +509,22 @@ public:
     void apply(const schema& s, const mutation_partition& mp, const schema& mp_schema);
     void apply(const schema& s, mutation_partition&& mp, const schema& mp_schema);
 
+    // Like apply(), but instead of merging mp with the existing data
+    // immediately, inserts it as a new version. Version chains are squashed
+    // when the entry is read or when the last snapshot referencing them is
+    // released, so this trades per-write comparator and tree-rebalancing
+    // work for a single merge pass later, which pays off when the same rows
+    // are overwritten repeatedly.
+    //
+    // To bound the memory overhead of unmerged overwrites the chain is only
+    // allowed to grow to max_versions; past that mp is merged immediately,
+    // like with apply().
+    // Strong exception guarantees.
+    // Assumes this instance and mp are fully continuous.
+    // Use only on non-evictable entries.
+    void apply_delayed(const schema& s, const mutation_partition& mp, const schema& mp_schema, size_t max_versions);
+    void apply_delayed(const schema& s, mutation_partition&& mp, const schema& mp_schema, size_t max_versions);
+
     // Adds mutation_partition represented by "other" to the one represented
     // by this entry.
     // This entry must be evictable.
@@ -241,6 +241,12 @@ public:
         ++_stats.resource_based_evictions;
         --_stats.population;
     }
+    virtual size_t evict_cost() const override {
+        // The buffered fragments are what the next page would otherwise have
+        // to read again from disk, so use them as a proxy for how expensive
+        // this querier would be to reconstruct.
+        return _pos->memory_usage();
+    }
 };
 
 template <typename Querier>
@@ -294,14 +300,47 @@ static void insert_querier(
     }
 }
 
+template <typename Querier>
+void querier_cache::insert_maybe_prefetch(index& idx, utils::UUID key, Querier&& q, tracing::trace_state_ptr trace_state) {
+    if (!_prefetch_enabled || _prefetch_gate.is_closed()) {
+        insert_querier(_sem, _entries, idx, _stats, _max_queriers_memory_usage, key, std::move(q), lowres_clock::now() + _entry_ttl,
+                std::move(trace_state));
+        return;
+    }
+
+    // Fill the reader's buffer while the client's next page request makes
+    // its network round trip, so the next page can be served from the
+    // buffer. The querier is inserted only once the prefetch completed, so
+    // lookups can never see a querier with a prefetch still in flight. A
+    // next page arriving before the insertion happened misses and falls
+    // back to creating a new querier, which is correct, just slower.
+    // Reversed queriers are never cached (see insert_querier()) so don't
+    // waste the read on them.
+    if (q.is_reversed()) {
+        return;
+    }
+    ++_stats.prefetches;
+    (void)with_gate(_prefetch_gate, [this, &idx, key, q = std::move(q), trace_state = std::move(trace_state)] () mutable {
+        auto fill = q.prefetch(db::timeout_clock::now() + _entry_ttl);
+        return fill.then_wrapped([this, &idx, key, q = std::move(q), trace_state = std::move(trace_state)] (future<> f) mutable {
+            if (f.failed()) {
+                f.ignore_ready_future();
+                ++_stats.prefetch_failures;
+                tracing::trace(trace_state, "Dropping querier with key {}, prefetch failed", key);
+                return;
+            }
+            insert_querier(_sem, _entries, idx, _stats, _max_queriers_memory_usage, key, std::move(q), lowres_clock::now() + _entry_ttl,
+                    std::move(trace_state));
+        });
+    });
+}
+
 void querier_cache::insert(utils::UUID key, data_querier&& q, tracing::trace_state_ptr trace_state) {
-    insert_querier(_sem, _entries, _data_querier_index, _stats, _max_queriers_memory_usage, key, std::move(q), lowres_clock::now() + _entry_ttl,
-            std::move(trace_state));
+    insert_maybe_prefetch(_data_querier_index, key, std::move(q), std::move(trace_state));
 }
 
 void querier_cache::insert(utils::UUID key, mutation_querier&& q, tracing::trace_state_ptr trace_state) {
-    insert_querier(_sem, _entries, _mutation_querier_index, _stats, _max_queriers_memory_usage, key, std::move(q), lowres_clock::now() + _entry_ttl,
-            std::move(trace_state));
+    insert_maybe_prefetch(_mutation_querier_index, key, std::move(q), std::move(trace_state));
 }
 
 void querier_cache::insert(utils::UUID key, shard_mutation_querier&& q, tracing::trace_state_ptr trace_state) {
@@ -24,6 +24,8 @@
 #include "mutation_compactor.hh"
 #include "mutation_reader.hh"
 
+#include <seastar/core/gate.hh>
+
 #include <boost/intrusive/set.hpp>
 
 #include <variant>
@@ -183,6 +185,19 @@ public:
         });
     }
 
+    /// Fill the reader's buffer in anticipation of the next page.
+    ///
+    /// Meant to be run while the querier is parked between pages, so that
+    /// by the time the client's next page request arrives the fragments are
+    /// already buffered and consume_page() doesn't have to wait for disk.
+    /// Cannot be called concurrently with consume_page().
+    future<> prefetch(db::timeout_clock::time_point timeout) {
+        if (_reader.is_end_of_stream() || _reader.is_buffer_full()) {
+            return make_ready_future<>();
+        }
+        return _reader.fill_buffer(timeout);
+    }
+
     size_t memory_usage() const {
         return _reader.buffer_size();
     }
@@ -316,6 +331,12 @@ public:
         // The number of queriers evicted to because the maximum memory usage
         // was reached.
         uint64_t memory_based_evictions = 0;
+        // The number of page prefetches started on behalf of cached
+        // queriers.
+        uint64_t prefetches = 0;
+        // The subset of prefetches that failed. The affected querier is
+        // dropped, the next page will recreate it.
+        uint64_t prefetch_failures = 0;
         // The number of queriers currently in the cache.
         uint64_t population = 0;
     };
@@ -408,9 +429,14 @@ private:
     std::chrono::seconds _entry_ttl;
     stats _stats;
     size_t _max_queriers_memory_usage;
+    bool _prefetch_enabled = false;
+    gate _prefetch_gate;
 
     void scan_cache_entries();
 
+    template <typename Querier>
+    void insert_maybe_prefetch(index& idx, utils::UUID key, Querier&& q, tracing::trace_state_ptr trace_state);
+
 public:
     explicit querier_cache(reader_concurrency_semaphore& sem, size_t max_cache_size = 1'000'000, std::chrono::seconds entry_ttl = default_entry_ttl);
 
@@ -466,6 +492,24 @@ public:
 
     void set_entry_ttl(std::chrono::seconds entry_ttl);
 
+    /// Enable or disable speculative prefetch of the next page.
+    ///
+    /// When enabled, inserted data and mutation queriers first fill their
+    /// reader's buffer in the background, while the client's next page
+    /// request makes its network round trip, and only then become visible
+    /// to lookups. A next page arriving before the prefetch finished simply
+    /// misses and falls back to creating a new querier.
+    void set_prefetch_enabled(bool enabled) {
+        _prefetch_enabled = enabled;
+    }
+
+    /// Stop the cache, waiting for in-flight prefetches to complete.
+    ///
+    /// The cache cannot be used after it was stopped.
+    future<> stop() {
+        return _prefetch_gate.close();
+    }
+
     /// Evict a querier.
     ///
     /// Return true if a querier was evicted and false otherwise (if the cache
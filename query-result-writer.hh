@@ -131,8 +131,15 @@ class result::builder {
     digester _digest;
     result_memory_accounter _memory_accounter;
 public:
-    builder(const partition_slice& slice, result_options options, result_memory_accounter memory_accounter)
-        : _slice(slice)
+    // initial_size_hint, when non-zero, pre-sizes the first chunk of the
+    // result buffer, so that a result of the predicted size is written into
+    // one contiguous chunk instead of growing through a chain of doubling
+    // fragments. A wrong hint is only a performance matter; bytes_ostream
+    // caps the chunk at its maximum chunk size.
+    builder(const partition_slice& slice, result_options options, result_memory_accounter memory_accounter,
+            size_t initial_size_hint = 0)
+        : _out(initial_size_hint ? bytes_ostream(initial_size_hint) : bytes_ostream())
+        , _slice(slice)
         , _w(ser::writer_of_query_result<bytes_ostream>(_out).start_partitions())
         , _request(options.request)
         , _digest(digester(options.digest_algo))
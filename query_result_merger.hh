@@ -55,4 +55,27 @@ public:
     foreign_ptr<lw_shared_ptr<query::result>> get();
 };
 
+// Collects non-overlapping partial results in order without concatenating
+// them, for callers which keep accumulating partials across several rounds
+// and merge only once at the end.
+// Implements @Reducer concept from distributed.hh
+class result_collector {
+    std::vector<foreign_ptr<lw_shared_ptr<query::result>>> _partial;
+public:
+    void reserve(size_t size) {
+        _partial.reserve(size);
+    }
+
+    void operator()(foreign_ptr<lw_shared_ptr<query::result>> r) {
+        if (!_partial.empty() && _partial.back()->is_short_read()) {
+            return;
+        }
+        _partial.emplace_back(std::move(r));
+    }
+
+    std::vector<foreign_ptr<lw_shared_ptr<query::result>>> get() {
+        return std::move(_partial);
+    }
+};
+
 }
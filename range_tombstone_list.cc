@@ -439,11 +439,36 @@ bool range_tombstone_list::equal(const schema& s, const range_tombstone_list& ot
 
 stop_iteration range_tombstone_list::apply_monotonically(const schema& s, range_tombstone_list&& list, is_preemptible preemptible) {
     auto del = current_deleter<range_tombstone>();
+    bound_view::compare less(s);
     auto it = list.begin();
     while (it != list.end()) {
-        // FIXME: Optimize by stealing the entry
-        apply_monotonically(s, *it);
-        it = list._tombstones.erase_and_dispose(it, del);
+        if (_tombstones.empty() || !less(it->start_bound(), std::prev(_tombstones.end())->end_bound())) {
+            // The tombstone starts at or after the end of everything in this
+            // list. Both lists are sorted, so the same holds for all the
+            // remaining tombstones and they cannot interact with existing
+            // entries. Steal the allocated entry from the source list
+            // instead of copying it through the merge path.
+            range_tombstone& rt = *it;
+            if (!_tombstones.empty()) {
+                auto last = std::prev(_tombstones.end());
+                if (last->tomb == rt.tomb && last->end_bound().adjacent(s, rt.start_bound())) {
+                    // Absorb the last entry instead of appending next to it,
+                    // so that adjacent tombstones with equal info don't
+                    // accumulate as fragments, same as insert_from() does.
+                    // rt is widened while still linked in the source list,
+                    // which is safe since only its start bound changes, and
+                    // on failure both lists still cover their old ranges.
+                    rt.start = last->start;
+                    rt.start_kind = last->start_kind;
+                    _tombstones.erase_and_dispose(last, del);
+                }
+            }
+            it = list._tombstones.erase(it);
+            _tombstones.insert(_tombstones.end(), rt);
+        } else {
+            apply_monotonically(s, *it);
+            it = list._tombstones.erase_and_dispose(it, del);
+        }
         if (preemptible && need_preempt()) {
             return stop_iteration::no;
         }
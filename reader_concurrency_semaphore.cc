@@ -64,9 +64,18 @@ bool reader_concurrency_semaphore::try_evict_one_inactive_read() {
     if (_inactive_reads.empty()) {
         return false;
     }
-    auto it = _inactive_reads.begin();
-    it->second->evict();
-    _inactive_reads.erase(it);
+    // Sacrifice the read that is cheapest to reconstruct, with ties broken
+    // towards the oldest (ids grow monotonically). The linear scan is fine:
+    // the inactive population is bounded by the querier cache's memory limit
+    // and eviction only happens when permits have already run out.
+    auto candidate = _inactive_reads.begin();
+    for (auto it = std::next(candidate); it != _inactive_reads.end(); ++it) {
+        if (it->second->evict_cost() < candidate->second->evict_cost()) {
+            candidate = it;
+        }
+    }
+    candidate->second->evict();
+    _inactive_reads.erase(candidate);
 
     ++_inactive_read_stats.permit_based_evictions;
     --_inactive_read_stats.population;
@@ -79,15 +88,14 @@ future<lw_shared_ptr<reader_concurrency_semaphore::reader_permit>> reader_concur
     if (_wait_list.size() >= _max_queue_length) {
         return make_exception_future<lw_shared_ptr<reader_permit>>(_make_queue_overloaded_exception());
     }
+    // Requests arriving with an already-passed deadline - typically client
+    // retries during an overload storm - would only take up a queue slot
+    // until the expiry timer gets around to dropping them. Fail them now.
+    if (timeout != db::no_timeout && timeout <= db::timeout_clock::now()) {
+        return make_exception_future<lw_shared_ptr<reader_permit>>(semaphore_timed_out());
+    }
     auto r = resources(1, static_cast<ssize_t>(memory));
-    auto it = _inactive_reads.begin();
-    while (!may_proceed(r) && it != _inactive_reads.end()) {
-        auto ir = std::move(it->second);
-        it = _inactive_reads.erase(it);
-        ir->evict();
-
-        ++_inactive_read_stats.permit_based_evictions;
-        --_inactive_read_stats.population;
+    while (!may_proceed(r) && try_evict_one_inactive_read()) {
     }
     if (may_proceed(r)) {
         _resources -= r;
@@ -181,8 +189,10 @@ public:
     }
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override {
-        return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, pc).then([this] (temporary_buffer<uint8_t> buf) {
+        auto start = std::chrono::steady_clock::now();
+        return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, pc).then([this, start] (temporary_buffer<uint8_t> buf) {
             if (_permit) {
+                _permit->account_io_latency(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
                 buf = make_tracked_buf(std::move(buf));
                 _permit->consume_memory(buf.size());
             }
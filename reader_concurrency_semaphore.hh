@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <seastar/core/file.hh>
 #include <seastar/core/future.hh>
@@ -40,7 +41,15 @@ using namespace seastar;
 /// The semaphore can be configured with the desired limits on
 /// construction. New readers will only be admitted when there is both
 /// enough count and memory units available. Readers are admitted in
-/// FIFO order.
+/// FIFO order. A request whose deadline has already passed is rejected
+/// without queueing, and queued waiters are dropped by the expiry timer
+/// when they reach their deadline, so doomed requests don't consume
+/// capacity. Admission is deliberately not ordered by remaining
+/// deadline: reads with distant deadlines (e.g. streaming) would be
+/// starved indefinitely by a steady flow of short-deadline statement
+/// reads. Isolation between read classes is instead achieved by giving
+/// each class its own semaphore (see `database`, which keeps separate
+/// instances for statement, streaming and system reads).
 /// It's possible to specify the maximum allowed number of waiting
 /// readers by the `max_queue_length` constructor parameter. When the
 /// number waiting readers would be equal or greater than this number
@@ -111,11 +120,22 @@ public:
         void signal_memory(size_t memory) {
             _semaphore.signal_memory(memory);
         }
+
+        void account_io_latency(std::chrono::microseconds d) {
+            _semaphore.account_io_latency(d);
+        }
     };
 
     class inactive_read {
     public:
         virtual void evict() = 0;
+        /// Estimate of how expensive the read would be to reconstruct if
+        /// evicted, in bytes of buffered data the next page would have to
+        /// re-read. Used to pick the cheapest victim when permits run out;
+        /// 0 means "evict me first".
+        virtual size_t evict_cost() const {
+            return 0;
+        }
         virtual ~inactive_read() = default;
     };
 
@@ -161,6 +181,15 @@ private:
 
 private:
     resources _resources;
+    int _count_limit;
+    // Exponentially weighted mean of the completion latency of individual
+    // disk reads issued under this semaphore's permits, in microseconds.
+    // Fed by the tracking file wrapper, consumed by the concurrency
+    // controller in database.cc. Zero until the first sample.
+    double _io_latency_ewma_us = 0;
+    // Small enough to ride out single outliers, large enough to follow a
+    // cache-hot/cache-cold transition within a few hundred reads.
+    static constexpr double io_latency_ewma_alpha = 0.05;
 
     expiring_fifo<entry, expiry_handler, db::timeout_clock> _wait_list;
 
@@ -200,6 +229,7 @@ public:
             size_t max_queue_length = std::numeric_limits<size_t>::max(),
             std::function<std::exception_ptr()> raise_queue_overloaded_exception = default_make_queue_overloaded_exception)
         : _resources(count, memory)
+        , _count_limit(count)
         , _max_queue_length(max_queue_length)
         , _make_queue_overloaded_exception(raise_queue_overloaded_exception) {
     }
@@ -262,6 +292,36 @@ public:
     size_t waiters() const {
         return _wait_list.size();
     }
+
+    int count_limit() const {
+        return _count_limit;
+    }
+
+    /// Adjust the concurrency (count) limit at runtime.
+    ///
+    /// Raising the limit admits eligible waiting readers immediately.
+    /// Lowering it does not revoke permits already issued - the number of
+    /// running reads drifts down to the new limit as they finish.
+    void set_count_limit(int new_limit) {
+        auto delta = new_limit - _count_limit;
+        _count_limit = new_limit;
+        if (delta > 0) {
+            signal(resources(delta, 0));
+        } else {
+            _resources.count += delta;
+        }
+    }
+
+    void account_io_latency(std::chrono::microseconds d) {
+        auto us = double(d.count());
+        _io_latency_ewma_us = _io_latency_ewma_us
+                ? io_latency_ewma_alpha * us + (1 - io_latency_ewma_alpha) * _io_latency_ewma_us
+                : us;
+    }
+
+    std::chrono::microseconds measured_io_latency() const {
+        return std::chrono::microseconds(uint64_t(_io_latency_ewma_us));
+    }
 };
 
 class reader_resource_tracker {
@@ -31,6 +31,7 @@
 #include "service/storage_service.hh"
 #include "service/priority_manager.hh"
 #include "message/messaging_service.hh"
+#include "utils/memory_label.hh"
 #include "sstables/sstables.hh"
 #include "database.hh"
 
@@ -571,6 +572,49 @@ static future<partition_checksum> checksum_range_shard(database &db,
 // (checksum_parallelism_semaphore) at once.
 static thread_local semaphore checksum_parallelism_semaphore(2);
 
+// Scheduled repairs mostly verify data that has not changed since the last
+// run, so remember the checksum computed for each range together with the
+// content epochs (see table::content_epoch()) of the involved shards at the
+// time, and reuse it while the epochs stand still. Any write to the table
+// moves its shard's epoch and invalidates the whole table's cached
+// checksums on that shard - the epoch deliberately has no notion of which
+// range a write landed in, to keep the write path untouched. The cache is
+// in memory only; a restarted node computes its checksums from scratch.
+struct range_checksum_cache_key {
+    utils::UUID cf_id;
+    ::dht::token_range range;
+    repair_checksum version;
+    bool operator==(const range_checksum_cache_key& other) const {
+        return cf_id == other.cf_id && version == other.version && range == other.range;
+    }
+    struct hash {
+        size_t operator()(const range_checksum_cache_key& k) const {
+            auto h = std::hash<utils::UUID>()(k.cf_id) ^ size_t(k.version);
+            auto feed_bound = [&h] (const std::optional<range_bound<dht::token>>& b) {
+                if (b) {
+                    h ^= std::hash<dht::token>()(b->value()) + 0x9e3779b9 + (h << 6) + (h >> 2);
+                    h ^= b->is_inclusive();
+                }
+            };
+            feed_bound(k.range.start());
+            feed_bound(k.range.end());
+            return h;
+        }
+    };
+};
+
+struct range_checksum_cache_entry {
+    // (shard, content epoch of the table on that shard), sorted by shard
+    std::vector<std::pair<unsigned, uint64_t>> shard_epochs;
+    partition_checksum checksum;
+};
+
+using range_checksum_cache_type = std::unordered_map<range_checksum_cache_key, range_checksum_cache_entry, range_checksum_cache_key::hash>;
+static thread_local range_checksum_cache_type range_checksum_cache;
+// ~150 bytes per entry; nodes*vnodes ranges per table keep typical usage
+// way below this, it only guards against unbounded growth over many tables.
+static constexpr size_t max_range_checksum_cache_entries = 64 * 1024;
+
 // Calculate the checksum of the data held on all shards of a column family,
 // in the given token range.
 // In practice, we only need to consider one or two shards which intersect the
@@ -587,21 +631,44 @@ future<partition_checksum> checksum_range(seastar::sharded<database> &db,
         const ::dht::token_range& range, repair_checksum hash_version) {
     auto& schema = db.local().find_column_family(keyspace, cf).schema();
     auto shard_ranges = dht::split_range_to_shards(dht::to_partition_range(range), *schema);
-    return do_with(partition_checksum(), std::move(shard_ranges), [&db, &keyspace, &cf, hash_version] (auto& result, auto& shard_ranges) {
-        return parallel_for_each(shard_ranges, [&db, &keyspace, &cf, &result, hash_version] (auto& shard_range) {
-            auto& shard = shard_range.first;
-            auto& prs = shard_range.second;
-            return db.invoke_on(shard, [keyspace, cf, prs = std::move(prs), hash_version] (database& db) mutable {
-                return do_with(std::move(keyspace), std::move(cf), std::move(prs), [&db, hash_version] (auto& keyspace, auto& cf, auto& prs) {
-                    return seastar::with_semaphore(checksum_parallelism_semaphore, 1, [&db, hash_version, &keyspace, &cf, &prs] {
-                        return checksum_range_shard(db, keyspace, cf, prs, hash_version);
+    auto key = range_checksum_cache_key{schema->id(), range, hash_version};
+    return do_with(partition_checksum(), std::move(shard_ranges), std::move(key), std::vector<std::pair<unsigned, uint64_t>>(),
+            [&db, &keyspace, &cf, hash_version] (auto& result, auto& shard_ranges, auto& key, auto& epochs) {
+        // Snapshot the content epochs of the involved shards before reading
+        // anything. A write racing with the checksum makes the entry go
+        // stale on the next run, never the other way around.
+        return parallel_for_each(shard_ranges, [&db, &keyspace, &cf, &epochs] (auto& shard_range) {
+            auto shard = shard_range.first;
+            return db.invoke_on(shard, [keyspace, cf] (database& db) {
+                return db.find_column_family(keyspace, cf).content_epoch();
+            }).then([&epochs, shard] (uint64_t epoch) {
+                epochs.emplace_back(shard, epoch);
+            });
+        }).then([&db, &keyspace, &cf, &result, &shard_ranges, &key, &epochs, hash_version] {
+            boost::sort(epochs);
+            auto it = range_checksum_cache.find(key);
+            if (it != range_checksum_cache.end() && it->second.shard_epochs == epochs) {
+                return make_ready_future<partition_checksum>(it->second.checksum);
+            }
+            return parallel_for_each(shard_ranges, [&db, &keyspace, &cf, &result, hash_version] (auto& shard_range) {
+                auto& shard = shard_range.first;
+                auto& prs = shard_range.second;
+                return db.invoke_on(shard, [keyspace, cf, prs = std::move(prs), hash_version] (database& db) mutable {
+                    return do_with(std::move(keyspace), std::move(cf), std::move(prs), [&db, hash_version] (auto& keyspace, auto& cf, auto& prs) {
+                        return seastar::with_semaphore(checksum_parallelism_semaphore, 1, [&db, hash_version, &keyspace, &cf, &prs] {
+                            return checksum_range_shard(db, keyspace, cf, prs, hash_version);
+                        });
                     });
+                }).then([&result] (partition_checksum sum) {
+                    result.add(sum);
                 });
-            }).then([&result] (partition_checksum sum) {
-                result.add(sum);
+            }).then([&result, &key, &epochs] {
+                if (range_checksum_cache.size() >= max_range_checksum_cache_entries) {
+                    range_checksum_cache.clear();
+                }
+                range_checksum_cache[std::move(key)] = range_checksum_cache_entry{std::move(epochs), result};
+                return make_ready_future<partition_checksum>(result);
             });
-        }).then([&result] {
-            return make_ready_future<partition_checksum>(result);
         });
     });
 }
@@ -1248,13 +1315,73 @@ private:
 };
 
 
-static thread_local semaphore ranges_parallelism_semaphore(16);
+// Controls how many ranges are repaired in parallel, which is the main
+// repair intensity knob. A controller in the spirit of backlog_controller
+// (see backlog_controller.hh) adjusts it from a feedback signal: repair does
+// not own a scheduling group it could steer shares for (it shares the
+// streaming group), so instead of shares it steers the semaphore units
+// between 1 and the static maximum. While the statement-group sstable read
+// latency exceeds the target configured with
+// read_concurrency_latency_target_in_ms -- the same SLO which drives the
+// statement read concurrency limit -- parallelism is halved each adjustment
+// period, and while there is latency headroom it recovers one unit at a
+// time, so unattended repairs back off quickly under load spikes and speed
+// back up during troughs. With the target unset (the default) the
+// parallelism stays at the static maximum.
+class repair_ranges_parallelism_controller {
+    static constexpr size_t max_parallelism = 16;
+    semaphore _sem{max_parallelism};
+    size_t _parallelism = max_parallelism;
+    lowres_clock::time_point _last_adjust;
+public:
+    semaphore& sem() { return _sem; }
+
+    // Called before each range acquires a unit; self-limits to one
+    // adjustment per second, so there is no need for a permanently armed
+    // timer while no repair is running.
+    void maybe_adjust(database& db) {
+        auto target_ms = db.get_config().read_concurrency_latency_target_in_ms();
+        if (!target_ms) {
+            return;
+        }
+        auto now = lowres_clock::now();
+        if (now - _last_adjust < std::chrono::seconds(1)) {
+            return;
+        }
+        _last_adjust = now;
+        auto latency = db.read_concurrency_sem().measured_io_latency();
+        if (latency == std::chrono::microseconds(0)) {
+            return;
+        }
+        const auto target = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::milliseconds(target_ms));
+        auto parallelism = _parallelism;
+        if (latency > target) {
+            parallelism = std::max(_parallelism / 2, size_t(1));
+        } else if (latency < target * 3 / 4) {
+            parallelism = std::min(_parallelism + 1, max_parallelism);
+        }
+        if (parallelism == _parallelism) {
+            return;
+        }
+        rlogger.debug("Adjusting repair ranges parallelism {} -> {} (statement read latency {}us, target {}us)",
+            _parallelism, parallelism, latency.count(), target.count());
+        if (parallelism > _parallelism) {
+            _sem.signal(parallelism - _parallelism);
+        } else {
+            _sem.consume(_parallelism - parallelism);
+        }
+        _parallelism = parallelism;
+    }
+};
+
+static thread_local repair_ranges_parallelism_controller ranges_parallelism_controller;
 
 static future<> do_repair_ranges(lw_shared_ptr<repair_info> ri) {
     if (ri->row_level_repair()) {
         // repair all the ranges in limited parallelism
         return parallel_for_each(ri->ranges, [ri] (auto&& range) {
-            return with_semaphore(ranges_parallelism_semaphore, 1, [ri, &range] {
+            ranges_parallelism_controller.maybe_adjust(ri->db.local());
+            return with_semaphore(ranges_parallelism_controller.sem(), 1, [ri, &range] {
                 ri->check_in_abort();
                 ri->ranges_index++;
                 rlogger.info("Repair {} out of {} ranges, id={}, shard={}, keyspace={}, table={}, range={}",
@@ -1298,7 +1425,9 @@ static future<> do_repair_ranges(lw_shared_ptr<repair_info> ri) {
 // same nodes as replicas.
 static future<> repair_ranges(lw_shared_ptr<repair_info> ri) {
     repair_tracker.add_repair_info(ri->id, ri);
-    return do_repair_ranges(ri).then([ri] {
+    return utils::with_memory_label("repair", [ri] {
+        return do_repair_ranges(ri);
+    }).then([ri] {
         ri->check_failed_ranges();
         repair_tracker.remove_repair_info(ri->id);
         return make_ready_future<>();
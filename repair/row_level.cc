@@ -144,18 +144,61 @@ public:
     }
 };
 
+// Every cell fed into the row hash is preceded by the name of its column and
+// the name of the column's type, which are invariant across rows. Feeding
+// those strings through feed_hash() for each cell of each row is a measurable
+// share of repair CPU, so precompute, per column, the exact byte stream
+// feed_hash() would produce for them and feed it with a single update per
+// cell. The stream is recorded through the hasher interface itself, so the
+// resulting hashes are bit-identical to the unbatched ones and stay
+// compatible with peers computing them the old way.
+class column_hash_prefixes {
+    class recording_hasher {
+        std::vector<char> _out;
+    public:
+        void update(const char* ptr, size_t size) {
+            _out.insert(_out.end(), ptr, ptr + size);
+        }
+        bytes to_bytes() && {
+            return bytes(reinterpret_cast<const int8_t*>(_out.data()), _out.size());
+        }
+    };
+    std::vector<bytes> _regular;
+    std::vector<bytes> _static;
+private:
+    static bytes make_prefix(const column_definition& col) {
+        recording_hasher h;
+        feed_hash(h, col.name());
+        feed_hash(h, col.type->name());
+        return std::move(h).to_bytes();
+    }
+public:
+    explicit column_hash_prefixes(const schema& s) {
+        _regular.reserve(s.regular_columns_count());
+        for (const auto& col : s.regular_columns()) {
+            _regular.push_back(make_prefix(col));
+        }
+        _static.reserve(s.static_columns_count());
+        for (const auto& col : s.static_columns()) {
+            _static.push_back(make_prefix(col));
+        }
+    }
+    const bytes& regular(column_id id) const { return _regular[id]; }
+    const bytes& statik(column_id id) const { return _static[id]; }
+};
+
 class fragment_hasher {
     const schema& _schema;
     xx_hasher& _hasher;
+    const column_hash_prefixes& _prefixes;
 private:
-    void consume_cell(const column_definition& col, const atomic_cell_or_collection& cell) {
-        feed_hash(_hasher, col.name());
-        feed_hash(_hasher, col.type->name());
+    void consume_cell(const bytes& prefix, const column_definition& col, const atomic_cell_or_collection& cell) {
+        _hasher.update(reinterpret_cast<const char*>(prefix.cbegin()), prefix.size());
         feed_hash(_hasher, cell, col);
     }
 public:
-    explicit fragment_hasher(const schema&s, xx_hasher& h)
-        : _schema(s), _hasher(h) { }
+    explicit fragment_hasher(const schema& s, xx_hasher& h, const column_hash_prefixes& prefixes)
+        : _schema(s), _hasher(h), _prefixes(prefixes) { }
 
     void hash(const mutation_fragment& mf) {
         mf.visit(seastar::make_visitor(
@@ -186,7 +229,7 @@ private:
     void consume(const static_row& sr) {
         sr.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
             auto&& col = _schema.static_column_at(id);
-            consume_cell(col, cell);
+            consume_cell(_prefixes.statik(id), col, cell);
         });
     }
 
@@ -196,7 +239,7 @@ private:
         feed_hash(_hasher, cr.marker());
         cr.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
             auto&& col = _schema.regular_column_at(id);
-            consume_cell(col, cell);
+            consume_cell(_prefixes.regular(id), col, cell);
         });
     }
 
@@ -392,7 +435,7 @@ public:
                 sstables::sstable_writer_config sst_cfg;
                 sst_cfg.large_data_handler = t->get_large_data_handler();
                 auto& pc = service::get_local_streaming_write_priority();
-                return sst->write_components(std::move(reader), std::max(1ul, estimated_partitions), s, sst_cfg, {}, pc).then([sst] {
+                return sst->write_components(std::move(reader), std::max(1ul, estimated_partitions), s, sst_cfg, t->get_streaming_encoding_stats(), pc).then([sst] {
                     return sst->open_data();
                 }).then([t, sst] {
                     return t->add_sstable_and_update_cache(sst);
@@ -486,6 +529,8 @@ private:
     std::optional<repair_sync_boundary> _current_sync_boundary;
     // Contains the hashes of rows in the _working_row_buffor for all peer nodes
     std::vector<std::unordered_set<repair_hash>> _peer_row_hash_sets;
+    // Precomputed per-column byte streams fed into the row hashes
+    column_hash_prefixes _column_hash_prefixes;
 public:
     repair_stats& stats() {
         return _stats;
@@ -543,7 +588,8 @@ public:
                     _seed,
                     repair_reader::is_local_reader(_repair_master || _same_sharding_config)
               )
-            , _repair_writer(_schema, _estimated_partitions, _nr_peer_nodes) {
+            , _repair_writer(_schema, _estimated_partitions, _nr_peer_nodes)
+            , _column_hash_prefixes(*_schema) {
     }
 
 public:
@@ -745,7 +791,7 @@ private:
 
     repair_hash do_hash_for_mf(const decorated_key_with_hash& dk_with_hash, const mutation_fragment& mf) {
         xx_hasher h(_seed);
-        fragment_hasher fh(*_schema, h);
+        fragment_hasher fh(*_schema, h, _column_hash_prefixes);
         fh.hash(mf);
         feed_hash(h, dk_with_hash.hash.hash);
         return repair_hash(h.finalize_uint64());
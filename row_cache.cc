@@ -31,6 +31,9 @@
 #include <boost/version.hpp>
 #include <sys/sdt.h>
 #include "read_context.hh"
+#include "mutation_rebuilder.hh"
+#include "frozen_mutation.hh"
+#include "compress.hh"
 #include "schema_upgrader.hh"
 #include "dirty_memory_manager.hh"
 #include "cache_flat_mutation_reader.hh"
@@ -110,12 +113,14 @@ cache_tracker::setup_metrics() {
         sm::make_derive("row_insertions", sm::description("total number of rows added to cache"), _stats.row_insertions),
         sm::make_derive("row_evictions", sm::description("total number of rows evicted from cache"), _stats.row_evictions),
         sm::make_derive("row_removals", sm::description("total number of invalidated rows"), _stats.row_removals),
+        sm::make_derive("rows_purged", sm::description("total number of dead rows with expired tombstones evicted by the background purge"), _stats.rows_purged),
         sm::make_derive("static_row_insertions", sm::description("total number of static rows added to cache"), _stats.static_row_insertions),
         sm::make_derive("concurrent_misses_same_key", sm::description("total number of operation with misses same key"), _stats.concurrent_misses_same_key),
         sm::make_derive("partition_merges", sm::description("total number of partitions merged"), _stats.partition_merges),
         sm::make_derive("partition_evictions", sm::description("total number of evicted partitions"), _stats.partition_evictions),
         sm::make_derive("partition_removals", sm::description("total number of invalidated partitions"), _stats.partition_removals),
         sm::make_derive("mispopulations", sm::description("number of entries not inserted by reads"), _stats.mispopulations),
+        sm::make_derive("memtable_update_bypasses", sm::description("number of cache entries evicted instead of merged during memtable flush because they were predicted to be evicted before the next read"), _stats.memtable_update_bypasses),
         sm::make_gauge("partitions", sm::description("total number of cached partitions"), _stats.partitions),
         sm::make_gauge("rows", sm::description("total number of cached rows"), _stats.rows),
         sm::make_derive("reads", sm::description("number of started reads"), _stats.reads),
@@ -131,12 +136,26 @@ cache_tracker::setup_metrics() {
             sm::description("total number of rows in memtables which were dropped during cache update on memtable flush")),
         sm::make_derive("rows_merged_from_memtable", _stats.rows_merged_from_memtable,
             sm::description("total number of rows in memtables which were merged with existing rows during cache update on memtable flush")),
+        sm::make_derive("memoized_slice_hits", sm::description("number of single-partition reads served from the memoized slice results"), _stats.memoized_slice_hits),
+        sm::make_derive("memoized_slice_insertions", sm::description("number of slice read results memoized"), _stats.memoized_slice_insertions),
+        sm::make_derive("cold_tier_hits", sm::description("number of reads rehydrated from the compressed cold tier"), _stats.cold_tier_hits),
+        sm::make_derive("cold_tier_insertions", sm::description("number of evicted partitions parked in the compressed cold tier"), _stats.cold_tier_insertions),
+        sm::make_derive("cold_tier_evictions", sm::description("number of partitions dropped from the compressed cold tier"), _stats.cold_tier_evictions),
+        sm::make_derive("cold_tier_promotions", sm::description("number of cold tier partitions promoted back to the hot tier"), _stats.cold_tier_promotions),
+        sm::make_gauge("cold_tier_bytes", sm::description("current compressed size of the cold tier"), [this] { return _cold_store_size; }),
+        sm::make_derive("negative_hits", sm::description("number of point reads answered from the negative lookup cache"), _stats.negative_hits),
+        sm::make_derive("negative_insertions", sm::description("number of absent keys recorded in the negative lookup cache"), _stats.negative_insertions),
     });
 }
 
 void cache_tracker::clear() {
     auto partitions_before = _stats.partitions;
     auto rows_before = _stats.rows;
+    _clearing = true;
+    auto on_done = defer([this] { _clearing = false; });
+    _cold_index.clear();
+    _cold_store.clear();
+    _cold_store_size = 0;
     // We need to clear garbage first because garbage versions cannot be evicted from,
     // mutation_partition::clear_gently() destroys intrusive tree invariants.
     with_allocator(_region.allocator(), [this] {
@@ -193,6 +212,12 @@ void cache_tracker::on_partition_eviction() {
     ++_stats.partition_evictions;
 }
 
+void cache_tracker::on_partition_eviction(lowres_clock::duration age, uint64_t rows) noexcept {
+    _stats.partition_eviction_age.add(std::chrono::duration_cast<std::chrono::milliseconds>(age).count());
+    _stats.partition_evictions_by_rows.add(rows);
+    on_partition_eviction();
+}
+
 void cache_tracker::on_row_eviction() {
     --_stats.rows;
     ++_stats.row_evictions;
@@ -210,6 +235,28 @@ void cache_tracker::on_mispopulate() {
     ++_stats.mispopulations;
 }
 
+void cache_tracker::on_memtable_update_bypass() {
+    ++_stats.memtable_update_bypasses;
+}
+
+bool cache_tracker::predicts_eviction_before_next_read(lowres_clock::time_point last_accessed) const {
+    // Don't trust the heuristic until the eviction age histogram has seen a
+    // reasonable number of samples. In particular, a cache under no memory
+    // pressure evicts nothing and must never bypass updates.
+    static constexpr int64_t min_eviction_samples = 128;
+    if (_stats.partition_eviction_age.count() < min_eviction_samples) {
+        return false;
+    }
+    // An entry which has already been idle for longer than the age at which
+    // partitions typically get evicted is unlikely to see another read
+    // before the LRU gets to it. The comparison is approximate: eviction age
+    // is measured since population while idleness is measured since the last
+    // read, which only makes the test more conservative for entries which
+    // were read at least once.
+    auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(lowres_clock::now() - last_accessed).count();
+    return idle > _stats.partition_eviction_age.percentile(0.5);
+}
+
 void cache_tracker::on_miss_already_populated() {
     ++_stats.concurrent_misses_same_key;
 }
@@ -218,6 +265,96 @@ void cache_tracker::pinned_dirty_memory_overload(uint64_t bytes) {
     _stats.pinned_dirty_memory_overload += bytes;
 }
 
+void cache_tracker::erase_cold_entry(cold_store_list::iterator it) {
+    auto rng = _cold_index.equal_range(it->key.token());
+    for (auto i = rng.first; i != rng.second; ++i) {
+        if (i->second == it) {
+            _cold_index.erase(i);
+            break;
+        }
+    }
+    _cold_store_size -= it->compressed.size();
+    _cold_store.erase(it);
+}
+
+void cache_tracker::offer_cold(cache_entry& e) noexcept {
+    if (_clearing || _cold_offer_suppressions || e.is_dummy_entry()) {
+        return;
+    }
+    try {
+        with_allocator(standard_allocator(), [&] {
+            auto mp = e.partition().squashed(*e.schema());
+            if (!mp.is_fully_continuous()) {
+                // Partially evicted partitions cannot be rehydrated faithfully.
+                return;
+            }
+            mutation m(e.schema(), e.key(), std::move(mp));
+            auto fm = freeze(m);
+            const bytes_ostream& rep = fm.representation();
+            bytes flat(bytes::initialized_later(), rep.size());
+            auto out = flat.begin();
+            for (bytes_view frag : rep.fragments()) {
+                out = std::copy(frag.begin(), frag.end(), out);
+            }
+            bytes compressed(bytes::initialized_later(), compressor::lz4->compress_max_size(flat.size()));
+            auto len = compressor::lz4->compress(reinterpret_cast<const char*>(flat.data()), flat.size(),
+                reinterpret_cast<char*>(compressed.data()), compressed.size());
+            compressed.resize(len);
+            while (_cold_store_size + compressed.size() > max_cold_store_size && !_cold_store.empty()) {
+                erase_cold_entry(_cold_store.begin());
+                ++_stats.cold_tier_evictions;
+            }
+            if (compressed.size() > max_cold_store_size) {
+                return;
+            }
+            _cold_store.push_back(cold_entry{e.schema(), e.key(), std::move(compressed), flat.size()});
+            auto it = std::prev(_cold_store.end());
+            _cold_index.emplace(it->key.token(), it);
+            _cold_store_size += it->compressed.size();
+            ++_stats.cold_tier_insertions;
+        });
+    } catch (...) {
+        // Best effort; under memory pressure we may be unable to even
+        // compress. The entry is then simply evicted.
+    }
+}
+
+std::optional<mutation> cache_tracker::lookup_cold(const schema_ptr& s, const dht::decorated_key& key) {
+    auto rng = _cold_index.equal_range(key.token());
+    for (auto i = rng.first; i != rng.second; ++i) {
+        auto it = i->second;
+        if (it->schema->id() == s->id() && it->key.equal(*s, key)) {
+            if (++it->hits >= cold_promotion_threshold) {
+                ++_stats.cold_tier_promotions;
+                erase_cold_entry(it);
+                return std::nullopt;
+            }
+            ++_stats.cold_tier_hits;
+            bytes uncompressed(bytes::initialized_later(), it->uncompressed_size);
+            compressor::lz4->uncompress(reinterpret_cast<const char*>(it->compressed.data()), it->compressed.size(),
+                reinterpret_cast<char*>(uncompressed.data()), uncompressed.size());
+            bytes_ostream bo;
+            bo.write(bytes_view(uncompressed));
+            auto m = frozen_mutation(std::move(bo)).unfreeze(it->schema);
+            if (s->version() != it->schema->version()) {
+                m.upgrade(s);
+            }
+            return m;
+        }
+    }
+    return std::nullopt;
+}
+
+void cache_tracker::drop_cold_entries(const schema_ptr& s) noexcept {
+    for (auto it = _cold_store.begin(); it != _cold_store.end();) {
+        auto next = std::next(it);
+        if (it->schema->id() == s->id()) {
+            erase_cold_entry(it);
+        }
+        it = next;
+    }
+}
+
 allocation_strategy& cache_tracker::allocator() {
     return _region.allocator();
 }
@@ -377,6 +514,7 @@ private:
                                 cache_entry* entry = current_allocator().construct<cache_entry>(
                                     _cache._schema, std::move(dk), std::move(mp));
                                 _cache._tracker.insert(*entry);
+                                ++_cache._stats.populations_from_read_miss;
                                 entry->set_continuous(i->continuous());
                                 return _cache._partitions.insert_before(i, *entry);
                             }, [&] (auto i) {
@@ -478,6 +616,210 @@ void row_cache::on_static_row_insert() {
     ++_tracker._stats.static_row_insertions;
 }
 
+void row_cache::sample_partition_hit(cache_entry& e) {
+    if (++_partition_hit_samples % partition_hit_sample_rate == 0) {
+        _stats.partition_hits_by_rows.add(e.partition().version()->partition().clustered_rows().calculate_size());
+    }
+}
+
+static bool slices_equal(const schema& s, const query::partition_slice& a, const query::partition_slice& b) {
+    clustering_key_prefix::equality eq(s);
+    return a.options.mask() == b.options.mask()
+        && a.static_columns == b.static_columns
+        && a.regular_columns == b.regular_columns
+        && a.partition_row_limit() == b.partition_row_limit()
+        && std::equal(a.default_row_ranges().begin(), a.default_row_ranges().end(),
+                      b.default_row_ranges().begin(), b.default_row_ranges().end(),
+            [&] (const query::clustering_range& r1, const query::clustering_range& r2) {
+                return r1.equal(r2, eq);
+            });
+}
+
+bool row_cache::can_memoize_slice(const query::partition_slice& slice) {
+    // Reversed slices are emitted in reverse order, which replay from a
+    // materialized mutation wouldn't preserve. Per-partition specific ranges
+    // are not worth the more complex key.
+    return !slice.options.contains(query::partition_slice::option::reversed)
+        && !slice.get_specific_ranges();
+}
+
+std::optional<flat_mutation_reader>
+row_cache::lookup_memoized_slice(const schema_ptr& s, const dht::decorated_key& dk, const query::partition_slice& slice) {
+    auto rng = _slice_memo.equal_range(dk.token());
+    for (auto i = rng.first; i != rng.second; ++i) {
+        memoized_slice_read& m = i->second;
+        if (m.result->schema()->version() == s->version()
+                && m.result->decorated_key().equal(*_schema, dk)
+                && slices_equal(*_schema, m.slice, slice)) {
+            _tracker.on_memoized_slice_hit();
+            on_partition_hit();
+            std::vector<mutation> ms;
+            ms.emplace_back(*m.result);
+            return flat_mutation_reader_from_mutations(std::move(ms));
+        }
+    }
+    return std::nullopt;
+}
+
+void row_cache::memoize_slice_read(const dht::decorated_key& dk, const query::partition_slice& slice, mutation&& m) {
+    auto rng = _slice_memo.equal_range(dk.token());
+    for (auto i = rng.first; i != rng.second; ++i) {
+        if (i->second.result->decorated_key().equal(*_schema, dk) && slices_equal(*_schema, i->second.slice, slice)) {
+            i->second.result = make_lw_shared<const mutation>(std::move(m));
+            return;
+        }
+    }
+    if (_slice_memo.size() >= max_memoized_slice_reads) {
+        // Simple wholesale replacement policy. The memo is rebuilt from
+        // completed reads, so dropping it only costs the next read of each
+        // memoized slice a snapshot walk.
+        _slice_memo.clear();
+    }
+    _slice_memo.emplace(dk.token(), memoized_slice_read{query::partition_slice(slice), make_lw_shared<const mutation>(std::move(m))});
+    _tracker.on_memoized_slice_insertion();
+}
+
+bool row_cache::is_known_absent(const dht::decorated_key& dk) const {
+    auto rng = _negative_cache.equal_range(dk.token());
+    for (auto i = rng.first; i != rng.second; ++i) {
+        if (i->second.equal(*_schema, dk)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void row_cache::note_absent(const dht::decorated_key& dk) {
+    if (is_known_absent(dk)) {
+        return;
+    }
+    if (_negative_cache.size() >= max_negative_entries) {
+        // Simple wholesale policy, as for the slice memo: entries are
+        // re-created cheaply by the misses themselves.
+        _negative_cache.clear();
+    }
+    _negative_cache.emplace(dk.token(), dk);
+    _tracker.on_negative_insertion();
+}
+
+// Wraps a single-partition cache read and records the stream it produces.
+// When the wrapped reader reaches end-of-stream the rebuilt result is handed
+// to row_cache::memoize_slice_read(). Recording is abandoned when the read is
+// consumed partially or the result grows beyond the memoization size limit.
+class slice_memoizing_reader final : public flat_mutation_reader::impl {
+    // Results larger than this are not worth keeping around; they would
+    // quickly dominate the memo while being the least likely to repeat
+    // verbatim.
+    static constexpr size_t max_recorded_size = 128 * 1024;
+
+    struct rebuilding_consumer {
+        mutation_rebuilder& _rebuilder;
+        stop_iteration consume(static_row&& sr) { return _rebuilder.consume(std::move(sr)); }
+        stop_iteration consume(clustering_row&& cr) { return _rebuilder.consume(std::move(cr)); }
+        stop_iteration consume(range_tombstone&& rt) { return _rebuilder.consume(std::move(rt)); }
+        stop_iteration consume(partition_start&& ps) { return _rebuilder.consume(ps.partition_tombstone()); }
+        stop_iteration consume(partition_end&&) { return stop_iteration::yes; }
+    };
+
+    row_cache& _cache;
+    flat_mutation_reader _underlying;
+    dht::decorated_key _key;
+    // Population phase at the time the read started. The result is only
+    // memoized if the phase still matches at end-of-stream; otherwise an
+    // update() ran concurrently and the result may predate it.
+    row_cache::phase_type _phase;
+    const query::partition_slice& _slice;
+    std::optional<mutation_rebuilder> _rebuilder;
+    size_t _recorded_size = 0;
+    bool _saw_fragment = false;
+    bool _abandoned = false;
+private:
+    void record(const mutation_fragment& mf) {
+        if (!_rebuilder) {
+            return;
+        }
+        _recorded_size += mf.memory_usage(*_schema);
+        if (_recorded_size > max_recorded_size) {
+            _rebuilder = std::nullopt;
+            return;
+        }
+        mutation_fragment copy(*_schema, mf);
+        rebuilding_consumer c{*_rebuilder};
+        std::move(copy).consume(c);
+    }
+    void maybe_memoize() {
+        if (!_abandoned && !_saw_fragment) {
+            // The underlying source produced nothing at all for this key, so
+            // the partition is definitively absent -- unless an update() ran
+            // since this read started, in which case the partition may have
+            // just been inserted; the phase check rejects that, like for the
+            // slice memo.
+            if (_phase == _cache.phase_of(_key)) {
+                _cache.note_absent(_key);
+            }
+            _rebuilder = std::nullopt;
+            return;
+        }
+        if (!_rebuilder) {
+            return;
+        }
+        auto mo = _rebuilder->consume_end_of_stream();
+        _rebuilder = std::nullopt;
+        // Re-check the phase like the other population paths do: an
+        // update() may have run since this read started and already dropped
+        // the memo, in which case this result would re-insert stale data.
+        if (mo && _phase == _cache.phase_of(_key)) {
+            _cache.memoize_slice_read(_key, _slice, std::move(*mo));
+        }
+    }
+public:
+    slice_memoizing_reader(row_cache& cache, flat_mutation_reader rd, dht::decorated_key key, const query::partition_slice& slice)
+        : impl(rd.schema())
+        , _cache(cache)
+        , _underlying(std::move(rd))
+        , _key(std::move(key))
+        , _phase(_cache.phase_of(_key))
+        , _slice(slice)
+        , _rebuilder(mutation_rebuilder(_key, _schema))
+    { }
+    virtual future<> fill_buffer(db::timeout_clock::time_point timeout) override {
+        return _underlying.fill_buffer(timeout).then([this] {
+            while (!_underlying.is_buffer_empty()) {
+                auto mf = _underlying.pop_mutation_fragment();
+                _saw_fragment = true;
+                record(mf);
+                push_mutation_fragment(std::move(mf));
+            }
+            if (_underlying.is_end_of_stream()) {
+                _end_of_stream = true;
+                maybe_memoize();
+            }
+        });
+    }
+    virtual void next_partition() override {
+        _rebuilder = std::nullopt;
+        _abandoned = true;
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            _end_of_stream = _underlying.is_end_of_stream();
+            _underlying.next_partition();
+        }
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr, db::timeout_clock::time_point timeout) override {
+        _rebuilder = std::nullopt;
+        _abandoned = true;
+        clear_buffer();
+        _end_of_stream = false;
+        return _underlying.fast_forward_to(pr, timeout);
+    }
+    virtual future<> fast_forward_to(position_range cr, db::timeout_clock::time_point timeout) override {
+        throw std::bad_function_call();
+    }
+    virtual size_t buffer_size() const override {
+        return flat_mutation_reader::impl::buffer_size() + _underlying.buffer_size();
+    }
+};
+
 class range_populating_reader {
     row_cache& _cache;
     autoupdating_underlying_reader& _reader;
@@ -580,6 +922,8 @@ private:
     flat_mutation_reader read_from_entry(cache_entry& ce) {
         _cache.upgrade_entry(ce);
         _cache.on_partition_hit();
+        _cache.sample_partition_hit(ce);
+        ce.mark_accessed();
         return ce.read(_cache, *_read_context);
     }
 
@@ -741,6 +1085,24 @@ row_cache::make_reader(schema_ptr s,
     auto ctx = make_lw_shared<read_context>(*this, s, range, slice, pc, trace_state, fwd_mr);
 
     if (!ctx->is_range_query() && !fwd_mr) {
+        const bool memoize = can_memoize_slice(slice);
+        if (is_known_absent(ctx->key())) {
+            _tracker.on_negative_hit();
+            on_partition_hit();
+            auto mr = make_empty_flat_reader(std::move(s));
+            if (fwd == streamed_mutation::forwarding::yes) {
+                return make_forwardable(std::move(mr));
+            }
+            return mr;
+        }
+        if (memoize) {
+            if (auto mr = lookup_memoized_slice(s, ctx->key(), slice)) {
+                if (fwd == streamed_mutation::forwarding::yes) {
+                    return make_forwardable(std::move(*mr));
+                }
+                return std::move(*mr);
+            }
+        }
         auto mr = _read_section(_tracker.region(), [&] {
             return with_linearized_managed_bytes([&] {
                 cache_entry::compare cmp(_schema);
@@ -750,16 +1112,30 @@ row_cache::make_reader(schema_ptr s,
                     cache_entry& e = *i;
                     upgrade_entry(e);
                     on_partition_hit();
+                    sample_partition_hit(e);
+                    e.mark_accessed();
                     return e.read(*this, *ctx);
                 } else if (i->continuous()) {
                     return make_empty_flat_reader(std::move(s));
                 } else {
+                    if (memoize) {
+                        if (auto mo = _tracker.lookup_cold(s, ctx->key())) {
+                            on_partition_hit();
+                            std::vector<mutation> ms;
+                            ms.emplace_back(std::move(*mo));
+                            return flat_mutation_reader_from_mutations(std::move(ms), slice);
+                        }
+                    }
                     on_partition_miss();
                     return make_flat_mutation_reader<single_partition_populating_reader>(*this, std::move(ctx));
                 }
             });
         });
 
+        if (memoize) {
+            mr = make_flat_mutation_reader<slice_memoizing_reader>(*this, std::move(mr), ctx->key(), slice);
+        }
+
         if (fwd == streamed_mutation::forwarding::yes) {
             return make_forwardable(std::move(mr));
         } else {
@@ -776,7 +1152,47 @@ row_cache::make_reader(schema_ptr s,
 }
 
 
+// Splits range into up to `parts` disjoint sub-ranges covering it, by
+// recursively halving the token range. Stops early when the range becomes
+// too narrow to split further.
+static void split_range_for_population(const dht::partition_range& range, unsigned parts, dht::partition_range_vector& out) {
+    if (parts <= 1) {
+        out.push_back(range);
+        return;
+    }
+    auto& start_token = range.start() ? range.start()->value().token() : dht::minimum_token();
+    auto& end_token = range.end() ? range.end()->value().token() : dht::maximum_token();
+    auto mid = dht::global_partitioner().midpoint(start_token, end_token);
+    if (mid == start_token || mid == end_token) {
+        out.push_back(range);
+        return;
+    }
+    auto left = dht::partition_range(range.start(),
+        dht::partition_range::bound(dht::ring_position::ending_at(mid), true));
+    auto right = dht::partition_range(
+        dht::partition_range::bound(dht::ring_position::ending_at(mid), false),
+        range.end());
+    split_range_for_population(left, parts / 2, out);
+    split_range_for_population(right, parts - parts / 2, out);
+}
+
+future<> row_cache::prepopulate(const dht::partition_range& range, unsigned concurrency) {
+    dht::partition_range_vector subranges;
+    subranges.reserve(concurrency);
+    split_range_for_population(range, concurrency, subranges);
+    return do_with(std::move(subranges), [this] (dht::partition_range_vector& subranges) {
+        return parallel_for_each(subranges, [this] (const dht::partition_range& pr) {
+            return do_with(make_reader(_schema, pr), [] (flat_mutation_reader& rd) {
+                return rd.consume_pausable([] (mutation_fragment&&) {
+                    return stop_iteration::no;
+                }, db::no_timeout);
+            });
+        });
+    });
+}
+
 row_cache::~row_cache() {
+    _tracker.drop_cold_entries(_schema);
     with_allocator(_tracker.allocator(), [this] {
         _partitions.clear_and_dispose([this, deleter = current_deleter<cache_entry>()] (auto&& p) mutable {
             if (!p->is_dummy_entry()) {
@@ -789,6 +1205,8 @@ row_cache::~row_cache() {
 }
 
 void row_cache::clear_now() noexcept {
+    drop_slice_memo();
+    _tracker.drop_cold_entries(_schema);
     with_allocator(_tracker.allocator(), [this] {
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this, deleter = current_deleter<cache_entry>()] (auto&& p) mutable {
             _tracker.on_partition_erase();
@@ -837,6 +1255,7 @@ cache_entry& row_cache::find_or_create(const dht::decorated_key& key, tombstone
     return do_find_or_create_entry(key, previous, [&] (auto i) { // create
         auto entry = current_allocator().construct<cache_entry>(cache_entry::incomplete_tag{}, _schema, key, t);
         _tracker.insert(*entry);
+        ++_stats.populations_from_read_miss;
         return _partitions.insert_before(i, *entry);
     }, [&] (auto i) { // visit
         _tracker.on_miss_already_populated();
@@ -847,11 +1266,14 @@ cache_entry& row_cache::find_or_create(const dht::decorated_key& key, tombstone
 }
 
 void row_cache::populate(const mutation& m, const previous_entry_pointer* previous) {
+  drop_slice_memo();
+  _tracker.drop_cold_entries(_schema);
   _populate_section(_tracker.region(), [&] {
     do_find_or_create_entry(m.decorated_key(), previous, [&] (auto i) {
         cache_entry* entry = current_allocator().construct<cache_entry>(
                 m.schema(), m.decorated_key(), m.partition());
         _tracker.insert(*entry);
+        ++_stats.populations_from_read_miss;
         entry->set_continuous(i->continuous());
         i = _partitions.insert_before(i, *entry);
         upgrade_entry(*i);
@@ -1006,8 +1428,23 @@ future<> row_cache::update(external_updater eu, memtable& m) {
         //        search it.
         if (cache_i != partitions_end() && cache_i->key().equal(*_schema, mem_e.key())) {
             cache_entry& entry = *cache_i;
+            if (_tracker.predicts_eviction_before_next_read(entry.last_accessed())) {
+                // Merging into an entry which the LRU will get to before
+                // anyone reads it again is wasted work which only delays the
+                // flush. Evict it instead and let the next read, if it ever
+                // comes, repopulate from sstables.
+                // The entry holds only pre-merge content here, and the
+                // memtable partition is not merged into it; parking it in
+                // the cold tier would serve reads without the flushed
+                // writes, so evict without the cold offer.
+                entry.evict(_tracker);
+                entry.on_evicted_without_cold_offer(_tracker);
+                _tracker.on_memtable_update_bypass();
+                return make_empty_coroutine();
+            }
             upgrade_entry(entry);
             _tracker.on_partition_merge();
+            ++_stats.populations_from_memtable;
             return entry.partition().apply_to_incomplete(*_schema, std::move(mem_e.partition()), *mem_e.schema(), _tracker.memtable_cleaner(),
                 alloc, _tracker.region(), _tracker, _underlying_phase, acc);
         } else if (cache_i->continuous()
@@ -1019,6 +1456,7 @@ future<> row_cache::update(external_updater eu, memtable& m) {
                 partition_entry::make_evictable(*_schema, mutation_partition(_schema)));
             entry->set_continuous(cache_i->continuous());
             _tracker.insert(*entry);
+            ++_stats.populations_from_memtable;
             _partitions.insert_before(cache_i, *entry);
             return entry->partition().apply_to_incomplete(*_schema, std::move(mem_e.partition()), *mem_e.schema(), _tracker.memtable_cleaner(),
                 alloc, _tracker.region(), _tracker, _underlying_phase, acc);
@@ -1038,7 +1476,8 @@ future<> row_cache::update_invalidating(external_updater eu, memtable& m) {
             // This invalidates all information about the partition.
             cache_entry& e = *cache_i;
             e.evict(_tracker);
-            e.on_evicted(_tracker);
+            // Invalidated content must not survive in the cold tier either.
+            e.on_evicted_without_cold_offer(_tracker);
         } else {
             _tracker.clear_continuity(*cache_i);
         }
@@ -1056,6 +1495,7 @@ void row_cache::touch(const dht::decorated_key& dk) {
   with_linearized_managed_bytes([&] {
     auto i = _partitions.find(dk, cache_entry::compare(_schema));
     if (i != _partitions.end()) {
+        i->mark_accessed();
         for (partition_version& pv : i->partition().versions_from_oldest()) {
             for (rows_entry& row : pv.partition().clustered_rows()) {
                 _tracker.touch(row);
@@ -1082,6 +1522,8 @@ void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
 }
 
 void row_cache::invalidate_locked(const dht::decorated_key& dk) {
+    drop_slice_memo();
+    _tracker.drop_cold_entries(_schema);
     auto pos = _partitions.lower_bound(dk, cache_entry::compare(_schema));
     if (pos == partitions_end() || !pos->key().equal(*_schema, dk)) {
         _tracker.clear_continuity(*pos);
@@ -1121,7 +1563,91 @@ void row_cache::evict(const dht::partition_range& range) {
     invalidate_unwrapped(range);
 }
 
+std::vector<dht::decorated_key> row_cache::cached_partition_keys(size_t max) {
+    std::vector<dht::decorated_key> keys;
+    keys.reserve(std::min(max, _partitions.size()));
+    // Our own allocations could trigger reclaim, which would invalidate the
+    // iterator, so keep it away while we walk the set.
+    logalloc::reclaim_lock _(_tracker.region());
+    for (auto& e : _partitions) {
+        if (keys.size() == max) {
+            break;
+        }
+        if (e.is_dummy_entry()) {
+            continue;
+        }
+        keys.emplace_back(e.key());
+    }
+    return keys;
+}
+
+size_t row_cache::purge_expired_tombstones(size_t max_rows) {
+    auto now = gc_clock::now();
+    auto gc_before = now - _schema->gc_grace_seconds();
+    size_t scanned = 0;
+    size_t purged = 0;
+    // Our own allocations could trigger reclaim, which would invalidate the
+    // iterators, so keep it away while we walk the set.
+    logalloc::reclaim_lock _(_tracker.region());
+    with_allocator(_tracker.allocator(), [&] {
+      with_linearized_managed_bytes([&] {
+        auto cmp = cache_entry::compare(_schema);
+        auto it = _tombstone_purge_pos
+                ? _partitions.upper_bound(*_tombstone_purge_pos, cmp)
+                : _partitions.begin();
+        while (it != partitions_end() && scanned < max_rows) {
+            cache_entry& ce = *it++;
+            with_allocator(standard_allocator(), [&] {
+                _tombstone_purge_pos = ce.key();
+            });
+            // Walk only the latest version. Rows in older versions are owned
+            // by snapshots and are squashed or evicted independently.
+            mutation_partition& mp = ce.partition().version()->partition();
+            const auto partition_tomb = mp.partition_tombstone();
+            auto& rows = mp.clustered_rows();
+            auto rit = rows.begin();
+            while (rit != rows.end() && scanned < max_rows) {
+                rows_entry& r = *rit++;
+                if (r.dummy()) {
+                    continue;
+                }
+                ++scanned;
+                tombstone t = partition_tomb;
+                t.apply(r.row().deleted_at().tomb());
+                // Entries can lag behind the cache's schema until a read
+                // upgrades them, so interpret rows with the entry's schema.
+                if (!t || t.deletion_time >= gc_before || r.row().is_live(*ce.schema(), t, now)) {
+                    continue;
+                }
+                // Evicting the last row cascades into eviction of the whole
+                // entry, which invalidates rit; stop the row walk there.
+                bool last_row = &r == &*rows.begin() && rit != rows.end() && rit->is_last_dummy();
+                r.on_evicted(_tracker);
+                ++purged;
+                if (last_row) {
+                    break;
+                }
+            }
+        }
+        if (it == partitions_end()) {
+            with_allocator(standard_allocator(), [&] {
+                _tombstone_purge_pos = std::nullopt; // wrap around on the next pass
+            });
+        }
+      });
+    });
+    if (purged) {
+        _tracker.on_rows_purged(purged);
+        // Readers may hold iterators into the modified rows trees; make them
+        // revalidate, as they would have to after an eviction.
+        _tracker.allocator().invalidate_references();
+    }
+    return purged;
+}
+
 void row_cache::invalidate_unwrapped(const dht::partition_range& range) {
+    drop_slice_memo();
+    _tracker.drop_cold_entries(_schema);
     logalloc::reclaim_lock _(_tracker.region());
 
     auto cmp = cache_entry::compare(_schema);
@@ -1174,15 +1700,26 @@ void cache_entry::evict(cache_tracker& tracker) noexcept {
 }
 
 void row_cache::set_schema(schema_ptr new_schema) noexcept {
+    drop_slice_memo();
+    _tracker.drop_cold_entries(_schema);
     _schema = std::move(new_schema);
 }
 
 void cache_entry::on_evicted(cache_tracker& tracker) noexcept {
+    tracker.offer_cold(*this);
+    on_evicted_without_cold_offer(tracker);
+}
+
+void cache_entry::on_evicted_without_cold_offer(cache_tracker& tracker) noexcept {
+    auto age = lowres_clock::now() - _populated_at;
+    // The invalidation paths call evict() before getting here, which leaves
+    // the entry without a version; report those evictions as zero rows.
+    uint64_t rows = (is_dummy_entry() || !_pe.version()) ? 0 : _pe.version()->partition().clustered_rows().calculate_size();
     auto it = row_cache::partitions_type::s_iterator_to(*this);
     std::next(it)->set_continuous(false);
     evict(tracker);
     current_deleter<cache_entry>()(this);
-    tracker.on_partition_eviction();
+    tracker.on_partition_eviction(age, rows);
 }
 
 void rows_entry::on_evicted(cache_tracker& tracker) noexcept {
@@ -1264,6 +1801,12 @@ future<> row_cache::do_update(row_cache::external_updater eu, row_cache::interna
         auto pos = dht::ring_position::min();
         eu();
         [&] () noexcept {
+            this->drop_slice_memo();
+            _tracker.drop_cold_entries(_schema);
+            // Entries evicted from now until the update completes may still
+            // hold pre-update content, which the cold tier would serve as the
+            // complete read result. Keep it closed until the merge is done.
+            _tracker.suppress_cold_offers();
             _prev_snapshot_pos = std::move(pos);
             _prev_snapshot = std::exchange(_underlying, _snapshot_source());
             ++_underlying_phase;
@@ -1271,6 +1814,7 @@ future<> row_cache::do_update(row_cache::external_updater eu, row_cache::interna
         return futurize_apply([&iu] {
             return iu();
         }).then_wrapped([this, permit = std::move(permit)] (auto f) {
+            _tracker.unsuppress_cold_offers();
             _prev_snapshot_pos = {};
             _prev_snapshot = {};
             if (f.failed()) {
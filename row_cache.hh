@@ -21,12 +21,16 @@
 
 #pragma once
 
+#include <list>
+#include <unordered_map>
+
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/intrusive/parent_from_member.hpp>
 
 #include <seastar/core/memory.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/util/noncopyable_function.hh>
 
 #include "mutation_reader.hh"
@@ -74,6 +78,12 @@ class cache_entry {
         bool _continuous : 1;
         bool _dummy_entry : 1;
     } _flags{};
+    // When this entry was inserted into cache; used for the eviction age
+    // histogram.
+    lowres_clock::time_point _populated_at = lowres_clock::now();
+    // When this entry was last used by a read; used by the update-bypass
+    // heuristic in row_cache::update().
+    lowres_clock::time_point _last_accessed = lowres_clock::now();
     cache_link_type _cache_link;
     friend class size_calculator;
 
@@ -125,7 +135,12 @@ public:
 
     // Called when all contents have been evicted.
     // This object should unlink and destroy itself from the container.
+    // Offers the entry's content to the tracker's cold tier first.
     void on_evicted(cache_tracker&) noexcept;
+    // Like on_evicted(), but never offers the content to the cold tier.
+    // For paths which evict because the content is stale or about to
+    // become stale, not because of memory pressure.
+    void on_evicted_without_cold_offer(cache_tracker&) noexcept;
     // Evicts contents of this entry.
     // The caller is still responsible for unlinking and destroying this entry.
     void evict(cache_tracker&) noexcept;
@@ -148,6 +163,10 @@ public:
 
     bool is_dummy_entry() const { return _flags._dummy_entry; }
 
+    // Called when the entry is used by a read.
+    void mark_accessed() { _last_accessed = lowres_clock::now(); }
+    lowres_clock::time_point last_accessed() const { return _last_accessed; }
+
     struct compare {
         dht::ring_position_less_comparator _c;
 
@@ -212,9 +231,11 @@ public:
         uint64_t partition_removals;
         uint64_t row_evictions;
         uint64_t row_removals;
+        uint64_t rows_purged;
         uint64_t partitions;
         uint64_t rows;
         uint64_t mispopulations;
+        uint64_t memtable_update_bypasses;
         uint64_t underlying_recreations;
         uint64_t underlying_partition_skips;
         uint64_t underlying_row_skips;
@@ -222,11 +243,43 @@ public:
         uint64_t reads_with_misses;
         uint64_t reads_done;
         uint64_t pinned_dirty_memory_overload;
+        uint64_t memoized_slice_hits;
+        uint64_t memoized_slice_insertions;
+        uint64_t cold_tier_hits;
+        uint64_t cold_tier_insertions;
+        uint64_t cold_tier_evictions;
+        uint64_t cold_tier_promotions;
+        uint64_t negative_hits;
+        uint64_t negative_insertions;
+
+        // Age of partitions at the time they were evicted from the LRU, in
+        // milliseconds, and their size in rows. Eviction already walks the
+        // partition, so counting the rows there is free.
+        utils::estimated_histogram partition_eviction_age;
+        utils::estimated_histogram partition_evictions_by_rows;
 
         uint64_t active_reads() const {
             return reads - reads_done;
         }
     };
+private:
+    // Cold tier of the cache. When a fully cached partition is evicted from
+    // the LRU under memory pressure, its frozen representation is
+    // LZ4-compressed and parked here instead of being dropped outright.
+    // Reads which miss in the hot tier rehydrate from this store without
+    // going to sstables, trading decompression CPU for effective cache
+    // capacity. Entries read often enough are promoted back to the hot tier
+    // by letting the read take the regular populating miss path.
+    struct cold_entry {
+        schema_ptr schema;
+        dht::decorated_key key;
+        bytes compressed;
+        size_t uncompressed_size;
+        uint64_t hits = 0;
+    };
+    using cold_store_list = std::list<cold_entry>;
+    static constexpr size_t max_cold_store_size = 8 * 1024 * 1024;
+    static constexpr uint64_t cold_promotion_threshold = 4;
 private:
     stats _stats{};
     seastar::metrics::metric_groups _metrics;
@@ -234,8 +287,16 @@ private:
     lru_type _lru;
     mutation_cleaner _garbage;
     mutation_cleaner _memtable_cleaner;
+    cold_store_list _cold_store; // in insertion order, oldest first
+    std::unordered_multimap<dht::token, cold_store_list::iterator> _cold_index;
+    size_t _cold_store_size = 0;
+    bool _clearing = false;
+    // Number of cache updates in flight across the tables sharing this
+    // tracker. Non-zero suppresses offer_cold(), see suppress_cold_offers().
+    unsigned _cold_offer_suppressions = 0;
 private:
     void setup_metrics();
+    void erase_cold_entry(cold_store_list::iterator);
 public:
     cache_tracker();
     ~cache_tracker();
@@ -253,11 +314,39 @@ public:
     void on_partition_hit();
     void on_partition_miss();
     void on_partition_eviction();
+    void on_partition_eviction(lowres_clock::duration age, uint64_t rows) noexcept;
     void on_row_eviction();
     void on_row_hit();
     void on_row_miss();
     void on_miss_already_populated();
     void on_mispopulate();
+    void on_memtable_update_bypass();
+    void on_rows_purged(uint64_t n) { _stats.rows_purged += n; }
+    // Returns true when an entry which was last used by a read at
+    // last_accessed will probably be evicted before it is read again,
+    // judging by the age at which partitions have been leaving the LRU.
+    bool predicts_eviction_before_next_read(lowres_clock::time_point last_accessed) const;
+    void on_memoized_slice_hit() { ++_stats.memoized_slice_hits; }
+    void on_memoized_slice_insertion() { ++_stats.memoized_slice_insertions; }
+    void on_negative_hit() { ++_stats.negative_hits; }
+    void on_negative_insertion() { ++_stats.negative_insertions; }
+    // Offers the contents of an entry being evicted from the LRU to the cold
+    // tier. Best effort; gives up on any allocation failure.
+    void offer_cold(cache_entry&) noexcept;
+    // Closes the cold tier to new entries for the duration of a cache
+    // update. Cold entries carry no population phase, so an entry evicted
+    // while a memtable merge is in flight could park pre-merge content and
+    // later serve reads without the flushed writes. Counted, because the
+    // tracker is shared by all tables on the shard.
+    void suppress_cold_offers() noexcept { ++_cold_offer_suppressions; }
+    void unsuppress_cold_offers() noexcept { --_cold_offer_suppressions; }
+    // Rehydrates a partition from the cold tier, if present. Returns nullopt
+    // on a cold miss, and also when the entry has been read often enough to
+    // deserve promotion, in which case it is dropped so that the read
+    // repopulates the hot tier through the regular miss path.
+    std::optional<mutation> lookup_cold(const schema_ptr&, const dht::decorated_key&);
+    // Drops all cold tier entries belonging to the given table.
+    void drop_cold_entries(const schema_ptr&) noexcept;
     void on_row_processed_from_memtable() { ++_stats.rows_processed_from_memtable; }
     void on_row_dropped_from_memtable() { ++_stats.rows_dropped_from_memtable; }
     void on_row_merged_from_memtable() { ++_stats.rows_merged_from_memtable; }
@@ -339,10 +428,21 @@ public:
         utils::timed_rate_moving_average misses;
         utils::timed_rate_moving_average reads_with_misses;
         utils::timed_rate_moving_average reads_with_no_misses;
+        // Partition hits bucketed by the number of rows cached for the hit
+        // partition. Sampled on every 256th hit, since counting the rows
+        // walks the partition. Together with the eviction histograms in
+        // cache_tracker this shows which partition sizes actually benefit
+        // from cache memory for this table.
+        utils::estimated_histogram partition_hits_by_rows;
+        // How partitions got into the cache for this table.
+        uint64_t populations_from_memtable = 0;
+        uint64_t populations_from_read_miss = 0;
     };
 private:
     cache_tracker& _tracker;
     stats _stats{};
+    static constexpr uint64_t partition_hit_sample_rate = 256;
+    uint64_t _partition_hit_samples = 0;
     schema_ptr _schema;
     partitions_type _partitions; // Cached partitions are complete.
 
@@ -387,6 +487,56 @@ private:
     logalloc::allocating_section _update_section;
     logalloc::allocating_section _populate_section;
     logalloc::allocating_section _read_section;
+
+    // Memoized results of repeated identical single-partition slice reads.
+    //
+    // Dashboard-style workloads keep re-issuing the same clustering slice
+    // against the same hot partition. Even when the partition is fully cached,
+    // each such read walks the partition snapshot again. When a memoizable
+    // single-partition read runs to completion, its materialized result is
+    // remembered here, keyed by partition key and slice, and replayed for
+    // subsequent identical reads without touching the snapshot.
+    //
+    // The memo never outlives the data it was built from. It is dropped
+    // wholesale by the synchronizing methods (update(), invalidate()), by
+    // evict() and on schema change. Eviction of cache entries under memory
+    // pressure does not invalidate it, because the underlying mutation source
+    // still reflects the same writes.
+    struct memoized_slice_read {
+        query::partition_slice slice;
+        lw_shared_ptr<const mutation> result;
+    };
+    using slice_memo_map = std::unordered_multimap<dht::token, memoized_slice_read>;
+    slice_memo_map _slice_memo;
+    static constexpr size_t max_memoized_slice_reads = 1024;
+
+    // Negative lookup cache. When a single-partition read completes without
+    // producing any fragment, the key is definitively absent from the
+    // underlying source, and is recorded here so that subsequent point reads
+    // for it are answered with a hash lookup instead of probing sstable
+    // filters and indexes. High-miss-rate workloads (e.g. dedup checks) are
+    // dominated by such reads. Shares the invalidation discipline of the
+    // slice memo: dropped by all synchronizers, so a key made live by a
+    // flushed or streamed write is never reported absent.
+    std::unordered_multimap<dht::token, dht::decorated_key> _negative_cache;
+    static constexpr size_t max_negative_entries = 8192;
+
+    // Where the last purge_expired_tombstones() pass stopped; the next pass
+    // resumes from there, so the bounded passes cover the whole cache over time.
+    std::optional<dht::decorated_key> _tombstone_purge_pos;
+
+    static bool can_memoize_slice(const query::partition_slice&);
+    std::optional<flat_mutation_reader> lookup_memoized_slice(const schema_ptr&, const dht::decorated_key&, const query::partition_slice&);
+    void memoize_slice_read(const dht::decorated_key&, const query::partition_slice&, mutation&&);
+    bool is_known_absent(const dht::decorated_key&) const;
+    void note_absent(const dht::decorated_key&);
+    // Drops the slice memo and the negative cache; both are derived read
+    // results and share the same validity domain.
+    void drop_slice_memo() noexcept {
+        _slice_memo.clear();
+        _negative_cache.clear();
+    }
+
     flat_mutation_reader create_underlying_reader(cache::read_context&, mutation_source&, const dht::partition_range&);
     flat_mutation_reader make_scanning_reader(const dht::partition_range&, lw_shared_ptr<cache::read_context>);
     void on_partition_hit();
@@ -395,6 +545,7 @@ private:
     void on_row_miss();
     void on_static_row_insert();
     void on_mispopulate();
+    void sample_partition_hit(cache_entry&);
     void upgrade_entry(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void invalidate_unwrapped(const dht::partition_range&);
@@ -509,6 +660,17 @@ public:
     // Can only be called prior to any reads.
     void populate(const mutation& m, const previous_entry_pointer* previous = nullptr);
 
+    // Reads the given range through the cache using up to `concurrency`
+    // concurrent readers over disjoint sub-ranges, populating cache entries
+    // as a side effect. Intended for warming up cold ranges ahead of scans
+    // which would otherwise be bound by single-reader latency.
+    //
+    // Sub-ranges are obtained by recursive token midpoint splits, so the
+    // spread of work over readers is only as even as the data distribution.
+    // Coherency is maintained by the regular read path, which this reuses;
+    // concurrent updates and invalidation behave as for any other read.
+    future<> prepopulate(const dht::partition_range&, unsigned concurrency);
+
     // Synchronizes cache with the underlying data source from a memtable which
     // has just been flushed to the underlying data source.
     // The memtable can be queried during the process, but must not be written.
@@ -559,6 +721,26 @@ public:
     size_t partitions() const {
         return _partitions.size();
     }
+
+    // Returns the keys of up to max cached partitions, in ring order.
+    // What is in the cache is by construction the recently read set, so
+    // this doubles as a summary of the hot keys.
+    std::vector<dht::decorated_key> cached_partition_keys(size_t max);
+
+    // Evicts cached rows which carry no live data and whose tombstones
+    // expired before gc_grace_seconds ago. Such rows occupy memory and
+    // make every read skip over them, but contribute nothing to results;
+    // the underlying source purges them during its own compaction, so once
+    // past gc_grace they don't come back on repopulation either. Since this
+    // is plain (selective) eviction, it is safe regardless of concurrent
+    // reads and updates; affected ranges just become discontinuous.
+    //
+    // Examines at most max_rows rows per call and resumes on the next call
+    // where it left off, so each call is a small bounded amount of work.
+    // Only rows made dead by the partition tombstone or their own row
+    // tombstone are considered; range tombstones and static rows are left
+    // for regular eviction. Returns the number of rows evicted.
+    size_t purge_expired_tombstones(size_t max_rows);
     const cache_tracker& get_cache_tracker() const {
         return _tracker;
     }
@@ -573,6 +755,7 @@ public:
 
     friend class just_cache_scanning_reader;
     friend class scanning_and_populating_reader;
+    friend class slice_memoizing_reader;
     friend class range_populating_reader;
     friend class cache_tracker;
     friend class mark_end_as_continuous;
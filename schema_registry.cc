@@ -292,6 +292,23 @@ schema_ptr global_schema_ptr::get() const {
     }
 }
 
+void schema_registry::prewarm(const global_schema_ptr& gs) {
+    // get() thaws the version into this shard's registry if it wasn't
+    // there already. Referencing the result from _prewarmed keeps the entry
+    // alive past the grace period, until enough newer versions push it out.
+    auto s = gs.get();
+    slogger.debug("Pre-warmed version {} of {}.{}", s->version(), s->ks_name(), s->cf_name());
+    for (const auto& p : _prewarmed) {
+        if (p->version() == s->version()) {
+            return;
+        }
+    }
+    if (_prewarmed.size() >= max_prewarmed_schemas) {
+        _prewarmed.pop_front();
+    }
+    _prewarmed.push_back(std::move(s));
+}
+
 global_schema_ptr::global_schema_ptr(const schema_ptr& ptr)
     : _ptr([&ptr]() {
         // _ptr must always have an associated registry entry,
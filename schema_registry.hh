@@ -22,6 +22,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <deque>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/timer.hh>
 #include <seastar/core/shared_future.hh>
@@ -33,6 +34,7 @@ class schema_ctxt;
 }
 
 class schema_registry;
+class global_schema_ptr;
 
 using async_schema_loader = std::function<future<frozen_schema>(table_schema_version)>;
 using schema_loader = std::function<frozen_schema(table_schema_version)>;
@@ -116,6 +118,11 @@ public:
 class schema_registry {
     std::unordered_map<table_schema_version, lw_shared_ptr<schema_registry_entry>> _entries;
     std::unique_ptr<db::schema_ctxt> _ctxt;
+    // Recently pre-warmed schemas, referenced here so their entries survive
+    // until the first requests actually use them. Bounded; new versions push
+    // the oldest ones out.
+    static constexpr size_t max_prewarmed_schemas = 16;
+    std::deque<schema_ptr> _prewarmed;
 
     friend class schema_registry_entry;
     schema_registry_entry& get_entry(table_schema_version) const;
@@ -156,6 +163,13 @@ public:
     // because doing so ensures that the entry will be kept in the registry as
     // long as the schema is actively used.
     schema_ptr learn(const schema_ptr&);
+
+    // Thaws a schema version which originated on another shard into this
+    // shard's registry and keeps it referenced for a while. Used to pre-warm
+    // shards when a new schema version is learned, so that the first
+    // requests using the version don't block on the thaw or, worse, fetch
+    // the version from a remote node again.
+    void prewarm(const global_schema_ptr&);
 };
 
 schema_registry& local_schema_registry();
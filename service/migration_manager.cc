@@ -967,10 +967,25 @@ static future<> maybe_sync(const schema_ptr& s, netw::messaging_service::msg_add
 }
 
 future<schema_ptr> get_schema_definition(table_schema_version v, netw::messaging_service::msg_addr dst) {
+    if (auto s = local_schema_registry().get_or_null(v)) {
+        return make_ready_future<schema_ptr>(std::move(s));
+    }
     return local_schema_registry().get_or_load(v, [dst] (table_schema_version v) {
         mlogger.debug("Requesting schema {} from {}", v, dst);
         auto& ms = netw::get_local_messaging_service();
         return ms.send_get_schema_version(dst, v);
+    }).then([] (schema_ptr s) {
+        // This was the first time this node saw the version. Pre-warm the
+        // other shards while we still hold the entry: each of them would
+        // otherwise thaw the version on the hot path of its first request
+        // using it, or worse, ask dst for the definition all over again.
+        // Locally committed schema changes don't need this, because
+        // update_column_family() learns the new version on every shard.
+        return smp::invoke_on_all([gs = global_schema_ptr(s)] {
+            local_schema_registry().prewarm(gs);
+        }).then([s] {
+            return s;
+        });
     });
 }
 
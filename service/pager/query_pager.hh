@@ -76,6 +76,22 @@ protected:
     bool _exhausted = false;
     uint32_t _max;
 
+    // Target serialized size of one page. A page of page_size rows of a
+    // wide-row table can be arbitrarily large, so subsequent fetches are
+    // clamped to the number of rows which, at the bytes-per-row achieved by
+    // the previous page, stays near this budget.
+    static constexpr size_t page_size_goal_bytes = 1 << 20;
+    // Never clamp below this many rows, so that queries with grossly
+    // oversized rows still make progress at a reasonable round-trip rate.
+    static constexpr uint32_t min_rows_per_page = 100;
+    // Serialized bytes per row achieved by the last non-empty page. 0 until
+    // the first page is consumed, which means "no clamping".
+    size_t _bytes_per_row_estimate = 0;
+    // Row limit actually sent with the last fetch; may be smaller than the
+    // page size the user asked for when the byte budget clamped it. The
+    // exhaustion check must compare against this, not against page_size.
+    uint32_t _last_fetched_row_limit = std::numeric_limits<uint32_t>::max();
+
     std::optional<partition_key> _last_pkey;
     std::optional<clustering_key> _last_ckey;
 
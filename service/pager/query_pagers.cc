@@ -89,9 +89,16 @@ static bool has_clustering_keys(const schema& s, const query::read_command& cmd)
             _cmd->is_first_page = false;
             _last_replicas = state->get_last_replicas();
             _query_read_repair_decision = state->get_query_read_repair_decision();
-        } else {
+        } else if (!_last_pkey) {
             _cmd->query_uuid = utils::make_random_uuid();
             _cmd->is_first_page = true;
+        } else {
+            // A subsequent page fetched through the same pager, as happens
+            // when aggregation or filtering pages internally. Keep the
+            // query_uuid assigned on the first page and stop advertising a
+            // first page, so that the replicas resume the queriers they
+            // saved instead of creating new readers for every page.
+            _cmd->is_first_page = false;
         }
         qlogger.trace("fetch_page query id {}", _cmd->query_uuid);
 
@@ -204,6 +211,17 @@ static bool has_clustering_keys(const schema& s, const query::read_command& cmd)
 
         auto max_rows = max_rows_to_fetch(page_size);
 
+        // Adapt the row limit toward the page byte budget. Replicas cut
+        // oversized pages on their own (short reads), but storage_proxy may
+        // run several sub-queries concurrently, each with the full row
+        // limit, so asking only for what is likely to fit keeps the page
+        // assembly memory bounded as well.
+        if (_bytes_per_row_estimate) {
+            auto budget_rows = std::max(uint32_t(page_size_goal_bytes / _bytes_per_row_estimate), min_rows_per_page);
+            max_rows = std::min(max_rows, budget_rows);
+        }
+        _last_fetched_row_limit = max_rows;
+
         // We always need PK so we can determine where to start next.
         _cmd->slice.options.set<query::partition_slice::option::send_partition_key>();
         // don't add empty bytes (cks) unless we have to
@@ -223,7 +241,7 @@ static bool has_clustering_keys(const schema& s, const query::read_command& cmd)
                 std::move(command),
                 std::move(ranges),
                 _options.get_consistency(),
-                {timeout, _state.get_trace_state(), std::move(_last_replicas), _query_read_repair_decision});
+                {timeout, _state.get_trace_state(), std::move(_last_replicas), _query_read_repair_decision, _state.get_abort_source()});
     }
 
     future<> query_pager::fetch_page(cql3::selection::result_set_builder& builder, uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) {
@@ -344,6 +362,10 @@ public:
 
         auto view = query::result_view(*results);
 
+        // A page is full when it reaches the row limit we actually sent,
+        // which the byte budget may have clamped below page_size.
+        const auto requested_rows = std::min(page_size, _last_fetched_row_limit);
+
         uint32_t row_count;
         if constexpr(!std::is_same_v<std::decay_t<Visitor>, noop_visitor>) {
             query_result_visitor<Visitor> v(std::forward<Visitor>(visitor));
@@ -355,13 +377,19 @@ public:
 
             row_count = v.total_rows - v.dropped_rows;
             _max = _max - row_count;
-            _exhausted = (v.total_rows < page_size && !results->is_short_read() && v.dropped_rows == 0) || _max == 0;
+            _exhausted = (v.total_rows < requested_rows && !results->is_short_read() && v.dropped_rows == 0) || _max == 0;
+            if (v.total_rows) {
+                _bytes_per_row_estimate = results->buf().size() / v.total_rows;
+            }
             _last_pkey = v.last_pkey;
             _last_ckey = v.last_ckey;
         } else {
             row_count = results->row_count() ? *results->row_count() : std::get<1>(view.count_partitions_and_rows());
             _max = _max - row_count;
-            _exhausted = (row_count < page_size && !results->is_short_read()) || _max == 0;
+            _exhausted = (row_count < requested_rows && !results->is_short_read()) || _max == 0;
+            if (row_count) {
+                _bytes_per_row_estimate = results->buf().size() / row_count;
+            }
 
             if (!_exhausted || row_count > 0) {
                 if (_last_pkey) {
@@ -23,6 +23,7 @@
 #ifndef SERVICE_QUERY_STATE_HH
 #define SERVICE_QUERY_STATE_HH
 
+#include <seastar/core/abort_source.hh>
 #include "service/client_state.hh"
 #include "tracing/tracing.hh"
 
@@ -32,11 +33,16 @@ class query_state final {
 private:
     client_state _client_state;
     tracing::trace_state_ptr _trace_state_ptr;
+    // Signalled when the client which issued the query goes away, so that
+    // in-flight reads can stop wasting resources. May be unset (e.g. for
+    // internal queries) and is only valid on the shard it was created on.
+    seastar::abort_source* _abort_source = nullptr;
 
 public:
-    query_state(client_state client_state)
+    query_state(client_state client_state, seastar::abort_source* abort_source = nullptr)
         : _client_state(client_state)
         , _trace_state_ptr(_client_state.get_trace_state())
+        , _abort_source(abort_source)
     { }
 
     const tracing::trace_state_ptr& get_trace_state() const {
@@ -57,6 +63,10 @@ public:
     api::timestamp_type get_timestamp() {
         return _client_state.get_timestamp();
     }
+
+    seastar::abort_source* get_abort_source() const {
+        return _abort_source;
+    }
 };
 
 }
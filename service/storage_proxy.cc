@@ -60,15 +60,19 @@
 #include "db/system_keyspace.hh"
 #include "exceptions/exceptions.hh"
 #include <boost/range/algorithm_ext/push_back.hpp>
+#include <boost/range/irange.hpp>
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/range/adaptors.hpp>
+#include <boost/algorithm/cxx11/all_of.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/cxx11/none_of.hpp>
 #include <boost/algorithm/cxx11/partition_copy.hpp>
 #include <boost/range/algorithm/count_if.hpp>
 #include <boost/range/algorithm/find.hpp>
 #include <boost/range/algorithm/find_if.hpp>
+#include <boost/range/algorithm/max_element.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
+#include <boost/range/algorithm/stable_partition.hpp>
 #include <boost/range/algorithm/heap_algorithm.hpp>
 #include <boost/range/numeric.hpp>
 #include <boost/range/algorithm/sort.hpp>
@@ -85,6 +89,7 @@
 #include "db/timeout_clock.hh"
 #include "multishard_mutation_query.hh"
 #include "database.hh"
+#include <algorithm>
 
 namespace service {
 
@@ -199,7 +204,7 @@ public:
     }
 };
 
-class abstract_write_response_handler : public seastar::enable_shared_from_this<abstract_write_response_handler> {
+class abstract_write_response_handler : public storage_proxy::handler_expiry_entry, public seastar::enable_shared_from_this<abstract_write_response_handler> {
 protected:
     storage_proxy::response_id_type _id;
     promise<> _ready; // available when cl is achieved
@@ -227,7 +232,6 @@ protected:
     size_t _all_failures = 0; // total amount of failures
     size_t _total_endpoints = 0;
     storage_proxy::write_stats& _stats;
-    timer<storage_proxy::clock_type> _expire_timer;
 
 protected:
     virtual bool waited_for(gms::inet_address from) = 0;
@@ -242,7 +246,7 @@ public:
             std::unique_ptr<mutation_holder> mh, std::unordered_set<gms::inet_address> targets, tracing::trace_state_ptr trace_state,
             storage_proxy::write_stats& stats, size_t pending_endpoints = 0, std::vector<gms::inet_address> dead_endpoints = {})
             : _id(p->get_next_response_id()), _proxy(std::move(p)), _trace_state(trace_state), _cl(cl), _type(type), _mutation_holder(std::move(mh)), _targets(std::move(targets)),
-              _dead_endpoints(std::move(dead_endpoints)), _stats(stats), _expire_timer([this] { timeout_cb(); }) {
+              _dead_endpoints(std::move(dead_endpoints)), _stats(stats) {
         // original comment from cassandra:
         // during bootstrap, include pending endpoints in the count
         // or we may fail the consistency level guarantees (see #833, #8058)
@@ -343,10 +347,11 @@ public:
         }
     }
     void expire_at(storage_proxy::clock_type::time_point timeout) {
-        _expire_timer.arm(timeout);
+        expiry = timeout;
+        _proxy->enqueue_expiry(*this);
     }
     void on_released() {
-        _expire_timer.cancel();
+        unlink(); // drop out of the expiry wheel, a no-op if already expired
         _mutation_holder->release_mutation();
     }
     void timeout_cb() {
@@ -383,7 +388,7 @@ public:
     std::chrono::microseconds calculate_delay(db::view::update_backlog backlog) {
         constexpr auto delay_limit_us = 1000000;
         auto adjust = [] (float x) { return x * x * x; };
-        auto budget = std::min(std::chrono::microseconds(0), std::chrono::microseconds(_expire_timer.get_timeout() - storage_proxy::clock_type::now()));
+        auto budget = std::min(std::chrono::microseconds(0), std::chrono::microseconds(expiry - storage_proxy::clock_type::now()));
         return std::min(
                 budget,
                 std::chrono::microseconds(uint32_t(adjust(backlog.relative_size()) * delay_limit_us)));
@@ -582,6 +587,42 @@ void storage_proxy::remove_response_handler(storage_proxy::response_id_type id)
     _response_handlers.erase(std::move(entry));
 }
 
+void storage_proxy::enqueue_expiry(handler_expiry_entry& e) {
+    auto tick = expiry_wheel_tick_of(e.expiry);
+    _expiry_wheel[tick % expiry_wheel_buckets].push_back(e);
+    if (!_expiry_tick_timer.armed()) {
+        _last_expiry_tick = clock_type::now().time_since_epoch() / expiry_wheel_tick;
+        _expiry_tick_timer.arm_periodic(expiry_wheel_tick);
+    }
+}
+
+void storage_proxy::expire_due_handlers() {
+    auto now = clock_type::now();
+    auto current_tick = now.time_since_epoch() / expiry_wheel_tick;
+    // Visit every bucket that became due since the last tick; if the reactor
+    // stalled we may have to sweep several, but never more than a full lap.
+    auto first_tick = _last_expiry_tick + 1;
+    if (current_tick - first_tick >= int64_t(expiry_wheel_buckets)) {
+        first_tick = current_tick - expiry_wheel_buckets + 1;
+    }
+    for (auto t = first_tick; t <= current_tick; t++) {
+        auto& bucket = _expiry_wheel[t % expiry_wheel_buckets];
+        auto it = bucket.begin();
+        while (it != bucket.end()) {
+            auto& e = *it++;
+            // an entry inserted more than a full lap ahead is not due yet
+            if (e.expiry <= now) {
+                e.unlink();
+                static_cast<abstract_write_response_handler&>(e).timeout_cb();
+            }
+        }
+    }
+    _last_expiry_tick = current_tick;
+    if (boost::algorithm::all_of(_expiry_wheel, [] (const expiry_bucket& b) { return b.empty(); })) {
+        _expiry_tick_timer.cancel();
+    }
+}
+
 
 void storage_proxy::got_response(storage_proxy::response_id_type id, gms::inet_address from, std::optional<db::view::update_backlog> backlog) {
     auto it = _response_handlers.find(id);
@@ -772,6 +813,7 @@ storage_proxy::~storage_proxy() {}
 storage_proxy::storage_proxy(distributed<database>& db, storage_proxy::config cfg, db::view::node_update_backlog& max_view_update_backlog)
     : _db(db)
     , _next_response_id(std::chrono::system_clock::now().time_since_epoch()/1ms)
+    , _expiry_tick_timer([this] { expire_due_handlers(); })
     , _hints_resource_manager(cfg.available_memory / 10)
     , _hints_for_views_manager(_db.local().get_config().view_hints_directory(), {}, _db.local().get_config().max_hint_window_in_ms(), _hints_resource_manager, _db)
     , _background_write_throttle_threahsold(cfg.available_memory / 10)
@@ -923,9 +965,23 @@ storage_proxy::mutate_locally(const schema_ptr& s, const frozen_mutation& m, clo
 
 future<>
 storage_proxy::mutate_locally(std::vector<mutation> mutations, clock_type::time_point timeout) {
-    return do_with(std::move(mutations), [this, timeout] (std::vector<mutation>& pmut){
-        return parallel_for_each(pmut.begin(), pmut.end(), [this, timeout] (const mutation& m) {
-            return mutate_locally(m, timeout);
+    // Group the mutations by destination shard and make one cross-shard hop
+    // per group instead of one per mutation; fan-out-heavy batches routinely
+    // put many small mutations on the same shard.
+    std::unordered_map<unsigned, std::vector<std::pair<global_schema_ptr, frozen_mutation>>> by_shard;
+    auto& db = _db.local();
+    for (auto& m : mutations) {
+        auto shard = db.shard_of(m);
+        _stats.replica_cross_shard_ops += shard != engine().cpu_id();
+        by_shard[shard].emplace_back(global_schema_ptr(m.schema()), freeze(m));
+    }
+    return do_with(std::move(by_shard), [this, timeout] (auto& by_shard) {
+        return parallel_for_each(by_shard, [this, timeout] (auto& shard_mutations) {
+            return _db.invoke_on(shard_mutations.first, [&ms = shard_mutations.second, timeout] (database& db) {
+                return parallel_for_each(ms, [&db, timeout] (std::pair<global_schema_ptr, frozen_mutation>& m) {
+                    return db.apply(m.first, m.second, timeout);
+                });
+            });
         });
     });
 }
@@ -1745,9 +1801,133 @@ future<> storage_proxy::schedule_repair(std::unordered_map<dht::token, std::unor
     if (diffs.empty()) {
         return make_ready_future<>();
     }
+    if (service::get_local_storage_service().cluster_supports_mutation_vector()) {
+        return schedule_batched_repair(std::move(diffs), cl, std::move(trace_state));
+    }
     return mutate_internal(diffs | boost::adaptors::map_values, cl, false, std::move(trace_state));
 }
 
+// Ships the read repair diffs of one (range) read as bounded mutation
+// vectors, one per replica, instead of one write handler and one RPC per
+// stale partition per replica, so a post-outage repair storm does not
+// multiply the RPC count. The consistency contract is unchanged: the
+// returned future resolves once every partition has been acknowledged by
+// enough replicas - counting the ones that were already up to date - to
+// satisfy cl, while the remaining batches continue in the background like
+// the background portion of a regular write.
+future<> storage_proxy::schedule_batched_repair(std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state) {
+    // a replica owed more than this is simply sent several vectors
+    static constexpr size_t max_repair_batch_size = 1024 * 1024;
+
+    struct repair_state {
+        schema_ptr s;
+        db::consistency_level cl;
+        size_t block_for = 0;
+        std::vector<size_t> acks_needed; // per partition
+        size_t unsatisfied = 0;          // partitions still short of cl
+        size_t outstanding = 0;          // batches still in flight
+        bool resolved = false;
+        promise<> done;
+    };
+    auto state = make_lw_shared<repair_state>();
+    state->cl = cl;
+
+    std::unordered_map<gms::inet_address, std::vector<std::pair<size_t, frozen_mutation>>> per_replica;
+    for (auto& diff : diffs) {
+        auto idx = state->acks_needed.size();
+        size_t up_to_date = 0;
+        schema_ptr s;
+        for (auto& ep_and_m : diff.second) {
+            if (!ep_and_m.second) {
+                ++up_to_date;
+                continue;
+            }
+            s = ep_and_m.second->schema();
+            per_replica[ep_and_m.first].emplace_back(idx, freeze(*ep_and_m.second));
+        }
+        size_t needed = 0;
+        if (s) {
+            if (!state->s) {
+                state->s = s;
+            }
+            auto& ks = _db.local().find_keyspace(s->ks_name());
+            state->block_for = db::block_for(ks, cl);
+            needed = state->block_for > up_to_date ? state->block_for - up_to_date : 0;
+        }
+        state->acks_needed.push_back(needed);
+        if (needed) {
+            ++state->unsatisfied;
+        }
+    }
+
+    auto complete_batch = [state] (const std::vector<size_t>& idxs, bool failed) {
+        --state->outstanding;
+        if (!failed) {
+            for (auto idx : idxs) {
+                if (state->acks_needed[idx] && --state->acks_needed[idx] == 0) {
+                    --state->unsatisfied;
+                }
+            }
+        }
+        if (!state->resolved) {
+            if (state->unsatisfied == 0) {
+                state->resolved = true;
+                state->done.set_value();
+            } else if (state->outstanding == 0) {
+                state->resolved = true;
+                state->done.set_exception(mutation_write_timeout_exception(state->s->ks_name(), state->s->cf_name(), state->cl,
+                        state->block_for - *boost::range::max_element(state->acks_needed), state->block_for, db::write_type::SIMPLE));
+            }
+        }
+    };
+
+    auto timeout = clock_type::now() + std::chrono::milliseconds(_db.local().get_config().write_request_timeout_in_ms());
+    auto my_address = utils::fb_utilities::get_broadcast_address();
+    auto p = shared_from_this();
+    for (auto& replica_and_muts : per_replica) {
+        auto ep = replica_and_muts.first;
+        auto& muts = replica_and_muts.second;
+        size_t i = 0;
+        while (i < muts.size()) {
+            std::vector<size_t> idxs;
+            std::vector<frozen_mutation> fms;
+            size_t bytes = 0;
+            do {
+                bytes += muts[i].second.representation().size();
+                idxs.push_back(muts[i].first);
+                fms.push_back(std::move(muts[i].second));
+                ++i;
+            } while (i < muts.size() && bytes < max_repair_batch_size);
+            ++state->outstanding;
+            future<> f = make_ready_future<>();
+            if (ep == my_address) {
+                f = do_with(std::move(fms), [p, s = state->s, timeout] (std::vector<frozen_mutation>& fms) {
+                    return do_for_each(fms, [p, s, timeout] (const frozen_mutation& fm) {
+                        return p->mutate_locally(s, fm, timeout);
+                    });
+                });
+            } else {
+                tracing::trace(trace_state, "Enqueuing a read repair batch of {} mutations to /{}", fms.size(), ep);
+                auto& ms = netw::get_local_messaging_service();
+                f = ms.send_mutation_vector(netw::messaging_service::msg_addr{ep, 0}, timeout, std::move(fms), tracing::make_trace_info(trace_state));
+            }
+            f.then_wrapped([p, ep, complete_batch, idxs = std::move(idxs)] (future<> f) {
+                bool failed = f.failed();
+                if (failed) {
+                    slogger.debug("Read repair batch to {} failed: {}", ep, f.get_exception());
+                }
+                complete_batch(idxs, failed);
+            });
+        }
+    }
+    if (state->unsatisfied == 0 && !state->resolved) {
+        // nothing to block for; the batches complete in the background
+        state->resolved = true;
+        state->done.set_value();
+    }
+    return state->done.get_future();
+}
+
 class abstract_read_resolver {
 protected:
     db::consistency_level _cl;
@@ -2490,9 +2670,12 @@ protected:
     }
     future<> make_data_requests(digest_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout, bool want_digest) {
         return parallel_for_each(begin, end, [this, resolver = std::move(resolver), timeout, want_digest] (gms::inet_address ep) {
-            return make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep] (future<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature> f) {
+            utils::latency_counter lc;
+            lc.start();
+            return make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep, lc] (future<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature> f) mutable {
                 try {
                     auto v = f.get();
+                    _proxy->read_latency_for(ep).add(std::chrono::duration_cast<std::chrono::microseconds>(lc.stop().latency()));
                     _cf->set_hit_rate(ep, std::get<1>(v));
                     resolver->add_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->_stats.data_read_completed.get_ep_stat(ep);
@@ -2506,9 +2689,12 @@ protected:
     }
     future<> make_digest_requests(digest_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout) {
         return parallel_for_each(begin, end, [this, resolver = std::move(resolver), timeout] (gms::inet_address ep) {
-            return make_digest_request(ep, timeout).then_wrapped([this, resolver, ep] (future<query::result_digest, api::timestamp_type, cache_temperature> f) {
+            utils::latency_counter lc;
+            lc.start();
+            return make_digest_request(ep, timeout).then_wrapped([this, resolver, ep, lc] (future<query::result_digest, api::timestamp_type, cache_temperature> f) mutable {
                 try {
                     auto v = f.get();
+                    _proxy->read_latency_for(ep).add(std::chrono::duration_cast<std::chrono::microseconds>(lc.stop().latency()));
                     _cf->set_hit_rate(ep, std::get<2>(v));
                     resolver->add_digest(ep, std::get<0>(v), std::get<1>(v));
                     ++_proxy->_stats.digest_read_completed.get_ep_stat(ep);
@@ -2732,6 +2918,16 @@ public:
         auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
             std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
             std::chrono::milliseconds(unsigned(sr.get_value()));
+        if (sr.get_type() == speculative_retry::type::PERCENTILE) {
+            // The table-level percentile mixes all replicas together and its
+            // histogram lags behind sudden changes. When every replica we are
+            // waiting for has an up-to-date estimate, prefer the worst of
+            // their p99s: it reacts within a few tens of responses when one
+            // of them starts to hiccup.
+            if (auto est = _proxy->estimated_read_p99(_targets.begin(), _targets.end() - 1)) {
+                t = std::min(t, std::chrono::ceil<std::chrono::milliseconds>(*est));
+            }
+        }
         _speculate_timer.arm(t);
 
         // if CL + RR result in covering all replicas, getReadExecutor forces AlwaysSpeculating.  So we know
@@ -2782,6 +2978,53 @@ db::read_repair_decision storage_proxy::new_read_repair_decision(const schema& s
     return db::read_repair_decision::NONE;
 }
 
+std::optional<std::chrono::microseconds>
+storage_proxy::estimated_read_p99(std::vector<gms::inet_address>::const_iterator begin,
+        std::vector<gms::inet_address>::const_iterator end) {
+    std::chrono::microseconds worst{0};
+    for (auto it = begin; it != end; ++it) {
+        auto i = _read_latency_estimates.find(*it);
+        if (i == _read_latency_estimates.end() || !i->second.valid()) {
+            return std::nullopt;
+        }
+        worst = std::max(worst, i->second.p99());
+    }
+    if (worst.count() == 0) {
+        return std::nullopt;
+    }
+    return worst;
+}
+
+// A replica whose estimated p99 is both demotion_ratio times worse than its
+// fastest peer's and more than demotion_margin above it is considered
+// degraded - e.g. paused by GC. The margin keeps microsecond-level noise
+// between healthy replicas from reshuffling the snitch's preference.
+static constexpr double demotion_ratio = 2.0;
+static constexpr std::chrono::microseconds demotion_margin = 1ms;
+
+void storage_proxy::demote_slow_replicas(std::vector<gms::inet_address>& targets) {
+    if (targets.size() < 2) {
+        return;
+    }
+    std::optional<std::chrono::microseconds> best;
+    for (auto&& ep : targets) {
+        auto i = _read_latency_estimates.find(ep);
+        if (i != _read_latency_estimates.end() && i->second.valid()) {
+            best = best ? std::min(*best, i->second.p99()) : i->second.p99();
+        }
+    }
+    if (!best) {
+        return;
+    }
+    auto threshold = std::max(std::chrono::microseconds(uint64_t(best->count() * demotion_ratio)), *best + demotion_margin);
+    // Degraded replicas go to the back of the list, out of the preferred
+    // data-read position and into the digest/speculative-extra slots.
+    boost::stable_partition(targets, [&] (gms::inet_address ep) {
+        auto i = _read_latency_estimates.find(ep);
+        return i == _read_latency_estimates.end() || !i->second.valid() || i->second.p99() <= threshold;
+    });
+}
+
 ::shared_ptr<abstract_read_executor> storage_proxy::get_read_executor(lw_shared_ptr<query::read_command> cmd,
         schema_ptr schema,
         dht::partition_range pr,
@@ -2800,6 +3043,8 @@ db::read_repair_decision storage_proxy::new_read_repair_decision(const schema& s
             retry_type == speculative_retry::type::NONE ? nullptr : &extra_replica,
             _db.local().get_config().cache_hit_rate_read_balancing() ? &*cf : nullptr);
 
+    demote_slow_replicas(target_replicas);
+
     slogger.trace("creating read executor for token {} with all: {} targets: {} rp decision: {}", token, all_replicas, target_replicas, repair_decision);
     tracing::trace(trace_state, "Creating read executor for token {} with all: {} targets: {} repair decision: {}", token, all_replicas, target_replicas, repair_decision);
 
@@ -2866,7 +3111,15 @@ storage_proxy::query_result_local(schema_ptr s, lw_shared_ptr<query::read_comman
     cmd->slice.options.set_if<query::partition_slice::option::with_digest>(opts.request != query::result_request::only_result);
     if (pr.is_singular()) {
         unsigned shard = _db.local().shard_of(pr.start()->value().token());
-        _stats.replica_cross_shard_ops += shard != engine().cpu_id();
+        if (shard != engine().cpu_id()) {
+            ++_stats.replica_cross_shard_ops;
+            // Reads bound for the same shard are coalesced into one smp
+            // message per flush; a multi-key IN () fans out into many of
+            // these within one task batch.
+            return submit_shard_read(shard, batched_shard_read{global_schema_ptr(s), cmd,
+                    dht::partition_range_vector({pr}) /* FIXME: pr is copied */, opts, max_size, timeout,
+                    tracing::global_trace_state_ptr(std::move(trace_state))});
+        }
         return _db.invoke_on(shard, [max_size, gs = global_schema_ptr(s), prv = dht::partition_range_vector({pr}) /* FIXME: pr is copied */, cmd, opts, timeout, gt = tracing::global_trace_state_ptr(std::move(trace_state))] (database& db) mutable {
             auto trace_state = gt.get();
             tracing::trace(trace_state, "Start querying the token range that starts with {}", seastar::value_of([&prv] { return prv.begin()->start()->value().token(); }));
@@ -2883,6 +3136,84 @@ storage_proxy::query_result_local(schema_ptr s, lw_shared_ptr<query::read_comman
     }
 }
 
+future<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>
+storage_proxy::submit_shard_read(unsigned shard, batched_shard_read read) {
+    if (_shard_read_queues.empty()) {
+        _shard_read_queues.resize(smp::count);
+    }
+    auto& q = _shard_read_queues[shard];
+    q.reads.emplace_back(std::move(read));
+    q.promises.emplace_back();
+    auto f = q.promises.back().get_future();
+    // Bound the batch so a huge fan-out cannot park arbitrary state here;
+    // at this size the per-message overhead is already well amortized.
+    constexpr size_t max_batched_shard_reads = 128;
+    if (q.reads.size() >= max_batched_shard_reads) {
+        flush_shard_reads(shard);
+    } else if (!q.flush_scheduled) {
+        q.flush_scheduled = true;
+        // later() runs once the reactor has drained the already-queued
+        // tasks, so all reads submitted within the current task batch make
+        // it into one message without adding a timer-based delay.
+        (void)later().then([this, shard] {
+            flush_shard_reads(shard);
+        });
+    }
+    return f;
+}
+
+void storage_proxy::flush_shard_reads(unsigned shard) {
+    auto& q = _shard_read_queues[shard];
+    q.flush_scheduled = false;
+    if (q.reads.empty()) {
+        return;
+    }
+    auto reads = std::exchange(q.reads, {});
+    auto promises = std::exchange(q.promises, {});
+    // The reads vector is destroyed back on this shard, like any smp
+    // message payload, so the non-atomic reference counts inside the items
+    // are never touched remotely; results travel back as foreign_ptr.
+    (void)_db.invoke_on(shard, [reads = std::move(reads)] (database& db) mutable {
+        return do_with(std::move(reads), std::vector<batched_shard_read_result>(), [&db] (std::vector<batched_shard_read>& reads, std::vector<batched_shard_read_result>& results) {
+            results.resize(reads.size());
+            return parallel_for_each(boost::irange<size_t>(0, reads.size()), [&db, &reads, &results] (size_t i) {
+                auto& r = reads[i];
+                auto trace_state = r.gt.get();
+                tracing::trace(trace_state, "Start querying the token range that starts with {}", seastar::value_of([&r] { return r.prv.begin()->start()->value().token(); }));
+                return db.query(r.gs, *r.cmd, r.opts, r.prv, trace_state, r.max_size, r.timeout).then_wrapped([&results, i, trace_state] (future<lw_shared_ptr<query::result>, cache_temperature> f) {
+                    try {
+                        auto res = f.get();
+                        tracing::trace(trace_state, "Querying is done");
+                        results[i].result = make_foreign(std::move(std::get<0>(res)));
+                        results[i].hit_rate = std::get<1>(res);
+                    } catch (...) {
+                        results[i].exception = std::current_exception();
+                    }
+                });
+            }).then([&results] {
+                return std::move(results);
+            });
+        });
+    }).then_wrapped([promises = std::move(promises)] (future<std::vector<batched_shard_read_result>> f) mutable {
+        if (f.failed()) {
+            auto ex = f.get_exception();
+            for (auto& p : promises) {
+                p.set_exception(ex);
+            }
+            return;
+        }
+        auto results = f.get0();
+        for (size_t i = 0; i < promises.size(); ++i) {
+            auto& r = results[i];
+            if (r.exception) {
+                promises[i].set_exception(std::move(r.exception));
+            } else {
+                promises[i].set_value(std::move(r.result), r.hit_rate);
+            }
+        }
+    });
+}
+
 void storage_proxy::handle_read_error(std::exception_ptr eptr, bool range) {
     try {
         std::rethrow_exception(eptr);
@@ -2911,6 +3242,58 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
     db::read_repair_decision repair_decision = query_options.read_repair_decision
         ? *query_options.read_repair_decision : new_read_repair_decision(*schema);
 
+    // Fast path for single-partition reads which this node can answer alone,
+    // e.g. CL=LOCAL_ONE with the coordinator being a replica: skip the read
+    // executor and digest resolver allocations and serve straight from the
+    // local (possibly cached) read. Speculating executors are only bypassed
+    // when there is nobody to speculate to, so retry semantics are unchanged.
+    if (partition_ranges.size() == 1 && repair_decision == db::read_repair_decision::NONE) {
+        const dht::partition_range& pr = partition_ranges[0];
+        if (!pr.is_singular()) {
+            throw std::runtime_error("mixed singular and non singular range are not supported");
+        }
+        const dht::token& token = pr.start()->value().token();
+        keyspace& ks = _db.local().find_keyspace(schema->ks_name());
+        auto token_range = dht::token_range::make_singular(token);
+        auto it = query_options.preferred_replicas.find(token_range);
+        const auto preferred_endpoints = it == query_options.preferred_replicas.end()
+            ? std::vector<gms::inet_address>{} : replica_ids_to_endpoints(it->second);
+        std::vector<gms::inet_address> all_replicas = get_live_sorted_endpoints(ks, token);
+        auto cf = _db.local().find_column_family(schema).shared_from_this();
+        std::vector<gms::inet_address> target_replicas = db::filter_for_query(cl, ks, all_replicas, preferred_endpoints, repair_decision,
+                nullptr, _db.local().get_config().cache_hit_rate_read_balancing() ? &*cf : nullptr);
+        if (target_replicas.size() == 1 && fbu::is_me(target_replicas[0]) && db::block_for(ks, cl) == 1
+                && (schema->speculative_retry().get_type() == speculative_retry::type::NONE || all_replicas.size() == 1)) {
+            auto ep = target_replicas[0];
+            tracing::trace(query_options.trace_state, "Satisfying the read locally, bypassing the read executor");
+            ++_stats.data_read_attempts.get_ep_stat(ep);
+            utils::latency_counter lc;
+            lc.start();
+            auto p = shared_from_this();
+            auto timeout = query_options.timeout(*this);
+            query::result_options opts{query::result_request::only_result, query::digest_algorithm::none};
+            return query_result_local(schema, cmd, pr, opts, query_options.trace_state, timeout).then_wrapped(
+                    [p, cf = std::move(cf), ep, lc, token_range = std::move(token_range), repair_decision] (
+                        future<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature> f) mutable {
+                if (lc.is_start()) {
+                    cf->add_coordinator_read_latency(lc.stop().latency());
+                }
+                if (f.failed()) {
+                    ++p->_stats.data_read_errors.get_ep_stat(ep);
+                    auto eptr = f.get_exception();
+                    p->handle_read_error(eptr, false);
+                    return make_exception_future<storage_proxy::coordinator_query_result>(std::move(eptr));
+                }
+                auto v = f.get();
+                cf->set_hit_rate(ep, std::get<1>(v));
+                ++p->_stats.data_read_completed.get_ep_stat(ep);
+                replicas_per_token_range used_replicas;
+                used_replicas.emplace(std::move(token_range), endpoints_to_replica_ids({ep}));
+                return make_ready_future<coordinator_query_result>(coordinator_query_result(std::get<0>(std::move(v)), std::move(used_replicas), repair_decision));
+            });
+        }
+    }
+
     for (auto&& pr: partition_ranges) {
         if (!pr.is_singular()) {
             throw std::runtime_error("mixed singular and non singular range are not supported");
@@ -2972,7 +3355,14 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         tracing::trace_state_ptr trace_state,
         uint32_t remaining_row_count,
         uint32_t remaining_partition_count,
-        replicas_per_token_range preferred_replicas) {
+        replicas_per_token_range preferred_replicas,
+        seastar::abort_source* abort_source) {
+    // Between rounds the client may have given up on the scan (e.g. its
+    // connection was dropped); don't issue the next round of replica reads
+    // for a result nobody will consume.
+    if (abort_source) {
+        abort_source->check();
+    }
     schema_ptr schema = local_schema_registry().get(cmd->schema_version);
     keyspace& ks = _db.local().find_keyspace(schema->ks_name());
     std::vector<::shared_ptr<abstract_read_executor>> exec;
@@ -3072,17 +3462,24 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         ranges_per_exec.emplace(exec.back().get(), std::move(merged_ranges));
     }
 
-    query::result_merger merger(cmd->row_limit, cmd->partition_limit);
-    merger.reserve(exec.size());
+    // Don't concatenate the responses of this round: keep them as the
+    // self-contained buffers they arrived in and let the caller merge all
+    // rounds at once. This way each buffer is copied at most once, instead
+    // of once per round plus once in the final merge.
+    query::result_collector collector;
+    collector.reserve(exec.size());
 
     auto f = ::map_reduce(exec.begin(), exec.end(), [timeout] (::shared_ptr<abstract_read_executor>& rex) {
         return rex->execute(timeout);
-    }, std::move(merger));
+    }, std::move(collector));
+
+    const auto ranges_queried = std::distance(concurrent_fetch_starting_index, i);
 
     return f.then([p,
             exec = std::move(exec),
             results = std::move(results),
             i = std::move(i),
+            ranges_queried,
             ranges = std::move(ranges),
             cl,
             cmd,
@@ -3092,11 +3489,21 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
             remaining_partition_count,
             trace_state = std::move(trace_state),
             preferred_replicas = std::move(preferred_replicas),
-            ranges_per_exec = std::move(ranges_per_exec)] (foreign_ptr<lw_shared_ptr<query::result>>&& result) mutable {
-        result->ensure_counts();
-        remaining_row_count -= result->row_count().value();
-        remaining_partition_count -= result->partition_count().value();
-        results.emplace_back(std::move(result));
+            ranges_per_exec = std::move(ranges_per_exec),
+            abort_source] (std::vector<foreign_ptr<lw_shared_ptr<query::result>>>&& partials) mutable {
+        uint32_t rows_fetched = 0;
+        uint32_t partitions_fetched = 0;
+        for (auto&& partial : partials) {
+            partial->ensure_counts();
+            rows_fetched += partial->row_count().value();
+            partitions_fetched += partial->partition_count().value();
+            results.emplace_back(std::move(partial));
+        }
+        // Unlike a merged result, the individual responses are not trimmed
+        // to the row/partition limits, so their sum can exceed what remains;
+        // the final merge takes care of the trimming.
+        remaining_row_count -= std::min(remaining_row_count, rows_fetched);
+        remaining_partition_count -= std::min(remaining_partition_count, partitions_fetched);
         if (i == ranges.end() || !remaining_row_count || !remaining_partition_count) {
             auto used_replicas = replicas_per_token_range();
             for (auto& e : exec) {
@@ -3114,8 +3521,23 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         } else {
             cmd->row_limit = remaining_row_count;
             cmd->partition_limit = remaining_partition_count;
+            // Size the next round according to the yield of the current one.
+            // The factor starts at 1 and doubling it unconditionally is the
+            // right thing for sparsely populated ranges, but once ranges
+            // start producing rows the doubling quickly queries many more
+            // ranges than the remaining limit needs, with all the excess
+            // rows fetched from the replicas only to be trimmed by the
+            // merger. If this round produced rows, estimate how many ranges
+            // are needed to cover the remaining limit instead, never growing
+            // faster than the doubling would.
+            auto next_concurrency_factor = concurrency_factor * 2;
+            if (rows_fetched) {
+                auto rows_per_range = double(rows_fetched) / ranges_queried;
+                next_concurrency_factor = std::clamp(int(std::ceil(remaining_row_count / rows_per_range)), 1, next_concurrency_factor);
+            }
             return p->query_partition_key_range_concurrent(timeout, std::move(results), cmd, cl, std::move(i), std::move(ranges),
-                    concurrency_factor * 2, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas));
+                    next_concurrency_factor, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas),
+                    abort_source);
         }
     }).handle_exception([p] (std::exception_ptr eptr) {
         p->handle_read_error(eptr, true);
@@ -3185,7 +3607,8 @@ storage_proxy::query_partition_key_range(lw_shared_ptr<query::read_command> cmd,
             std::move(query_options.trace_state),
             cmd->row_limit,
             cmd->partition_limit,
-            std::move(query_options.preferred_replicas)).then([row_limit, partition_limit] (
+            std::move(query_options.preferred_replicas),
+            query_options.abort_source).then([row_limit, partition_limit] (
                     std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results,
                     replicas_per_token_range used_replicas) {
         query::result_merger merger(row_limit, partition_limit);
@@ -3243,6 +3666,12 @@ storage_proxy::do_query(schema_ptr s,
             (slice.default_row_ranges().empty() && !slice.get_specific_ranges())) {
         return make_empty();
     }
+    if (query_options.abort_source && query_options.abort_source->abort_requested()) {
+        // The client is already gone, e.g. it timed out and dropped the
+        // connection; don't bother the replicas with a read whose result
+        // nobody will consume.
+        return make_exception_future<coordinator_query_result>(std::make_exception_ptr(seastar::abort_requested_exception()));
+    }
     utils::latency_counter lc;
     lc.start();
     auto p = shared_from_this();
@@ -3686,6 +4115,35 @@ void storage_proxy::init_messaging_service() {
             });
         });
     });
+    ms.register_mutation_vector([] (const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<frozen_mutation> fms, std::optional<tracing::trace_info> trace_info) {
+        auto src_addr = netw::messaging_service::get_source(cinfo);
+
+        tracing::trace_state_ptr trace_state_ptr;
+        if (trace_info) {
+            trace_state_ptr = tracing::tracing::get_local_tracing_instance().create_session(*trace_info);
+            tracing::begin(trace_state_ptr);
+            tracing::trace(trace_state_ptr, "Message received from /{}", src_addr.addr);
+        }
+
+        storage_proxy::clock_type::time_point timeout;
+        if (!t) {
+            auto timeout_in_ms = get_local_shared_storage_proxy()->_db.local().get_config().write_request_timeout_in_ms();
+            timeout = clock_type::now() + std::chrono::milliseconds(timeout_in_ms);
+        } else {
+            timeout = *t;
+        }
+
+        return do_with(std::move(fms), get_local_shared_storage_proxy(),
+                [src_addr, timeout, trace_state_ptr = std::move(trace_state_ptr)] (std::vector<frozen_mutation>& fms, shared_ptr<storage_proxy>& p) {
+            return parallel_for_each(fms, [&p, src_addr, timeout] (const frozen_mutation& fm) {
+                return get_schema_for_write(fm.schema_version(), src_addr).then([&p, &fm, timeout] (schema_ptr s) {
+                    return p->mutate_locally(std::move(s), fm, timeout);
+                });
+            }).then([trace_state_ptr = std::move(trace_state_ptr)] {
+                tracing::trace(trace_state_ptr, "Mutation vector applied");
+            });
+        });
+    });
     ms.register_mutation([] (const rpc::client_info& cinfo, rpc::opt_time_point t, frozen_mutation in, std::vector<gms::inet_address> forward, gms::inet_address reply_to, unsigned shard, storage_proxy::response_id_type response_id, rpc::optional<std::optional<tracing::trace_info>> trace_info) {
         tracing::trace_state_ptr trace_state_ptr;
         auto src_addr = netw::messaging_service::get_source(cinfo);
@@ -3900,6 +4358,7 @@ void storage_proxy::init_messaging_service() {
 
 void storage_proxy::uninit_messaging_service() {
     auto& ms = netw::get_local_messaging_service();
+    ms.unregister_mutation_vector();
     ms.unregister_mutation();
     ms.unregister_mutation_done();
     ms.unregister_mutation_failed();
@@ -3967,6 +4426,7 @@ future<> storage_proxy::stop_hints_manager() {
 future<>
 storage_proxy::stop() {
     // FIXME: hints manager should be stopped here but it seems like this function is never called
+    _expiry_tick_timer.cancel();
     uninit_messaging_service();
     return make_ready_future<>();
 }
@@ -47,6 +47,7 @@
 #include "query-result-set.hh"
 #include <seastar/core/distributed.hh>
 #include <seastar/core/execution_stage.hh>
+#include <seastar/core/abort_source.hh>
 #include "db/consistency_level_type.hh"
 #include "db/read_repair_decision.hh"
 #include "db/write_type.hh"
@@ -55,12 +56,17 @@
 #include "db/view/node_view_update_backlog.hh"
 #include "utils/histogram.hh"
 #include "utils/estimated_histogram.hh"
+#include <cmath>
 #include "tracing/trace_state.hh"
 #include <seastar/core/metrics.hh>
 #include "frozen_mutation.hh"
+#include "schema_registry.hh"
 #include "storage_proxy_stats.hh"
 #include "cache_temperature.hh"
 #include "mutation_query.hh"
+#include <seastar/core/timer.hh>
+#include <boost/intrusive/list.hpp>
+#include <array>
 
 namespace locator {
 
@@ -93,6 +99,24 @@ using allow_hints = bool_class<allow_hints_tag>;
 class storage_proxy : public seastar::async_sharded_service<storage_proxy> /*implements StorageProxyMBean*/ {
 public:
     using clock_type = lowres_clock;
+    // Intrusive hook plus deadline for the per-shard handler expiry wheel
+    // below. Write response handlers derive from this instead of each arming
+    // a timer of their own.
+    struct handler_expiry_entry : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
+        clock_type::time_point expiry;
+    };
+    // Geometry of the per-shard handler expiry wheel below. Public so tests
+    // can check the bucketing invariant.
+    static constexpr size_t expiry_wheel_buckets = 128;
+    static constexpr clock_type::duration expiry_wheel_tick = std::chrono::duration_cast<clock_type::duration>(std::chrono::milliseconds(100));
+    // The wheel tick an expiry is filed under: one past the expiry's own
+    // tick. The sweep for a tick runs at an arbitrary point within it,
+    // generally before expiries landing later in the same tick, and an entry
+    // skipped by its sweep is only revisited a full lap later. The first
+    // sweep at or after the returned tick is always past the expiry.
+    static int64_t expiry_wheel_tick_of(clock_type::time_point expiry) {
+        return expiry.time_since_epoch() / expiry_wheel_tick + 1;
+    }
     struct config {
         std::optional<std::vector<sstring>> hinted_handoff_enabled = {};
         size_t available_memory;
@@ -125,15 +149,21 @@ public:
         tracing::trace_state_ptr trace_state = nullptr;
         replicas_per_token_range preferred_replicas;
         std::optional<db::read_repair_decision> read_repair_decision;
+        // Signalled when the client which issued the query went away (see
+        // service::query_state). Checked at coordination boundaries so that
+        // abandoned reads stop issuing new work. Must live on this shard.
+        seastar::abort_source* abort_source = nullptr;
 
         coordinator_query_options(clock_type::time_point timeout,
                 tracing::trace_state_ptr trace_state = nullptr,
                 replicas_per_token_range preferred_replicas = { },
-                std::optional<db::read_repair_decision> read_repair_decision = { })
+                std::optional<db::read_repair_decision> read_repair_decision = { },
+                seastar::abort_source* abort_source = nullptr)
             : _timeout(timeout)
             , trace_state(std::move(trace_state))
             , preferred_replicas(std::move(preferred_replicas))
-            , read_repair_decision(read_repair_decision) {
+            , read_repair_decision(read_repair_decision)
+            , abort_source(abort_source) {
         }
 
         clock_type::time_point timeout(storage_proxy& sp) const {
@@ -141,6 +171,39 @@ public:
         }
     };
 
+    // Exponentially weighted mean and variance of a replica's read response
+    // time as observed by this shard's coordinator. Cheaper than a
+    // histogram, and mean plus three standard deviations gives a usable
+    // stand-in for the recent p99.
+    class endpoint_read_latency {
+        // Weight of a new sample. Small enough to ride out a single
+        // outlier, large enough to notice within a few tens of responses
+        // that a replica started to hiccup.
+        static constexpr double alpha = 0.1;
+        // Samples needed before the estimate is meaningful.
+        static constexpr uint64_t min_samples = 8;
+        double _mean_us = 0;
+        double _var_us2 = 0;
+        uint64_t _samples = 0;
+    public:
+        void add(std::chrono::microseconds sample) {
+            auto s = double(sample.count());
+            if (_samples++ == 0) {
+                _mean_us = s;
+            } else {
+                auto d = s - _mean_us;
+                _mean_us += alpha * d;
+                _var_us2 = (1 - alpha) * (_var_us2 + alpha * d * d);
+            }
+        }
+        bool valid() const {
+            return _samples >= min_samples;
+        }
+        std::chrono::microseconds p99() const {
+            return std::chrono::microseconds(uint64_t(_mean_us + 3 * std::sqrt(_var_us2)));
+        }
+    };
+
     struct coordinator_query_result {
         foreign_ptr<lw_shared_ptr<query::result>> query_result;
         replicas_per_token_range last_replicas;
@@ -157,6 +220,19 @@ public:
 private:
     distributed<database>& _db;
     response_id_type _next_response_id;
+    // Hashed timing wheel for write response handler expiry. A dedicated
+    // timer per handler means hundreds of thousands of reactor timer
+    // insertions and cancellations per second under write load; the wheel
+    // gives O(1) insert and cancel into an intrusive bucket list, with a
+    // single tick timer per shard that is armed only while handlers are
+    // pending. A handler whose deadline has not been reached when its bucket
+    // is visited simply stays there for the next lap. Declared before
+    // _response_handlers so that linked handlers are destroyed before the
+    // bucket lists they auto-unlink from.
+    using expiry_bucket = boost::intrusive::list<handler_expiry_entry, boost::intrusive::constant_time_size<false>>;
+    std::array<expiry_bucket, expiry_wheel_buckets> _expiry_wheel;
+    timer<clock_type> _expiry_tick_timer;
+    int64_t _last_expiry_tick = 0;
     std::unordered_map<response_id_type, ::shared_ptr<abstract_write_response_handler>> _response_handlers;
     // This buffer hold ids of throttled writes in case resource consumption goes
     // below the threshold and we want to unthrottle some of them. Without this throttled
@@ -170,6 +246,9 @@ private:
     std::optional<db::hints::manager> _hints_manager;
     db::hints::manager _hints_for_views_manager;
     stats _stats;
+    // Per-endpoint read latency estimates, feeding the speculative retry
+    // timer and the demotion of degraded replicas in get_read_executor().
+    std::unordered_map<gms::inet_address, endpoint_read_latency> _read_latency_estimates;
     static constexpr float CONCURRENT_SUBREQUESTS_MARGIN = 0.10;
     // for read repair chance calculation
     std::default_random_engine _urandom;
@@ -195,6 +274,8 @@ private:
             coordinator_query_options optional_params);
     response_id_type register_response_handler(shared_ptr<abstract_write_response_handler>&& h);
     void remove_response_handler(response_id_type id);
+    void enqueue_expiry(handler_expiry_entry& e);
+    void expire_due_handlers();
     void got_response(response_id_type id, gms::inet_address from, std::optional<db::view::update_backlog> backlog);
     void got_failure_response(response_id_type id, gms::inet_address from, size_t count, std::optional<db::view::update_backlog> backlog);
     future<> response_wait(response_id_type id, clock_type::time_point timeout);
@@ -213,6 +294,13 @@ private:
     db::hints::manager& hints_manager_for(db::write_type type);
     std::vector<gms::inet_address> get_live_endpoints(keyspace& ks, const dht::token& token);
     std::vector<gms::inet_address> get_live_sorted_endpoints(keyspace& ks, const dht::token& token);
+    endpoint_read_latency& read_latency_for(gms::inet_address ep) {
+        return _read_latency_estimates[ep];
+    }
+    std::optional<std::chrono::microseconds> estimated_read_p99(
+            std::vector<gms::inet_address>::const_iterator begin,
+            std::vector<gms::inet_address>::const_iterator end);
+    void demote_slow_replicas(std::vector<gms::inet_address>& targets);
     db::read_repair_decision new_read_repair_decision(const schema& s);
     ::shared_ptr<abstract_read_executor> get_read_executor(lw_shared_ptr<query::read_command> cmd,
             schema_ptr schema,
@@ -221,6 +309,32 @@ private:
             db::read_repair_decision repair_decision,
             tracing::trace_state_ptr trace_state,
             const std::vector<gms::inet_address>& preferred_endpoints);
+    // A singular read bound for another shard, parked until the next flush
+    // of that shard's batch. All fields are safe to access from the
+    // destination shard.
+    struct batched_shard_read {
+        global_schema_ptr gs;
+        lw_shared_ptr<query::read_command> cmd;
+        dht::partition_range_vector prv;
+        query::result_options opts;
+        uint64_t max_size;
+        clock_type::time_point timeout;
+        tracing::global_trace_state_ptr gt;
+    };
+    struct batched_shard_read_result {
+        foreign_ptr<lw_shared_ptr<query::result>> result;
+        cache_temperature hit_rate;
+        std::exception_ptr exception; // set instead of result on failure
+    };
+    struct shard_read_queue {
+        std::vector<batched_shard_read> reads;
+        std::vector<promise<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> promises;
+        bool flush_scheduled = false;
+    };
+    // Indexed by destination shard; sized lazily on first use.
+    std::vector<shard_read_queue> _shard_read_queues;
+    future<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature> submit_shard_read(unsigned shard, batched_shard_read read);
+    void flush_shard_reads(unsigned shard);
     future<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature> query_result_local(schema_ptr, lw_shared_ptr<query::read_command> cmd, const dht::partition_range& pr,
                                                                            query::result_options opts,
                                                                            tracing::trace_state_ptr trace_state,
@@ -247,7 +361,8 @@ private:
             tracing::trace_state_ptr trace_state,
             uint32_t remaining_row_count,
             uint32_t remaining_partition_count,
-            replicas_per_token_range preferred_replicas);
+            replicas_per_token_range preferred_replicas,
+            seastar::abort_source* abort_source);
 
     future<coordinator_query_result> do_query(schema_ptr,
         lw_shared_ptr<query::read_command> cmd,
@@ -261,6 +376,7 @@ private:
     future<> mutate_begin(std::vector<unique_response_handler> ids, db::consistency_level cl, std::optional<clock_type::time_point> timeout_opt = { });
     future<> mutate_end(future<> mutate_result, utils::latency_counter, write_stats& stats, tracing::trace_state_ptr trace_state);
     future<> schedule_repair(std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state);
+    future<> schedule_batched_repair(std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state);
     bool need_throttle_writes() const;
     void unthrottle();
     void handle_read_error(std::exception_ptr eptr, bool range);
@@ -107,6 +107,7 @@ static const sstring STREAM_WITH_RPC_STREAM = "STREAM_WITH_RPC_STREAM";
 static const sstring MC_SSTABLE_FEATURE = "MC_SSTABLE_FORMAT";
 static const sstring ROW_LEVEL_REPAIR = "ROW_LEVEL_REPAIR";
 static const sstring TRUNCATION_TABLE = "TRUNCATION_TABLE";
+static const sstring MUTATION_VECTOR_FEATURE = "MUTATION_VECTOR";
 
 distributed<storage_service> _the_storage_service;
 
@@ -153,6 +154,7 @@ storage_service::storage_service(distributed<database>& db, sharded<auth::servic
         , _mc_sstable_feature(_feature_service, MC_SSTABLE_FEATURE)
         , _row_level_repair_feature(_feature_service, ROW_LEVEL_REPAIR)
         , _truncation_table(_feature_service, TRUNCATION_TABLE)
+        , _mutation_vector_feature(_feature_service, MUTATION_VECTOR_FEATURE)
         , _replicate_action([this] { return do_replicate_to_all_cores(); })
         , _update_pending_ranges_action([this] { return do_update_pending_ranges(); })
         , _sys_dist_ks(sys_dist_ks)
@@ -185,6 +187,7 @@ void storage_service::enable_all_features() {
         std::ref(_mc_sstable_feature),
         std::ref(_row_level_repair_feature),
         std::ref(_truncation_table),
+        std::ref(_mutation_vector_feature),
     })
     {
         if (features.count(f.name())) {
@@ -273,6 +276,7 @@ std::set<sstring> storage_service::get_config_supported_features_set() {
         INDEXES_FEATURE,
         ROW_LEVEL_REPAIR,
         TRUNCATION_TABLE,
+        MUTATION_VECTOR_FEATURE,
     };
 
     // Do not respect config in the case database is not started
@@ -2155,6 +2159,24 @@ future<bool> storage_service::is_rpc_server_running() {
     });
 }
 
+// The native transport can be stopped and restarted over the node's lifetime
+// (nodetool disablebinary/enablebinary), but scheduling groups cannot be
+// destroyed, so the group for CQL frame (de)compression is created once and
+// reused. Called on shard 0, under the api lock.
+static future<seastar::scheduling_group> cql_compression_scheduling_group(const db::config& cfg) {
+    if (!cfg.cpu_scheduler()) {
+        return make_ready_future<seastar::scheduling_group>(seastar::scheduling_group());
+    }
+    static std::optional<seastar::scheduling_group> sg;
+    if (sg) {
+        return make_ready_future<seastar::scheduling_group>(*sg);
+    }
+    return seastar::create_scheduling_group("cql_compression", 200).then([] (seastar::scheduling_group group) {
+        sg = group;
+        return group;
+    });
+}
+
 future<> storage_service::start_native_transport() {
     return run_with_api_lock(sstring("start_native_transport"), [] (storage_service& ss) {
         if (ss._cql_server || isolated.load()) {
@@ -2171,6 +2193,8 @@ future<> storage_service::start_native_transport() {
         cql_server_config.timeout_config = make_timeout_config(cfg);
         cql_server_config.max_request_size = ss._db.local().get_available_memory() / 10;
         cql_transport::cql_load_balance lb = cql_transport::parse_load_balance(cfg.load_balance());
+        return cql_compression_scheduling_group(cfg).then([&ss, cserver, addr, &cfg, lb, keepalive, ceo = std::move(ceo), cql_server_config] (seastar::scheduling_group sg) mutable {
+        cql_server_config.compression_scheduling_group = sg;
         return seastar::net::dns::resolve_name(addr).then([&ss, cserver, addr, &cfg, lb, keepalive, ceo = std::move(ceo), cql_server_config] (seastar::net::inet_address ip) {
                 return cserver->start(std::ref(service::get_storage_proxy()), std::ref(cql3::get_query_processor()), lb, std::ref(ss._auth_service), cql_server_config).then([cserver, &cfg, addr, ip, ceo, keepalive]() {
                 // #293 - do not stop anything
@@ -2227,6 +2251,7 @@ future<> storage_service::start_native_transport() {
 
                 });
             });
+        });
         }).then([&ss] {
             return ss.set_cql_ready(true);
         });
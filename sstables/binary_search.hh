@@ -22,11 +22,22 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "sstables/key.hh"
 #include "dht/i_partitioner.hh"
 
 namespace sstables {
 
+// Detects whether an entry carries the token it was decorated with, like
+// summary_entry does. For those, the binary search below compares stored
+// tokens instead of rehashing the key on every probe.
+template <typename T, typename = void>
+struct entry_stores_token : std::false_type {};
+
+template <typename T>
+struct entry_stores_token<T, std::void_t<decltype(std::declval<const T&>().token)>> : std::true_type {};
+
 /**
  * @returns: >= 0, if key is found. That is the index where the key is found.
  *             -1, if key is not found, and is smaller than the first key in the list.
@@ -52,8 +63,6 @@ template <typename T>
 int binary_search(const T& entries, const key& sk, const dht::token& token) {
     int low = 0, mid = entries.size(), high = mid - 1, result = -1;
 
-    auto& partitioner = dht::global_partitioner();
-
     while (low <= high) {
         // The token comparison should yield the right result most of the time.
         // So we avoid expensive copying operations that happens at key
@@ -61,12 +70,19 @@ int binary_search(const T& entries, const key& sk, const dht::token& token) {
         // both parts of the comparison ourselves.
         mid = low + ((high - low) >> 1);
         key_view mid_key = entries[mid].get_key();
-        auto mid_token = partitioner.get_token(mid_key);
 
-        if (token == mid_token) {
+        int token_result;
+        if constexpr (entry_stores_token<std::decay_t<decltype(entries[mid])>>::value) {
+            token_result = dht::tri_compare(dht::token_view(token), entries[mid].token);
+        } else {
+            auto mid_token = dht::global_partitioner().get_token(mid_key);
+            token_result = token == mid_token ? 0 : (token < mid_token ? -1 : 1);
+        }
+
+        if (token_result == 0) {
             result = sk.tri_compare(mid_key);
         } else {
-            result = token < mid_token ? -1 : 1;
+            result = token_result;
         }
 
         if (result > 0) {
@@ -47,6 +47,7 @@
 #include <boost/range/algorithm.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/join.hpp>
+#include <boost/range/irange.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 
 #include <seastar/core/future-util.hh>
@@ -134,9 +135,12 @@ class compaction;
 
 class compacting_sstable_writer {
     compaction& _c;
+    // Index of the sub-range stream this consumer writes for. Jobs which
+    // don't split their range always use stream 0.
+    unsigned _stream;
     sstable_writer* _writer = nullptr;
 public:
-    explicit compacting_sstable_writer(compaction& c) : _c(c) {}
+    explicit compacting_sstable_writer(compaction& c, unsigned stream) : _c(c), _stream(stream) {}
 
     void consume_new_partition(const dht::decorated_key& dk);
 
@@ -322,6 +326,10 @@ protected:
     std::vector<unsigned long> _ancestors;
     db::replay_position _rp;
     encoding_stats_collector _stats_collector;
+    // Ranges compacted by this job, each by its own fiber with an
+    // independent reader and set of writers. Kept alive here because the
+    // readers only hold references to them.
+    std::vector<dht::partition_range> _ranges;
 protected:
     compaction(column_family& cf, std::vector<shared_sstable> sstables, uint64_t max_sstable_size, uint32_t sstable_level)
         : _cf(cf)
@@ -378,9 +386,21 @@ public:
     }
 private:
     // Default range sstable reader that will only return mutation that belongs to current shard.
-    virtual flat_mutation_reader make_sstable_reader() const = 0;
+    virtual flat_mutation_reader make_sstable_reader(const dht::partition_range& range) const = 0;
 
-    flat_mutation_reader setup() {
+    // The ranges compacted by this job. Kinds which keep no cross-range
+    // state may return more than one range, each of which is compacted
+    // concurrently by its own fiber with an independent reader and set of
+    // writers. Kinds relying on key ordering across the whole job
+    // (incremental sstable replacement, the purgeable timestamp selector)
+    // must stick to the single full range.
+    virtual std::vector<dht::partition_range> make_compaction_ranges() {
+        std::vector<dht::partition_range> ranges;
+        ranges.push_back(query::full_partition_range);
+        return ranges;
+    }
+
+    void setup() {
         auto ssts = make_lw_shared<sstables::sstable_set>(_cf.get_compaction_strategy().make_sstable_set(_cf.schema()));
         auto schema = _cf.schema();
         sstring formatted_msg = "[";
@@ -421,7 +441,7 @@ private:
         report_start(formatted_msg);
 
         _compacting = std::move(ssts);
-        return make_sstable_reader();
+        _ranges = make_compaction_ranges();
     }
 
     compaction_info finish(std::chrono::time_point<db_clock> started_at, std::chrono::time_point<db_clock> ended_at) {
@@ -471,15 +491,15 @@ private:
         };
     }
 
-    // select a sstable writer based on decorated key.
-    virtual sstable_writer* select_sstable_writer(const dht::decorated_key& dk) = 0;
-    // stop current writer
-    virtual void stop_sstable_writer() = 0;
-    // finish all writers.
-    virtual void finish_sstable_writer() = 0;
+    // select a sstable writer based on decorated key, for a given stream.
+    virtual sstable_writer* select_sstable_writer(const dht::decorated_key& dk, unsigned stream) = 0;
+    // stop writer currently used by a given stream.
+    virtual void stop_sstable_writer(unsigned stream) = 0;
+    // finish all writers of a given stream.
+    virtual void finish_sstable_writer(unsigned stream) = 0;
 
-    compacting_sstable_writer get_compacting_sstable_writer() {
-        return compacting_sstable_writer(*this);
+    compacting_sstable_writer get_compacting_sstable_writer(unsigned stream) {
+        return compacting_sstable_writer(*this, stream);
     }
 
     const schema_ptr& schema() const {
@@ -496,7 +516,7 @@ void compacting_sstable_writer::consume_new_partition(const dht::decorated_key&
         // Compaction manager will catch this exception and re-schedule the compaction.
         throw compaction_stop_exception(_c._info->ks_name, _c._info->cf_name, _c._info->stop_requested);
     }
-    _writer = _c.select_sstable_writer(dk);
+    _writer = _c.select_sstable_writer(dk, _stream);
     _writer->consume_new_partition(dk);
     _c._info->total_keys_written++;
 }
@@ -505,14 +525,14 @@ stop_iteration compacting_sstable_writer::consume_end_of_partition() {
     auto ret = _writer->consume_end_of_partition();
     if (ret == stop_iteration::yes) {
         // stop sstable writer being currently used.
-        _c.stop_sstable_writer();
+        _c.stop_sstable_writer(_stream);
     }
     return ret;
 }
 
 void compacting_sstable_writer::consume_end_of_stream() {
-    // this will stop any writer opened by compaction.
-    _c.finish_sstable_writer();
+    // this will stop any writer opened for this stream by compaction.
+    _c.finish_sstable_writer(_stream);
 }
 
 class regular_compaction : public compaction {
@@ -542,13 +562,21 @@ public:
         , _weight_registration(std::move(descriptor.weight_registration))
         , _monitor_generator(_cf.get_compaction_manager(), _cf)
     {
+        if (_max_sstable_size == std::numeric_limits<uint64_t>::max() && cf.compaction_output_segment_size()) {
+            // Sealing an otherwise unbounded output in segments lets
+            // exhausted inputs be released while the compaction is still
+            // running, bounding transient space; the segments share
+            // _run_identifier, so size-tiered bucketing sees them as a
+            // single sstable.
+            _max_sstable_size = cf.compaction_output_segment_size();
+        }
         _info->run_identifier = _run_identifier;
     }
 
-    flat_mutation_reader make_sstable_reader() const override {
+    flat_mutation_reader make_sstable_reader(const dht::partition_range& range) const override {
         return ::make_local_shard_sstable_reader(_cf.schema(),
                 _compacting,
-                query::full_partition_range,
+                range,
                 _cf.schema()->full_slice(),
                 service::get_local_compaction_priority(),
                 no_resource_tracking(),
@@ -585,7 +613,7 @@ public:
         };
     }
 
-    virtual sstable_writer* select_sstable_writer(const dht::decorated_key& dk) override {
+    virtual sstable_writer* select_sstable_writer(const dht::decorated_key& dk, unsigned stream) override {
         if (!_writer) {
             _sst = _creator();
             setup_new_sstable(_sst);
@@ -603,15 +631,15 @@ public:
         return &*_writer;
     }
 
-    virtual void stop_sstable_writer() override {
+    virtual void stop_sstable_writer(unsigned stream) override {
         finish_new_sstable(_writer, _sst);
         maybe_replace_exhausted_sstables();
     }
 
-    virtual void finish_sstable_writer() override {
+    virtual void finish_sstable_writer(unsigned stream) override {
         on_end_of_stream();
         if (_writer) {
-            stop_sstable_writer();
+            stop_sstable_writer(stream);
         }
         replace_remaining_exhausted_sstables();
     }
@@ -741,8 +769,13 @@ public:
 
 
 class resharding_compaction final : public compaction {
+    // Maximum number of token sub-ranges compacted concurrently by one job.
+    static constexpr uint64_t max_sub_compaction_ranges = 4;
+
+    // Output writers, indexed by stream * smp::count + shard. Each stream
+    // is driven by its own fiber, so writers are never shared.
     std::vector<std::pair<shared_sstable, std::optional<sstable_writer>>> _output_sstables;
-    shard_id _shard; // shard of current sstable writer
+    std::vector<shard_id> _current_shard; // shard of current sstable writer, per stream
     std::function<shared_sstable(shard_id)> _sstable_creator;
     compaction_backlog_tracker _resharding_backlog_tracker;
 
@@ -763,14 +796,19 @@ class resharding_compaction final : public compaction {
 private:
     // return estimated partitions per sstable for a given shard
     uint64_t partitions_per_sstable(shard_id s) const {
-        uint64_t estimated_sstables = std::max(uint64_t(1), uint64_t(ceil(double(_estimation_per_shard[s].estimated_size) / _max_sstable_size)));
-        return ceil(double(_estimation_per_shard[s].estimated_partitions) / estimated_sstables);
+        // Each stream writes its own sstables, so size the estimates to the
+        // fraction of the shard's data a single stream sees.
+        auto streams = std::max(std::size_t(1), _current_shard.size());
+        auto estimated_size = uint64_t(ceil(double(_estimation_per_shard[s].estimated_size) / streams));
+        uint64_t estimated_sstables = std::max(uint64_t(1), uint64_t(ceil(double(estimated_size) / _max_sstable_size)));
+        return ceil(double(_estimation_per_shard[s].estimated_partitions) / streams / estimated_sstables);
     }
 public:
     resharding_compaction(std::vector<shared_sstable> sstables, column_family& cf, std::function<shared_sstable(shard_id)> creator,
             uint64_t max_sstable_size, uint32_t sstable_level)
         : compaction(cf, std::move(sstables), max_sstable_size, sstable_level)
         , _output_sstables(smp::count)
+        , _current_shard(1)
         , _sstable_creator(std::move(creator))
         , _resharding_backlog_tracker(std::make_unique<resharding_backlog_tracker>())
         , _estimation_per_shard(smp::count)
@@ -796,11 +834,65 @@ public:
         }
     }
 
+    // Resharding keeps no cross-range state: nothing is purged and input
+    // sstables are only replaced when the whole job completes. A large job
+    // can therefore be split into token sub-ranges compacted concurrently
+    // on this shard, overlapping the CPU work of one sub-range with the
+    // I/O of another. Use roughly one sub-range per GB of input, bounded
+    // by max_sub_compaction_ranges.
+    //
+    // The split points are taken from quantiles of the inputs' summary
+    // samples rather than from blind splits of the token ring: the inputs
+    // may well occupy a narrow token band, in which case a ring-based split
+    // would leave almost all of the data to a single stream. Every summary
+    // entry stands for roughly the same amount of data, so sample quantiles
+    // divide the work evenly.
+    std::vector<dht::partition_range> make_compaction_ranges() override {
+        auto fanout = std::clamp(_info->start_size >> 30, uint64_t(1), max_sub_compaction_ranges);
+        if (fanout == 1) {
+            return compaction::make_compaction_ranges();
+        }
+        std::vector<dht::token> samples;
+        for (auto& sst : _sstables) {
+            for (auto& e : sst->get_summary().entries) {
+                samples.emplace_back(e.token);
+            }
+        }
+        if (samples.size() < fanout) {
+            return compaction::make_compaction_ranges();
+        }
+        boost::sort(samples);
+        std::vector<dht::partition_range> ranges;
+        std::optional<dht::token> last;
+        for (uint64_t i = 1; i < fanout; i++) {
+            auto& t = samples[i * samples.size() / fanout];
+            if (last && !(*last < t)) {
+                continue;
+            }
+            auto end = dht::partition_range::bound(dht::ring_position::ending_at(t), true);
+            if (!last) {
+                ranges.push_back(dht::partition_range::make_ending_with(std::move(end)));
+            } else {
+                ranges.push_back(dht::partition_range::make(
+                        dht::partition_range::bound(dht::ring_position::ending_at(*last), false), std::move(end)));
+            }
+            last = t;
+        }
+        if (!last) {
+            return compaction::make_compaction_ranges();
+        }
+        ranges.push_back(dht::partition_range::make_starting_with(
+                dht::partition_range::bound(dht::ring_position::ending_at(*last), false)));
+        _output_sstables.resize(ranges.size() * smp::count);
+        _current_shard.resize(ranges.size());
+        return ranges;
+    }
+
     // Use reader that makes sure no non-local mutation will not be filtered out.
-    flat_mutation_reader make_sstable_reader() const override {
+    flat_mutation_reader make_sstable_reader(const dht::partition_range& range) const override {
         return ::make_range_sstable_reader(_cf.schema(),
                 _compacting,
-                query::full_partition_range,
+                range,
                 _cf.schema()->full_slice(),
                 service::get_local_compaction_priority(),
                 no_resource_tracking(),
@@ -819,33 +911,35 @@ public:
 
     void backlog_tracker_adjust_charges() override { }
 
-    sstable_writer* select_sstable_writer(const dht::decorated_key& dk) override {
-        _shard = dht::shard_of(dk.token());
-        auto& sst = _output_sstables[_shard].first;
-        auto& writer = _output_sstables[_shard].second;
+    sstable_writer* select_sstable_writer(const dht::decorated_key& dk, unsigned stream) override {
+        auto shard = dht::shard_of(dk.token());
+        _current_shard[stream] = shard;
+        auto& sst = _output_sstables[stream * smp::count + shard].first;
+        auto& writer = _output_sstables[stream * smp::count + shard].second;
 
         if (!writer) {
-            sst = _sstable_creator(_shard);
+            sst = _sstable_creator(shard);
             setup_new_sstable(sst);
 
             sstable_writer_config cfg;
             cfg.max_sstable_size = _max_sstable_size;
             cfg.large_data_handler = _cf.get_large_data_handler();
             auto&& priority = service::get_local_compaction_priority();
-            writer.emplace(sst->get_writer(*_cf.schema(), partitions_per_sstable(_shard), cfg, get_encoding_stats(), priority, _shard));
+            writer.emplace(sst->get_writer(*_cf.schema(), partitions_per_sstable(shard), cfg, get_encoding_stats(), priority, shard));
         }
         return &*writer;
     }
 
-    void stop_sstable_writer() override {
-        auto& sst = _output_sstables[_shard].first;
-        auto& writer = _output_sstables[_shard].second;
+    void stop_sstable_writer(unsigned stream) override {
+        auto& sst = _output_sstables[stream * smp::count + _current_shard[stream]].first;
+        auto& writer = _output_sstables[stream * smp::count + _current_shard[stream]].second;
 
         finish_new_sstable(writer, sst);
     }
 
-    void finish_sstable_writer() override {
-        for (auto& p : _output_sstables) {
+    void finish_sstable_writer(unsigned stream) override {
+        for (shard_id shard = 0; shard < smp::count; shard++) {
+            auto& p = _output_sstables[stream * smp::count + shard];
             if (p.second) {
                 finish_new_sstable(p.second, p.first);
             }
@@ -855,19 +949,24 @@ public:
 
 future<compaction_info> compaction::run(std::unique_ptr<compaction> c) {
     return seastar::async([c = std::move(c)] () mutable {
-        auto reader = c->setup();
-
-        auto cr = c->get_compacting_sstable_writer();
-        auto cfc = make_stable_flattened_mutations_consumer<compact_for_compaction<compacting_sstable_writer>>(
-            *c->schema(), gc_clock::now(), std::move(cr), c->max_purgeable_func());
+        c->setup();
 
         auto start_time = db_clock::now();
         try {
-            // make sure the readers are all gone before the compaction object is gone. We will
-            // leave this block either successfully or exceptionally with the reader object
-            // destroyed.
-            auto r = std::move(reader);
-            r.consume_in_thread(std::move(cfc), c->filter_func(), db::no_timeout);
+            // Each range is compacted by its own fiber with an independent
+            // reader and set of writers. parallel_for_each() waits for all
+            // fibers, so the readers are all gone before the compaction
+            // object is gone. We will leave this block either successfully
+            // or exceptionally with the reader objects destroyed.
+            parallel_for_each(boost::irange(unsigned(0), unsigned(c->_ranges.size())), [&c] (unsigned stream) {
+                return seastar::async([&c, stream] {
+                    auto cr = c->get_compacting_sstable_writer(stream);
+                    auto cfc = make_stable_flattened_mutations_consumer<compact_for_compaction<compacting_sstable_writer>>(
+                        *c->schema(), gc_clock::now(), std::move(cr), c->max_purgeable_func());
+                    auto r = c->make_sstable_reader(c->_ranges[stream]);
+                    r.consume_in_thread(std::move(cfc), c->filter_func(), db::no_timeout);
+                });
+            }).get();
         } catch (...) {
             delete_sstables_for_interrupted_compaction(c->_info->new_sstables, c->_info->ks_name, c->_info->cf_name);
             c = nullptr; // make sure writers are stopped while running in thread context
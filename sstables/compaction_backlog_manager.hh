@@ -87,6 +87,13 @@ public:
     double backlog() const;
     void add_sstable(sstables::shared_sstable sst);
     void remove_sstable(sstables::shared_sstable sst);
+    // Records how many sstables a read had to consult. Kept as an
+    // exponentially-decaying average and used to scale the backlog reported
+    // to the controller, so compaction urgency follows the read amplification
+    // reads actually experience. Cheap enough for the read path.
+    void register_read(unsigned sstables_consulted) {
+        _sstables_per_read = _sstables_per_read * read_ema_decay + sstables_consulted * (1.0 - read_ema_decay);
+    }
     void register_partially_written_sstable(sstables::shared_sstable sst, backlog_write_progress_manager& wp);
     void register_compacting_sstable(sstables::shared_sstable sst, backlog_read_progress_manager& rp);
     void transfer_ongoing_charges(compaction_backlog_tracker& new_bt, bool move_read_charges = true);
@@ -97,6 +104,13 @@ private:
         _ongoing_writes = {};
         _ongoing_compactions = {};
     }
+    double read_amplification_factor() const;
+
+    // Each read contributes 0.1%, so the average spans roughly the last few
+    // thousand reads and tracks workload changes within seconds.
+    static constexpr double read_ema_decay = 0.999;
+    // Decayed average of sstables consulted per read; 0 until a read is seen.
+    double _sstables_per_read = 0;
     bool _disabled = false;
     std::unique_ptr<impl> _impl;
     // We keep track of this so that we can transfer to a new tracker if the compaction strategy is
@@ -25,6 +25,10 @@
 #include "sstables/sstables.hh"
 #include "database.hh"
 #include <seastar/core/metrics.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/thread.hh>
+#include "service/priority_manager.hh"
+#include "utils/memory_label.hh"
 #include "exceptions.hh"
 #include <cmath>
 #include <boost/range/algorithm/count_if.hpp>
@@ -261,15 +265,24 @@ future<> compaction_manager::submit_major_compaction(column_family* cf) {
             // candidates are sstables that aren't being operated on by other compaction types.
             // those are eligible for major compaction.
             sstables::compaction_strategy cs = cf->get_compaction_strategy();
-            sstables::compaction_descriptor descriptor = cs.get_major_compaction_job(*cf, get_candidates(*cf));
-            auto compacting = compacting_sstable_registration(this, descriptor.sstables);
+            std::vector<sstables::compaction_descriptor> descriptors = cs.get_major_compaction_jobs(*cf, get_candidates(*cf));
+            std::vector<sstables::shared_sstable> all_sstables;
+            for (auto& descriptor : descriptors) {
+                all_sstables.insert(all_sstables.end(), descriptor.sstables.begin(), descriptor.sstables.end());
+            }
+            auto compacting = compacting_sstable_registration(this, std::move(all_sstables));
 
-            cmlog.info0("User initiated compaction started on behalf of {}.{}", cf->schema()->ks_name(), cf->schema()->cf_name());
+            cmlog.info0("User initiated compaction started on behalf of {}.{}, in {} job(s)", cf->schema()->ks_name(), cf->schema()->cf_name(), descriptors.size());
             compaction_backlog_tracker user_initiated(std::make_unique<user_initiated_backlog_tracker>(_compaction_controller.backlog_of_shares(200), _available_memory));
-            return do_with(std::move(user_initiated), [this, cf, descriptor = std::move(descriptor)] (compaction_backlog_tracker& bt) mutable {
+            return do_with(std::move(user_initiated), std::move(descriptors), [this, cf] (compaction_backlog_tracker& bt, std::vector<sstables::compaction_descriptor>& descriptors) {
                 register_backlog_tracker(bt);
-                return with_scheduling_group(_scheduling_group, [this, cf, descriptor = std::move(descriptor)] () mutable {
-                    return cf->compact_sstables(std::move(descriptor));
+                return with_scheduling_group(_scheduling_group, [this, cf, &descriptors] {
+                    // The jobs operate on disjoint sets of sstables, so they
+                    // are safe to run concurrently; strategies that cannot
+                    // split their major work return a single job.
+                    return parallel_for_each(descriptors, [cf] (sstables::compaction_descriptor& descriptor) {
+                        return cf->compact_sstables(std::move(descriptor));
+                    });
                 });
             }).then([compacting = std::move(compacting)] {});
         });
@@ -527,7 +540,9 @@ void compaction_manager::submit(column_family* cf) {
             _stats.pending_tasks--;
             _stats.active_tasks++;
             task->compaction_running = true;
-            return cf.run_compaction(std::move(descriptor)).then_wrapped([this, task, compacting = std::move(compacting)] (future<> f) mutable {
+            return utils::with_memory_label("compaction", [&cf, descriptor = std::move(descriptor)] () mutable {
+                return cf.run_compaction(std::move(descriptor));
+            }).then_wrapped([this, task, compacting = std::move(compacting)] (future<> f) mutable {
                 _stats.active_tasks--;
                 task->compaction_running = false;
 
@@ -622,6 +637,50 @@ future<> compaction_manager::perform_cleanup(column_family* cf) {
     return task->compaction_done.get_future().then([task] {});
 }
 
+future<int64_t> compaction_manager::perform_sstable_validation(column_family* cf) {
+    // Enough concurrent files to keep the disk busy, without turning the
+    // sweep into a seek storm.
+    static constexpr size_t validation_concurrency = 4;
+
+    auto sstables = make_lw_shared<std::vector<sstables::shared_sstable>>(get_candidates(*cf));
+    auto errors = make_lw_shared<int64_t>(0);
+    cmlog.info("Validating checksums of {} sstables of {}.{}", sstables->size(),
+            cf->schema()->ks_name(), cf->schema()->cf_name());
+    return with_scheduling_group(_scheduling_group, [cf, sstables, errors] {
+        return do_with(semaphore(validation_concurrency), [cf, sstables, errors] (semaphore& sem) {
+            return parallel_for_each(*sstables, [cf, errors, &sem] (sstables::shared_sstable sst) {
+                return with_semaphore(sem, 1, [cf, errors, sst] {
+                    return sst->validate_checksums(service::get_local_compaction_priority()).then([cf, errors, sst] (bool valid) {
+                        if (valid) {
+                            return make_ready_future<>();
+                        }
+                        ++(*errors);
+                        // The cheap scan only tells that a chunk is bad; parse
+                        // the sstable for real to report what is damaged.
+                        return seastar::async([cf, sst] {
+                            auto reader = sst->read_rows_flat(cf->schema(), service::get_local_compaction_priority());
+                            while (reader(db::no_timeout).get0()) {
+                            }
+                        }).then_wrapped([sst] (future<> f) {
+                            try {
+                                f.get();
+                                cmlog.error("{}: checksum mismatch, but the content still parses", sst->get_filename());
+                            } catch (...) {
+                                cmlog.error("{}: {}", sst->get_filename(), std::current_exception());
+                            }
+                        });
+                    });
+                });
+            });
+        });
+    }).then([sstables, errors] {
+        if (*errors) {
+            cmlog.error("Validation of {} sstables found {} corrupted", sstables->size(), *errors);
+        }
+        return *errors;
+    });
+}
+
 future<> compaction_manager::remove(column_family* cf) {
     // FIXME: better way to iterate through compaction info for a given column family,
     // although this path isn't performance sensitive.
@@ -690,8 +749,23 @@ void compaction_manager::propagate_replacement(column_family* cf,
     }
 }
 
+// Reads touching many sstables are the user-visible cost of backlog, so scale
+// what the controller sees by what reads actually experience: up to twice the
+// shape-based backlog when reads consult many files, down to half of it when
+// the table's reads, if there are any, are satisfied by a single sstable, as
+// on write-only tables.
+double compaction_backlog_tracker::read_amplification_factor() const {
+    if (_sstables_per_read == 0) {
+        // No reads sampled yet; don't distort the shape-based backlog.
+        return 1.0;
+    }
+    // Compactions merge at least 4 sstables, so a read consulting 4 is one
+    // compaction away from consulting one: treat that as neutral.
+    return std::clamp(_sstables_per_read / 4.0, 0.5, 2.0);
+}
+
 double compaction_backlog_tracker::backlog() const {
-    return _disabled ? compaction_controller::disable_backlog : _impl->backlog(_ongoing_writes, _ongoing_compactions);
+    return _disabled ? compaction_controller::disable_backlog : _impl->backlog(_ongoing_writes, _ongoing_compactions) * read_amplification_factor();
 }
 
 void compaction_backlog_tracker::add_sstable(sstables::shared_sstable sst) {
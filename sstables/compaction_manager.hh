@@ -166,6 +166,13 @@ public:
     // Submit a column family to be cleaned up and wait for its termination.
     future<> perform_cleanup(column_family* cf);
 
+    // Verify the Digest and per-chunk checksums of all sstables of a column
+    // family without parsing their contents, validating a few files at a time
+    // under the compaction scheduling group. Sstables whose checksums don't
+    // match are read again through the full parse path to report what exactly
+    // is damaged. Returns the number of corrupted sstables found.
+    future<int64_t> perform_sstable_validation(column_family* cf);
+
     // Submit a column family for major compaction.
     future<> submit_major_compaction(column_family* cf);
 
@@ -121,9 +121,14 @@ sstable_set::operator=(const sstable_set& x) {
 sstable_set&
 sstable_set::operator=(sstable_set&&) noexcept = default;
 
+thread_local sstable_set::selection_stats sstable_set::_selection_stats;
+
 std::vector<shared_sstable>
 sstable_set::select(const dht::partition_range& range) const {
-    return _impl->select(range);
+    auto ssts = _impl->select(range);
+    _selection_stats.selections++;
+    _selection_stats.sstables_selected += ssts.size();
+    return ssts;
 }
 
 std::vector<sstable_run>
@@ -174,6 +179,8 @@ sstable_set::incremental_selector::select(const dht::ring_position_view& pos) co
     if (!_current_range_view || !_current_range_view->contains(pos, _cmp)) {
         std::tie(_current_range, _current_sstables, _current_next_position) = _impl->select(pos);
         _current_range_view = _current_range->transform([] (const dht::ring_position& rp) { return dht::ring_position_view(rp); });
+        _selection_stats.selections++;
+        _selection_stats.sstables_selected += _current_sstables.size();
     }
     return {_current_sstables, _current_next_position};
 }
@@ -236,7 +243,16 @@ private:
     // Change counter on interval map for leveled sstables which is used by
     // incremental selector to determine whether or not to invalidate iterators.
     uint64_t _leveled_sstables_change_cnt = 0;
+    // When true, level 0 sstables are stored aside in _unleveled_sstables and
+    // returned from every select(), matching the leveled strategy's assumption
+    // that L0 files may overlap anything. When false, all sstables go into the
+    // interval map keyed by their first and last keys, so selection stays
+    // logarithmic no matter how many narrow sstables pile up.
+    bool _use_level_metadata = true;
 private:
+    bool store_as_unleveled(const shared_sstable& sst) const {
+        return _use_level_metadata && sst->get_sstable_level() == 0;
+    }
     static interval_type make_interval(const schema& s, const dht::partition_range& range) {
         return interval_type::closed(
                 compatible_ring_position_view(s, range.start()->value()),
@@ -295,8 +311,9 @@ public:
         auto upper_bound = dht::partition_range::bound(to_ring_position(i.lower()), !boost::icl::is_left_closed(i.bounds()));
         return dht::partition_range::make(std::move(lower_bound), std::move(upper_bound));
     }
-    explicit partitioned_sstable_set(schema_ptr schema)
-            : _schema(std::move(schema)) {
+    explicit partitioned_sstable_set(schema_ptr schema, bool use_level_metadata = true)
+            : _schema(std::move(schema))
+            , _use_level_metadata(use_level_metadata) {
     }
     virtual std::unique_ptr<sstable_set_impl> clone() const override {
         return std::make_unique<partitioned_sstable_set>(*this);
@@ -314,7 +331,7 @@ public:
         return r;
     }
     virtual void insert(shared_sstable sst) override {
-        if (sst->get_sstable_level() == 0) {
+        if (store_as_unleveled(sst)) {
             _unleveled_sstables.push_back(std::move(sst));
         } else {
             _leveled_sstables_change_cnt++;
@@ -322,7 +339,7 @@ public:
         }
     }
     virtual void erase(shared_sstable sst) override {
-        if (sst->get_sstable_level() == 0) {
+        if (store_as_unleveled(sst)) {
             _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
         } else {
             _leveled_sstables_change_cnt++;
@@ -403,13 +420,24 @@ std::unique_ptr<incremental_selector_impl> partitioned_sstable_set::make_increme
 }
 
 std::unique_ptr<sstable_set_impl> compaction_strategy_impl::make_sstable_set(schema_ptr schema) const {
-    return std::make_unique<bag_sstable_set>();
+    // All sstables go into the interval map regardless of level, so reads
+    // only consider the sstables whose key range actually intersects theirs.
+    return std::make_unique<partitioned_sstable_set>(std::move(schema), false);
 }
 
 std::unique_ptr<sstable_set_impl> leveled_compaction_strategy::make_sstable_set(schema_ptr schema) const {
     return std::make_unique<partitioned_sstable_set>(std::move(schema));
 }
 
+std::unordered_set<shared_sstable>
+compaction_strategy_impl::maybe_get_fully_expired_sstables(column_family& cf, const std::vector<shared_sstable>& candidates, gc_clock::time_point gc_before) {
+    if (db_clock::now() - _last_expired_check < DEFAULT_EXPIRED_SSTABLE_CHECK_FREQUENCY()) {
+        return {};
+    }
+    _last_expired_check = db_clock::now();
+    return get_fully_expired_sstables(cf, candidates, gc_before);
+}
+
 std::vector<resharding_descriptor>
 compaction_strategy_impl::get_resharding_jobs(column_family& cf, std::vector<sstables::shared_sstable> candidates) {
     std::vector<resharding_descriptor> jobs;
@@ -719,6 +747,10 @@ compaction_descriptor compaction_strategy::get_major_compaction_job(column_famil
     return _compaction_strategy_impl->get_major_compaction_job(cf, std::move(candidates));
 }
 
+std::vector<compaction_descriptor> compaction_strategy::get_major_compaction_jobs(column_family& cf, std::vector<sstables::shared_sstable> candidates) {
+    return _compaction_strategy_impl->get_major_compaction_jobs(cf, std::move(candidates));
+}
+
 std::vector<resharding_descriptor> compaction_strategy::get_resharding_jobs(column_family& cf, std::vector<sstables::shared_sstable> candidates) {
     return _compaction_strategy_impl->get_resharding_jobs(cf, std::move(candidates));
 }
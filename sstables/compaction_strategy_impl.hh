@@ -23,6 +23,9 @@
 
 #include "cql3/statements/property_definitions.hh"
 #include "compaction_backlog_manager.hh"
+#include <boost/range/algorithm/remove_if.hpp>
+#include <boost/range/algorithm/sort.hpp>
+#include <unordered_set>
 
 namespace sstables {
 
@@ -34,6 +37,8 @@ class compaction_strategy_impl {
     static constexpr float DEFAULT_TOMBSTONE_THRESHOLD = 0.2f;
     // minimum interval needed to perform tombstone removal compaction in seconds, default 86400 or 1 day.
     static constexpr std::chrono::seconds DEFAULT_TOMBSTONE_COMPACTION_INTERVAL() { return std::chrono::seconds(86400); }
+    // how often to look for sstables that expired wholesale, default 600 or 10 minutes.
+    static constexpr std::chrono::seconds DEFAULT_EXPIRED_SSTABLE_CHECK_FREQUENCY() { return std::chrono::seconds(600); }
 protected:
     const sstring TOMBSTONE_THRESHOLD_OPTION = "tombstone_threshold";
     const sstring TOMBSTONE_COMPACTION_INTERVAL_OPTION = "tombstone_compaction_interval";
@@ -42,6 +47,7 @@ protected:
     bool _disable_tombstone_compaction = false;
     float _tombstone_threshold = DEFAULT_TOMBSTONE_THRESHOLD;
     db_clock::duration _tombstone_compaction_interval = DEFAULT_TOMBSTONE_COMPACTION_INTERVAL();
+    db_clock::time_point _last_expired_check;
 public:
     static std::optional<sstring> get_value(const std::map<sstring, sstring>& options, const sstring& name) {
         auto it = options.find(name);
@@ -70,6 +76,14 @@ public:
     virtual compaction_descriptor get_major_compaction_job(column_family& cf, std::vector<sstables::shared_sstable> candidates) {
         return compaction_descriptor(std::move(candidates));
     }
+    // Major compaction normally rewrites all candidates in one job; a
+    // strategy whose major work falls apart into jobs over disjoint sets of
+    // sstables can override this so they are scheduled in parallel.
+    virtual std::vector<compaction_descriptor> get_major_compaction_jobs(column_family& cf, std::vector<sstables::shared_sstable> candidates) {
+        std::vector<compaction_descriptor> jobs;
+        jobs.push_back(get_major_compaction_job(cf, std::move(candidates)));
+        return jobs;
+    }
     virtual std::vector<resharding_descriptor> get_resharding_jobs(column_family& cf, std::vector<sstables::shared_sstable> candidates);
     virtual void notify_completion(const std::vector<shared_sstable>& removed, const std::vector<shared_sstable>& added) { }
     virtual compaction_strategy_type type() const = 0;
@@ -103,6 +117,29 @@ public:
         return sst->estimate_droppable_tombstone_ratio(gc_before) >= _tombstone_threshold;
     }
 
+    // Looks for sstables whose data expired wholesale (e.g. TTL-only tables
+    // with no explicit deletes). Such sstables are detected by
+    // max_local_deletion_time in their stats metadata alone and get dropped
+    // by compaction without reading a single row, so reclaiming them is much
+    // cheaper than any merge. The check is rate limited because
+    // get_fully_expired_sstables() is not entirely free.
+    std::unordered_set<shared_sstable> maybe_get_fully_expired_sstables(column_family& cf, const std::vector<shared_sstable>& candidates, gc_clock::time_point gc_before);
+
+    // Filters out candidates which are not entitled for tombstone compaction
+    // and sorts the rest by droppable tombstone ratio, in decreasing order,
+    // so callers can prioritize the candidates whose compaction is expected
+    // to reclaim the most disk space.
+    std::vector<shared_sstable> get_sstables_by_garbage_ratio(std::vector<shared_sstable> candidates, gc_clock::time_point gc_before) {
+        auto e = boost::range::remove_if(candidates, [this, &gc_before] (const shared_sstable& sst) {
+            return !worth_dropping_tombstones(sst, gc_before);
+        });
+        candidates.erase(e, candidates.end());
+        boost::sort(candidates, [&gc_before] (const shared_sstable& i, const shared_sstable& j) {
+            return i->estimate_droppable_tombstone_ratio(gc_before) > j->estimate_droppable_tombstone_ratio(gc_before);
+        });
+        return candidates;
+    }
+
     virtual compaction_backlog_tracker& get_backlog_tracker() = 0;
 };
 }
@@ -36,6 +36,7 @@ enum class component_type {
     Statistics,
     TemporaryTOC,
     TemporaryStatistics,
+    TemporarySummary,
     Scylla,
     Unknown,
 };
@@ -21,6 +21,10 @@
 
 #include <stdexcept>
 #include <cstdlib>
+#include <atomic>
+#include <list>
+#include <optional>
+#include <unordered_map>
 
 #include <boost/range/algorithm/find_if.hpp>
 #include <seastar/core/align.hh>
@@ -33,6 +37,7 @@
 #include "unimplemented.hh"
 #include "segmented_compress_params.hh"
 #include "utils/class_registrator.hh"
+#include "utils/hash.hh"
 
 namespace sstables {
 
@@ -246,6 +251,8 @@ public:
 
     size_t uncompress(const char* input, size_t input_len, char* output,
                     size_t output_len) const;
+    size_t uncompress_partial(const char* input, size_t input_len, char* output,
+                    size_t output_len, size_t target_len) const;
     size_t compress(const char* input, size_t input_len, char* output,
                     size_t output_len) const;
     size_t compress_max_size(size_t input_len) const;
@@ -286,6 +293,13 @@ size_t local_compression::uncompress(const char* input,
     }
     return _compressor->uncompress(input, input_len, output, output_len);
 }
+size_t local_compression::uncompress_partial(const char* input,
+                size_t input_len, char* output, size_t output_len, size_t target_len) const {
+    if (!_compressor) {
+        throw std::runtime_error("uncompress is not supported");
+    }
+    return _compressor->uncompress_partial(input, input_len, output, output_len, target_len);
+}
 size_t local_compression::compress(const char* input, size_t input_len,
                 char* output, size_t output_len) const {
     if (!_compressor) {
@@ -312,8 +326,16 @@ void compression::set_compressor(compressor_ptr c) {
     }
 }
 
+static std::atomic<uint64_t> chunk_cache_next_id{1};
+
 void compression::update(uint64_t compressed_file_length) {
     _compressed_file_length = compressed_file_length;
+    if (!_cache_id) {
+        // update() may run on several shards for shared components; the
+        // worst a race can produce is two distinct ids for one sstable,
+        // which only costs cache misses.
+        _cache_id = chunk_cache_next_id.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 
@@ -337,6 +359,73 @@ compression::locate(uint64_t position, const compression::segmented_offsets::acc
 
 }
 
+// Shard-local cache of uncompressed chunks, keyed by the compression
+// metadata's cache id and the chunk's position in the compressed file.
+// Hot mid-partition slices which bypass the row cache decompress the same
+// chunks on every read; keeping the uncompressed bytes around lets such
+// reads skip both checksum verification and decompression. Entries are
+// dropped in LRU order to stay within a fixed byte budget; cache ids are
+// never reused, so entries of deleted sstables simply age out.
+class uncompressed_chunk_cache {
+public:
+    using key_type = std::pair<uint64_t, uint64_t>;
+
+    static thread_local struct stats {
+        uint64_t hits = 0; // Number of lookups which found the chunk cached
+        uint64_t misses = 0; // Number of lookups which did not
+        uint64_t evictions = 0; // Number of chunks evicted to stay within the budget
+        uint64_t bytes = 0; // Memory currently held by cached chunks
+    } _shard_stats;
+private:
+    static constexpr size_t max_bytes = 4 * 1024 * 1024;
+
+    using lru_list = std::list<std::pair<key_type, temporary_buffer<char>>>;
+    lru_list _lru; // Most recently used first
+    std::unordered_map<key_type, lru_list::iterator, utils::tuple_hash> _chunks;
+private:
+    void evict_one() noexcept {
+        auto& victim = _lru.back();
+        _shard_stats.bytes -= victim.second.size();
+        ++_shard_stats.evictions;
+        _chunks.erase(victim.first);
+        _lru.pop_back();
+    }
+public:
+    // Returns a buffer sharing storage with the cached chunk, or a
+    // disengaged optional when the chunk is not cached.
+    std::optional<temporary_buffer<char>> lookup(key_type key) {
+        auto i = _chunks.find(key);
+        if (i == _chunks.end()) {
+            ++_shard_stats.misses;
+            return std::nullopt;
+        }
+        _lru.splice(_lru.begin(), _lru, i->second);
+        ++_shard_stats.hits;
+        return i->second->second.share();
+    }
+
+    // Offers a freshly uncompressed chunk for retention. The buffer is
+    // shared, not copied.
+    void populate(key_type key, temporary_buffer<char>& buf) {
+        if (buf.size() > max_bytes || _chunks.count(key)) {
+            return;
+        }
+        while (_shard_stats.bytes + buf.size() > max_bytes) {
+            evict_one();
+        }
+        _lru.emplace_front(key, buf.share());
+        _chunks.emplace(key, _lru.begin());
+        _shard_stats.bytes += buf.size();
+    }
+
+    static uncompressed_chunk_cache& shard_cache() {
+        static thread_local uncompressed_chunk_cache cache;
+        return cache;
+    }
+};
+
+thread_local uncompressed_chunk_cache::stats uncompressed_chunk_cache::_shard_stats;
+
 template <typename ChecksumType>
 GCC6_CONCEPT(
     requires ChecksumUtils<ChecksumType>
@@ -393,6 +482,20 @@ public:
         if (_pos != _beg_pos && addr.offset != 0) {
             throw std::runtime_error("compressed reader out of sync");
         }
+        auto cache_key = uncompressed_chunk_cache::key_type(_compression_metadata->chunk_cache_id(), addr.chunk_start);
+        if (cache_key.first) {
+            if (auto cached = uncompressed_chunk_cache::shard_cache().lookup(cache_key)) {
+                auto out = std::move(*cached);
+                out.trim_front(addr.offset);
+                _pos += out.size();
+                _underlying_pos += addr.chunk_len;
+                // The chunk was verified when it entered the cache; just move
+                // the underlying stream past it.
+                return _input_stream->skip(addr.chunk_len).then([out = std::move(out)] () mutable {
+                    return make_ready_future<temporary_buffer<char>>(std::move(out));
+                });
+            }
+        }
         return _input_stream->read_exactly(addr.chunk_len).
             then([this, addr](temporary_buffer<char> buf) {
                 // The last 4 bytes of the chunk are the adler32/crc32 checksum
@@ -412,9 +515,27 @@ public:
                 // The compressed data is the whole chunk, minus the last 4
                 // bytes (which contain the checksum verified above).
 
-                auto len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
-
-                out.trim(len);
+                // How much of this chunk the stream will actually serve. When
+                // the read range ends inside the chunk (e.g. a point read of a
+                // small slice), there is no need to decompress the tail of the
+                // chunk past _end_pos; decompressors which can stop early
+                // (lz4, deflate) then do proportionally less work.
+                auto chunk_start = _pos - addr.offset;
+                auto needed = _end_pos - chunk_start;
+                size_t len;
+                if (needed < out.size()) {
+                    len = _compression.uncompress_partial(buf.get(), compressed_len, out.get_write(), out.size(), needed);
+                    out.trim(len);
+                } else {
+                    len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
+                    out.trim(len);
+                    // Only fully decompressed chunks may enter the cache; a
+                    // partial chunk would be served as if it were whole.
+                    auto cache_key = uncompressed_chunk_cache::key_type(_compression_metadata->chunk_cache_id(), addr.chunk_start);
+                    if (cache_key.first) {
+                        uncompressed_chunk_cache::shard_cache().populate(cache_key, out);
+                    }
+                }
                 out.trim_front(addr.offset);
                 _pos += out.size();
                 _underlying_pos += addr.chunk_len;
@@ -493,6 +614,11 @@ class compressed_file_data_sink_impl : public data_sink_impl {
     sstables::local_compression _compression;
     size_t _pos = 0;
     uint32_t _full_checksum;
+    // Resolves when all chunks queued so far have been written. put()
+    // returns the future of the previous chunk's write instead of the
+    // current one's, so compression and checksumming of the next chunk
+    // overlap with the write of this one, with at most one chunk in flight.
+    future<> _pending_write = make_ready_future<>();
 public:
     compressed_file_data_sink_impl(file f, sstables::compression* cm, sstables::local_compression lc, file_output_stream_options options)
             : _out(make_file_output_stream(std::move(f), options))
@@ -540,11 +666,16 @@ public:
 
         compressed.trim(len + 4);
 
-        auto f = _out.write(compressed.get(), compressed.size());
-        return f.then([compressed = std::move(compressed)] {});
+        auto write_fut = _pending_write.then([this, compressed = std::move(compressed)] () mutable {
+            auto f = _out.write(compressed.get(), compressed.size());
+            return f.then([compressed = std::move(compressed)] {});
+        });
+        return std::exchange(_pending_write, std::move(write_fut));
     }
     virtual future<> close() override {
-        return _out.close();
+        return std::exchange(_pending_write, make_ready_future<>()).finally([this] {
+            return _out.close();
+        });
     }
 };
 
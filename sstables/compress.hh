@@ -306,12 +306,18 @@ private:
     // Variables *not* found in the "Compression Info" file (added by update()):
     uint64_t _compressed_file_length = 0;
     uint32_t _full_checksum = 0;
+    // Key namespace in the shard-local uncompressed chunk cache, assigned
+    // from a never-reused global counter by update(). 0 means unassigned.
+    uint64_t _cache_id = 0;
 public:
     // Set the compressor algorithm, please check the definition of enum compressor.
     void set_compressor(compressor_ptr c);
     // After changing _compression, update() must be called to update
-    // additional variables depending on it.    
+    // additional variables depending on it.
     void update(uint64_t compressed_file_length);
+    uint64_t chunk_cache_id() const noexcept {
+        return _cache_id;
+    }
     operator bool() const {
         return !name.value.empty();
     }
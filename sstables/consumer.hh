@@ -119,8 +119,11 @@ private:
         } else {
             const vint_size_type len = VintType::serialized_size_from_first_byte(*data.begin());
             if (data.size() >= len) {
+                // Pass the whole remaining buffer, not just the vint's own
+                // bytes: deserialize() stops after the vint anyway, and the
+                // extra visible bytes let it use its single-load fast path.
                 dest = VintType::deserialize(
-                        bytes_view(reinterpret_cast<bytes::value_type*>(data.get_write()), len)).value;
+                        bytes_view(reinterpret_cast<bytes::value_type*>(data.get_write()), data.size())).value;
                 data.trim_front(len);
                 return read_status::ready;
             } else {
@@ -413,6 +413,14 @@ public:
     date_tiered_compaction_strategy(const std::map<sstring, sstring>& options);
     virtual compaction_descriptor get_sstables_for_compaction(column_family& cfs, std::vector<sstables::shared_sstable> candidates) override {
         auto gc_before = gc_clock::now() - cfs.schema()->gc_grace_seconds();
+
+        // Prefer dropping sstables that expired wholesale; they are reclaimed
+        // from their stats metadata alone, without reading any data.
+        auto expired = maybe_get_fully_expired_sstables(cfs, candidates, gc_before);
+        if (!expired.empty()) {
+            return sstables::compaction_descriptor(std::vector<sstables::shared_sstable>(expired.begin(), expired.end()));
+        }
+
         auto sstables = _manifest.get_next_sstables(cfs, candidates, gc_before);
 
         if (!sstables.empty()) {
@@ -420,20 +428,13 @@ public:
             return sstables::compaction_descriptor(std::move(sstables));
         }
 
-        // filter out sstables which droppable tombstone ratio isn't greater than the defined threshold.
-        auto e = boost::range::remove_if(candidates, [this, &gc_before] (const sstables::shared_sstable& sst) -> bool {
-            return !worth_dropping_tombstones(sst, gc_before);
-        });
-        candidates.erase(e, candidates.end());
-        if (candidates.empty()) {
+        // try compacting the single sstable which is worth dropping tombstones and whose
+        // compaction reclaims the most garbage.
+        auto worth = get_sstables_by_garbage_ratio(std::move(candidates), gc_before);
+        if (worth.empty()) {
             return sstables::compaction_descriptor();
         }
-        // find oldest sstable which is worth dropping tombstones because they are more unlikely to
-        // shadow data from other sstables, and it also tends to be relatively big.
-        auto it = std::min_element(candidates.begin(), candidates.end(), [] (auto& i, auto& j) {
-            return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
-        });
-        return sstables::compaction_descriptor({ *it });
+        return sstables::compaction_descriptor({ worth.front() });
     }
 
     virtual int64_t estimated_pending_compactions(column_family& cf) const override {
@@ -244,6 +244,25 @@ private:
 
     std::variant<k_l_parser_context, m_parser_context> _ctx;
 
+    // Called in the parsing loop after each block is appended to _pi_blocks.
+    // In consume_until mode parsing can stop at the first block whose start
+    // position is past the searched-for position: blocks are ordered by
+    // start, so that block is the upper bound and nothing after it is
+    // needed. Returns true when parsing of the current batch should stop.
+    // Blocks which can no longer be the upper bound are trimmed as we go, so
+    // that a promoted index arriving in a single buffer is never materialized
+    // in full just to locate one block.
+    bool should_stop_parsing() {
+        if (_mode != consuming_mode::consume_until) {
+            return false;
+        }
+        if (promoted_index_block_compare(_s)(*_pos, _pi_blocks.back().start(_s))) {
+            return true;
+        }
+        erase_all_but_last_two(_pi_blocks);
+        return false;
+    }
+
     void process_state(temporary_buffer<char>& data, k_l_parser_context& ctx) {
         using state_k_l = typename k_l_parser_context::state;
         // keep running in the loop until we either are out of data or have consumed all the blocks
@@ -288,6 +307,9 @@ private:
                 if (_num_blocks_left == 0) {
                     return;
                 }
+                if (should_stop_parsing()) {
+                    return;
+                }
             }
         }
     }
@@ -423,6 +445,9 @@ private:
                 if (_num_blocks_left == 0) {
                     return;
                 }
+                if (should_stop_parsing()) {
+                    return;
+                }
             }
         }
     }
@@ -584,6 +609,14 @@ public:
     index_entry(index_entry&&) = default;
     index_entry& operator=(index_entry&&) = default;
 
+    // Returns a copy of this entry which shares the key buffer with this one.
+    // Only valid for entries without a promoted index, since the promoted
+    // index reader is stateful and cannot be shared between copies.
+    index_entry share() {
+        assert(!_index);
+        return index_entry(_key.share(), _position, nullptr);
+    }
+
     // Reads promoted index blocks from the stream until it finds the upper bound
     // for a given position.
     // Returns the index of the element right before the upper bound one.
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "shared_index_lists.hh"
+#include "utils/hash.hh"
+#include <algorithm>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace sstables {
+
+class sstable;
+
+// Shard-wide retention cache for parsed index pages.
+//
+// shared_index_lists only shares a page between readers which hold it at the
+// same time; once the last reference is dropped the parsed page is discarded
+// and the next read of the same partition pays for reading and parsing the
+// page all over again. This cache keeps recently used pages alive past that
+// point, bounded by a byte budget and evicted in LRU order.
+//
+// Only pages whose entries carry no promoted index are retained. An entry
+// with a promoted index owns a stateful stream which is advanced and closed
+// by the read which loaded it, so it cannot be handed out to a later read.
+// Pages are cloned on both insertion and lookup (key buffers are shared, not
+// copied), so readers never observe each other's mutations of a page.
+class index_page_cache {
+public:
+    // Pages are keyed by the owning sstable and the summary index of the page.
+    using key_type = std::pair<const sstable*, uint64_t>;
+
+    static thread_local struct stats {
+        uint64_t hits = 0; // Number of lookups which found the page cached
+        uint64_t misses = 0; // Number of lookups which did not
+        uint64_t insertions = 0; // Number of pages inserted
+        uint64_t evictions = 0; // Number of pages evicted to stay within the budget
+        uint64_t bytes = 0; // Memory currently held by cached pages
+    } _shard_stats;
+private:
+    static constexpr size_t max_bytes = 4 * 1024 * 1024;
+
+    using lru_list = std::list<std::pair<key_type, index_list>>;
+    lru_list _lru; // Most recently used first
+    std::unordered_map<key_type, lru_list::iterator, utils::tuple_hash> _pages;
+private:
+    static size_t page_size(const index_list& list) {
+        size_t size = 0;
+        for (const index_entry& e : list) {
+            size += sizeof(index_entry) + e.get_key_bytes().size();
+        }
+        return size;
+    }
+
+    static bool is_cacheable(const index_list& list) {
+        return std::all_of(list.begin(), list.end(), [] (const index_entry& e) {
+            return e.get_promoted_index_size() == 0;
+        });
+    }
+
+    static index_list share_page(index_list& list) {
+        index_list copy;
+        copy.reserve(list.size());
+        for (index_entry& e : list) {
+            copy.push_back(e.share());
+        }
+        return copy;
+    }
+
+    void evict_one() noexcept {
+        auto& victim = _lru.back();
+        _shard_stats.bytes -= page_size(victim.second);
+        ++_shard_stats.evictions;
+        _pages.erase(victim.first);
+        _lru.pop_back();
+    }
+public:
+    // Returns a copy of the cached page, or disengaged optional when the page
+    // is not cached. The copy shares key buffers with the cached master copy.
+    std::optional<index_list> lookup(const sstable& sst, uint64_t summary_idx) {
+        auto i = _pages.find(key_type(&sst, summary_idx));
+        if (i == _pages.end()) {
+            ++_shard_stats.misses;
+            return std::nullopt;
+        }
+        _lru.splice(_lru.begin(), _lru, i->second);
+        ++_shard_stats.hits;
+        return share_page(i->second->second);
+    }
+
+    // Offers a freshly parsed page for retention. No-op when any entry in the
+    // page has a promoted index or the page alone exceeds the budget.
+    void populate(const sstable& sst, uint64_t summary_idx, index_list& list) {
+        auto size = page_size(list);
+        if (size > max_bytes || !is_cacheable(list)) {
+            return;
+        }
+        auto key = key_type(&sst, summary_idx);
+        if (_pages.count(key)) {
+            return;
+        }
+        while (_shard_stats.bytes + size > max_bytes) {
+            evict_one();
+        }
+        _lru.emplace_front(key, share_page(list));
+        _pages.emplace(key, _lru.begin());
+        _shard_stats.bytes += size;
+        ++_shard_stats.insertions;
+    }
+
+    // Drops all pages belonging to sst. Must be called before the sstable
+    // object is destroyed, since pages are keyed by its address.
+    void invalidate(const sstable& sst) noexcept {
+        for (auto i = _lru.begin(); i != _lru.end();) {
+            if (i->first.first == &sst) {
+                _shard_stats.bytes -= page_size(i->second);
+                _pages.erase(i->first);
+                i = _lru.erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    static const stats& shard_stats() { return _shard_stats; }
+    static index_page_cache& shard_cache();
+};
+
+}
@@ -24,6 +24,7 @@
 #include "consumer.hh"
 #include "downsampling.hh"
 #include "sstables/shared_index_lists.hh"
+#include "sstables/index_page_cache.hh"
 #include <seastar/util/bool_class.hh>
 #include "utils/buffer_input_stream.hh"
 #include "sstables/prepended_input_stream.hh"
@@ -367,6 +368,9 @@ private:
             return make_ready_future<>();
         }
         auto loader = [this] (uint64_t summary_idx) -> future<index_list> {
+            if (auto cached = index_page_cache::shard_cache().lookup(*_sstable, summary_idx)) {
+                return make_ready_future<index_list>(std::move(*cached));
+            }
             auto& summary = _sstable->get_summary();
             uint64_t position = summary.entries[summary_idx].position;
             uint64_t quantity = downsampling::get_effective_index_interval_after_index(summary_idx, summary.header.sampling_level,
@@ -382,6 +386,7 @@ private:
             return do_with(std::make_unique<reader>(_sstable, _pc, position, end, quantity), [this, summary_idx] (auto& entries_reader) {
                 return entries_reader->_context.consume_input().then([this, summary_idx, &entries_reader] {
                     auto indexes = std::move(entries_reader->_consumer.indexes);
+                    index_page_cache::shard_cache().populate(*_sstable, summary_idx, indexes);
                     return entries_reader->_context.close().then([indexes = std::move(indexes)] () mutable {
                         return std::move(indexes);
                     });
@@ -801,6 +806,14 @@ public:
         return _lower_bound.element;
     }
 
+    // Returns the kind of sstable element the upper bound cursor is pointing
+    // at. partition means the upper bound sits on a partition boundary (or
+    // at the end of the data file), i.e. data_file_positions() covers the
+    // lower bound's partition in full.
+    indexable_element upper_element_kind() const {
+        return _upper_bound ? _upper_bound->element : indexable_element::partition;
+    }
+
     std::optional<open_rt_marker> end_open_marker() const {
         return _lower_bound.end_open_marker;
     }
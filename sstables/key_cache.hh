@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "bytes.hh"
+#include "utils/hash.hh"
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace sstables {
+
+class sstable;
+
+// Shard-wide cache of partition key -> data file position, in the vein of
+// Cassandra's key cache.
+//
+// A point read whose partition is not in the row cache still has to resolve
+// the partition's position on disk through the summary and the index file.
+// Uniform-random point-read workloads defeat the row cache but revisit the
+// same keys often enough that remembering the resolved positions pays for
+// itself; a hit turns the read into a single seek straight into the Data
+// file. Bounded by a byte budget and evicted in LRU order.
+//
+// Only whole-partition position ranges are cached (the range ends at the
+// next partition), so a hit can serve any slice of the partition.
+class key_cache {
+public:
+    // Entries are keyed by the owning sstable and the partition key bytes.
+    // The full key is stored, not just a hash: a false hit would read some
+    // other partition's data.
+    using key_type = std::pair<const sstable*, bytes>;
+
+    struct data_file_range {
+        uint64_t start;
+        uint64_t end;
+    };
+
+    static thread_local struct stats {
+        uint64_t hits = 0; // Number of lookups which found the position cached
+        uint64_t misses = 0; // Number of lookups which did not
+        uint64_t insertions = 0; // Number of positions inserted
+        uint64_t evictions = 0; // Number of positions evicted to stay within the budget
+        uint64_t bytes = 0; // Memory currently held by cached entries
+    } _shard_stats;
+private:
+    static constexpr size_t max_bytes = 4 * 1024 * 1024;
+
+    using lru_list = std::list<std::pair<key_type, data_file_range>>;
+    lru_list _lru; // Most recently used first
+    std::unordered_map<key_type, lru_list::iterator, utils::tuple_hash> _entries;
+private:
+    static size_t entry_size(const key_type& key) {
+        return sizeof(lru_list::value_type) + key.second.size();
+    }
+
+    void evict_one() noexcept {
+        auto& victim = _lru.back();
+        _shard_stats.bytes -= entry_size(victim.first);
+        ++_shard_stats.evictions;
+        _entries.erase(victim.first);
+        _lru.pop_back();
+    }
+public:
+    std::optional<data_file_range> lookup(const sstable& sst, bytes_view key_repr) {
+        auto i = _entries.find(key_type(&sst, bytes(key_repr.begin(), key_repr.end())));
+        if (i == _entries.end()) {
+            ++_shard_stats.misses;
+            return std::nullopt;
+        }
+        _lru.splice(_lru.begin(), _lru, i->second);
+        ++_shard_stats.hits;
+        return i->second->second;
+    }
+
+    void populate(const sstable& sst, bytes_view key_repr, data_file_range range) {
+        auto key = key_type(&sst, bytes(key_repr.begin(), key_repr.end()));
+        if (_entries.count(key)) {
+            return;
+        }
+        auto size = entry_size(key);
+        while (!_lru.empty() && _shard_stats.bytes + size > max_bytes) {
+            evict_one();
+        }
+        _lru.emplace_front(std::move(key), range);
+        _entries.emplace(_lru.front().first, _lru.begin());
+        _shard_stats.bytes += size;
+        ++_shard_stats.insertions;
+    }
+
+    // Drops all entries belonging to sst. Must be called before the sstable
+    // object is destroyed, since entries are keyed by its address.
+    void invalidate(const sstable& sst) noexcept {
+        for (auto i = _lru.begin(); i != _lru.end();) {
+            if (i->first.first == &sst) {
+                _shard_stats.bytes -= entry_size(i->first);
+                _entries.erase(i->first);
+                i = _lru.erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    static const stats& shard_stats() { return _shard_stats; }
+    static key_cache& shard_cache();
+};
+
+}
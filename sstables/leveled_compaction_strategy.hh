@@ -66,6 +66,13 @@ public:
 };
 
 compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(column_family& cfs, std::vector<sstables::shared_sstable> candidates) {
+    // Reclaiming sstables that expired wholesale is cheaper than any real
+    // compaction, so deal with those before consulting the manifest.
+    auto expired = maybe_get_fully_expired_sstables(cfs, candidates, gc_clock::now() - cfs.schema()->gc_grace_seconds());
+    if (!expired.empty()) {
+        return sstables::compaction_descriptor(std::vector<sstables::shared_sstable>(expired.begin(), expired.end()));
+    }
+
     // NOTE: leveled_manifest creation may be slightly expensive, so later on,
     // we may want to store it in the strategy itself. However, the sstable
     // lists managed by the manifest may become outdated. For example, one
@@ -88,18 +95,11 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(c
     // theoretically contain oldest non-overlapping data.
     auto gc_before = gc_clock::now() - cfs.schema()->gc_grace_seconds();
     for (auto level = int(manifest.get_level_count()); level >= 0; level--) {
-        auto& sstables = manifest.get_level(level);
-        // filter out sstables which droppable tombstone ratio isn't greater than the defined threshold.
-        auto e = boost::range::remove_if(sstables, [this, &gc_before] (const sstables::shared_sstable& sst) -> bool {
-            return !worth_dropping_tombstones(sst, gc_before);
-        });
-        sstables.erase(e, sstables.end());
-        if (sstables.empty()) {
+        auto worth = get_sstables_by_garbage_ratio(manifest.get_level(level), gc_before);
+        if (worth.empty()) {
             continue;
         }
-        auto& sst = *std::max_element(sstables.begin(), sstables.end(), [&] (auto& i, auto& j) {
-            return i->estimate_droppable_tombstone_ratio(gc_before) < j->estimate_droppable_tombstone_ratio(gc_before);
-        });
+        auto& sst = worth.front();
         return sstables::compaction_descriptor({ sst }, sst->get_sstable_level());
     }
     return {};
@@ -30,6 +30,9 @@
 #include "db/config.hh"
 #include "atomic_cell.hh"
 
+#include <seastar/core/future-util.hh>
+#include <seastar/core/thread.hh>
+
 #include <functional>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/container/static_vector.hpp>
@@ -1359,16 +1362,22 @@ void writer::consume_end_of_stream() {
         dht::global_partitioner().name(), _schema.bloom_filter_fp_chance(),
         _sst._schema, _sst.get_first_decorated_key(), _sst.get_last_decorated_key(), _enc_stats);
     close_data_writer();
-    _sst.write_summary(_pc);
-    _sst.write_filter(_pc);
-    _sst.write_statistics(_pc);
-    _sst.write_compression(_pc);
     auto features = sstable_enabled_features::all();
     if (!_cfg.correctly_serialize_non_compound_range_tombstones) {
         features.disable(sstable_feature::NonCompoundRangeTombstones);
     }
     run_identifier identifier{_run_identifier};
-    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier));
+    // Summary, Filter, Statistics, CompressionInfo and the scylla metadata
+    // are independent components living in separate files, so get their
+    // writes in flight together, mirroring what load() does on the read side.
+    seastar::when_all_succeed(
+            seastar::async([this] { _sst.write_summary(_pc); }),
+            seastar::async([this] { _sst.write_filter(_pc); }),
+            seastar::async([this] { _sst.write_statistics(_pc); }),
+            seastar::async([this] { _sst.write_compression(_pc); }),
+            seastar::async([this, features = std::move(features), identifier] () mutable {
+                _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier));
+            })).get();
     _cfg.monitor->on_write_completed();
     if (!_cfg.leave_unsealed) {
         _sst.seal_sstable(_cfg.backup).get();
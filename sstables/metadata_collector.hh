@@ -71,7 +71,7 @@ struct column_stats {
     min_max_tracker<int32_t> local_deletion_time_tracker;
     min_max_tracker<int32_t> ttl_tracker;
     /** histogram of tombstone drop time */
-    utils::streaming_histogram tombstone_histogram;
+    utils::streaming_histogram_builder tombstone_histogram;
 
     bool has_legacy_counter_shards;
     bool capped_local_deletion_time = false;
@@ -156,7 +156,7 @@ private:
     min_max_tracker<int32_t> _ttl_tracker{0, 0};
     double _compression_ratio = NO_COMPRESSION_RATIO;
     std::set<int> _ancestors;
-    utils::streaming_histogram _estimated_tombstone_drop_time{TOMBSTONE_HISTOGRAM_BIN_SIZE};
+    utils::streaming_histogram_builder _estimated_tombstone_drop_time{TOMBSTONE_HISTOGRAM_BIN_SIZE};
     int _sstable_level = 0;
     std::vector<bytes_opt> _min_column_names;
     std::vector<bytes_opt> _max_column_names;
@@ -199,7 +199,7 @@ public:
         _estimated_cells_count.add(cells_count);
     }
 
-    void merge_tombstone_histogram(utils::streaming_histogram& histogram) {
+    void merge_tombstone_histogram(utils::streaming_histogram_builder& histogram) {
         _estimated_tombstone_drop_time.merge(histogram);
     }
 
@@ -274,7 +274,7 @@ public:
         m.min_ttl = _ttl_tracker.min();
         m.max_ttl = _ttl_tracker.max();
         m.compression_ratio = _compression_ratio;
-        m.estimated_tombstone_drop_time = std::move(_estimated_tombstone_drop_time);
+        m.estimated_tombstone_drop_time = _estimated_tombstone_drop_time.build();
         m.sstable_level = _sstable_level;
         m.repaired_at = _repaired_at;
         convert(m.min_column_names, std::move(_min_column_names));
@@ -42,6 +42,13 @@ class mutation_fragment_filter {
     position_in_partition _fwd_end;
     size_t _last_lower_bound_counter = 0;
 
+    // End position and tombstone of the widest-reaching range tombstone
+    // emitted so far. Later range tombstones which end within its interval
+    // and don't supersede its tombstone are provably shadowed by it and can
+    // be dropped instead of emitted (see apply(const range_tombstone&)).
+    std::optional<position_in_partition> _active_rt_end;
+    tombstone _active_rt_tomb;
+
     bool is_after_fwd_window(position_in_partition_view pos) const {
         return _fwd && !position_in_partition::less_compare(_schema)(pos, _fwd_end);
     }
@@ -104,9 +111,22 @@ public:
             // This happens only when fwd is set
             _out_of_range = true;
             return result::store_and_finish;
-        } else {
-            return result::emit;
         }
+        // Fragments are ordered by position, so rt starts at or after the
+        // active tombstone's start. If rt also ends within the active
+        // tombstone's interval and doesn't supersede its tombstone, the
+        // downstream range tombstone merge would drop rt without a trace,
+        // so don't emit it in the first place. Tombstone-dense (queue-like)
+        // partitions produce long runs of such shadowed tombstones.
+        position_in_partition::less_compare less(_schema);
+        if (_active_rt_end && !less(*_active_rt_end, rt.end_position()) && rt.tomb <= _active_rt_tomb) {
+            return result::ignore;
+        }
+        if (!_active_rt_end || less(*_active_rt_end, rt.end_position())) {
+            _active_rt_end = position_in_partition(rt.end_position());
+            _active_rt_tomb = rt.tomb;
+        }
+        return result::emit;
     }
 
     bool out_of_range() const {
@@ -129,6 +149,10 @@ public:
      */
     std::optional<position_in_partition_view> fast_forward_to(position_range r) {
         assert(_fwd);
+        // The active range tombstone was emitted in an earlier forwarding
+        // window, so it cannot be relied upon to shadow tombstones of the
+        // new window.
+        _active_rt_end.reset();
         _walker.trim_front(r.start());
         _fwd_end = std::move(r).end();
         _out_of_range = !_walker.advance_to(r.start(), _fwd_end);
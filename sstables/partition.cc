@@ -30,6 +30,7 @@
 #include <seastar/core/byteorder.hh>
 #include <seastar/util/gcc6-concepts.hh>
 #include "index_reader.hh"
+#include "key_cache.hh"
 #include "counters.hh"
 #include "utils/data_input.hh"
 #include "clustering_ranges_walker.hh"
@@ -203,6 +204,23 @@ public:
         , _consumer(this, _schema, slice, pc, std::move(resource_tracker), fwd, _sst)
         , _single_partition_read(true)
         , _initialize([this, key = std::move(key), &pc, &slice, fwd_mr] () mutable {
+            // The key cache remembers where recently read partitions live in
+            // the data file; a hit skips the summary/index lookup entirely.
+            // Anything the index would additionally provide (partition
+            // tombstone, promoted index for slicing) is recovered lazily
+            // through the usual !_index_in_current_partition paths.
+            if (key.key()) {
+                if (auto cached = key_cache::shard_cache().lookup(*_sst, key.key()->representation())) {
+                    _sst->get_filter_tracker().add_true_positive();
+                    _read_enabled = (cached->start != cached->end);
+                    _context = data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer,
+                            { cached->start, cached->end });
+                    _monitor.on_read_started(_context->reader_position());
+                    _will_likely_slice = will_likely_slice(slice);
+                    _index_in_current_partition = false;
+                    return make_ready_future<>();
+                }
+            }
             position_in_partition_view pos = get_slice_upper_bound(*_schema, slice, key);
             auto f = get_index_reader().advance_lower_and_check_if_present(key, pos);
             return f.then([this, &slice, &pc, key] (bool present) mutable {
@@ -215,6 +233,12 @@ public:
 
                 auto [start, end] = _index_reader->data_file_positions();
                 assert(end);
+                // Only a range which covers the partition in full may be
+                // cached - the upper bound may have stopped mid-partition on
+                // a promoted index block when the slice has an upper bound.
+                if (key.key() && _index_reader->upper_element_kind() == indexable_element::partition) {
+                    key_cache::shard_cache().populate(*_sst, key.key()->representation(), { start, *end });
+                }
                 _read_enabled = (start != *end);
                 _context = data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer,
                         { start, *end });
@@ -388,6 +412,15 @@ private:
                 if (!_context->need_skip(index_position.start)) {
                     return make_ready_future<>();
                 }
+                // When a slice has many clustering ranges the target blocks are
+                // often close to each other in the data file. Seeking drops the
+                // parser state and the read-ahead buffer, so for gaps smaller
+                // than one buffer it's cheaper to keep parsing sequentially and
+                // let the consumer's clustering range filter drop the rows in
+                // between, effectively merging the reads of adjacent blocks.
+                if (index_position.start - _context->reader_position().position < default_sstable_buffer_size()) {
+                    return make_ready_future<>();
+                }
                 return _context->skip_to(idx.element_kind(), index_position.start).then([this, &idx] {
                     _sst->get_stats().on_partition_seek();
                     set_range_tombstone_start_from_end_open_marker(_consumer, *_schema, idx);
@@ -70,18 +70,23 @@ class file_random_access_reader : public random_access_reader {
     uint64_t _file_size;
     size_t _buffer_size;
     unsigned _read_ahead;
+    // Must outlive the reader. The priority classes handed out by
+    // service/priority_manager.hh are per-shard singletons, so that holds.
+    const io_priority_class& _pc;
 public:
     virtual input_stream<char> open_at(uint64_t pos) override {
         auto len = _file_size - pos;
         file_input_stream_options options;
         options.buffer_size = _buffer_size;
         options.read_ahead = _read_ahead;
+        options.io_priority_class = _pc;
 
         return make_file_input_stream(_file, pos, len, std::move(options));
     }
 
-    explicit file_random_access_reader(file f, uint64_t file_size, size_t buffer_size = 8192, unsigned read_ahead = 4)
-        : _file(std::move(f)), _file_size(file_size), _buffer_size(buffer_size), _read_ahead(read_ahead) {
+    explicit file_random_access_reader(file f, uint64_t file_size, size_t buffer_size = 8192, unsigned read_ahead = 4,
+            const io_priority_class& pc = default_priority_class())
+        : _file(std::move(f)), _file_size(file_size), _buffer_size(buffer_size), _read_ahead(read_ahead), _pc(pc) {
         seek(0);
     }
 
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/core/file.hh>
+#include <seastar/core/shared_future.hh>
+
+#include <functional>
+#include <list>
+#include <optional>
+#include <stdexcept>
+
+#include "seastarx.hh"
+
+namespace sstables {
+
+// Wraps an sstable component file so that its descriptor can be dropped while
+// the sstable is cold and transparently reopened on the next access.
+//
+// Every wrapper holding an open descriptor sits in a per-shard LRU list; an
+// access moves it to the front, and opening a descriptor past the per-shard
+// budget drops the descriptors of the least recently used wrappers. Dropping
+// only releases this wrapper's reference to the file: input streams and
+// in-flight operations hold their own references, so the descriptor really
+// closes once the last of them goes away, and a reader that kept a copy of
+// the wrapper simply triggers a reopen on its next read.
+class reopenable_file_impl : public file_impl {
+public:
+    using opener_fn = std::function<future<file> ()>;
+private:
+    // Wrappers currently holding an open descriptor on this shard, most
+    // recently used first.
+    struct resident_files_type {
+        std::list<reopenable_file_impl*> lru;
+        uint64_t count = 0;
+    };
+    static thread_local resident_files_type _resident_files;
+
+    opener_fn _opener;
+    uint64_t _fd_budget;
+    file _file; // engaged while the descriptor is open
+    std::optional<std::list<reopenable_file_impl*>::iterator> _lru_link;
+    std::optional<shared_future<>> _reopen;
+    bool _closed = false;
+public:
+    reopenable_file_impl(uint64_t fd_budget, opener_fn opener, file f)
+            : _opener(std::move(opener)), _fd_budget(fd_budget), _file(std::move(f)) {
+        _memory_dma_alignment = _file.memory_dma_alignment();
+        _disk_read_dma_alignment = _file.disk_read_dma_alignment();
+        _disk_write_dma_alignment = _file.disk_write_dma_alignment();
+        make_resident();
+    }
+
+    ~reopenable_file_impl() {
+        unlink_resident();
+    }
+
+    // Resolves once the wrapped file holds an open descriptor, reopening it
+    // if it was dropped. Concurrent callers share a single reopen.
+    future<> ensure_open() {
+        if (_file) {
+            touch();
+            return make_ready_future<>();
+        }
+        if (_closed) {
+            return make_exception_future<>(std::runtime_error("reopenable file: access after close"));
+        }
+        if (!_reopen) {
+            _reopen.emplace(_opener().then([this] (file f) -> future<> {
+                if (_closed) {
+                    // close() ran while the reopen was in flight; do not
+                    // resurrect the descriptor.
+                    return f.close().finally([f] {});
+                }
+                _file = std::move(f);
+                make_resident();
+                return make_ready_future<>();
+            }).finally([this] {
+                _reopen = std::nullopt;
+            }));
+        }
+        return _reopen->get_future();
+    }
+
+    // Hands the wrapped file back to the caller and permanently detaches this
+    // wrapper from it; used when the file is about to outlive the sstable the
+    // reopen callback is bound to.
+    file detach() {
+        if (!_file) {
+            throw std::runtime_error("reopenable file: detach of a dropped descriptor");
+        }
+        unlink_resident();
+        _closed = true;
+        return std::move(_file);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, const io_priority_class& pc) override {
+        return with_file([pos, buffer, len, pc] (file& f) {
+            return get_file_impl(f)->write_dma(pos, buffer, len, pc);
+        });
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return with_file([pos, iov = std::move(iov), pc] (file& f) mutable {
+            return get_file_impl(f)->write_dma(pos, std::move(iov), pc);
+        });
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, const io_priority_class& pc) override {
+        return with_file([pos, buffer, len, pc] (file& f) {
+            return get_file_impl(f)->read_dma(pos, buffer, len, pc);
+        });
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return with_file([pos, iov = std::move(iov), pc] (file& f) mutable {
+            return get_file_impl(f)->read_dma(pos, std::move(iov), pc);
+        });
+    }
+
+    virtual future<> flush(void) override {
+        return with_file([] (file& f) {
+            return get_file_impl(f)->flush();
+        });
+    }
+
+    virtual future<struct stat> stat(void) override {
+        return with_file([] (file& f) {
+            return get_file_impl(f)->stat();
+        });
+    }
+
+    virtual future<> truncate(uint64_t length) override {
+        return with_file([length] (file& f) {
+            return get_file_impl(f)->truncate(length);
+        });
+    }
+
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        return with_file([offset, length] (file& f) {
+            return get_file_impl(f)->discard(offset, length);
+        });
+    }
+
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return with_file([position, length] (file& f) {
+            return get_file_impl(f)->allocate(position, length);
+        });
+    }
+
+    virtual future<uint64_t> size(void) override {
+        return with_file([] (file& f) {
+            return get_file_impl(f)->size();
+        });
+    }
+
+    virtual future<> close() override {
+        _closed = true;
+        if (!_file) {
+            return make_ready_future<>();
+        }
+        unlink_resident();
+        auto f = std::move(_file);
+        return f.close().finally([f] {});
+    }
+
+    // The dup()'d handle has its own reference on the descriptor, so a later
+    // drop on this shard does not affect it. dup() cannot reopen the file by
+    // itself; callers reach it through sstable::get_open_info(), which
+    // reopens the file first if needed.
+    virtual std::unique_ptr<seastar::file_handle_impl> dup() override {
+        if (!_file) {
+            throw std::runtime_error("reopenable file: dup() of a dropped descriptor");
+        }
+        touch();
+        return get_file_impl(_file)->dup();
+    }
+
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        if (!_file) {
+            throw std::runtime_error("reopenable file: list_directory() of a dropped descriptor");
+        }
+        touch();
+        return get_file_impl(_file)->list_directory(next);
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override {
+        return with_file([offset, range_size, pc] (file& f) {
+            return get_file_impl(f)->dma_read_bulk(offset, range_size, pc);
+        });
+    }
+private:
+    // Runs func against the open file, reopening it first if needed. A copy
+    // of the file is held until the returned future resolves, so a drop
+    // racing with the operation cannot close the descriptor under it.
+    template <typename Func>
+    auto with_file(Func func) -> decltype(func(std::declval<file&>())) {
+        if (_file) {
+            touch();
+            return func(_file).finally([f = _file] {});
+        }
+        return ensure_open().then([this, func = std::move(func)] () mutable {
+            // Re-dispatch rather than use the file directly; under extreme
+            // descriptor pressure it may have been dropped again before this
+            // continuation ran.
+            return this->with_file(std::move(func));
+        });
+    }
+
+    void touch() {
+        _resident_files.lru.splice(_resident_files.lru.begin(), _resident_files.lru, *_lru_link);
+    }
+
+    void make_resident() {
+        _resident_files.lru.push_front(this);
+        _lru_link = _resident_files.lru.begin();
+        ++_resident_files.count;
+        // Drop the coldest descriptors to stay within the budget. The file
+        // just opened is never the victim.
+        while (_fd_budget && _resident_files.count > _fd_budget && _resident_files.lru.back() != this) {
+            _resident_files.lru.back()->drop_fd();
+        }
+    }
+
+    void drop_fd() {
+        unlink_resident();
+        _file = file();
+    }
+
+    void unlink_resident() {
+        if (_lru_link) {
+            _resident_files.lru.erase(*_lru_link);
+            _lru_link = std::nullopt;
+            --_resident_files.count;
+        }
+    }
+};
+
+inline file make_reopenable_file(uint64_t fd_budget, reopenable_file_impl::opener_fn opener, file f) {
+    return file(::make_shared<reopenable_file_impl>(fd_budget, std::move(opener), std::move(f)));
+}
+
+inline reopenable_file_impl* try_get_reopenable_file(file& f) {
+    return dynamic_cast<reopenable_file_impl*>(get_file_impl(f).get());
+}
+
+}
@@ -27,6 +27,7 @@
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
+#include <unordered_map>
 
 namespace sstables {
 
@@ -116,34 +117,48 @@ class size_tiered_compaction_strategy : public compaction_strategy_impl {
     size_tiered_compaction_strategy_options _options;
     compaction_backlog_tracker _backlog_tracker;
 
-    // Return a list of pair of shared_sstable and its respective size.
-    std::vector<std::pair<sstables::shared_sstable, uint64_t>> create_sstable_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables) const;
+    // Segments sealed by one incremental compaction, grouped by their shared
+    // run identifier; an sstable written as a single file is a run of one.
+    using sstable_run = std::vector<sstables::shared_sstable>;
 
-    // Group files of similar size into buckets.
-    std::vector<std::vector<sstables::shared_sstable>> get_buckets(const std::vector<sstables::shared_sstable>& sstables) const;
+    // Group sstables into runs, each paired with its aggregate size.
+    static std::vector<std::pair<sstable_run, uint64_t>> create_run_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables);
 
-    // Maybe return a bucket of sstables to compact
+    // Group runs of similar total size into buckets.
+    std::vector<std::vector<sstable_run>> get_buckets(const std::vector<sstables::shared_sstable>& sstables) const;
+
+    // Maybe return a bucket of runs to compact
     std::vector<sstables::shared_sstable>
-    most_interesting_bucket(std::vector<std::vector<sstables::shared_sstable>> buckets, unsigned min_threshold, unsigned max_threshold);
+    most_interesting_bucket(std::vector<std::vector<sstable_run>> buckets, unsigned min_threshold, unsigned max_threshold);
+
+    static std::vector<sstables::shared_sstable> to_sstables(std::vector<sstable_run> bucket) {
+        std::vector<sstables::shared_sstable> sstables;
+        for (auto& run : bucket) {
+            std::move(run.begin(), run.end(), std::back_inserter(sstables));
+        }
+        return sstables;
+    }
 
-    // Return the average size of a given list of sstables.
-    uint64_t avg_size(std::vector<sstables::shared_sstable>& sstables) {
-        assert(sstables.size() > 0); // this should never fail
+    // Return the average run size of a given bucket of runs.
+    uint64_t avg_size(std::vector<sstable_run>& bucket) {
+        assert(bucket.size() > 0); // this should never fail
         uint64_t n = 0;
 
-        for (auto& sstable : sstables) {
-            // FIXME: Switch to sstable->bytes_on_disk() afterwards. That's what C* uses.
-            n += sstable->data_size();
+        for (auto& run : bucket) {
+            for (auto& sstable : run) {
+                // FIXME: Switch to sstable->bytes_on_disk() afterwards. That's what C* uses.
+                n += sstable->data_size();
+            }
         }
 
-        return n / sstables.size();
+        return n / bucket.size();
     }
 
-    bool is_bucket_interesting(const std::vector<sstables::shared_sstable>& bucket, int min_threshold) const {
+    bool is_bucket_interesting(const std::vector<sstable_run>& bucket, int min_threshold) const {
         return bucket.size() >= size_t(min_threshold);
     }
 
-    bool is_any_bucket_interesting(const std::vector<std::vector<sstables::shared_sstable>>& buckets, int min_threshold) const {
+    bool is_any_bucket_interesting(const std::vector<std::vector<sstable_run>>& buckets, int min_threshold) const {
         return boost::algorithm::any_of(buckets, [&] (const auto& bucket) {
             return this->is_bucket_interesting(bucket, min_threshold);
         });
@@ -172,41 +187,53 @@ public:
     }
 };
 
-inline std::vector<std::pair<sstables::shared_sstable, uint64_t>>
-size_tiered_compaction_strategy::create_sstable_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables) const {
-
-    std::vector<std::pair<sstables::shared_sstable, uint64_t>> sstable_length_pairs;
-    sstable_length_pairs.reserve(sstables.size());
+inline auto
+size_tiered_compaction_strategy::create_run_and_length_pairs(const std::vector<sstables::shared_sstable>& sstables)
+        -> std::vector<std::pair<sstable_run, uint64_t>> {
+    // Segments sealed by an incremental compaction share a run identifier and
+    // cover disjoint token ranges, so for tiering purposes they behave like
+    // one big sstable and are sized as a whole. Sstables written as a single
+    // file get a unique random run identifier, so they form runs of one and
+    // this grouping is a no-op for them.
+    std::unordered_map<utils::UUID, size_t> run_indexes;
+    std::vector<std::pair<sstable_run, uint64_t>> runs;
+    runs.reserve(sstables.size());
 
     for(auto& sstable : sstables) {
         auto sstable_size = sstable->data_size();
         assert(sstable_size != 0);
 
-        sstable_length_pairs.emplace_back(sstable, sstable_size);
+        auto i = run_indexes.emplace(sstable->run_identifier(), runs.size());
+        if (i.second) {
+            runs.emplace_back(sstable_run(), uint64_t(0));
+        }
+        auto& run = runs[i.first->second];
+        run.first.push_back(sstable);
+        run.second += sstable_size;
     }
 
-    return sstable_length_pairs;
+    return runs;
 }
 
-inline std::vector<std::vector<sstables::shared_sstable>>
+inline std::vector<std::vector<size_tiered_compaction_strategy::sstable_run>>
 size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_sstable>& sstables) const {
-    // sstables sorted by size of its data file.
-    auto sorted_sstables = create_sstable_and_length_pairs(sstables);
+    // runs sorted by total size of their data files.
+    auto sorted_runs = create_run_and_length_pairs(sstables);
 
-    std::sort(sorted_sstables.begin(), sorted_sstables.end(), [] (auto& i, auto& j) {
+    std::sort(sorted_runs.begin(), sorted_runs.end(), [] (auto& i, auto& j) {
         return i.second < j.second;
     });
 
-    std::map<size_t, std::vector<sstables::shared_sstable>> buckets;
+    std::map<size_t, std::vector<sstable_run>> buckets;
 
     bool found;
-    for (auto& pair : sorted_sstables) {
+    for (auto& pair : sorted_runs) {
         found = false;
         size_t size = pair.second;
 
-        // look for a bucket containing similar-sized files:
+        // look for a bucket containing similar-sized runs:
         // group in the same bucket if it's w/in 50% of the average for this bucket,
-        // or this file and the bucket are all considered "small" (less than `minSSTableSize`)
+        // or this run and the bucket are all considered "small" (less than `minSSTableSize`)
         for (auto it = buckets.begin(); it != buckets.end(); it++) {
             size_t old_average_size = it->first;
 
@@ -216,7 +243,7 @@ size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_
                 size_t total_size = bucket.size() * old_average_size;
                 size_t new_average_size = (total_size + size) / (bucket.size() + 1);
 
-                bucket.push_back(pair.first);
+                bucket.push_back(std::move(pair.first));
                 buckets.erase(it);
                 buckets.insert({ new_average_size, std::move(bucket) });
 
@@ -227,13 +254,13 @@ size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_
 
         // no similar bucket found; put it in a new one
         if (!found) {
-            std::vector<sstables::shared_sstable> new_bucket;
-            new_bucket.push_back(pair.first);
+            std::vector<sstable_run> new_bucket;
+            new_bucket.push_back(std::move(pair.first));
             buckets.insert({ size, std::move(new_bucket) });
         }
     }
 
-    std::vector<std::vector<sstables::shared_sstable>> bucket_list;
+    std::vector<std::vector<sstable_run>> bucket_list;
     bucket_list.reserve(buckets.size());
 
     for (auto& entry : buckets) {
@@ -244,10 +271,10 @@ size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_
 }
 
 inline std::vector<sstables::shared_sstable>
-size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector<sstables::shared_sstable>> buckets,
+size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector<sstable_run>> buckets,
         unsigned min_threshold, unsigned max_threshold)
 {
-    std::vector<std::pair<std::vector<sstables::shared_sstable>, uint64_t>> pruned_buckets_and_hotness;
+    std::vector<std::pair<std::vector<sstable_run>, uint64_t>> pruned_buckets_and_hotness;
     pruned_buckets_and_hotness.reserve(buckets.size());
 
     // FIXME: add support to get hotness for each bucket.
@@ -275,7 +302,7 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
     });
     auto hottest = std::move(min.first);
 
-    return hottest;
+    return to_sstables(std::move(hottest));
 }
 
 inline compaction_descriptor
@@ -285,6 +312,14 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(column_family& cfs,
     int max_threshold = cfs.schema()->max_compaction_threshold();
     auto gc_before = gc_clock::now() - cfs.schema()->gc_grace_seconds();
 
+    // Fully expired sstables, common on TTL-only tables, are dropped without
+    // being read, so claim them as soon as they become droppable instead of
+    // waiting for their size tier to fill up.
+    auto expired = maybe_get_fully_expired_sstables(cfs, candidates, gc_before);
+    if (!expired.empty()) {
+        return sstables::compaction_descriptor(std::vector<sstables::shared_sstable>(expired.begin(), expired.end()));
+    }
+
     // TODO: Add support to filter cold sstables (for reference: SizeTieredCompactionStrategy::filterColdSSTables).
 
     auto buckets = get_buckets(candidates);
@@ -302,22 +337,17 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(column_family& cfs,
 
     // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
     // ratio is greater than threshold.
-    // prefer oldest sstables from biggest size tiers because they will be easier to satisfy conditions for
-    // tombstone purge, i.e. less likely to shadow even older data.
-    for (auto&& sstables : buckets | boost::adaptors::reversed) {
-        // filter out sstables which droppable tombstone ratio isn't greater than the defined threshold.
-        auto e = boost::range::remove_if(sstables, [this, &gc_before] (const sstables::shared_sstable& sst) -> bool {
-            return !worth_dropping_tombstones(sst, gc_before);
-        });
-        sstables.erase(e, sstables.end());
-        if (sstables.empty()) {
+    // prefer biggest size tiers because they will be easier to satisfy conditions for
+    // tombstone purge, i.e. less likely to shadow even older data; within the
+    // tier, pick the sstable whose compaction reclaims the most garbage.
+    for (auto&& bucket : buckets | boost::adaptors::reversed) {
+        // A single-sstable tombstone purge is fine even for a segment of a
+        // run; the rewritten segment just gets a run of its own.
+        auto worth = get_sstables_by_garbage_ratio(to_sstables(std::move(bucket)), gc_before);
+        if (worth.empty()) {
             continue;
         }
-        // find oldest sstable from current tier
-        auto it = std::min_element(sstables.begin(), sstables.end(), [] (auto& i, auto& j) {
-            return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
-        });
-        return sstables::compaction_descriptor({ *it });
+        return sstables::compaction_descriptor({ worth.front() });
     }
     return sstables::compaction_descriptor();
 }
@@ -44,6 +44,17 @@ public:
 };
 
 class sstable_set {
+public:
+    // Shard-wide counters over all sstable sets, exposed as metrics so read
+    // amplification can be watched live: sstables_selected / selections is
+    // the average number of sstables a read has to consider.
+    struct selection_stats {
+        uint64_t selections = 0; // Number of (re-)selections done against any set
+        uint64_t sstables_selected = 0; // Total number of sstables those selections returned
+    };
+    static const selection_stats& shard_selection_stats() { return _selection_stats; }
+private:
+    static thread_local selection_stats _selection_stats;
     std::unique_ptr<sstable_set_impl> _impl;
     schema_ptr _schema;
     // used to support column_family::get_sstable(), which wants to return an sstable_list
@@ -45,6 +45,8 @@
 #include "compress.hh"
 #include "unimplemented.hh"
 #include "index_reader.hh"
+#include "key_cache.hh"
+#include "sstable_set.hh"
 #include "remove.hh"
 #include "memtable.hh"
 #include "range.hh"
@@ -66,6 +68,7 @@
 
 #include "checked-file-impl.hh"
 #include "integrity_checked_file_impl.hh"
+#include "reopenable_file_impl.hh"
 #include "service/storage_service.hh"
 #include "db/extensions.hh"
 #include "unimplemented.hh"
@@ -1023,6 +1026,191 @@ void sstable::write_digest(uint32_t full_checksum) {
     w.close();
 }
 
+future<uint32_t> sstable::read_digest(const io_priority_class& pc) {
+    sstlog.debug("Reading Digest file {} ", filename(component_type::Digest));
+    return open_file(component_type::Digest, open_flags::ro).then([&pc] (file f) {
+        file_input_stream_options options;
+        options.buffer_size = 4096;
+        options.io_priority_class = pc;
+        auto stream = make_file_input_stream(std::move(f), options);
+        return do_with(std::move(stream), sstring(), [] (input_stream<char>& stream, sstring& digest_str) {
+            return repeat([&stream, &digest_str] {
+                return stream.read().then([&digest_str] (temporary_buffer<char> buf) {
+                    if (buf.empty()) {
+                        return stop_iteration::yes;
+                    }
+                    digest_str.append(buf.get(), buf.size());
+                    return stop_iteration::no;
+                });
+            }).then([&digest_str] {
+                return boost::lexical_cast<uint32_t>(digest_str);
+            }).finally([&stream] {
+                return stream.close();
+            });
+        });
+    });
+}
+
+future<checksum> sstable::read_checksum(const io_priority_class& pc) {
+    auto file_path = filename(component_type::CRC);
+    sstlog.debug("Reading CRC file {} ", file_path);
+    return open_file(component_type::CRC, open_flags::ro).then([&pc, file_path = std::move(file_path)] (file f) {
+        auto fut = f.size();
+        return fut.then([&pc, f = std::move(f), file_path = std::move(file_path)] (uint64_t size) mutable {
+            if (size < sizeof(uint32_t) || size % sizeof(uint32_t)) {
+                throw malformed_sstable_exception(format("CRC file has invalid size {}", size), file_path);
+            }
+            file_input_stream_options options;
+            options.buffer_size = 4096;
+            options.io_priority_class = pc;
+            auto stream = make_file_input_stream(std::move(f), options);
+            auto count = size / sizeof(uint32_t) - 1;
+            return do_with(std::move(stream), checksum(), [count] (input_stream<char>& stream, checksum& c) {
+                c.checksums.reserve(count);
+                return stream.read_exactly(sizeof(uint32_t)).then([&stream, &c, count] (temporary_buffer<char> buf) {
+                    c.chunk_size = read_be<uint32_t>(buf.get());
+                    return do_until([&c, count] { return c.checksums.size() == count; }, [&stream, &c] {
+                        return stream.read_exactly(sizeof(uint32_t)).then([&c] (temporary_buffer<char> buf) {
+                            c.checksums.push_back(read_be<uint32_t>(buf.get()));
+                        });
+                    });
+                }).then([&c] {
+                    return std::move(c);
+                }).finally([&stream] {
+                    return stream.close();
+                });
+            });
+        });
+    });
+}
+
+template <typename ChecksumType>
+bool sstable::validate_uncompressed_checksums(const io_priority_class& pc, uint32_t expected_digest) {
+    auto c = read_checksum(pc).get0();
+
+    file_input_stream_options options;
+    options.buffer_size = sstable_buffer_size;
+    options.io_priority_class = pc;
+    auto stream = make_file_input_stream(_data_file, options);
+
+    bool valid = true;
+    std::exception_ptr ex;
+    try {
+        uint32_t full_checksum = ChecksumType::init_checksum();
+        uint64_t offset = 0;
+        size_t chunk_idx = 0;
+        while (true) {
+            auto buf = stream.read_exactly(c.chunk_size).get0();
+            if (buf.empty()) {
+                break;
+            }
+            uint32_t per_chunk_checksum = ChecksumType::checksum(buf.get(), buf.size());
+            if (chunk_idx < c.checksums.size() && per_chunk_checksum != c.checksums[chunk_idx]) {
+                sstlog.error("{}: chunk checksum mismatch at offset {}: expected {}, got {}",
+                        filename(component_type::Data), offset, c.checksums[chunk_idx], per_chunk_checksum);
+                valid = false;
+            }
+            full_checksum = checksum_combine_or_feed<ChecksumType>(full_checksum, per_chunk_checksum, buf.get(), buf.size());
+            offset += buf.size();
+            chunk_idx++;
+        }
+        if (chunk_idx != c.checksums.size()) {
+            sstlog.error("{}: size mismatch: {} chunks on disk, CRC has checksums for {}",
+                    filename(component_type::Data), chunk_idx, c.checksums.size());
+            valid = false;
+        }
+        if (full_checksum != expected_digest) {
+            sstlog.error("{}: full checksum mismatch: Digest has {}, got {}",
+                    filename(component_type::Data), expected_digest, full_checksum);
+            valid = false;
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    stream.close().get();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    return valid;
+}
+
+template <typename ChecksumType>
+bool sstable::validate_compressed_checksums(const io_priority_class& pc, uint32_t expected_digest, bool digest_covers_chunk_checksums) {
+    auto& c = _components->compression;
+    auto offsets = c.offsets.get_accessor();
+
+    file_input_stream_options options;
+    options.buffer_size = sstable_buffer_size;
+    options.io_priority_class = pc;
+    auto stream = make_file_input_stream(_data_file, options);
+
+    bool valid = true;
+    std::exception_ptr ex;
+    try {
+        uint32_t full_checksum = ChecksumType::init_checksum();
+        for (size_t i = 0; i < c.offsets.size(); ++i) {
+            auto offset = offsets.at(i);
+            auto next_offset = (i + 1 == c.offsets.size()) ? c.compressed_file_length() : offsets.at(i + 1);
+            if (next_offset < offset + sizeof(uint32_t)) {
+                throw malformed_sstable_exception(format("compressed chunk {} has invalid length", i), filename(component_type::Data));
+            }
+            // The last 4 bytes of each chunk are the adler32/crc32 checksum of
+            // the compressed data preceding them.
+            auto compressed_len = next_offset - offset - sizeof(uint32_t);
+            auto buf = stream.read_exactly(compressed_len + sizeof(uint32_t)).get0();
+            if (buf.size() < compressed_len + sizeof(uint32_t)) {
+                sstlog.error("{}: data file truncated at offset {}", filename(component_type::Data), offset + buf.size());
+                valid = false;
+                break;
+            }
+            uint32_t per_chunk_checksum = ChecksumType::checksum(buf.get(), compressed_len);
+            uint32_t stored_checksum = read_be<uint32_t>(buf.get() + compressed_len);
+            if (stored_checksum != per_chunk_checksum) {
+                sstlog.error("{}: chunk checksum mismatch at offset {}: expected {}, got {}",
+                        filename(component_type::Data), offset, stored_checksum, per_chunk_checksum);
+                valid = false;
+            }
+            full_checksum = checksum_combine_or_feed<ChecksumType>(full_checksum, per_chunk_checksum, buf.get(), compressed_len);
+            if (digest_covers_chunk_checksums) {
+                // 'mc' digests the per-chunk checksums too; they are already
+                // in big-endian in the buffer, like on the write side.
+                full_checksum = ChecksumType::checksum(full_checksum, buf.get() + compressed_len, sizeof(uint32_t));
+            }
+        }
+        if (full_checksum != expected_digest) {
+            sstlog.error("{}: full checksum mismatch: Digest has {}, got {}",
+                    filename(component_type::Data), expected_digest, full_checksum);
+            valid = false;
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    stream.close().get();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    return valid;
+}
+
+future<bool> sstable::validate_checksums(const io_priority_class& pc) {
+    return seastar::async([this, &pc] {
+        auto expected_digest = read_digest(pc).get0();
+        if (has_component(component_type::CRC)) {
+            if (get_version() == sstable_version_types::mc) {
+                return validate_uncompressed_checksums<crc32_utils>(pc, expected_digest);
+            } else {
+                return validate_uncompressed_checksums<adler32_utils>(pc, expected_digest);
+            }
+        } else {
+            if (get_version() == sstable_version_types::mc) {
+                return validate_compressed_checksums<crc32_utils>(pc, expected_digest, true);
+            } else {
+                return validate_compressed_checksums<adler32_utils>(pc, expected_digest, false);
+            }
+        }
+    });
+}
+
 thread_local std::array<std::vector<int>, downsampling::BASE_SAMPLING_LEVEL> downsampling::_sample_pattern_cache;
 thread_local std::array<std::vector<int>, downsampling::BASE_SAMPLING_LEVEL> downsampling::_original_index_cache;
 
@@ -1032,11 +1220,11 @@ future<> sstable::read_simple(T& component, const io_priority_class& pc) {
 
     auto file_path = filename(Type);
     sstlog.debug(("Reading " + sstable_version_constants::get_component_map(_version).at(Type) + " file {} ").c_str(), file_path);
-    return open_file_dma(file_path, open_flags::ro).then([this, &component] (file fi) {
+    return open_file_dma(file_path, open_flags::ro).then([this, &component, &pc] (file fi) {
         auto fut = fi.size();
-        return fut.then([this, &component, fi = std::move(fi)] (uint64_t size) {
+        return fut.then([this, &component, &pc, fi = std::move(fi)] (uint64_t size) {
             auto f = make_checked_file(_read_error_handler, fi);
-            auto r = make_lw_shared<file_random_access_reader>(std::move(f), size, sstable_buffer_size);
+            auto r = make_lw_shared<file_random_access_reader>(std::move(f), size, sstable_buffer_size, 4, pc);
             auto fut = parse(_version, *r, component);
             return fut.finally([r] {
                 return r->close();
@@ -1211,6 +1399,36 @@ void sstable::rewrite_statistics(const io_priority_class& pc) {
     sstable_write_io_check(rename_file, file_path, filename(component_type::Statistics)).get();
 }
 
+future<> sstable::persist_generated_summary(const io_priority_class& pc) {
+    if (!has_component(component_type::Summary)) {
+        // The TOC doesn't list a Summary, so this sstable was produced by a
+        // tool which never writes one. Adding the component would require
+        // rewriting the TOC as well, so keep the generated summary in memory
+        // only.
+        return make_ready_future<>();
+    }
+    return seastar::async([this, &pc] {
+        auto file_path = filename(component_type::TemporarySummary);
+        sstlog.info("Persisting regenerated Summary file {}", filename(component_type::Summary));
+        file f = new_sstable_component_file(_write_error_handler, component_type::TemporarySummary, open_flags::wo | open_flags::create | open_flags::truncate).get0();
+
+        file_output_stream_options options;
+        options.buffer_size = sstable_buffer_size;
+        options.io_priority_class = pc;
+        auto w = file_writer(std::move(f), std::move(options));
+        write(_version, w, _components->summary);
+        w.flush();
+        w.close();
+        // rename() guarantees atomicity when renaming a file into place of
+        // the missing or corrupt one.
+        sstable_write_io_check(rename_file, file_path, filename(component_type::Summary)).get();
+    }).handle_exception([this] (auto ep) {
+        // Failing to persist is not fatal; the in-memory summary is intact
+        // and the Index scan simply repeats on the next load.
+        sstlog.warn("Couldn't persist regenerated summary file {}: {}", filename(component_type::Summary), ep);
+    });
+}
+
 future<> sstable::read_summary(const io_priority_class& pc) {
     if (_components->summary) {
         return make_ready_future<>();
@@ -1222,7 +1440,9 @@ future<> sstable::read_summary(const io_priority_class& pc) {
         if (has_component(component_type::Summary)) {
             return read_simple<component_type::Summary>(_components->summary, pc).handle_exception([this, &pc] (auto ep) {
                 sstlog.warn("Couldn't read summary file {}: {}. Recreating it.", this->filename(component_type::Summary), ep);
-                return this->generate_summary(pc);
+                return this->generate_summary(pc).then([this, &pc] {
+                    return this->persist_generated_summary(pc);
+                });
             });
         } else {
             return generate_summary(pc);
@@ -1252,13 +1472,39 @@ future<file> sstable::open_file(component_type type, open_flags flags, file_open
     });
 }
 
+thread_local reopenable_file_impl::resident_files_type reopenable_file_impl::_resident_files;
+
+file sstable::maybe_make_reopenable_file(component_type type, file f) {
+    auto budget = get_config().sstable_file_descriptor_budget();
+    if (!budget) {
+        return f;
+    }
+    // The opener captures this; readers keep the owning sstable alive for as
+    // long as they may touch its files, so the callback cannot outlive it.
+    return make_reopenable_file(budget, [this, type] {
+        return open_file(type, open_flags::ro);
+    }, std::move(f));
+}
+
+future<> sstable::ensure_resident_files() {
+    auto ensure = [] (file& f) {
+        if (auto rf = try_get_reopenable_file(f)) {
+            return rf->ensure_open();
+        }
+        return make_ready_future<>();
+    };
+    return ensure(_index_file).then([this, ensure] {
+        return ensure(_data_file);
+    });
+}
+
 future<> sstable::open_data() {
     return when_all(open_file(component_type::Index, open_flags::ro),
                     open_file(component_type::Data, open_flags::ro))
                     .then([this] (auto files) {
 
-        _index_file = std::get<file>(std::get<0>(files).get());
-        _data_file = std::get<file>(std::get<1>(files).get());
+        _index_file = maybe_make_reopenable_file(component_type::Index, std::get<file>(std::get<0>(files).get()));
+        _data_file = maybe_make_reopenable_file(component_type::Data, std::get<file>(std::get<1>(files).get()));
 
         return this->update_info_for_opened_data();
     }).then([this] {
@@ -1328,12 +1574,35 @@ future<> sstable::create_data() {
     });
 }
 
+// Per-shard accounting of lazily loaded bloom filters, most recently loaded
+// first. Only filters of sstables whose components are owned by this shard
+// are ever deferred, so the list and the filters it refers to are strictly
+// shard-local.
+struct resident_filters_type {
+    std::list<sstable*> lru;
+    size_t bytes = 0;
+};
+static thread_local resident_filters_type resident_filters;
+
 future<> sstable::read_filter(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
         _components->filter = std::make_unique<utils::filter::always_present_filter>();
         return make_ready_future<>();
     }
 
+    if (get_config().bloom_filter_memory_budget_mb()) {
+        // Defer reading the filter until the first key probe; until it is
+        // read, every key is reported as possibly present, which is correct
+        // but costs an index lookup per probe.
+        _components->filter = std::make_unique<utils::filter::always_present_filter>();
+        _components->filter_deferred = true;
+        return make_ready_future<>();
+    }
+
+    return do_read_filter(pc);
+}
+
+future<> sstable::do_read_filter(const io_priority_class& pc) {
     return seastar::async([this, &pc] () mutable {
         sstables::filter filter;
         read_simple<component_type::Filter>(filter, pc).get();
@@ -1343,9 +1612,51 @@ future<> sstable::read_filter(const io_priority_class& pc) {
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
         _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        _components->filter_deferred = false;
+    });
+}
+
+void sstable::load_deferred_filter() {
+    if (_filter_load_in_progress || _components.get_owner_shard() != engine().cpu_id()) {
+        return;
+    }
+    _filter_load_in_progress = true;
+    (void)do_read_filter(default_priority_class()).then_wrapped([sst = shared_from_this(), op = background_jobs().start()] (future<> f) {
+        sst->_filter_load_in_progress = false;
+        if (f.failed()) {
+            sstlog.warn("Loading filter of {} failed: {}", sst->get_filename(), f.get_exception());
+            return;
+        }
+        sst->account_resident_filter();
     });
 }
 
+void sstable::account_resident_filter() {
+    resident_filters.lru.push_front(this);
+    _resident_filter_link = resident_filters.lru.begin();
+    _resident_filter_bytes = _components->filter->memory_size();
+    resident_filters.bytes += _resident_filter_bytes;
+    auto budget = get_config().bloom_filter_memory_budget_mb() << 20;
+    while (resident_filters.bytes > budget && resident_filters.lru.size() > 1) {
+        resident_filters.lru.back()->evict_filter();
+    }
+}
+
+void sstable::evict_filter() {
+    _components->filter = std::make_unique<utils::filter::always_present_filter>();
+    _components->filter_deferred = true;
+    unlink_resident_filter();
+}
+
+void sstable::unlink_resident_filter() noexcept {
+    if (_resident_filter_link) {
+        resident_filters.lru.erase(*_resident_filter_link);
+        resident_filters.bytes -= _resident_filter_bytes;
+        _resident_filter_link = {};
+        _resident_filter_bytes = 0;
+    }
+}
+
 void sstable::write_filter(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
         return;
@@ -1362,18 +1673,30 @@ void sstable::write_filter(const io_priority_class& pc) {
 // No need to set tunable priorities for it.
 future<> sstable::load(const io_priority_class& pc) {
     return read_toc().then([this, &pc] {
-        // Read statistics ahead of others - if summary is missing
-        // we'll attempt to re-generate it and we need statistics for that
-        return read_statistics(pc).then([this, &pc] {
-            return seastar::when_all_succeed(
-                    read_compression(pc),
-                    read_scylla_metadata(pc),
-                    read_filter(pc),
-                    read_summary(pc)).then([this] {
-                validate_min_max_metadata();
-                validate_max_local_deletion_time();
-                return open_data();
-            });
+        // Regenerating a missing summary (the exceptional path of
+        // read_summary()) requires statistics, so that pair is chained;
+        // everything else is read concurrently to get the component reads
+        // of a single sstable in flight together.
+        return seastar::when_all_succeed(
+                read_statistics(pc).then([this, &pc] { return read_summary(pc); }),
+                read_compression(pc),
+                read_scylla_metadata(pc),
+                read_filter(pc)).then([this, &pc] {
+            validate_min_max_metadata();
+            validate_max_local_deletion_time();
+            if (_components->filter_deferred) {
+                // Deferred filters are loaded and dropped only by the shard
+                // owning the components. Shards of a shared sstable, or a
+                // sole owner other than this shard, could then observe the
+                // filter being swapped under them or never trigger the load
+                // at all, so only sstables owned solely by this shard keep
+                // their filter deferred.
+                auto shards = compute_shards_for_this_sstable();
+                if (shards.size() != 1 || shards.front() != engine().cpu_id()) {
+                    return do_read_filter(pc).then([this] { return open_data(); });
+                }
+            }
+            return open_data();
         });
     });
 }
@@ -1381,8 +1704,10 @@ future<> sstable::load(const io_priority_class& pc) {
 future<> sstable::load(sstables::foreign_sstable_open_info info) {
     return read_toc().then([this, info = std::move(info)] () mutable {
         _components = std::move(info.components);
-        _data_file = make_checked_file(_read_error_handler, info.data.to_file());
-        _index_file = make_checked_file(_read_error_handler, info.index.to_file());
+        _data_file = maybe_make_reopenable_file(component_type::Data,
+                make_checked_file(_read_error_handler, info.data.to_file()));
+        _index_file = maybe_make_reopenable_file(component_type::Index,
+                make_checked_file(_read_error_handler, info.index.to_file()));
         _shards = std::move(info.owners);
         validate_min_max_metadata();
         validate_max_local_deletion_time();
@@ -1394,16 +1719,28 @@ future<sstable_open_info> sstable::load_shared_components(const schema_ptr& s, s
         const io_priority_class& pc) {
     auto sst = sstables::make_sstable(s, dir, generation, v, f);
     return sst->load(pc).then([sst] () mutable {
-        auto info = sstable_open_info{make_lw_shared<shareable_components>(std::move(*sst->_components)),
-            std::move(sst->_shards), std::move(sst->_data_file), std::move(sst->_index_file)};
-        return make_ready_future<sstable_open_info>(std::move(info));
+        return sst->ensure_resident_files().then([sst] () mutable {
+            // The files outlive sst, whose reopen callbacks must not fire
+            // afterwards, so hand out the plain files instead.
+            auto unwrap = [] (file f) {
+                if (auto rf = try_get_reopenable_file(f)) {
+                    return rf->detach();
+                }
+                return f;
+            };
+            auto info = sstable_open_info{make_lw_shared<shareable_components>(std::move(*sst->_components)),
+                std::move(sst->_shards), unwrap(std::move(sst->_data_file)), unwrap(std::move(sst->_index_file))};
+            return make_ready_future<sstable_open_info>(std::move(info));
+        });
     });
 }
 
 future<foreign_sstable_open_info> sstable::get_open_info() & {
     return _components.copy().then([this] (auto c) mutable {
-        return foreign_sstable_open_info{std::move(c), this->get_shards_for_this_sstable(), _data_file.dup(), _index_file.dup(),
-            _generation, _version, _format};
+        return ensure_resident_files().then([this, c = std::move(c)] () mutable {
+            return foreign_sstable_open_info{std::move(c), this->get_shards_for_this_sstable(), _data_file.dup(), _index_file.dup(),
+                _generation, _version, _format};
+        });
     });
 }
 
@@ -2304,16 +2641,22 @@ void sstable_writer_k_l::consume_end_of_stream()
     _components_writer->consume_end_of_stream();
     _components_writer = std::nullopt;
     finish_file_writer();
-    _sst.write_summary(_pc);
-    _sst.write_filter(_pc);
-    _sst.write_statistics(_pc);
-    _sst.write_compression(_pc);
     auto features = all_features();
     if (!_correctly_serialize_non_compound_range_tombstones) {
         features.disable(sstable_feature::NonCompoundRangeTombstones);
     }
     run_identifier identifier{_run_identifier};
-    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier));
+    // Summary, Filter, Statistics, CompressionInfo and the scylla metadata
+    // are independent components living in separate files, so get their
+    // writes in flight together, mirroring what load() does on the read side.
+    seastar::when_all_succeed(
+            seastar::async([this] { _sst.write_summary(_pc); }),
+            seastar::async([this] { _sst.write_filter(_pc); }),
+            seastar::async([this] { _sst.write_statistics(_pc); }),
+            seastar::async([this] { _sst.write_compression(_pc); }),
+            seastar::async([this, features = std::move(features), identifier] () mutable {
+                _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier));
+            })).get();
 
     _monitor->on_write_completed();
 
@@ -2465,6 +2808,9 @@ future<> sstable::generate_summary(const io_priority_class& pc) {
                 file_input_stream_options options;
                 options.buffer_size = sstable_buffer_size;
                 options.io_priority_class = pc;
+                // The scan is strictly sequential over the whole Index file,
+                // so keep the disk busy while we parse.
+                options.read_ahead = std::clamp<uint32_t>(index_size / sstable_buffer_size, 1, 16);
                 return do_with(summary_generator(_components->summary),
                         [this, &pc, options = std::move(options), index_file, index_size] (summary_generator& s) mutable {
                     auto ctx = make_lw_shared<index_consume_entry_context<summary_generator>>(
@@ -2620,6 +2966,38 @@ future<> sstable::create_links(const sstring& dir, int64_t generation) const {
     });
 }
 
+// Creates a hard link and ignores EEXIST. Snapshot links are idempotent:
+// the source component is immutable, so an existing destination was
+// necessarily created by another shard linking the same shared sstable.
+static future<> link_file_idempotent(sstring src, sstring dst) {
+    return link_file(std::move(src), std::move(dst)).then_wrapped([] (future<> f) {
+        try {
+            f.get();
+        } catch (std::system_error& e) {
+            if (e.code() != std::error_code(EEXIST, std::system_category())) {
+                throw;
+            }
+        }
+    });
+}
+
+future<> sstable::snapshot_link_components(const sstring& dir) const {
+    return parallel_for_each(all_components(), [this, dir] (auto p) {
+        if (p.first == component_type::TOC) {
+            return make_ready_future<>();
+        }
+        auto src = sstable::filename(_dir, _schema->ks_name(), _schema->cf_name(), _version, _generation, _format, p.second);
+        auto dst = sstable::filename(dir, _schema->ks_name(), _schema->cf_name(), _version, _generation, _format, p.second);
+        return this->sstable_write_io_check(link_file_idempotent, std::move(src), std::move(dst));
+    });
+}
+
+future<> sstable::snapshot_link_toc(const sstring& dir) const {
+    auto src = filename(component_type::TOC);
+    auto dst = sstable::filename(dir, _schema->ks_name(), _schema->cf_name(), _version, _generation, _format, component_type::TOC);
+    return sstable_write_io_check(link_file_idempotent, std::move(src), std::move(dst));
+}
+
 future<> sstable::set_generation(int64_t new_generation) {
     return create_links(_dir, new_generation).then([this] {
         return remove_file(filename(component_type::TOC)).then([this] {
@@ -2727,7 +3105,13 @@ input_stream<char> sstable::data_stream(uint64_t pos, size_t len, const io_prior
     file_input_stream_options options;
     options.buffer_size = sstable_buffer_size;
     options.io_priority_class = pc;
-    options.read_ahead = 4;
+    // Size the initial read-ahead window from the amount of data this read
+    // declares it will span, so point slices don't pay for speculative I/O
+    // they will never consume while wide-partition scans get a deep enough
+    // pipeline not to stall on each buffer. The per-sstable stream history
+    // (options.dynamic_adjustments) then trims the window further based on
+    // how much of the read-ahead past reads actually used.
+    options.read_ahead = std::clamp<uint32_t>(len / sstable_buffer_size, 1, 16);
     options.dynamic_adjustments = std::move(history);
 
     auto f = resource_tracker.track(_data_file);
@@ -2860,6 +3244,9 @@ future<>
 delete_sstables(std::vector<sstring> tocs);
 
 sstable::~sstable() {
+    index_page_cache::shard_cache().invalidate(*this);
+    key_cache::shard_cache().invalidate(*this);
+    unlink_resident_filter();
     if (_index_file) {
         _index_file.close().handle_exception([save = _index_file, op = background_jobs().start()] (auto ep) {
             sstlog.warn("sstable close index_file failed: {}", ep);
@@ -3133,8 +3520,38 @@ delete_atomically(std::vector<shared_sstable> ssts, const db::large_data_handler
     return when_all(std::move(del), std::move(update)).discard_result();
 }
 
+future<>
+deactivate_sstable(shared_sstable sst) {
+    return seastar::async([sst = std::move(sst)] {
+        const io_error_handler& error_handler = sstable_write_error_handler;
+        auto toc_name = sst->toc_filename();
+        if (!sstable_io_check(error_handler, file_exists, toc_name).get0()) {
+            // Already renamed to TemporaryTOC by an earlier call, or being
+            // deleted concurrently. Either way the sstable won't be reloaded.
+            return;
+        }
+        sstring prefix = toc_name.substr(0, toc_name.size() - sstable_version_constants::TOC_SUFFIX.size());
+        auto new_toc_name = prefix + sstable_version_constants::TEMPORARY_TOC_SUFFIX;
+        sstable_io_check(error_handler, rename_file, toc_name, new_toc_name).get();
+        fsync_directory(error_handler, dirname(toc_name)).get();
+    });
+}
+
 thread_local sstables_stats::stats sstables_stats::_shard_stats;
 thread_local shared_index_lists::stats shared_index_lists::_shard_stats;
+thread_local index_page_cache::stats index_page_cache::_shard_stats;
+
+index_page_cache& index_page_cache::shard_cache() {
+    static thread_local index_page_cache cache;
+    return cache;
+}
+
+thread_local key_cache::stats key_cache::_shard_stats;
+
+key_cache& key_cache::shard_cache() {
+    static thread_local key_cache cache;
+    return cache;
+}
 static thread_local seastar::metrics::metric_groups metrics;
 
 future<> init_metrics() {
@@ -3148,6 +3565,33 @@ future<> init_metrics() {
         sm::make_derive("index_page_blocks", [] { return shared_index_lists::shard_stats().blocks; },
             sm::description("Index page requests which needed to wait due to page not being loaded yet")),
 
+        sm::make_derive("index_page_cache_hits", [] { return index_page_cache::shard_stats().hits; },
+            sm::description("Index page loads served from the shard index page cache")),
+        sm::make_derive("index_page_cache_misses", [] { return index_page_cache::shard_stats().misses; },
+            sm::description("Index page loads which were not found in the shard index page cache")),
+        sm::make_derive("index_page_cache_insertions", [] { return index_page_cache::shard_stats().insertions; },
+            sm::description("Index pages retained in the shard index page cache")),
+        sm::make_derive("index_page_cache_evictions", [] { return index_page_cache::shard_stats().evictions; },
+            sm::description("Index pages evicted from the shard index page cache to stay within its budget")),
+        sm::make_gauge("index_page_cache_bytes", [] { return index_page_cache::shard_stats().bytes; },
+            sm::description("Memory currently held by the shard index page cache")),
+
+        sm::make_derive("key_cache_hits", [] { return key_cache::shard_stats().hits; },
+            sm::description("Single partition reads which found the partition's data file position in the shard key cache")),
+        sm::make_derive("key_cache_misses", [] { return key_cache::shard_stats().misses; },
+            sm::description("Single partition reads which did not find the partition's data file position in the shard key cache")),
+        sm::make_derive("key_cache_insertions", [] { return key_cache::shard_stats().insertions; },
+            sm::description("Partition positions inserted into the shard key cache")),
+        sm::make_derive("key_cache_evictions", [] { return key_cache::shard_stats().evictions; },
+            sm::description("Partition positions evicted from the shard key cache to stay within its budget")),
+        sm::make_gauge("key_cache_bytes", [] { return key_cache::shard_stats().bytes; },
+            sm::description("Memory currently held by the shard key cache")),
+
+        sm::make_derive("sstable_set_selections", [] { return sstable_set::shard_selection_stats().selections; },
+            sm::description("Number of sstable selections done against the shard's sstable sets")),
+        sm::make_derive("sstable_set_sstables_selected", [] { return sstable_set::shard_selection_stats().sstables_selected; },
+            sm::description("Total number of sstables returned by sstable set selections; divided by sstable_set_selections it gives the average number of sstables a read considers")),
+
         sm::make_derive("partition_writes", [] { return sstables_stats::get_shard_stats().partition_writes; },
             sm::description("Number of partitions written")),
         sm::make_derive("static_row_writes", [] { return sstables_stats::get_shard_stats().static_row_writes; },
@@ -3223,6 +3667,7 @@ std::ostream& operator<<(std::ostream& out, const sstables::component_type& comp
     case ct::Statistics: out << "Statistics"; break;
     case ct::TemporaryTOC: out << "TemporaryTOC"; break;
     case ct::TemporaryStatistics: out << "TemporaryStatistics"; break;
+    case ct::TemporarySummary: out << "TemporarySummary"; break;
     case ct::Scylla: out << "Scylla"; break;
     case ct::Unknown: out << "Unknown"; break;
     }
@@ -31,6 +31,7 @@
 #include <seastar/core/enum.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/distributed.hh>
+#include <list>
 #include <unordered_set>
 #include <unordered_map>
 #include <experimental/filesystem>
@@ -253,6 +254,14 @@ public:
     // The mutation_source shares ownership of this sstable.
     mutation_source as_mutation_source();
 
+    // Verifies the integrity of the data file against its on-disk checksums
+    // without parsing its contents: the per-chunk checksums (CRC.db for
+    // uncompressed sstables, the trailer of each compressed chunk otherwise)
+    // and the Digest full checksum. Mismatches are logged with their chunk
+    // offset. Returns whether the data file is intact; callers wanting to
+    // know what exactly is damaged must fall back to a full parse.
+    future<bool> validate_checksums(const io_priority_class& pc);
+
     future<> write_components(flat_mutation_reader mr,
             uint64_t estimated_partitions,
             schema_ptr schema,
@@ -409,6 +418,17 @@ public:
         return create_links(dir, _generation);
     }
 
+    // Batched variant of create_links() for snapshots. The caller links
+    // many sstables into the same directory and is expected to amortize
+    // the directory syncs over the whole batch: link all component files
+    // with snapshot_link_components(), sync the directory, then link the
+    // TOCs with snapshot_link_toc() and sync again. This preserves the
+    // TOC-last ordering of create_links() with two directory syncs per
+    // batch instead of three per sstable. Both steps tolerate EEXIST so
+    // that shards sharing an sstable can race linking it.
+    future<> snapshot_link_components(const sstring& dir) const;
+    future<> snapshot_link_toc(const sstring& dir) const;
+
     /**
      * Note. This is using the Origin definition of
      * max_data_age, which is load time. This could maybe
@@ -432,6 +452,9 @@ public:
     struct shareable_components {
         sstables::compression compression;
         utils::filter_ptr filter;
+        // True when the Filter component exists on disk but hasn't been read
+        // yet; filter is then an always-present placeholder. See read_filter().
+        bool filter_deferred = false;
         sstables::summary summary;
         sstables::statistics statistics;
         std::optional<sstables::scylla_metadata> scylla_metadata;
@@ -466,6 +489,12 @@ private:
     utils::UUID _run_identifier;
     utils::observable<sstable&> _on_closed;
 
+    // Lazily loaded filter state, see read_filter(). The link points into
+    // the per-shard residency list in sstables.cc.
+    bool _filter_load_in_progress = false;
+    std::optional<std::list<sstable*>::iterator> _resident_filter_link;
+    size_t _resident_filter_bytes = 0;
+
     lw_shared_ptr<file_input_stream_history> _single_partition_history = make_lw_shared<file_input_stream_history>();
     lw_shared_ptr<file_input_stream_history> _partition_range_history = make_lw_shared<file_input_stream_history>();
 
@@ -521,6 +550,14 @@ private:
 
     future<file> open_file(component_type, open_flags, file_open_options = {});
 
+    // Wraps a read-side component file so its descriptor can be dropped under
+    // fd pressure and reopened on access; a no-op unless
+    // sstable_file_descriptor_budget is set. See reopenable_file_impl.hh.
+    file maybe_make_reopenable_file(component_type type, file f);
+    // dup() needs an open descriptor, so reopen dropped files before handing
+    // them to another shard.
+    future<> ensure_resident_files();
+
     template <component_type Type, typename T>
     future<> read_simple(T& comp, const io_priority_class& pc);
 
@@ -530,6 +567,15 @@ private:
     void write_crc(const checksum& c);
     void write_digest(uint32_t full_checksum);
 
+    future<uint32_t> read_digest(const io_priority_class& pc);
+    future<checksum> read_checksum(const io_priority_class& pc);
+
+    // Both must run inside a seastar thread.
+    template <typename ChecksumType>
+    bool validate_compressed_checksums(const io_priority_class& pc, uint32_t expected_digest, bool digest_covers_chunk_checksums);
+    template <typename ChecksumType>
+    bool validate_uncompressed_checksums(const io_priority_class& pc, uint32_t expected_digest);
+
     future<file> rename_new_sstable_component_file(sstring from_file, sstring to_file, file fd);
     future<file> new_sstable_component_file(const io_error_handler& error_handler, component_type f, open_flags flags, file_open_options options = {});
     future<file> new_sstable_component_file_non_checked(component_type f, open_flags flags, file_open_options options = {});
@@ -549,6 +595,25 @@ private:
 
     future<> read_filter(const io_priority_class& pc);
 
+    // Reads the Filter component unconditionally, clearing any deferral.
+    future<> do_read_filter(const io_priority_class& pc);
+
+    // Starts reading a deferred filter in the background, once, and only on
+    // the shard owning the components. Until the read finishes (and on all
+    // other shards) probes answer through the always-present placeholder.
+    void load_deferred_filter();
+
+    // Registers a lazily loaded filter with the per-shard residency
+    // accounting and evicts the least recently loaded filters when over
+    // the configured budget.
+    void account_resident_filter();
+
+    // Drops a lazily loaded filter back to its deferred state. The next
+    // probe will reload it.
+    void evict_filter();
+
+    void unlink_resident_filter() noexcept;
+
     void write_filter(const io_priority_class& pc);
 
     future<> read_summary(const io_priority_class& pc);
@@ -561,6 +626,12 @@ private:
     // happen if old tools are being used.
     future<> generate_summary(const io_priority_class& pc);
 
+    // Writes a summary produced by generate_summary() back to disk, by
+    // creating a temporary Summary and renaming it into place, so that the
+    // Index scan happens at most once per sstable. Does nothing if the TOC
+    // doesn't list a Summary; never fails the load.
+    future<> persist_generated_summary(const io_priority_class& pc);
+
     future<> read_statistics(const io_priority_class& pc);
     void write_statistics(const io_priority_class& pc);
     // Rewrite statistics component by creating a temporary Statistics and
@@ -676,6 +747,9 @@ public:
     }
 
     bool filter_has_key(const key& key) {
+        if (_components->filter_deferred) {
+            load_deferred_filter();
+        }
         return _components->filter->is_present(bytes_view(key));
     }
 
@@ -688,6 +762,9 @@ public:
     future<bool> has_partition_key(const utils::hashed_key& hk, const dht::decorated_key& dk);
 
     bool filter_has_key(utils::hashed_key key) {
+        if (_components->filter_deferred) {
+            load_deferred_filter();
+        }
         return _components->filter->is_present(key);
     }
 
@@ -850,6 +927,14 @@ future<> await_background_jobs_on_all_shards();
 // This function only solves the second problem for now.
 future<> delete_atomically(std::vector<shared_sstable> ssts, const db::large_data_handler& large_data_handler);
 
+// Makes an sstable invisible to reload after a restart without unlinking its
+// data: renames its TOC to TemporaryTOC and syncs the directory. An sstable
+// left in this state is cleaned up on the next boot, and delete_atomically()
+// recognizes the renamed TOC, so the actual unlinking of the components can
+// be deferred to a background fiber. A no-op if the sstable was already
+// deactivated.
+future<> deactivate_sstable(shared_sstable sst);
+
 struct index_sampling_state {
     static constexpr size_t default_summary_byte_cost = 2000;
 
@@ -169,6 +169,23 @@ public:
         }
         return compaction_descriptor(std::move(compaction_candidates));
     }
+
+    virtual std::vector<compaction_descriptor> get_major_compaction_jobs(column_family& cf, std::vector<shared_sstable> candidates) override {
+        if (candidates.empty()) {
+            return {};
+        }
+        // Time windows never overlap, so each window can be rewritten by its
+        // own job and the jobs may run in parallel. This also avoids creating
+        // one giant sstable spanning every window, which would defeat the
+        // strategy.
+        auto p = get_buckets(std::move(candidates), _options);
+        std::vector<compaction_descriptor> jobs;
+        jobs.reserve(p.first.size());
+        for (auto&& key_bucket : p.first) {
+            jobs.push_back(compaction_descriptor(std::move(key_bucket.second)));
+        }
+        return jobs;
+    }
 private:
     static timestamp_type
     to_timestamp_type(time_window_compaction_strategy_options::timestamp_resolutions resolution, int64_t timestamp_from_sstable) {
@@ -191,18 +208,12 @@ private:
         }
 
         // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
-        // ratio is greater than threshold.
-        auto e = boost::range::remove_if(non_expiring_sstables, [this, &gc_before] (const shared_sstable& sst) -> bool {
-            return !worth_dropping_tombstones(sst, gc_before);
-        });
-        non_expiring_sstables.erase(e, non_expiring_sstables.end());
-        if (non_expiring_sstables.empty()) {
+        // ratio is greater than threshold, preferring the one which reclaims the most garbage.
+        auto worth = get_sstables_by_garbage_ratio(std::move(non_expiring_sstables), gc_before);
+        if (worth.empty()) {
             return {};
         }
-        auto it = boost::min_element(non_expiring_sstables, [] (auto& i, auto& j) {
-            return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
-        });
-        return { *it };
+        return { worth.front() };
     }
 
     std::vector<shared_sstable> get_compaction_candidates(column_family& cf, std::vector<shared_sstable> candidate_sstables) {
@@ -133,6 +133,11 @@ class checksummed_file_data_sink_impl : public data_sink_impl {
     data_sink _out;
     struct checksum& _c;
     uint32_t& _full_checksum;
+    // Resolves when all buffers queued so far have been written. put()
+    // returns the future of the previous buffer's write instead of the
+    // current one's, so checksumming of the next buffer overlaps with the
+    // write of this one, with at most one buffer in flight.
+    future<> _pending_put = make_ready_future<>();
 public:
     checksummed_file_data_sink_impl(file f, struct checksum& c, uint32_t& full_file_checksum, file_output_stream_options options)
             : _out(make_file_data_sink(std::move(f), std::move(options)))
@@ -153,12 +158,17 @@ public:
             _full_checksum = checksum_combine_or_feed<ChecksumType>(_full_checksum, per_chunk_checksum, buf.begin() + offset, size);
             _c.checksums.push_back(per_chunk_checksum);
         }
-        return _out.put(std::move(buf));
+        auto put_fut = _pending_put.then([this, buf = std::move(buf)] () mutable {
+            return _out.put(std::move(buf));
+        });
+        return std::exchange(_pending_put, std::move(put_fut));
     }
 
     virtual future<> close() {
         // Nothing to do, because close at the file_stream level will call flush on us.
-        return _out.close();
+        return std::exchange(_pending_put, make_ready_future<>()).finally([this] {
+            return _out.close();
+        });
     }
 };
 
@@ -191,7 +191,7 @@ void stream_session::init_messaging_service_handler() {
                                 sstables::sstable_writer_config sst_cfg;
                                 sst_cfg.large_data_handler = cf->get_large_data_handler();
                                 auto& pc = service::get_local_streaming_write_priority();
-                                return sst->write_components(std::move(reader), std::max(1ul, estimated_partitions), s, sst_cfg, {}, pc).then([sst] {
+                                return sst->write_components(std::move(reader), std::max(1ul, estimated_partitions), s, sst_cfg, cf->get_streaming_encoding_stats(), pc).then([sst] {
                                     return sst->open_data();
                                 }).then([cf, sst] {
                                     return cf->add_sstable_and_update_cache(sst);
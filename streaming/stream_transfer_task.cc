@@ -211,6 +211,21 @@ future<> send_mutation_fragments(lw_shared_ptr<send_info> si) {
   });
 }
 
+// Streaming always goes through the read path - sstables are decompressed,
+// parsed into mutation fragments and re-serialized onto the wire - even for
+// a rebuild where the receiver takes whole ranges. Shipping raw sstable
+// files instead (the receiver would only need to verify range containment
+// against the Index and could write the data through
+// integrity_checked_file_impl) would make such streams NIC-bound, but it
+// does not fit how data is placed here: an sstable written on one sender
+// shard covers token ranges that map to many shards on the receiver, while
+// every receiver shard requires its sstables to contain only its own
+// tokens. Splitting a foreign sstable is what resharding does, and that is
+// an offline compaction-manager job driven from distributed_loader at boot,
+// not something the write path can absorb during a stream. Until sstables
+// are partitioned per range rather than per shard, the fragment stream
+// below (send_mutation_fragments) is the fast path, and it already avoids
+// the per-mutation RPC round trips of the legacy send_mutations path.
 future<> stream_transfer_task::execute() {
     auto plan_id = session->plan_id();
     auto cf_id = this->cf_id;
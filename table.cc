@@ -295,6 +295,7 @@ create_single_key_sstable_reader(column_family* cf,
         return make_empty_flat_reader(schema);
     }
     sstable_histogram.add(readers.size());
+    cf->get_compaction_strategy().get_backlog_tracker().register_read(readers.size());
     return make_combined_reader(schema, std::move(readers), fwd, fwd_mr);
 }
 
@@ -439,7 +440,6 @@ table::make_reader(schema_ptr s,
     }
 
     std::vector<flat_mutation_reader> readers;
-    readers.reserve(_memtables->size() + 1);
 
     // We're assuming that cache and memtables are both read atomically
     // for single-key queries, so we don't need to special case memtable
@@ -461,22 +461,72 @@ table::make_reader(schema_ptr s,
     // https://github.com/scylladb/scylla/issues/309
     // https://github.com/scylladb/scylla/issues/185
 
-    for (auto&& mt : *_memtables) {
-        readers.emplace_back(mt->make_flat_reader(s, range, slice, pc, trace_state, fwd, fwd_mr));
-    }
+    // Single-partition readers which cannot be fast-forwarded to other
+    // partitions can skip memtables which don't contain the key. The lookup
+    // is much cheaper than constructing a reader which would produce
+    // nothing, and on a cache hit with idle memtables the cache reader is
+    // the only one left, so make_combined_reader() returns it directly
+    // without the combining wrapper. The opposite doesn't hold: memtables
+    // carry no continuity information, so a partition present in a memtable
+    // never allows skipping the cache or sstable readers. The lookups and
+    // reader construction happen without deferring, preserving the
+    // atomicity assumption above.
+    const bool skip_empty_memtables = query::is_single_partition(range)
+            && fwd_mr == mutation_reader::forwarding::no;
+
+    auto make_cache_or_sstable_reader = [&] () -> flat_mutation_reader {
+        if (_config.enable_cache && !slice.options.contains(query::partition_slice::option::bypass_cache)) {
+            return _cache.make_reader(s, range, slice, pc, std::move(trace_state), fwd, fwd_mr);
+        } else {
+            return make_sstable_reader(s, _sstables, range, slice, pc, std::move(trace_state), fwd, fwd_mr);
+        }
+    };
 
-    if (_config.enable_cache && !slice.options.contains(query::partition_slice::option::bypass_cache)) {
-        readers.emplace_back(_cache.make_reader(s, range, slice, pc, std::move(trace_state), fwd, fwd_mr));
-    } else {
-        readers.emplace_back(make_sstable_reader(s, _sstables, range, slice, pc, std::move(trace_state), fwd, fwd_mr));
-    }
+    auto maybe_add_listeners = [&] (flat_mutation_reader rd) -> flat_mutation_reader {
+        if (_config.data_listeners && !_config.data_listeners->empty()) {
+            return _config.data_listeners->on_read(s, range, slice, std::move(rd));
+        }
+        return rd;
+    };
 
-    auto comb_reader = make_combined_reader(s, std::move(readers), fwd, fwd_mr);
-    if (_config.data_listeners && !_config.data_listeners->empty()) {
-        return _config.data_listeners->on_read(s, range, slice, std::move(comb_reader));
+    if (skip_empty_memtables) {
+        // Point reads find the key in no memtable (read-mostly workloads) or
+        // just the active one, so wire those cases up directly, saving the
+        // readers vector allocation and, in the former case, the combining
+        // reader on every such read.
+        flat_mutation_reader_opt mt_reader;
+        for (auto&& mt : *_memtables) {
+            if (!mt->contains_partition(range.start()->value())) {
+                continue;
+            }
+            auto rd = mt->make_flat_reader(s, range, slice, pc, trace_state, fwd, fwd_mr);
+            if (!mt_reader) {
+                mt_reader = std::move(rd);
+            } else {
+                // The key is in several memtables; rare enough that the
+                // vector is not worth avoiding.
+                if (readers.empty()) {
+                    readers.reserve(_memtables->size() + 1);
+                    readers.emplace_back(std::move(*mt_reader));
+                }
+                readers.emplace_back(std::move(rd));
+            }
+        }
+        if (readers.empty()) {
+            if (!mt_reader) {
+                return maybe_add_listeners(make_cache_or_sstable_reader());
+            }
+            return maybe_add_listeners(make_combined_reader(s, std::move(*mt_reader), make_cache_or_sstable_reader(), fwd, fwd_mr));
+        }
     } else {
-        return comb_reader;
+        readers.reserve(_memtables->size() + 1);
+        for (auto&& mt : *_memtables) {
+            readers.emplace_back(mt->make_flat_reader(s, range, slice, pc, trace_state, fwd, fwd_mr));
+        }
     }
+
+    readers.emplace_back(make_cache_or_sstable_reader());
+    return maybe_add_listeners(make_combined_reader(s, std::move(readers), fwd, fwd_mr));
 }
 
 sstables::shared_sstable table::make_streaming_sstable_for_write(std::optional<sstring> subdir) {
@@ -671,6 +721,9 @@ void table::add_sstable(sstables::shared_sstable sstable, const std::vector<unsi
 
 future<>
 table::add_sstable_and_update_cache(sstables::shared_sstable sst) {
+    // Unlike a memtable flush, this brings in content the table did not
+    // have yet (streamed or imported data).
+    ++_content_epoch;
     return get_row_cache().invalidate([this, sst] () noexcept {
         // FIXME: this is not really noexcept, but we need to provide strong exception guarantees.
         // atomically load all opened sstables into column family.
@@ -951,6 +1004,10 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
     // The code as is guarantees that we'll never partially backup a
     // single sstable, so that is enough of a guarantee.
     database_sstable_write_monitor monitor(std::move(permit), newtab, _compaction_manager, _compaction_strategy, old->get_max_timestamp());
+    // The sealed memtable receives no more writes and its region is freed
+    // wholesale when the flush completes, so compacting it is wasted work
+    // which only invalidates the flush reader's position.
+    old->on_flush_start();
     return do_with(std::move(monitor), [this, old, newtab] (auto& monitor) {
         auto&& priority = service::get_local_memtable_flush_priority();
         auto f = write_memtable_to_sstable(*old, newtab, monitor, get_large_data_handler(), incremental_backups_enabled(), priority, false);
@@ -959,6 +1016,7 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
         // priority inversion.
         return with_scheduling_group(default_scheduling_group(), [this, &monitor, old = std::move(old), newtab = std::move(newtab), f = std::move(f)] () mutable {
             return f.then([this, newtab, old, &monitor] {
+                record_flush_encoding_stats(old->get_encoding_stats());
                 return newtab->open_data().then([this, old, newtab] () {
                     tlogger.debug("Flushing to {} done", newtab->get_filename());
                     return with_scheduling_group(_config.memtable_to_cache_scheduling_group, [this, old, newtab] {
@@ -976,6 +1034,7 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
                 // If we failed this write we will try the write again and that will create a new flush reader
                 // that will decrease dirty memory again. So we need to reset the accounting.
                 old->revert_flushed_memory();
+                old->on_flush_failed();
                 return stop_iteration(_async_gate.is_closed());
             });
         });
@@ -991,6 +1050,8 @@ table::start() {
 
 future<>
 table::stop() {
+    // Let the reclaim fiber skip its pacing pauses and drain quickly.
+    _sstable_reclaim_abort.request_abort();
     return _async_gate.close().then([this] {
         return when_all(await_pending_writes(), await_pending_reads(), await_pending_streams()).discard_result().finally([this] {
             return when_all(_memtables->request_flush(), _streaming_memtables->request_flush()).discard_result().finally([this] {
@@ -1093,6 +1154,16 @@ void table::set_metrics() {
         add_row_lock_metrics(_row_locker_stats.exclusive_partition, "exclusive_partition");
         add_row_lock_metrics(_row_locker_stats.shared_partition, "shared_partition");
 
+        // Metrics related to counter cell locking
+        if (_schema->is_counter()) {
+            auto& stats = _counter_cell_locks->table_stats();
+            _metrics.add_group("column_family", {
+                ms::make_total_operations("counter_cell_lock_fast_path", stats.lock_cells_fast_path, ms::description("Counter lock acquisitions that skipped walking the lock hash thanks to a clear contention hint"))(cf)(ks),
+                ms::make_total_operations("counter_cell_lock_false_hints", stats.lock_cells_false_hints, ms::description("Counter lock acquisitions that walked the lock hash but found no locks held"))(cf)(ks),
+                ms::make_total_operations("counter_cell_lock_contended", stats.lock_cells_contended, ms::description("Counter lock acquisitions that found locks already held in the partition"))(cf)(ks),
+            });
+        }
+
         // View metrics are created only for base tables, so there's no point in adding them to views (which cannot act as base tables for other views)
         if (!_schema->is_view()) {
             _metrics.add_group("column_family", {
@@ -1108,6 +1179,7 @@ void table::set_metrics() {
             _metrics.add_group("column_family", {
                     ms::make_histogram("read_latency", ms::description("Read latency histogram"), [this] {return _stats.estimated_read.get_histogram(std::chrono::microseconds(100));})(cf)(ks),
                     ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return _stats.estimated_write.get_histogram(std::chrono::microseconds(100));})(cf)(ks),
+                    ms::make_histogram("write_size", ms::description("Serialized size of applied mutations histogram"), [this] {return _stats.estimated_write_size.get_histogram(128);})(cf)(ks),
                     ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks)
             });
         }
@@ -1148,6 +1220,12 @@ table::rebuild_sstable_list(const std::vector<sstables::shared_sstable>& new_sst
     _sstables = make_lw_shared(std::move(new_sstable_list));
 }
 
+// Note that the row cache is deliberately left alone here: it is a
+// snapshot-isolated view over the combined mutation sources, not over
+// individual sstables, and compaction doesn't change the data those sources
+// return. Cached entries therefore stay valid (and hot) across compaction;
+// the only cache work needed is refresh_snapshot() below, which rebuilds the
+// underlying snapshot so it stops pinning the deleted input files.
 void
 table::on_compaction_completion(const std::vector<sstables::shared_sstable>& new_sstables,
                                     const std::vector<sstables::shared_sstable>& sstables_to_remove) {
@@ -1645,6 +1723,9 @@ struct snapshot_manager {
 };
 static thread_local std::unordered_map<sstring, lw_shared_ptr<snapshot_manager>> pending_snapshots;
 
+// Bounds how many sstables have their snapshot links created at once.
+static constexpr size_t snapshot_link_concurrency = 64;
+
 static future<>
 seal_snapshot(sstring jsondir) {
     std::ostringstream ss;
@@ -1688,22 +1769,39 @@ future<> table::snapshot(sstring name) {
         return do_with(std::move(tables), [this, name](std::vector<sstables::shared_sstable> & tables) {
             auto jsondir = _config.datadir + "/snapshots/" + name;
             return io_check(recursive_touch_directory, jsondir).then([this, name, jsondir, &tables] {
-                return parallel_for_each(tables, [name](sstables::shared_sstable sstable) {
-                    auto dir = sstable->get_dir() + "/snapshots/" + name;
-                    return io_check(recursive_touch_directory, dir).then([sstable, dir] {
-                        return sstable->create_links(dir).then_wrapped([] (future<> f) {
-                            // If the SSTables are shared, one of the CPUs will fail here.
-                            // That is completely fine, though. We only need one link.
-                            try {
-                                f.get();
-                            } catch (std::system_error& e) {
-                                if (e.code() != std::error_code(EEXIST, std::system_category())) {
-                                    throw;
-                                }
-                            }
-                            return make_ready_future<>();
+                // Link in two phases over the whole batch of sstables -
+                // component files first, TOCs second - so each snapshot
+                // directory is created and synced once per phase instead
+                // of three times per sstable, and bound the number of
+                // sstables linking concurrently so a snapshot of a table
+                // with tens of thousands of sstables does not monopolize
+                // the shard. Shared sstables may be linked by several
+                // shards concurrently; the links are idempotent.
+                std::unordered_set<sstring> dirs;
+                for (auto& sst : tables) {
+                    dirs.insert(sst->get_dir() + "/snapshots/" + name);
+                }
+                return do_with(std::move(dirs), semaphore(snapshot_link_concurrency), [name, &tables] (std::unordered_set<sstring>& dirs, semaphore& limit) {
+                    auto sync_dirs = [&dirs] {
+                        return parallel_for_each(dirs, [] (const sstring& dir) {
+                            return io_check(sync_directory, dir);
                         });
-                    });
+                    };
+                    return parallel_for_each(dirs, [] (const sstring& dir) {
+                        return io_check(recursive_touch_directory, dir);
+                    }).then([name, &tables, &limit] {
+                        return parallel_for_each(tables, [name, &limit] (sstables::shared_sstable sstable) {
+                            return with_semaphore(limit, 1, [sstable, name] {
+                                return sstable->snapshot_link_components(sstable->get_dir() + "/snapshots/" + name);
+                            });
+                        });
+                    }).then(sync_dirs).then([name, &tables, &limit] {
+                        return parallel_for_each(tables, [name, &limit] (sstables::shared_sstable sstable) {
+                            return with_semaphore(limit, 1, [sstable, name] {
+                                return sstable->snapshot_link_toc(sstable->get_dir() + "/snapshots/" + name);
+                            });
+                        });
+                    }).then(sync_dirs);
                 });
             }).then([jsondir, &tables] {
                 return io_check(sync_directory, std::move(jsondir));
@@ -1880,6 +1978,7 @@ future<> table::fail_streaming_mutations(utils::UUID plan_id) {
 }
 
 future<> table::clear() {
+    ++_content_epoch;
     if (_commitlog) {
         _commitlog->discard_completed_segments(_schema->id());
     }
@@ -1896,6 +1995,7 @@ future<> table::clear() {
 future<db::replay_position> table::discard_sstables(db_clock::time_point truncated_at) {
     assert(_compaction_disabled > 0);
 
+    ++_content_epoch;
     return with_lock(_sstables_lock.for_read(), [this, truncated_at] {
         struct pruner {
             column_family& cf;
@@ -1930,16 +2030,62 @@ future<db::replay_position> table::discard_sstables(db_clock::time_point truncat
             p->prune(truncated_at);
             tlogger.debug("cleaning out row cache");
         }).then([this, p]() mutable {
-            return parallel_for_each(p->remove, [this](sstables::shared_sstable s) {
+            for (auto& s : p->remove) {
                 _compaction_strategy.get_backlog_tracker().remove_sstable(s);
-                return sstables::delete_atomically({s}, *get_large_data_handler());
-            }).then([p] {
+            }
+            // Deactivate the pruned sstables now, so a restart cannot bring
+            // the truncated data back, but defer unlinking their components
+            // to the background reclaim fiber. Truncating or dropping a large
+            // table may discard thousands of sstables, and unlinking them all
+            // at once would stall foreground I/O for a long time.
+            return parallel_for_each(p->remove, [] (sstables::shared_sstable s) {
+                return sstables::deactivate_sstable(std::move(s));
+            }).then([this, p] {
+                for (auto& s : p->remove) {
+                    _sstables_pending_reclaim.push_back(s);
+                }
+                reclaim_discarded_sstables();
                 return make_ready_future<db::replay_position>(p->rp);
             });
         });
     });
 }
 
+// Unlinks the components of sstables discarded by truncate, one sstable at a
+// time with a pause between them. Unlinks are metadata operations the I/O
+// scheduler has no control over, so pacing the fiber is the only way to keep
+// the reclaim of a large table from competing with foreground requests. The
+// sstables were already deactivated by discard_sstables(), so there is no
+// hurry: a restart simply finishes the job during the startup cleanup.
+void table::reclaim_discarded_sstables() {
+    static constexpr auto reclaim_pause = 100ms;
+
+    if (_sstable_reclaim_active || _sstables_pending_reclaim.empty()) {
+        return;
+    }
+    _sstable_reclaim_active = true;
+    seastar::with_gate(_sstable_deletion_gate, [this] {
+        return do_until([this] { return _sstables_pending_reclaim.empty(); }, [this] {
+            auto sst = _sstables_pending_reclaim.front();
+            _sstables_pending_reclaim.pop_front();
+            return with_semaphore(_sstable_deletion_sem, 1, [this, sst] {
+                return sstables::delete_atomically({sst}, *get_large_data_handler());
+            }).then_wrapped([this, sst] (future<> f) {
+                try {
+                    f.get();
+                    ++_sstables_reclaimed;
+                } catch (...) {
+                    tlogger.warn("Failed to reclaim discarded sstable {}: {}. Ignoring, it will be removed on the next start",
+                            sst->toc_filename(), std::current_exception());
+                }
+                return sleep_abortable(reclaim_pause, _sstable_reclaim_abort).handle_exception_type([] (const seastar::sleep_aborted&) {});
+            });
+        }).finally([this] {
+            _sstable_reclaim_active = false;
+        });
+    });
+}
+
 future<int64_t>
 table::disable_sstable_write() {
     _sstable_writes_disabled_at = std::chrono::steady_clock::now();
@@ -2052,7 +2198,14 @@ future<> table::generate_and_propagate_view_updates(const schema_ptr& base,
             flat_mutation_reader_from_mutations({std::move(m)}),
             std::move(existings)).then([this, base_token = std::move(base_token)] (std::vector<frozen_mutation_and_schema>&& updates) mutable {
         auto units = seastar::consume_units(*_config.view_update_concurrency_semaphore, memory_usage_of(updates));
-        db::view::mutate_MV(std::move(base_token), std::move(updates), _view_stats, std::move(units)).handle_exception([] (auto ignored) { });
+        // The updates are pushed in the background; run them in their own
+        // scheduling group so that view fan-out does not compete for CPU
+        // with the foreground writes whose latency we are serving. The
+        // semaphore units above keep the backlog bounded regardless.
+        with_scheduling_group(_config.view_update_scheduling_group,
+                [this, base_token = std::move(base_token), updates = std::move(updates), units = std::move(units)] () mutable {
+            return db::view::mutate_MV(std::move(base_token), std::move(updates), _view_stats, std::move(units));
+        }).handle_exception([] (auto ignored) { });
     });
 }
 
@@ -2215,6 +2368,7 @@ void table::apply_streaming_mutation(schema_ptr m_schema, utils::UUID plan_id, c
     if (tlogger.is_enabled(logging::log_level::trace)) {
         tlogger.trace("streaming apply {}", m.pretty_printer(m_schema));
     }
+    ++_content_epoch;
     if (fragmented) {
         apply_streaming_big_mutation(std::move(m_schema), plan_id, m);
         return;
@@ -2248,6 +2402,7 @@ template<typename... Args>
 void table::do_apply(db::rp_handle&& h, Args&&... args) {
     utils::latency_counter lc;
     _stats.writes.set_latency(lc);
+    ++_content_epoch;
     db::replay_position rp = h;
     check_valid_rp(rp);
     try {
@@ -2270,9 +2425,53 @@ table::apply(const mutation& m, db::rp_handle&& h) {
 
 void
 table::apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& h) {
+    const auto size = m.representation().size();
+    _stats.estimated_write_size.add(size);
+    get_large_data_handler()->maybe_log_large_write(m_schema, m, size);
     do_apply(std::move(h), m, m_schema);
 }
 
+void
+table::apply_batch(const utils::chunked_vector<mutation>& ms, db::rp_handle&& h) {
+    if (ms.empty()) {
+        return;
+    }
+    dht::decorated_key::less_comparator cmp(_schema);
+    for (size_t i = 1; i < ms.size(); ++i) {
+        if (cmp(ms[i].decorated_key(), ms[i - 1].decorated_key())) {
+            throw std::invalid_argument("table::apply_batch(): mutations not sorted by ring position");
+        }
+    }
+    do_apply(std::move(h), ms);
+}
+
+void table::record_flush_encoding_stats(const encoding_stats& stats) {
+    if (_flush_encoding_stats_history.size() >= encoding_stats_history_size) {
+        _flush_encoding_stats_history.pop_front();
+    }
+    _flush_encoding_stats_history.push_back(stats);
+}
+
+encoding_stats table::get_streaming_encoding_stats() const {
+    encoding_stats_collector collector;
+    bool any = false;
+    for (auto& stats : _flush_encoding_stats_history) {
+        collector.update(stats);
+        any = true;
+    }
+    // Also cover the live sstables, so that a base derived from recent
+    // flushes cannot end up above the timestamps of older data the stream
+    // may carry.
+    for (auto& sst : *get_sstables()) {
+        collector.update(sst->get_encoding_stats_for_compaction());
+        any = true;
+    }
+    if (!any) {
+        return encoding_stats{};
+    }
+    return collector.get();
+}
+
 future<>
 write_memtable_to_sstable(memtable& mt, sstables::shared_sstable sst,
                           sstables::write_monitor& monitor, db::large_data_handler* lp_handler,
@@ -2283,8 +2482,12 @@ write_memtable_to_sstable(memtable& mt, sstables::shared_sstable sst,
     cfg.leave_unsealed = leave_unsealed;
     cfg.monitor = &monitor;
     cfg.large_data_handler = lp_handler;
-    return sst->write_components(mt.make_flush_reader(mt.schema(), pc), mt.partition_count(),
-        mt.schema(), cfg, mt.get_encoding_stats(), pc);
+    // Let the flush reader traverse the partition tree and compact the
+    // fragments for the next batch while the writer waits for I/O, so that
+    // flushed memory is also accounted for incrementally rather than in
+    // bursts between writes.
+    return sst->write_components(make_prefetching_reader(mt.make_flush_reader(mt.schema(), pc)),
+        mt.partition_count(), mt.schema(), cfg, mt.get_encoding_stats(), pc);
 }
 
 future<>
@@ -2300,10 +2503,11 @@ struct query_state {
                          const query::read_command& cmd,
                          query::result_options opts,
                          const dht::partition_range_vector& ranges,
-                         query::result_memory_accounter memory_accounter = { })
+                         query::result_memory_accounter memory_accounter = { },
+                         size_t result_size_hint = 0)
             : schema(std::move(s))
             , cmd(cmd)
-            , builder(cmd.slice, opts, std::move(memory_accounter))
+            , builder(cmd.slice, opts, std::move(memory_accounter), result_size_hint)
             , limit(cmd.row_limit)
             , partition_limit(cmd.partition_limit)
             , current_partition_range(ranges.begin())
@@ -2344,15 +2548,60 @@ table::query(schema_ptr s,
              ? memory_limiter.new_digest_read(max_size) : memory_limiter.new_data_read(max_size);
     return f.then([this, lc, s = std::move(s), &cmd, opts, &partition_ranges,
             trace_state = std::move(trace_state), timeout, cache_ctx = std::move(cache_ctx)] (query::result_memory_accounter accounter) mutable {
-        auto qs_ptr = std::make_unique<query_state>(std::move(s), cmd, opts, partition_ranges, std::move(accounter));
+        // Digest-only results stay tiny no matter what the data looks like,
+        // so they neither use nor train the result size estimate.
+        auto result_size_hint = opts.request == query::result_request::only_digest ? 0 : _stats.ewma_result_size;
+        auto qs_ptr = std::make_unique<query_state>(std::move(s), cmd, opts, partition_ranges, std::move(accounter), result_size_hint);
         auto& qs = *qs_ptr;
-        return do_until(std::bind(&query_state::done, &qs), [this, &qs, trace_state = std::move(trace_state), timeout, cache_ctx = std::move(cache_ctx)] {
-            auto&& range = *qs.current_partition_range++;
-            return data_query(qs.schema, as_mutation_source(), range, qs.cmd.slice, qs.remaining_rows(),
-                              qs.remaining_partitions(), qs.cmd.timestamp, qs.builder, trace_state, timeout, cache_ctx);
-        }).then([qs_ptr = std::move(qs_ptr), &qs] {
-            return make_ready_future<lw_shared_ptr<query::result>>(
-                    make_lw_shared<query::result>(qs.builder.build()));
+        future<> reading = make_ready_future<>();
+        // A multi-key IN (...) fan-out arrives as a vector of singular ranges.
+        // Querying them one at a time creates a complete reader stack per key.
+        // Merging them into a single token-ordered pass lets one reader serve
+        // the whole batch, sharing sstable index and filter lookups between
+        // the keys. The merged pass cannot be resumed by the querier cache,
+        // which is fine: paging recomputes the remaining ranges on its own.
+        if (partition_ranges.size() > 1 && boost::algorithm::all_of(partition_ranges, std::mem_fn(&dht::partition_range::is_singular))) {
+            dht::partition_range_vector sorted_ranges(partition_ranges);
+            std::sort(sorted_ranges.begin(), sorted_ranges.end(),
+                    [cmp = dht::ring_position_comparator(*qs.schema)] (const dht::partition_range& a, const dht::partition_range& b) {
+                return cmp(a.start()->value(), b.start()->value()) < 0;
+            });
+            // fast_forward_to() must move strictly forward, so duplicate keys
+            // have to be collapsed.
+            sorted_ranges.erase(std::unique(sorted_ranges.begin(), sorted_ranges.end(),
+                    [cmp = dht::ring_position_comparator(*qs.schema)] (const dht::partition_range& a, const dht::partition_range& b) {
+                return cmp(a.start()->value(), b.start()->value()) == 0;
+            }), sorted_ranges.end());
+            auto ms = mutation_source([source = as_mutation_source(), ranges = std::move(sorted_ranges)] (
+                    schema_ptr s,
+                    const dht::partition_range&,
+                    const query::partition_slice& slice,
+                    const io_priority_class& pc,
+                    tracing::trace_state_ptr trace_state,
+                    streamed_mutation::forwarding fwd,
+                    mutation_reader::forwarding) {
+                assert(fwd == streamed_mutation::forwarding::no);
+                return make_flat_multi_range_reader(std::move(s), source, ranges, slice, pc, std::move(trace_state));
+            });
+            reading = data_query(qs.schema, ms, query::full_partition_range, qs.cmd.slice, qs.remaining_rows(),
+                                 qs.remaining_partitions(), qs.cmd.timestamp, qs.builder, std::move(trace_state), timeout, { });
+        } else {
+            reading = do_until(std::bind(&query_state::done, &qs), [this, &qs, trace_state = std::move(trace_state), timeout, cache_ctx = std::move(cache_ctx)] {
+                auto&& range = *qs.current_partition_range++;
+                return data_query(qs.schema, as_mutation_source(), range, qs.cmd.slice, qs.remaining_rows(),
+                                  qs.remaining_partitions(), qs.cmd.timestamp, qs.builder, trace_state, timeout, cache_ctx);
+            });
+        }
+        return reading.then([this, opts, qs_ptr = std::move(qs_ptr), &qs] {
+            auto result = make_lw_shared<query::result>(qs.builder.build());
+            if (opts.request != query::result_request::only_digest) {
+                // Weight 1/8 to the new sample: stable enough not to be
+                // thrown off by the odd large scan, quick enough to follow
+                // a workload change within a few dozen queries.
+                auto& ewma = _stats.ewma_result_size;
+                ewma = ewma ? (7 * ewma + result->buf().size()) / 8 : result->buf().size();
+            }
+            return make_ready_future<lw_shared_ptr<query::result>>(std::move(result));
         }).finally([lc, this]() mutable {
             _stats.reads.mark(lc);
             if (lc.is_start()) {
@@ -2362,6 +2611,38 @@ table::query(schema_ptr s,
     });
 }
 
+std::vector<bytes> table::cache_key_sample(size_t max) const {
+    std::vector<bytes> keys;
+    if (!_config.enable_cache) {
+        return keys;
+    }
+    for (auto&& dk : _cache.cached_partition_keys(max)) {
+        keys.emplace_back(to_bytes(dk.key().representation()));
+    }
+    return keys;
+}
+
+future<> table::warm_cache_for_key(bytes serialized_key) {
+    if (!_config.enable_cache) {
+        return make_ready_future<>();
+    }
+    auto dk = dht::global_partitioner().decorate_key(*_schema, partition_key::from_bytes(serialized_key));
+    if (dht::shard_of(dk.token()) != engine().cpu_id()) {
+        return make_ready_future<>();
+    }
+    return do_with(dht::partition_range::make_singular(std::move(dk)), [this] (dht::partition_range& range) {
+        auto reader = make_reader(_schema, range, _schema->full_slice(),
+                service::get_local_streaming_read_priority(), nullptr,
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+        return do_with(std::move(reader), [] (flat_mutation_reader& reader) {
+            // One buffer's worth of fragments establishes the head of the
+            // partition in cache, which is what a typical read wants;
+            // pulling in entire partitions could evict more than it warms.
+            return reader.fill_buffer(db::no_timeout);
+        });
+    });
+}
+
 mutation_source
 table::as_mutation_source() const {
     return mutation_source([this] (schema_ptr s,
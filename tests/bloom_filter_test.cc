@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "seastarx.hh"
+#include <seastar/testing/test_case.hh>
+
+#include "utils/bloom_filter.hh"
+#include "utils/i_filter.hh"
+
+using namespace utils;
+
+static bytes make_key(int i) {
+    return to_bytes(format("key{:d}", i));
+}
+
+SEASTAR_TEST_CASE(test_is_present_many_agrees_with_is_present) {
+    for (auto fmt : {filter_format::k_l_format, filter_format::m_format}) {
+        auto f = i_filter::get_filter(1000, 0.01, fmt);
+
+        for (int i = 0; i < 1000; ++i) {
+            f->add(make_key(i));
+        }
+
+        // Probe a mix of present and (mostly) absent keys.
+        std::vector<hashed_key> keys;
+        std::vector<bool> expected;
+        for (int i = 0; i < 2000; ++i) {
+            auto key = make_key(i);
+            keys.push_back(make_hashed_key(key));
+            expected.push_back(f->is_present(keys.back()));
+            BOOST_REQUIRE(i >= 1000 || expected.back());
+        }
+
+        // Batch sizes around and away from the internal chunking.
+        for (size_t batch : {size_t(1), size_t(7), size_t(8), size_t(9), keys.size()}) {
+            std::vector<char> results(batch);
+            for (size_t off = 0; off + batch <= keys.size(); off += batch) {
+                f->is_present_many(keys.data() + off, batch, reinterpret_cast<bool*>(results.data()));
+                for (size_t i = 0; i != batch; ++i) {
+                    BOOST_REQUIRE_EQUAL(bool(results[i]), bool(expected[off + i]));
+                }
+            }
+        }
+    }
+    return make_ready_future<>();
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <map>
+#include <random>
+
+#include "utils/bptree.hh"
+
+// A small node size so that the tests exercise splits and structural
+// shrinking with few elements.
+using tree = utils::bptree<int, int, 4>;
+
+static const std::less<int> less{};
+
+BOOST_AUTO_TEST_CASE(test_insert_and_iterate_sorted) {
+    tree t;
+    BOOST_REQUIRE(t.empty());
+    BOOST_REQUIRE(t.begin() == t.end());
+
+    for (int i = 1000; i-- > 0; ) {
+        auto [it, inserted] = t.insert(i, i * 2, less);
+        BOOST_REQUIRE(inserted);
+        BOOST_REQUIRE_EQUAL(it.key(), i);
+        BOOST_REQUIRE_EQUAL(*it, i * 2);
+    }
+    BOOST_REQUIRE_EQUAL(t.size(), 1000);
+
+    auto [it, inserted] = t.insert(500, 7, less);
+    BOOST_REQUIRE(!inserted);
+    BOOST_REQUIRE_EQUAL(*it, 1000);
+    BOOST_REQUIRE_EQUAL(t.size(), 1000);
+
+    int expected = 0;
+    for (auto i = t.begin(); i != t.end(); ++i) {
+        BOOST_REQUIRE_EQUAL(i.key(), expected);
+        BOOST_REQUIRE_EQUAL(*i, expected * 2);
+        expected++;
+    }
+    BOOST_REQUIRE_EQUAL(expected, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_bounds_and_find) {
+    tree t;
+    for (int i = 0; i < 100; i += 2) {
+        t.insert(i, i, less);
+    }
+
+    BOOST_REQUIRE_EQUAL(t.lower_bound(10, less).key(), 10);
+    BOOST_REQUIRE_EQUAL(t.lower_bound(11, less).key(), 12);
+    BOOST_REQUIRE_EQUAL(t.upper_bound(10, less).key(), 12);
+    BOOST_REQUIRE(t.lower_bound(99, less) == t.end());
+    BOOST_REQUIRE(t.upper_bound(98, less) == t.end());
+
+    BOOST_REQUIRE_EQUAL(t.find(42, less).key(), 42);
+    BOOST_REQUIRE(t.find(43, less) == t.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_erase_to_empty) {
+    tree t;
+    for (int i = 0; i < 1000; i++) {
+        t.insert(i, i, less);
+    }
+    for (int i = 0; i < 1000; i++) {
+        auto it = t.find(i, less);
+        BOOST_REQUIRE(it != t.end());
+        auto next = t.erase(it);
+        if (i != 999) {
+            BOOST_REQUIRE_EQUAL(next.key(), i + 1);
+        } else {
+            BOOST_REQUIRE(next == t.end());
+        }
+    }
+    BOOST_REQUIRE(t.empty());
+    BOOST_REQUIRE(t.begin() == t.end());
+
+    // The tree is reusable after having been fully emptied.
+    t.insert(1, 1, less);
+    BOOST_REQUIRE_EQUAL(t.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_move) {
+    tree t;
+    for (int i = 0; i < 100; i++) {
+        t.insert(i, i, less);
+    }
+
+    tree t2(std::move(t));
+    BOOST_REQUIRE(t.empty());
+    BOOST_REQUIRE_EQUAL(t2.size(), 100);
+
+    tree t3;
+    t3.insert(7, 7, less);
+    t3 = std::move(t2);
+    BOOST_REQUIRE_EQUAL(t3.size(), 100);
+    BOOST_REQUIRE(t3.find(99, less) != t3.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_random_walk) {
+    auto rand = std::default_random_engine();
+    auto key_dist = std::uniform_int_distribution<int>(0, 500);
+    auto op_dist = std::uniform_int_distribution<unsigned>(0, 4);
+
+    tree t;
+    std::map<int, int> m;
+    for (int i = 0; i != 100000; ++i) {
+        auto key = key_dist(rand);
+        switch (op_dist(rand)) {
+        case 0:
+        case 1: {
+            auto r1 = t.insert(key, i, less);
+            auto r2 = m.emplace(key, i);
+            BOOST_REQUIRE_EQUAL(r1.second, r2.second);
+            BOOST_REQUIRE_EQUAL(*r1.first, r2.first->second);
+            break;
+        }
+        case 2: {
+            auto it = t.find(key, less);
+            auto mit = m.find(key);
+            if (mit == m.end()) {
+                BOOST_REQUIRE(it == t.end());
+            } else {
+                t.erase(it);
+                m.erase(mit);
+            }
+            break;
+        }
+        case 3: {
+            auto it = t.lower_bound(key, less);
+            auto mit = m.lower_bound(key);
+            if (mit == m.end()) {
+                BOOST_REQUIRE(it == t.end());
+            } else {
+                BOOST_REQUIRE_EQUAL(it.key(), mit->first);
+                BOOST_REQUIRE_EQUAL(*it, mit->second);
+            }
+            break;
+        }
+        case 4: {
+            auto it = t.upper_bound(key, less);
+            auto mit = m.upper_bound(key);
+            if (mit == m.end()) {
+                BOOST_REQUIRE(it == t.end());
+            } else {
+                BOOST_REQUIRE_EQUAL(it.key(), mit->first);
+            }
+            break;
+        }
+        default:
+            abort();
+        }
+        BOOST_REQUIRE_EQUAL(t.size(), m.size());
+    }
+
+    auto it = t.begin();
+    for (auto&& [key, value] : m) {
+        BOOST_REQUIRE(it != t.end());
+        BOOST_REQUIRE_EQUAL(it.key(), key);
+        BOOST_REQUIRE_EQUAL(*it, value);
+        ++it;
+    }
+    BOOST_REQUIRE(it == t.end());
+}
@@ -322,3 +322,35 @@ BOOST_AUTO_TEST_CASE(test_remove_suffix) {
         test(std::max(a, b), std::min(a, b));
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_release) {
+    auto test = [] (size_t length) {
+        BOOST_TEST_MESSAGE("Testing buffer size " << length);
+
+        auto data = tests::random::get_bytes(length);
+        bytes_view view = data;
+
+        bytes_ostream bo;
+        bo.write(data);
+
+        auto fragments = std::move(bo).release();
+        BOOST_REQUIRE(bo.empty());
+        BOOST_REQUIRE_EQUAL(bo.size(), 0);
+
+        for (auto& fragment : fragments) {
+            BOOST_REQUIRE_LE(fragment.size(), view.size());
+            BOOST_REQUIRE(bytes_view(reinterpret_cast<const int8_t*>(fragment.get()), fragment.size())
+                          == bytes_view(view.data(), fragment.size()));
+            view.remove_prefix(fragment.size());
+        }
+        BOOST_REQUIRE_EQUAL(view.size(), 0);
+
+        // The stream must be reusable after release().
+        bo.write(data);
+        BOOST_REQUIRE(bytes_view(data) == bo.linearize());
+    };
+
+    test(0);
+    test(16);
+    test(1'000'000);
+}
@@ -164,6 +164,36 @@ public:
     exception_safe_class& operator=(exception_safe_class&&) = default;
 };
 
+BOOST_AUTO_TEST_CASE(test_lazy_reserve) {
+    disk_array c; // 128 elements per chunk
+    c.reserve(10000);
+    // A reserve does not allocate the whole capacity up front...
+    BOOST_REQUIRE(c.memory_size() <= 1024);
+    for (uint64_t i = 0; i < 10000; ++i) {
+        c.push_back(i);
+    }
+    // ...and it sizes the tail chunk exactly.
+    BOOST_REQUIRE_EQUAL(c.memory_size(), 10000 * sizeof(uint64_t));
+    for (uint64_t i = 0; i < 10000; ++i) {
+        BOOST_REQUIRE_EQUAL(c[i], i);
+    }
+    c.shrink_to_fit();
+    BOOST_REQUIRE_EQUAL(c.memory_size(), 10000 * sizeof(uint64_t));
+}
+
+BOOST_AUTO_TEST_CASE(test_shrink_to_fit_returns_slack) {
+    disk_array c;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        c.push_back(i);
+    }
+    c.shrink_to_fit();
+    BOOST_REQUIRE_EQUAL(c.memory_size(), 1000 * sizeof(uint64_t));
+    BOOST_REQUIRE_EQUAL(c.size(), 1000);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        BOOST_REQUIRE_EQUAL(c[i], i);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(tests_constructor_exception_safety) {
     auto checker = exception_safety_checker();
     auto v = std::vector<exception_safe_class>(100, exception_safe_class(checker));
@@ -39,7 +39,9 @@
 #include "utils/UUID_gen.hh"
 #include "tmpdir.hh"
 #include "db/commitlog/commitlog.hh"
+#include "db/commitlog/commitlog_extensions.hh"
 #include "db/commitlog/rp_set.hh"
+#include "db/extensions.hh"
 #include "log.hh"
 #include "service/priority_manager.hh"
 
@@ -142,6 +144,45 @@ SEASTAR_TEST_CASE(test_commitlog_new_segment){
     });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_tail_extension_sees_sealed_segments){
+    struct tail_recorder : public db::commitlog_tail_extension {
+        std::vector<std::pair<sstring, db::replay_position>> sealed;
+        void on_segment_sealed(const sstring& filename, const db::replay_position& checkpoint) override {
+            sealed.emplace_back(filename, checkpoint);
+        }
+    };
+    auto recorder = std::make_unique<tail_recorder>();
+    auto* r = recorder.get();
+    auto exts = std::make_unique<db::extensions>();
+    exts->add_commitlog_tail_extension("tail_recorder", std::move(recorder));
+    commitlog::config cfg;
+    cfg.commitlog_segment_size_in_mb = 1;
+    cfg.extensions = exts.get();
+    return cl_test(cfg, [r](commitlog& log) {
+        return do_with(rp_set(), [&log, r](auto& set) {
+            auto uuid = utils::UUID_gen::get_time_UUID();
+            // fill the first segment and roll over to a second one
+            return do_until([&log]() { return log.get_active_segment_names().size() > 1; }, [&log, &set, uuid]() {
+                sstring tmp(sstring::initialized_later(), 16 * 1024);
+                return log.add_mutation(uuid, tmp.size(), [tmp](db::commitlog::output& dst) {
+                    dst.write(tmp.data(), tmp.size());
+                }).then([&set](rp_handle h) {
+                    set.put(std::move(h));
+                });
+            });
+        }).then([&log] {
+            return log.sync_all_segments();
+        }).then([r] {
+            BOOST_REQUIRE(!r->sealed.empty());
+            for (auto& [name, checkpoint] : r->sealed) {
+                BOOST_CHECK(!name.empty());
+                BOOST_CHECK_NE(checkpoint, db::replay_position());
+            }
+        });
+    }).finally([exts = std::move(exts)] {
+    });
+}
+
 typedef std::vector<sstring> segment_names;
 
 static segment_names segment_diff(commitlog& log, segment_names prev = {}) {
@@ -2158,6 +2158,39 @@ APPLY BATCH;)"
     });
 }
 
+SEASTAR_TEST_CASE(test_single_partition_logged_batch_skips_batchlog) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table blog (p1 varchar, c1 int, r1 int, PRIMARY KEY (p1, c1));").get();
+        auto& stats = e.local_qp().get_cql_stats();
+
+        const auto unlogged_before = stats.batches_unlogged_from_logged;
+        const auto logged_before = stats.batches_pure_logged;
+
+        // All statements touch the same partition of the same table, so the
+        // updates merge into a single mutation and the batchlog is skipped;
+        // atomicity is guaranteed by the single mutation apply.
+        e.execute_cql(R"(BEGIN BATCH
+insert into blog (p1, c1, r1) values ('key1', 1, 100);
+insert into blog (p1, c1, r1) values ('key1', 2, 200);
+APPLY BATCH;)").get();
+
+        BOOST_REQUIRE_EQUAL(stats.batches_unlogged_from_logged, unlogged_before + 1);
+        BOOST_REQUIRE_EQUAL(stats.batches_pure_logged, logged_before);
+
+        // Distinct partitions must keep going through the batchlog.
+        e.execute_cql(R"(BEGIN BATCH
+insert into blog (p1, c1, r1) values ('key1', 3, 300);
+insert into blog (p1, c1, r1) values ('key2', 1, 100);
+APPLY BATCH;)").get();
+
+        BOOST_REQUIRE_EQUAL(stats.batches_unlogged_from_logged, unlogged_before + 1);
+        BOOST_REQUIRE_EQUAL(stats.batches_pure_logged, logged_before + 1);
+
+        e.require_column_has_value("blog", {sstring("key1")}, {1}, "r1", 100).get();
+        e.require_column_has_value("blog", {sstring("key2")}, {1}, "r1", 100).get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_in_restriction) {
     return do_with_cql_env([] (cql_test_env& e) {
         return e.execute_cql("create table tir (p1 int, c1 int, r1 int, PRIMARY KEY (p1, c1));").discard_result().then([&e] {
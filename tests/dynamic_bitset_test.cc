@@ -24,6 +24,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/irange.hpp>
+#include <algorithm>
 #include <vector>
 #include <random>
 
@@ -117,6 +118,43 @@ BOOST_AUTO_TEST_CASE(test_find_last_prev) {
     BOOST_REQUIRE_EQUAL(i, 174);
 }
 
+BOOST_AUTO_TEST_CASE(test_rank_select) {
+    for (auto size : { size_t(1), size_t(178), size_t(512), size_t(2000) }) {
+        utils::dynamic_bitset bits(size);
+        std::vector<bool> bv(size, false);
+
+        auto check = [&] {
+            size_t set_bits = 0;
+            for (size_t i = 0; i < size; i++) {
+                BOOST_REQUIRE_EQUAL(bits.rank(i), set_bits);
+                if (bv[i]) {
+                    BOOST_REQUIRE_EQUAL(bits.select(set_bits), i);
+                    set_bits++;
+                }
+            }
+            BOOST_REQUIRE_EQUAL(bits.rank(size), set_bits);
+            BOOST_REQUIRE_EQUAL(bits.count(), set_bits);
+            BOOST_REQUIRE_EQUAL(bits.select(set_bits), utils::dynamic_bitset::npos);
+        };
+
+        check();
+
+        for (size_t i = 0; i < size; i += 3) {
+            bits.set(i);
+            bits.set(i); // redundant sets must not skew the counters
+            bv[i] = true;
+        }
+        check();
+
+        for (size_t i = 0; i < size; i += 6) {
+            bits.clear(i);
+            bits.clear(i);
+            bv[i] = false;
+        }
+        check();
+    }
+}
+
 static void test_random_ops(size_t size, std::random_device& rd ) {
     // BOOST_REQUIRE and friends are very slow, just use regular throws instead.
     auto require = [] (bool b) {
@@ -133,7 +171,7 @@ static void test_random_ops(size_t size, std::random_device& rd ) {
     std::uniform_int_distribution<size_t> global_op_dist(0, size-1);
     std::uniform_int_distribution<size_t> bit_dist(0, size-1);
     std::uniform_int_distribution<int> global_op_selection_dist(0, 1);
-    std::uniform_int_distribution<int> single_op_selection_dist(0, 5);
+    std::uniform_int_distribution<int> single_op_selection_dist(0, 7);
     auto is_set = [&] (size_t i) -> bool {
         return bv[i];
     };
@@ -210,6 +248,27 @@ static void test_random_ops(size_t size, std::random_device& rd ) {
                 }
                 break;
             }
+            case 6: {
+                auto bit = bit_dist(rd);
+                auto r = size_t(std::count(bv.begin(), bv.begin() + bit, true));
+                require_equal(db.rank(bit), r);
+                break;
+            }
+            case 7: {
+                auto nr_set = size_t(std::count(bv.begin(), bv.end(), true));
+                require_equal(db.count(), nr_set);
+                if (nr_set) {
+                    std::uniform_int_distribution<size_t> k_dist(0, nr_set - 1);
+                    auto k = k_dist(rd);
+                    auto pos = db.select(k);
+                    require(pos != db.npos);
+                    require(is_set(pos));
+                    require_equal(db.rank(pos), k);
+                } else {
+                    require_equal(db.select(0), size_t(db.npos));
+                }
+                break;
+            }
             }
         }
     }
@@ -714,6 +714,35 @@ SEASTAR_TEST_CASE(test_make_forwardable) {
     });
 }
 
+SEASTAR_TEST_CASE(test_make_prefetching_reader) {
+    return seastar::async([] {
+        simple_schema s;
+
+        auto keys = s.make_pkeys(10);
+
+        auto ms = boost::copy_range<std::vector<mutation>>(keys | boost::adaptors::transformed([&] (auto& key) {
+            auto m = mutation(s.schema(), key);
+            for (auto n : boost::irange(0, 3)) {
+                m.apply(s.make_row(s.make_ckey(n), "value"));
+            }
+            return m;
+        }));
+
+        // Use a small buffer so that the stream spans many background fills.
+        auto underlying = flat_mutation_reader_from_mutations(ms);
+        underlying.set_max_buffer_size(1);
+        auto rd = assert_that(make_prefetching_reader(std::move(underlying)));
+        for (auto& m : ms) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+
+        // Abandoning the reader with a background fill in flight must be safe.
+        auto rd2 = make_prefetching_reader(flat_mutation_reader_from_mutations(ms));
+        rd2.fill_buffer(db::no_timeout).get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_abandoned_flat_mutation_reader_from_mutation) {
     return seastar::async([] {
         for_each_mutation([&] (const mutation& m) {
@@ -316,6 +316,47 @@ SEASTAR_TEST_CASE(test_loading_cache_loading_reloading) {
     });
 }
 
+static thread_local int slow_load_attempts;
+static future<sstring> slow_loader(const int& k) {
+    ++slow_load_attempts;
+    return seastar::sleep(std::chrono::milliseconds(100)).then([k = k] {
+        return loader(k);
+    });
+}
+
+SEASTAR_TEST_CASE(test_loading_cache_stale_while_revalidate) {
+    return seastar::async([] {
+        using namespace std::chrono;
+        load_count = 0;
+        slow_load_attempts = 0;
+        utils::loading_cache<int, sstring, utils::loading_cache_reload_enabled::yes> loading_cache(num_loaders, 1s, 20ms, test_logger, slow_loader);
+        auto stop_cache_reload = seastar::defer([&loading_cache] { loading_cache.stop().get(); });
+
+        prepare().get();
+
+        loading_cache.get_ptr(0).discard_result().get();
+        BOOST_REQUIRE_EQUAL(load_count, 1);
+
+        // Let the value become stale.
+        sleep(30ms).get();
+
+        // Reads of a stale value must be served immediately from the cached value
+        // even though its reload takes 100ms, and concurrent reads must piggyback
+        // on a single in-flight reload.
+        auto start = steady_clock::now();
+        std::vector<future<>> reads;
+        for (int i = 0; i < 10; ++i) {
+            reads.emplace_back(loading_cache.get_ptr(0).discard_result());
+        }
+        when_all(reads.begin(), reads.end()).get();
+        BOOST_REQUIRE(steady_clock::now() - start < 100ms);
+        BOOST_REQUIRE_LE(slow_load_attempts, 2);
+
+        // The background reload eventually refreshes the value.
+        BOOST_REQUIRE(eventually_true([&] { return load_count >= 2; }));
+    });
+}
+
 SEASTAR_TEST_CASE(test_loading_cache_max_size_eviction) {
     return seastar::async([] {
         using namespace std::chrono;
@@ -101,6 +101,95 @@ SEASTAR_TEST_CASE(test_compaction) {
 }
 
 
+SEASTAR_TEST_CASE(test_compaction_can_be_disabled_per_region) {
+    return seastar::async([] {
+        region reg;
+
+        with_allocator(reg.allocator(), [&reg] {
+            std::vector<managed_ref<int>> _allocated;
+
+            for (int i = 0; i < 32 * 1024 * 4; i++) {
+                _allocated.push_back(make_managed<int>());
+            }
+
+            shard_tracker().reclaim_all_free_segments();
+
+            // Free 1/3 randomly to make the region compactible
+
+            std::random_device random_device;
+            std::default_random_engine random(random_device());
+            std::shuffle(_allocated.begin(), _allocated.end(), random);
+
+            auto it = _allocated.begin();
+            size_t nr_freed = _allocated.size() / 3;
+            for (size_t i = 0; i < nr_freed; ++i) {
+                *it++ = {};
+            }
+
+            BOOST_REQUIRE(reg.compaction_enabled());
+            reg.set_compaction_enabled(false);
+
+            // With compaction disabled, reclaim must not move objects in
+            // the region.
+            auto reclaim_counter_1 = reg.reclaim_counter();
+            size_t target = sizeof(managed<int>) * nr_freed;
+            shard_tracker().reclaim(target);
+            BOOST_REQUIRE_EQUAL(reg.reclaim_counter(), reclaim_counter_1);
+
+            // Re-enabling makes the space reclaimable again.
+            reg.set_compaction_enabled(true);
+            BOOST_REQUIRE(shard_tracker().reclaim(target) >= target);
+            BOOST_REQUIRE(reg.reclaim_counter() != reclaim_counter_1);
+        });
+    });
+}
+
+SEASTAR_TEST_CASE(test_region_pin_blocks_compaction) {
+    return seastar::async([] {
+        region reg;
+
+        with_allocator(reg.allocator(), [&reg] {
+            std::vector<managed_ref<int>> _allocated;
+
+            for (int i = 0; i < 32 * 1024 * 4; i++) {
+                _allocated.push_back(make_managed<int>());
+            }
+
+            shard_tracker().reclaim_all_free_segments();
+
+            // Free 1/3 randomly to make the region compactible
+
+            std::random_device random_device;
+            std::default_random_engine random(random_device());
+            std::shuffle(_allocated.begin(), _allocated.end(), random);
+
+            auto it = _allocated.begin();
+            size_t nr_freed = _allocated.size() / 3;
+            for (size_t i = 0; i < nr_freed; ++i) {
+                *it++ = {};
+            }
+
+            size_t target = sizeof(managed<int>) * nr_freed;
+            auto reclaim_counter_1 = reg.reclaim_counter();
+            {
+                logalloc::region_pin pin1(reg);
+                // Pins count, an overlapping pin must keep the region pinned
+                // after the inner one goes away.
+                {
+                    logalloc::region_pin pin2(reg);
+                }
+                BOOST_REQUIRE(reg.is_pinned());
+                shard_tracker().reclaim(target);
+                BOOST_REQUIRE_EQUAL(reg.reclaim_counter(), reclaim_counter_1);
+            }
+
+            BOOST_REQUIRE(!reg.is_pinned());
+            BOOST_REQUIRE(shard_tracker().reclaim(target) >= target);
+            BOOST_REQUIRE(reg.reclaim_counter() != reclaim_counter_1);
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_compaction_with_multiple_regions) {
     return seastar::async([] {
         region reg1;
@@ -278,6 +367,41 @@ SEASTAR_TEST_CASE(test_blob) {
     });
 }
 
+SEASTAR_TEST_CASE(test_blob_equality) {
+    return seastar::async([] {
+        region reg;
+        with_allocator(reg.allocator(), [&] {
+            auto src = bytes(bytes::initialized_later(), 128);
+            std::fill(src.begin(), src.end(), 'a');
+
+            managed_bytes b1(src);
+            managed_bytes b2(src);
+
+            BOOST_REQUIRE(b1 == b2);
+
+            // Differs within the cached prefix
+            auto src2 = src;
+            src2[3] = 'b';
+            BOOST_REQUIRE(b1 != managed_bytes(src2));
+
+            // Differs past the cached prefix
+            auto src3 = src;
+            src3[100] = 'b';
+            BOOST_REQUIRE(b1 != managed_bytes(src3));
+
+            // Mutation through mutable access must be visible to comparison
+            b2[3] = 'b';
+            BOOST_REQUIRE(b1 != b2);
+            b1[3] = 'b';
+            BOOST_REQUIRE(b1 == b2);
+
+            reg.full_compaction();
+
+            BOOST_REQUIRE(b1 == b2);
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_merging) {
     return seastar::async([] {
         region reg1;
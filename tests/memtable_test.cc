@@ -168,6 +168,160 @@ SEASTAR_TEST_CASE(test_memtable_flush_reader) {
     });
 }
 
+SEASTAR_TEST_CASE(test_lazily_merged_overwrites) {
+    return seastar::async([] {
+        auto s = schema_builder("ks", "cf")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("v1", bytes_type, column_kind::regular_column)
+                .with_column("v2", bytes_type, column_kind::regular_column)
+                .build();
+
+        auto mt = make_lw_shared<memtable>(s);
+
+        auto expected = make_unique_mutation(s);
+        // More overwrites than the version chain cap, so that both the
+        // append path and the merge-on-overflow path are exercised.
+        for (int i = 0; i < 20; ++i) {
+            auto update = mutation(s, expected.decorated_key());
+            set_column(update, i % 2 ? "v1" : "v2");
+            mt->apply(update);
+            expected.apply(update);
+        }
+
+        assert_that(mt->make_flat_reader(s))
+            .produces(expected)
+            .produces_end_of_stream();
+
+        logalloc::shard_tracker().full_compaction();
+
+        assert_that(mt->make_flat_reader(s))
+            .produces(expected)
+            .produces_end_of_stream();
+    });
+}
+
+SEASTAR_TEST_CASE(test_memtable_to_memtable_apply) {
+    return seastar::async([] {
+        schema_ptr s = schema_builder("ks", "cf")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("col", bytes_type, column_kind::regular_column)
+                .build();
+
+        // Enough partitions to exercise the batching in apply(memtable&).
+        std::vector<mutation> ring = make_ring(s, 100);
+        for (auto&& m : ring) {
+            set_column(m, "col");
+        }
+
+        auto mt1 = make_lw_shared<memtable>(s);
+        auto mt2 = make_lw_shared<memtable>(s);
+        for (auto& m : ring) {
+            mt1->apply(m);
+        }
+        // Some partitions already present in the target, so that both the
+        // merge and the insert paths are taken.
+        for (size_t i = 0; i < ring.size(); i += 2) {
+            set_column(ring[i], "col");
+            mt2->apply(ring[i]);
+        }
+
+        mt2->apply(*mt1).get();
+
+        auto rd = assert_that(mt2->make_flat_reader(s));
+        for (auto& m : ring) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
+
+SEASTAR_TEST_CASE(test_sorted_batch_apply) {
+    return seastar::async([] {
+        schema_ptr s = schema_builder("ks", "cf")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("col", bytes_type, column_kind::regular_column)
+                .build();
+
+        std::vector<mutation> ring = make_ring(s, 100);
+
+        auto mt = make_lw_shared<memtable>(s);
+        // Pre-populate every fourth partition, so the batch both merges into
+        // existing entries and inserts new ones.
+        for (size_t i = 0; i < ring.size(); i += 4) {
+            set_column(ring[i], "col");
+            mt->apply(ring[i]);
+        }
+
+        utils::chunked_vector<mutation> batch;
+        for (size_t i = 0; i < ring.size(); ++i) {
+            auto update = mutation(s, ring[i].decorated_key());
+            set_column(update, "col");
+            ring[i].apply(update);
+            batch.push_back(std::move(update));
+            if (i % 3 == 0) {
+                // Duplicate keys within the batch are allowed.
+                auto dup = mutation(s, ring[i].decorated_key());
+                set_column(dup, "col");
+                ring[i].apply(dup);
+                batch.push_back(std::move(dup));
+            }
+        }
+
+        mt->apply(batch);
+
+        auto rd = assert_that(mt->make_flat_reader(s));
+        for (auto& m : ring) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
+
+SEASTAR_TEST_CASE(test_scanning_reader_pins_region_contents) {
+    return seastar::async([] {
+        schema_ptr s = schema_builder("ks", "cf")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("col", bytes_type, column_kind::regular_column)
+                .build();
+
+        std::vector<mutation> ring = make_ring(s, 10);
+        for (auto&& m : ring) {
+            set_column(m, "col");
+        }
+
+        auto mt = make_lw_shared<memtable>(s);
+        for (auto& m : ring) {
+            mt->apply(m);
+        }
+
+        {
+            auto rd = assert_that(mt->make_flat_reader(s));
+            rd.produces(ring[0]);
+
+            // While the reader is alive, compaction must not move the
+            // region's contents.
+            auto counter = mt->region().reclaim_counter();
+            logalloc::shard_tracker().full_compaction();
+            BOOST_REQUIRE_EQUAL(mt->region().reclaim_counter(), counter);
+
+            for (size_t i = 1; i < ring.size(); ++i) {
+                rd.produces(ring[i]);
+            }
+            rd.produces_end_of_stream();
+        }
+
+        // With no readers left the region is compactible again, and reads
+        // still see all the data afterwards.
+        BOOST_REQUIRE(!mt->region().is_pinned());
+        logalloc::shard_tracker().full_compaction();
+        auto rd = assert_that(mt->make_flat_reader(s));
+        for (auto& m : ring) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(test_adding_a_column_during_reading_doesnt_affect_read_result) {
     return seastar::async([] {
         auto common_builder = schema_builder("ks", "cf")
@@ -122,3 +122,28 @@ BOOST_AUTO_TEST_CASE(test_hash_output) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_batch_hash_output) {
+    auto assert_hashes_equal = [] (bytes_view data, std::array<uint64_t,2> lhs, std::array<uint64_t,2> rhs) {
+        if (lhs != rhs) {
+            BOOST_FAIL(format("Hashes differ for {} (got {{0x{:x}, 0x{:x}}} and {{0x{:x}, 0x{:x}}})", data,
+                lhs[0], lhs[1], rhs[0], rhs[1]));
+        }
+    };
+
+    // Lanes get prefixes of different lengths, so they run out of full
+    // blocks at different iterations and exercise the per-lane leftovers.
+    for (size_t i = 0; i + 4 <= full_sequence.size(); ++i) {
+        std::array<bytes_view, 4> keys;
+        for (size_t lane = 0; lane < 4; ++lane) {
+            keys[lane] = bytes_view(full_sequence.begin(), i + lane);
+        }
+
+        std::array<std::array<uint64_t, 2>, 4> dst;
+        utils::murmur_hash::hash3_x64_128_batch(keys, seed, dst);
+
+        for (size_t lane = 0; lane < 4; ++lane) {
+            assert_hashes_equal(keys[lane], dst[lane], prefix_hashes[i + lane]);
+        }
+    }
+}
@@ -112,6 +112,43 @@ SEASTAR_TEST_CASE(test_combining_two_partially_overlapping_readers) {
     });
 }
 
+SEASTAR_TEST_CASE(test_combining_readers_with_disjoint_clustering_runs) {
+    return seastar::async([] {
+        // Overlapping partitions, but within each partition every reader owns
+        // a long contiguous run of clustering keys. This drives the merger
+        // into gallop mode and back at every run boundary.
+        simple_schema s;
+        auto pkeys = s.make_pkeys(2);
+
+        std::vector<mutation> first;
+        std::vector<mutation> second;
+        std::vector<mutation> combined;
+        for (auto& pkey : pkeys) {
+            mutation m1(s.schema(), pkey);
+            for (auto i = 0; i < 50; i++) {
+                m1.apply(s.make_row(s.make_ckey(i), "first"));
+            }
+            mutation m2(s.schema(), pkey);
+            for (auto i = 50; i < 100; i++) {
+                m2.apply(s.make_row(s.make_ckey(i), "second"));
+            }
+            auto m = m1;
+            m.apply(m2);
+            first.push_back(std::move(m1));
+            second.push_back(std::move(m2));
+            combined.push_back(std::move(m));
+        }
+
+        auto rd = assert_that(make_combined_reader(s.schema(),
+                flat_mutation_reader_from_mutations(std::move(first)),
+                flat_mutation_reader_from_mutations(std::move(second))));
+        for (auto& m : combined) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(test_combining_one_reader_with_many_partitions) {
     return seastar::async([] {
         auto s = make_schema();
@@ -324,6 +361,44 @@ SEASTAR_TEST_CASE(test_fast_forwarding_combining_reader) {
     });
 }
 
+SEASTAR_TEST_CASE(test_flat_multi_range_reader) {
+    return seastar::async([] {
+        auto s = make_schema();
+
+        auto keys = generate_keys(s, 6);
+        auto ring = to_ring_positions(keys);
+
+        auto ms = boost::copy_range<std::vector<mutation>>(keys | boost::adaptors::transformed([&] (auto& key) {
+            return make_mutation_with_key(s, key);
+        }));
+
+        auto source = mutation_source([&ms] (schema_ptr, const dht::partition_range& range, const query::partition_slice&) {
+            return flat_mutation_reader_from_mutations(ms, range);
+        });
+
+        auto singular_ranges = dht::partition_range_vector{
+            dht::partition_range::make_singular(ring[0]),
+            dht::partition_range::make_singular(ring[2]),
+            dht::partition_range::make_singular(ring[5]),
+        };
+        assert_that(make_flat_multi_range_reader(s, source, std::move(singular_ranges), s->full_slice()))
+            .produces(keys[0])
+            .produces(keys[2])
+            .produces(keys[5])
+            .produces_end_of_stream();
+
+        auto mixed_ranges = dht::partition_range_vector{
+            dht::partition_range::make(ring[0], ring[1]),
+            dht::partition_range::make_singular(ring[4]),
+        };
+        assert_that(make_flat_multi_range_reader(s, source, std::move(mixed_ranges), s->full_slice()))
+            .produces(keys[0])
+            .produces(keys[1])
+            .produces(keys[4])
+            .produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(test_sm_fast_forwarding_combining_reader) {
     return seastar::async([] {
         storage_service_for_tests ssft;
@@ -1065,6 +1065,18 @@ SEASTAR_TEST_CASE(test_mutation_hash) {
             };
             test_with_hasher(md5_hasher());
             test_with_hasher(xx_hasher());
+            test_with_hasher(xx_hasher_wide());
+
+            // digester substitutes xx_hasher_wide for the xxHash digest
+            // algorithm, so it must produce exactly the same digest as
+            // xx_hasher.
+            auto get_xx_hash = [&] (auto hasher, const mutation& m) {
+                feed_hash(hasher, m);
+                return hasher.finalize();
+            };
+            if (get_xx_hash(xx_hasher(), m1) != get_xx_hash(xx_hasher_wide(), m1)) {
+                BOOST_FAIL(format("xx_hasher_wide produced a different digest for {}", m1));
+            }
         });
     });
 }
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+
+#include "utils/object_pool.hh"
+
+struct pooled_thing {
+    static unsigned constructions;
+    static unsigned destructions;
+
+    int value;
+    bool idle = false;
+
+    explicit pooled_thing(int v) : value(v) { constructions++; }
+    ~pooled_thing() { destructions++; }
+
+    void reset() noexcept {
+        value = 0;
+        idle = true;
+    }
+    void reset(int v) {
+        value = v;
+        idle = false;
+    }
+};
+
+unsigned pooled_thing::constructions = 0;
+unsigned pooled_thing::destructions = 0;
+
+BOOST_AUTO_TEST_CASE(test_reuse) {
+    utils::object_pool<pooled_thing> pool(2);
+    auto base_constructions = pooled_thing::constructions;
+
+    pooled_thing* first;
+    {
+        auto p = pool.allocate(42);
+        first = p.get();
+        BOOST_REQUIRE_EQUAL(p->value, 42);
+        BOOST_REQUIRE_EQUAL(pool.stats().hits, 0);
+    }
+    BOOST_REQUIRE_EQUAL(pool.pooled(), 1);
+    BOOST_REQUIRE(first->idle);
+
+    {
+        auto p = pool.allocate(7);
+        BOOST_REQUIRE_EQUAL(p.get(), first);
+        BOOST_REQUIRE_EQUAL(p->value, 7);
+        BOOST_REQUIRE(!p->idle);
+        BOOST_REQUIRE_EQUAL(pool.stats().hits, 1);
+        BOOST_REQUIRE_EQUAL(pool.pooled(), 0);
+    }
+
+    BOOST_REQUIRE_EQUAL(pooled_thing::constructions - base_constructions, 1);
+    BOOST_REQUIRE_EQUAL(pool.stats().allocations, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded) {
+    utils::object_pool<pooled_thing> pool(2);
+    auto base_destructions = pooled_thing::destructions;
+
+    {
+        auto a = pool.allocate(1);
+        auto b = pool.allocate(2);
+        auto c = pool.allocate(3);
+    }
+    // Only two fit in the pool, the third was deleted.
+    BOOST_REQUIRE_EQUAL(pool.pooled(), 2);
+    BOOST_REQUIRE_EQUAL(pool.stats().discards, 1);
+    BOOST_REQUIRE_EQUAL(pooled_thing::destructions - base_destructions, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_destruction_frees_pooled_objects) {
+    auto base_destructions = pooled_thing::destructions;
+    {
+        utils::object_pool<pooled_thing> pool(4);
+        auto a = pool.allocate(1);
+        auto b = pool.allocate(2);
+    }
+    BOOST_REQUIRE_EQUAL(pooled_thing::destructions - base_destructions, 2);
+}
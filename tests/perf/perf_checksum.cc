@@ -23,6 +23,8 @@
 #include "sstables/checksum_utils.hh"
 #include "tests/make_random_string.hh"
 #include "utils/gz/crc_combine.hh"
+#include "md5_hasher.hh"
+#include "xx_hasher.hh"
 
 #include <seastar/tests/perf/perf_tests.hh>
 
@@ -67,3 +69,52 @@ PERF_TEST_F(crc_test, perf_zlib_crc32_checksum) {
     perf_tests::do_not_optimize(
         zlib_crc32_checksummer::checksum(data.data(), data.size()));
 }
+
+// Digest reads hash a query::result as a long sequence of small cell
+// values, not as one big buffer, so the digest benchmarks feed the
+// hashers both ways: cell-sized updates mimic the digester update
+// pattern, the bulk updates give the upper bound of the hash kernel.
+struct digest_test {
+    static constexpr size_t cell_size = 8;
+    const sstring data = make_random_string(64*1024);
+
+    template<typename Hasher>
+    std::array<uint8_t, 16> hash_cells() {
+        Hasher h;
+        for (size_t off = 0; off < data.size(); off += cell_size) {
+            h.update(data.data() + off, cell_size);
+        }
+        return h.finalize_array();
+    }
+
+    template<typename Hasher>
+    std::array<uint8_t, 16> hash_bulk() {
+        Hasher h;
+        h.update(data.data(), data.size());
+        return h.finalize_array();
+    }
+};
+
+PERF_TEST_F(digest_test, perf_md5_digest_cells) {
+    perf_tests::do_not_optimize(hash_cells<md5_hasher>());
+}
+
+PERF_TEST_F(digest_test, perf_xx_digest_cells) {
+    perf_tests::do_not_optimize(hash_cells<xx_hasher>());
+}
+
+PERF_TEST_F(digest_test, perf_xx_wide_digest_cells) {
+    perf_tests::do_not_optimize(hash_cells<xx_hasher_wide>());
+}
+
+PERF_TEST_F(digest_test, perf_md5_digest_bulk) {
+    perf_tests::do_not_optimize(hash_bulk<md5_hasher>());
+}
+
+PERF_TEST_F(digest_test, perf_xx_digest_bulk) {
+    perf_tests::do_not_optimize(hash_bulk<xx_hasher>());
+}
+
+PERF_TEST_F(digest_test, perf_xx_wide_digest_bulk) {
+    perf_tests::do_not_optimize(hash_bulk<xx_hasher_wide>());
+}
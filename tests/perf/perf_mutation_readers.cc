@@ -39,11 +39,13 @@ class combined {
     std::vector<mutation> _single;
     std::vector<std::vector<mutation>> _disjoint_interleaved;
     std::vector<std::vector<mutation>> _disjoint_ranges;
+    std::vector<std::vector<mutation>> _disjoint_clustering;
 private:
     static std::vector<mutation> create_one_row(simple_schema&);
     static std::vector<mutation> create_single_stream(simple_schema&);
     static std::vector<std::vector<mutation>> create_disjoint_interleaved_streams(simple_schema&);
     static std::vector<std::vector<mutation>> create_disjoint_ranges_streams(simple_schema&);
+    static std::vector<std::vector<mutation>> create_disjoint_clustering_streams(simple_schema&);
 protected:
     simple_schema& schema() const { return _schema; }
     const std::vector<mutation>& one_row_stream() const { return _one_row; }
@@ -54,6 +56,9 @@ protected:
     const std::vector<std::vector<mutation>>& disjoint_ranges_streams() const {
         return _disjoint_ranges;
     }
+    const std::vector<std::vector<mutation>>& disjoint_clustering_streams() const {
+        return _disjoint_clustering;
+    }
     future<> consume_all(flat_mutation_reader mr) const;
 public:
     combined()
@@ -61,6 +66,7 @@ public:
         , _single(create_single_stream(_schema))
         , _disjoint_interleaved(create_disjoint_interleaved_streams(_schema))
         , _disjoint_ranges(create_disjoint_ranges_streams(_schema))
+        , _disjoint_clustering(create_disjoint_clustering_streams(_schema))
     { }
 };
 
@@ -118,6 +124,28 @@ std::vector<std::vector<mutation>> combined::create_disjoint_ranges_streams(simp
     return mss;
 }
 
+// All streams share the same partitions, but within each partition every
+// stream owns a contiguous, disjoint run of clustering keys. This is the
+// shape L0 sstables produce for clustered workloads and exercises the
+// merger's gallop mode.
+std::vector<std::vector<mutation>> combined::create_disjoint_clustering_streams(simple_schema& s)
+{
+    auto pkeys = s.make_pkeys(32);
+    std::vector<std::vector<mutation>> mss;
+    for (auto i = 0; i < 4; i++) {
+        std::vector<mutation> ms;
+        for (auto& dkey : pkeys) {
+            auto m = mutation(s.schema(), dkey);
+            for (auto j = 0; j < 16; j++) {
+                m.apply(s.make_row(s.make_ckey(i * 16 + j), "value"));
+            }
+            ms.emplace_back(std::move(m));
+        }
+        mss.emplace_back(std::move(ms));
+    }
+    return mss;
+}
+
 future<> combined::consume_all(flat_mutation_reader mr) const
 {
     return do_with(std::move(mr), [] (auto& mr) {
@@ -183,6 +211,18 @@ PERF_TEST_F(combined, disjoint_ranges)
     ));
 }
 
+PERF_TEST_F(combined, disjoint_clustering)
+{
+    return consume_all(make_combined_reader(schema().schema(),
+        boost::copy_range<std::vector<flat_mutation_reader>>(
+            disjoint_clustering_streams()
+            | boost::adaptors::transformed([] (auto&& ms) {
+                return flat_mutation_reader_from_mutations(std::move(ms));
+            })
+        )
+    ));
+}
+
 class memtable {
     static constexpr size_t partition_count = 1000;
     static constexpr size_t row_count = 50;
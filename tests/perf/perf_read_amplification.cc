@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Read path benchmark parameterized by sstable topology.
+//
+// perf_fast_forward measures iteration patterns against a single dataset;
+// this harness instead constructs sstable layouts that mimic what the
+// compaction strategies leave on disk and measures point, slice and scan
+// latency distributions against each:
+//
+//   l0_spike     N sstables all covering the full partition and clustering
+//                ranges, as after a flush storm that STCS has not yet
+//                digested. Every read touches all N sstables.
+//
+//   lcs_steady   N sstables with disjoint partition ranges, as in a
+//                steady-state leveled run. Point reads should touch one
+//                sstable plus bloom filter checks.
+//
+//   twcs_window  N sstables all covering every partition but with disjoint
+//                clustering ranges, as in a time-series table where the
+//                clustering key is a timestamp. Slices should be able to
+//                exclude windows via the promoted index.
+//
+// Sstables are written directly and injected into a column_family with the
+// cache disabled, so the measured latencies reflect sstable read
+// amplification rather than cache hit rates. The --tombstone-fraction
+// option replaces that fraction of the generated rows with row tombstones
+// to expose the cost of tombstone-heavy workloads.
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/thread.hh>
+#include <random>
+
+#include "tests/sstable_utils.hh"
+#include "tests/sstable_test.hh"
+#include "partition_slice_builder.hh"
+#include "reader_concurrency_semaphore.hh"
+#include "sstables/compaction_manager.hh"
+#include "db/large_data_handler.hh"
+#include "db/timeout_clock.hh"
+
+using namespace sstables;
+
+enum class layout_type {
+    l0_spike,
+    lcs_steady,
+    twcs_window,
+};
+
+static std::unordered_map<sstring, layout_type> layout_names = {
+    {"l0-spike", layout_type::l0_spike},
+    {"lcs-steady", layout_type::lcs_steady},
+    {"twcs-window", layout_type::twcs_window},
+};
+
+struct test_config {
+    layout_type layout;
+    unsigned partitions;
+    unsigned rows_per_partition;
+    unsigned sstables;
+    unsigned value_size;
+    double tombstone_fraction;
+    unsigned point_reads;
+    unsigned slice_reads;
+    unsigned slice_width;
+    unsigned scans;
+};
+
+static const char* layout_name(layout_type layout) {
+    for (auto& [name, l] : layout_names) {
+        if (l == layout) {
+            return name.c_str();
+        }
+    }
+    abort();
+}
+
+std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
+    return os << "{layout=" << layout_name(cfg.layout)
+           << ", partitions=" << cfg.partitions
+           << ", rows-per-partition=" << cfg.rows_per_partition
+           << ", sstables=" << cfg.sstables
+           << ", value-size=" << cfg.value_size
+           << ", tombstone-fraction=" << cfg.tombstone_fraction
+           << "}";
+}
+
+// Keeps the objects a column_family depends on alive for the duration
+// of the test. Reads bypass the cache so that sstables are always hit.
+struct table_for_tests {
+    schema_ptr s;
+    cache_tracker tracker;
+    cell_locker_stats cl_stats;
+    compaction_manager cm;
+    reader_concurrency_semaphore read_semaphore;
+    db::nop_large_data_handler large_data_handler;
+    column_family::config cfg;
+    lw_shared_ptr<column_family> cf;
+
+    explicit table_for_tests(schema_ptr s)
+        : s(s)
+        , read_semaphore(100, 4 * 1024 * 1024)
+    {
+        cfg.enable_disk_writes = false;
+        cfg.enable_commitlog = false;
+        cfg.enable_cache = false;
+        cfg.large_data_handler = &large_data_handler;
+        cfg.read_concurrency_semaphore = &read_semaphore;
+        cfg.streaming_read_concurrency_semaphore = &read_semaphore;
+        cf = make_lw_shared<column_family>(s, cfg, column_family::no_commitlog(), cm, cl_stats, tracker);
+        cf->mark_ready_for_writes();
+    }
+
+    column_family& operator*() { return *cf; }
+    column_family* operator->() { return cf.get(); }
+};
+
+static schema_ptr make_test_schema() {
+    return schema_builder("ks", "cf")
+        .with_column("pk", bytes_type, column_kind::partition_key)
+        .with_column("ck", int32_type, column_kind::clustering_key)
+        .with_column("v", bytes_type)
+        .build();
+}
+
+static uint64_t consume_all(flat_mutation_reader& rd) {
+    uint64_t fragments = 0;
+    while (rd(db::no_timeout).get0()) {
+        ++fragments;
+    }
+    return fragments;
+}
+
+// Generates the mutations belonging to sstable number `sst_idx` of the
+// configured layout and timestamp ordering (later sstables are newer).
+static std::vector<mutation> make_sstable_content(schema_ptr s, const test_config& cfg,
+        const std::vector<dht::decorated_key>& keys, unsigned sst_idx, std::mt19937& rnd) {
+    unsigned first_key = 0;
+    unsigned last_key = cfg.partitions;
+    unsigned first_row = 0;
+    unsigned last_row = cfg.rows_per_partition;
+    switch (cfg.layout) {
+    case layout_type::l0_spike:
+        break;
+    case layout_type::lcs_steady:
+        first_key = cfg.partitions * sst_idx / cfg.sstables;
+        last_key = cfg.partitions * (sst_idx + 1) / cfg.sstables;
+        break;
+    case layout_type::twcs_window:
+        first_row = cfg.rows_per_partition * sst_idx / cfg.sstables;
+        last_row = cfg.rows_per_partition * (sst_idx + 1) / cfg.sstables;
+        break;
+    }
+
+    auto& v_def = *s->get_column_definition("v");
+    auto value = bytes(bytes::initialized_later(), cfg.value_size);
+    std::generate(value.begin(), value.end(), [&rnd] { return rnd(); });
+    auto ts = api::timestamp_type(1) + sst_idx;
+    auto tomb = tombstone(ts, gc_clock::now());
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    std::vector<mutation> muts;
+    muts.reserve(last_key - first_key);
+    for (unsigned k = first_key; k < last_key; ++k) {
+        mutation m(s, keys[k]);
+        for (unsigned r = first_row; r < last_row; ++r) {
+            auto ck = clustering_key::from_singular(*s, int32_t(r));
+            if (dist(rnd) < cfg.tombstone_fraction) {
+                m.partition().apply_delete(*s, ck, tomb);
+            } else {
+                m.set_clustered_cell(ck, v_def, atomic_cell::make_live(*bytes_type, ts, value));
+            }
+        }
+        muts.push_back(std::move(m));
+    }
+    return muts;
+}
+
+static void build_layout(table_for_tests& t, const test_config& cfg, const sstring& dir,
+        const std::vector<dht::decorated_key>& keys, std::mt19937& rnd) {
+    for (unsigned i = 0; i < cfg.sstables; ++i) {
+        auto muts = make_sstable_content(t.s, cfg, keys, i, rnd);
+        auto mt = make_lw_shared<memtable>(t.s);
+        std::size_t applied = 0;
+        for (auto&& m : muts) {
+            mt->apply(m);
+            if (++applied % 10 == 0) {
+                seastar::thread::yield();
+            }
+        }
+        auto sst = sstables::make_sstable(t.s, dir, i + 1, la, big);
+        write_memtable_to_sstable_for_test(*mt, sst).get();
+        sst->open_data().get();
+        column_family_test(t.cf).add_sstable(sst);
+    }
+}
+
+static void print_latencies(const sstring& name, std::vector<double> latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&] (double p) {
+        return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))];
+    };
+    std::cout << format("{:<8} n={:<7d} min={:>9.1f} median={:>9.1f} p95={:>9.1f} p99={:>9.1f} max={:>9.1f} [us]\n",
+            name, latencies.size(), latencies.front(), pct(0.5), pct(0.95), pct(0.99), latencies.back());
+}
+
+template <typename Op>
+static std::vector<double> measure(unsigned n, Op&& op) {
+    std::vector<double> latencies;
+    latencies.reserve(n);
+    for (unsigned i = 0; i < n; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        op(i);
+        std::chrono::duration<double, std::micro> d = std::chrono::steady_clock::now() - start;
+        latencies.push_back(d.count());
+    }
+    return latencies;
+}
+
+static void run_test(const test_config& cfg) {
+    auto s = make_test_schema();
+    storage_service_for_tests ssft;
+    tmpdir dir;
+    table_for_tests t(s);
+
+    std::mt19937 rnd(42);
+    auto raw_keys = make_local_keys(cfg.partitions, s);
+    std::vector<dht::decorated_key> keys;
+    keys.reserve(cfg.partitions);
+    for (auto& k : raw_keys) {
+        keys.push_back(dht::global_partitioner().decorate_key(*s, partition_key::from_single_value(*s, to_bytes(k))));
+    }
+    std::sort(keys.begin(), keys.end(), dht::decorated_key::less_comparator(s));
+
+    std::cout << "Running test with config: " << cfg << std::endl;
+    std::cout << "building layout...\n";
+    build_layout(t, cfg, dir.path().string(), keys, rnd);
+
+    print_latencies("point", measure(cfg.point_reads, [&] (unsigned) {
+        auto& dk = keys[rnd() % keys.size()];
+        auto pr = dht::partition_range::make_singular(dk);
+        auto rd = t->make_reader(s, pr, s->full_slice());
+        consume_all(rd);
+    }));
+
+    print_latencies("slice", measure(cfg.slice_reads, [&] (unsigned) {
+        auto& dk = keys[rnd() % keys.size()];
+        auto pr = dht::partition_range::make_singular(dk);
+        auto first_row = rnd() % std::max(1u, cfg.rows_per_partition - cfg.slice_width);
+        auto slice = partition_slice_builder(*s)
+            .with_range(query::clustering_range::make(
+                clustering_key::from_singular(*s, int32_t(first_row)),
+                clustering_key::from_singular(*s, int32_t(first_row + cfg.slice_width - 1))))
+            .build();
+        auto rd = t->make_reader(s, pr, slice);
+        consume_all(rd);
+    }));
+
+    print_latencies("scan", measure(cfg.scans, [&] (unsigned) {
+        auto rd = t->make_reader(s, query::full_partition_range, s->full_slice());
+        consume_all(rd);
+    }));
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("layout", bpo::value<sstring>()->default_value("l0-spike"), "one of: l0-spike (default), lcs-steady, twcs-window")
+        ("partitions", bpo::value<unsigned>()->default_value(1000), "number of partitions")
+        ("rows-per-partition", bpo::value<unsigned>()->default_value(32), "number of clustering rows per partition")
+        ("sstables", bpo::value<unsigned>()->default_value(8), "number of sstables in the layout")
+        ("value-size", bpo::value<unsigned>()->default_value(64), "size in bytes of each cell value")
+        ("tombstone-fraction", bpo::value<double>()->default_value(0.0), "fraction of rows written as row tombstones")
+        ("point-reads", bpo::value<unsigned>()->default_value(10000), "number of single partition reads")
+        ("slice-reads", bpo::value<unsigned>()->default_value(10000), "number of clustering slice reads")
+        ("slice-width", bpo::value<unsigned>()->default_value(4), "number of clustering rows per slice read")
+        ("scans", bpo::value<unsigned>()->default_value(5), "number of full range scans")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        return seastar::async([&app] {
+            auto cfg = test_config();
+            auto layout = app.configuration()["layout"].as<sstring>();
+            if (!layout_names.count(layout)) {
+                throw std::runtime_error(format("unknown layout: {}", layout));
+            }
+            cfg.layout = layout_names[layout];
+            cfg.partitions = app.configuration()["partitions"].as<unsigned>();
+            cfg.rows_per_partition = app.configuration()["rows-per-partition"].as<unsigned>();
+            cfg.sstables = app.configuration()["sstables"].as<unsigned>();
+            cfg.value_size = app.configuration()["value-size"].as<unsigned>();
+            cfg.tombstone_fraction = app.configuration()["tombstone-fraction"].as<double>();
+            cfg.point_reads = app.configuration()["point-reads"].as<unsigned>();
+            cfg.slice_reads = app.configuration()["slice-reads"].as<unsigned>();
+            cfg.slice_width = app.configuration()["slice-width"].as<unsigned>();
+            cfg.scans = app.configuration()["scans"].as<unsigned>();
+            run_test(cfg);
+        });
+    });
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// End-to-end write path benchmark with a configurable mutation shape.
+//
+// Unlike perf_simple_query, which uses a fixed five-column update, this
+// benchmark lets the mutation shape vary along the axes that dominate the
+// write path cost: the number of distinct partitions, the number of
+// clustering rows per partition, the size of the value written by each
+// operation, and the number of partitions touched by a single operation
+// (via an unlogged batch).
+//
+// There are no per-stage cycle counters here; instead, stage costs are
+// isolated by differential runs: run once with the default configuration
+// and once with --bypass-commitlog, and the throughput difference
+// approximates the commitlog contribution. The --flush option times a
+// full memtable flush after the measured run, covering the third stage.
+
+#include <boost/range/irange.hpp>
+#include "tests/cql_test_env.hh"
+#include "tests/perf/perf.hh"
+#include <seastar/core/app-template.hh>
+#include "db/config.hh"
+
+static const sstring table_name = "cf";
+
+struct test_config {
+    unsigned partitions;
+    unsigned rows_per_partition;
+    unsigned value_size;
+    unsigned partitions_per_op;
+    unsigned duration_in_seconds;
+    unsigned concurrency;
+    unsigned operations_per_shard = 0;
+    bool bypass_commitlog;
+};
+
+std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
+    return os << "{partitions=" << cfg.partitions
+           << ", rows-per-partition=" << cfg.rows_per_partition
+           << ", value-size=" << cfg.value_size
+           << ", partitions-per-op=" << cfg.partitions_per_op
+           << ", concurrency=" << cfg.concurrency
+           << ", bypass-commitlog=" << cfg.bypass_commitlog
+           << "}";
+}
+
+static bytes make_key(uint64_t sequence) {
+    bytes b(bytes::initialized_later(), sizeof(sequence));
+    auto i = b.begin();
+    write<uint64_t>(i, sequence);
+    return b;
+};
+
+static sstring make_insert_statement(const test_config& cfg) {
+    static const sstring insert = "INSERT INTO cf (\"KEY\", \"CK\", \"C0\") VALUES (?, ?, ?);";
+    if (cfg.partitions_per_op == 1) {
+        return insert;
+    }
+    sstring batch = "BEGIN UNLOGGED BATCH ";
+    for (unsigned i = 0; i < cfg.partitions_per_op; ++i) {
+        batch += insert;
+        batch += " ";
+    }
+    batch += "APPLY BATCH;";
+    return batch;
+}
+
+future<std::vector<double>> test_write(cql_test_env& env, test_config& cfg) {
+    return env.prepare(make_insert_statement(cfg)).then([&env, &cfg] (auto id) {
+        auto value = bytes(bytes::initialized_later(), cfg.value_size);
+        std::generate(value.begin(), value.end(), [] { return std::rand(); });
+        return time_parallel([&env, &cfg, id, value = std::move(value)] {
+            std::vector<cql3::raw_value> values;
+            values.reserve(cfg.partitions_per_op * 3);
+            for (unsigned i = 0; i < cfg.partitions_per_op; ++i) {
+                values.emplace_back(cql3::raw_value::make_value(make_key(std::rand() % cfg.partitions)));
+                values.emplace_back(cql3::raw_value::make_value(make_key(std::rand() % cfg.rows_per_partition)));
+                values.emplace_back(cql3::raw_value::make_value(value));
+            }
+            return env.execute_prepared(id, std::move(values)).discard_result();
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+    });
+}
+
+future<std::vector<double>> do_test(cql_test_env& env, test_config& cfg) {
+    std::cout << "Running test with config: " << cfg << std::endl;
+    return env.create_table([] (auto ks_name) {
+        return schema({}, ks_name, table_name,
+                {{"KEY", bytes_type}},
+                {{"CK", bytes_type}},
+                {{"C0", bytes_type}},
+                {},
+                utf8_type);
+    }).then([&env, &cfg] {
+        return test_write(env, cfg);
+    });
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("partitions", bpo::value<unsigned>()->default_value(10000), "number of partitions")
+        ("rows-per-partition", bpo::value<unsigned>()->default_value(1), "number of clustering rows per partition")
+        ("value-size", bpo::value<unsigned>()->default_value(100), "size in bytes of the value written by each operation")
+        ("partitions-per-op", bpo::value<unsigned>()->default_value(1), "number of partitions written by a single operation (unlogged batch)")
+        ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
+        ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
+        ("bypass-commitlog", "disable the commitlog to isolate its cost")
+        ("flush", "flush all memtables after the measured run and report the flush time")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        auto cfg = test_config();
+        cfg.partitions = app.configuration()["partitions"].as<unsigned>();
+        cfg.rows_per_partition = app.configuration()["rows-per-partition"].as<unsigned>();
+        cfg.value_size = app.configuration()["value-size"].as<unsigned>();
+        cfg.partitions_per_op = app.configuration()["partitions-per-op"].as<unsigned>();
+        cfg.duration_in_seconds = app.configuration()["duration"].as<unsigned>();
+        cfg.concurrency = app.configuration()["concurrency"].as<unsigned>();
+        cfg.bypass_commitlog = app.configuration().count("bypass-commitlog");
+        if (app.configuration().count("operations-per-shard")) {
+            cfg.operations_per_shard = app.configuration()["operations-per-shard"].as<unsigned>();
+        }
+        bool flush = app.configuration().count("flush");
+
+        db::config db_cfg{};
+        db_cfg.enable_commitlog(!cfg.bypass_commitlog);
+
+        return do_with_cql_env([cfg, flush] (auto&& env) mutable {
+            auto results = do_test(env, cfg).get0();
+
+            std::sort(results.begin(), results.end());
+            auto median = results[results.size() / 2];
+            auto min = results[0];
+            auto max = results[results.size() - 1];
+            for (auto& r : results) {
+                r = abs(r - median);
+            }
+            std::sort(results.begin(), results.end());
+            auto mad = results[results.size() / 2];
+            std::cout << format("\nmedian {:.2f}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median, mad, max, min);
+
+            if (flush) {
+                auto start = std::chrono::steady_clock::now();
+                env.db().invoke_on_all([] (database& db) {
+                    return db.flush_all_memtables();
+                }).get();
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                std::cout << format("flush: {:.3f} [s]\n", elapsed.count());
+            }
+            return make_ready_future<>();
+        }, db_cfg);
+    });
+}
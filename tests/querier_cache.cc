@@ -189,6 +189,10 @@ public:
         return _sem;
     }
 
+    query::querier_cache& get_cache() {
+        return _cache;
+    }
+
     dht::partition_range make_partition_range(bound begin, bound end) const {
         return dht::partition_range::make({_mutations.at(begin.value()).decorated_key(), begin.is_inclusive()},
                 {_mutations.at(end.value()).decorated_key(), end.is_inclusive()});
@@ -764,3 +768,25 @@ SEASTAR_THREAD_TEST_CASE(test_immediate_evict_on_insert) {
 
     permit2_fut.get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_prefetched_querier_is_found_by_lookup) {
+    test_querier_cache t;
+    t.get_cache().set_prefetch_enabled(true);
+
+    const auto entry = t.produce_first_page_and_save_data_querier();
+
+    // The querier becomes visible to lookups only once the background
+    // prefetch completed.
+    while (t.get_cache().get_stats().population == 0) {
+        seastar::thread::yield();
+    }
+    BOOST_REQUIRE_EQUAL(t.get_cache().get_stats().prefetches, 1);
+    BOOST_REQUIRE_EQUAL(t.get_cache().get_stats().prefetch_failures, 0);
+
+    t.assert_cache_lookup_data_querier(entry.key, *t.get_schema(), entry.expected_range, entry.expected_slice)
+        .no_misses()
+        .no_drops()
+        .no_evictions();
+
+    t.get_cache().stop().get();
+}
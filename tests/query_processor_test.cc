@@ -63,6 +63,28 @@ SEASTAR_TEST_CASE(test_execute_internal_insert) {
     });
 }
 
+SEASTAR_TEST_CASE(test_execute_internal_statement_handle) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+        qp.execute_internal("create table ks.cf (p1 varchar, c1 int, r1 int, PRIMARY KEY (p1, c1));").get();
+
+        cql3::query_processor::internal_statement insert_stmt{"insert into ks.cf (p1, c1, r1) values (?, ?, ?);"};
+        cql3::query_processor::internal_statement select_stmt{"select * from ks.cf where p1 = ? and c1 = ?;"};
+
+        // The first execution prepares the statement, the following ones
+        // reuse the handle.
+        for (auto i = 0; i < 3; i++) {
+            qp.execute_internal(insert_stmt, { sstring("key1"), i, i * 100 }).get();
+        }
+
+        for (auto i = 0; i < 3; i++) {
+            auto rs = qp.execute_internal(select_stmt, { sstring("key1"), i }).get0();
+            BOOST_REQUIRE(!rs->empty());
+            BOOST_CHECK_EQUAL(rs->one().get_as<int32_t>("r1"), i * 100);
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(test_execute_internal_delete) {
     return do_with_cql_env([] (auto& e) {
         auto& qp = e.local_qp();
@@ -865,6 +865,25 @@ BOOST_AUTO_TEST_CASE(test_exception_safety) {
     } while (injector.failed());
 }
 
+BOOST_AUTO_TEST_CASE(test_apply_monotonically_move_steals_entries) {
+    range_tombstone_list list(*s);
+    list.apply(*s, rtie(1, 3, 7));
+
+    range_tombstone_list other(*s);
+    other.apply(*s, rt(3, 5, 7)); // adjacent to [1, 3) with equal tombstone
+    other.apply(*s, rt(8, 9, 4));
+
+    auto expected = list;
+    expected.apply(*s, other);
+
+    list.apply_monotonically(*s, std::move(other));
+
+    assert_that(*s, list).is_equal_to(expected);
+    BOOST_REQUIRE(other.empty());
+    // The adjacent equal-tombstone ranges must be merged, not appended.
+    BOOST_REQUIRE_EQUAL(list.size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(test_accumulator) {
     auto ts1 = 1;
     auto ts2 = 2;
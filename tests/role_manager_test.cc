@@ -159,6 +159,35 @@ SEASTAR_TEST_CASE(grant_role) {
     });
 }
 
+SEASTAR_TEST_CASE(grant_role_diamond) {
+    return do_with_cql_env_thread([](auto&& env) {
+        auto m = make_manager(env);
+        m->start().get0();
+
+        //
+        // A role reachable through more than one path is reported once.
+        //
+
+        m->create("knight", auth::role_config()).get0();
+        m->create("bishop", auth::role_config()).get0();
+        m->create("baron", auth::role_config()).get0();
+        m->create("duke", auth::role_config()).get0();
+
+        m->grant("bishop", "duke").get0();
+        m->grant("baron", "duke").get0();
+        m->grant("knight", "bishop").get0();
+        m->grant("knight", "baron").get0();
+
+        BOOST_REQUIRE_EQUAL(
+                m->query_granted("knight", auth::recursive_role_query::yes).get0(),
+                (std::unordered_set<sstring>{"knight", "bishop", "baron", "duke"}));
+
+        BOOST_REQUIRE_EQUAL(
+                m->query_granted("knight", auth::recursive_role_query::no).get0(),
+                (std::unordered_set<sstring>{"knight", "bishop", "baron"}));
+    });
+}
+
 SEASTAR_TEST_CASE(revoke_role) {
     return do_with_cql_env_thread([](auto&& env) {
         auto m = make_manager(env);
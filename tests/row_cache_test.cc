@@ -181,6 +181,35 @@ SEASTAR_TEST_CASE(test_cache_works_after_clearing) {
     });
 }
 
+SEASTAR_TEST_CASE(test_repeated_single_partition_slice_read_is_memoized) {
+    return seastar::async([] {
+        auto s = make_schema();
+        auto m = make_new_mutation(s);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(make_source_with(m)), tracker);
+
+        auto range = dht::partition_range::make_singular(m.decorated_key());
+
+        assert_that(cache.make_reader(s, range))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().memoized_slice_hits, 0);
+
+        assert_that(cache.make_reader(s, range))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().memoized_slice_hits, 1);
+
+        // Synchronizers must drop the memo.
+        cache.invalidate(row_cache::external_updater([] {}), m.decorated_key()).get();
+        assert_that(cache.make_reader(s, range))
+            .produces(m)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().memoized_slice_hits, 1);
+    });
+}
+
 class partition_counting_reader final : public delegating_reader<flat_mutation_reader> {
     int& _counter;
     bool _count_fill_buffer = true;
@@ -532,6 +561,115 @@ static std::vector<mutation> make_ring(schema_ptr s, int n_mutations) {
     return mutations;
 }
 
+SEASTAR_TEST_CASE(test_point_read_of_absent_key_populates_negative_cache) {
+    return seastar::async([] {
+        auto s = make_schema();
+
+        std::vector<mutation> mutations = make_ring(s, 3);
+
+        auto mt = make_lw_shared<memtable>(s);
+        for (auto&& m : mutations) {
+            mt->apply(m);
+        }
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+        auto absent_key = make_new_mutation(s).decorated_key();
+
+        verify_does_not_have(cache, absent_key);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().negative_insertions, 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().negative_hits, 0);
+
+        verify_does_not_have(cache, absent_key);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().negative_hits, 1);
+
+        // Invalidation must forget recorded absence.
+        cache.invalidate(row_cache::external_updater([] {}), absent_key).get();
+        verify_does_not_have(cache, absent_key);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().negative_hits, 1);
+    });
+}
+
+SEASTAR_TEST_CASE(test_prepopulate_populates_whole_range) {
+    return seastar::async([] {
+        auto s = make_schema();
+
+        std::vector<mutation> mutations = make_ring(s, 4);
+
+        auto mt = make_lw_shared<memtable>(s);
+        for (auto&& m : mutations) {
+            mt->apply(m);
+        }
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+        cache.prepopulate(query::full_partition_range, 3).get();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, mutations.size());
+
+        // The whole range should now be served from cache.
+        auto reads_with_misses_before = tracker.get_stats().reads_with_misses;
+        auto rd = assert_that(cache.make_reader(s, query::full_partition_range));
+        for (auto&& m : mutations) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().reads_with_misses, reads_with_misses_before);
+    });
+}
+
+SEASTAR_TEST_CASE(test_tombstone_purge_evicts_expired_dead_rows) {
+    return seastar::async([] {
+        simple_schema table;
+        auto s = table.schema();
+
+        auto expired = gc_clock::now() - s->gc_grace_seconds() - 1h;
+
+        auto m1 = table.new_mutation("pk1");
+        table.add_row(m1, table.make_ckey(0), "v0");
+        table.add_row(m1, table.make_ckey(2), "v2");
+        // Dead rows whose tombstones expired before gc_grace ago.
+        m1.partition().apply_delete(*s, table.make_ckey(1), tombstone(table.new_timestamp(), expired));
+        m1.partition().apply_delete(*s, table.make_ckey(3), tombstone(table.new_timestamp(), expired));
+        // A recent tombstone; must not be purged.
+        m1.partition().apply_delete(*s, table.make_ckey(4), tombstone(table.new_timestamp(), gc_clock::now()));
+
+        // A partition with no live rows at all; should be evicted wholesale.
+        auto m2 = table.new_mutation("pk2");
+        m2.partition().apply_delete(*s, table.make_ckey(0), tombstone(table.new_timestamp(), expired));
+
+        auto mt = make_lw_shared<memtable>(s);
+        mt->apply(m1);
+        mt->apply(m2);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+        cache.populate(m1);
+        cache.populate(m2);
+
+        auto rows_before = tracker.get_stats().rows;
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 2);
+
+        BOOST_REQUIRE_EQUAL(cache.purge_expired_tombstones(1000), 3);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().rows_purged, 3);
+        BOOST_REQUIRE(tracker.get_stats().rows < rows_before);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 1);
+
+        // Nothing left to purge.
+        BOOST_REQUIRE_EQUAL(cache.purge_expired_tombstones(1000), 0);
+
+        // Purged ranges are discontinuous, so reads merge in the underlying
+        // data and still see everything, including the purged tombstones.
+        assert_that(cache.make_reader(s, dht::partition_range::make_singular(m1.decorated_key())))
+            .produces(m1)
+            .produces_end_of_stream();
+        assert_that(cache.make_reader(s, dht::partition_range::make_singular(m2.decorated_key())))
+            .produces(m2)
+            .produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(test_query_of_incomplete_range_goes_to_underlying) {
     return seastar::async([] {
         auto s = make_schema();
@@ -1754,6 +1892,44 @@ SEASTAR_TEST_CASE(test_update_invalidating) {
     });
 }
 
+SEASTAR_TEST_CASE(test_update_invalidating_populated_entry) {
+    return seastar::async([] {
+        simple_schema s;
+        cache_tracker tracker;
+        memtable_snapshot_source underlying(s.schema());
+
+        auto key = s.make_pkey("pk1");
+        mutation m1(s.schema(), key);
+        s.add_row(m1, s.make_ckey(0), "val");
+        underlying.apply(m1);
+
+        row_cache cache(s.schema(), snapshot_source([&] { return underlying(); }), tracker);
+
+        assert_that(cache.make_reader(s.schema()))
+            .produces(m1)
+            .produces_end_of_stream();
+
+        mutation m2(s.schema(), key);
+        s.add_row(m2, s.make_ckey(1), "val2");
+
+        auto mt = make_lw_shared<memtable>(s.schema());
+        mt->apply(m2);
+        auto mt_copy = make_lw_shared<memtable>(s.schema());
+        mt_copy->apply(*mt).get();
+
+        auto evictions_before = tracker.get_stats().partition_evictions;
+        // Invalidating over a populated entry evicts the contents and then
+        // unlinks the entry; this used to read the row count for the
+        // eviction stats from the already-evicted entry and abort.
+        cache.update_invalidating([&] { underlying.apply(mt_copy); }, *mt).get();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_evictions, evictions_before + 1);
+
+        assert_that(cache.make_reader(s.schema()))
+            .produces(m1 + m2)
+            .produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(test_scan_with_partial_partitions) {
     return seastar::async([] {
         simple_schema s;
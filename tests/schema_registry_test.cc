@@ -21,6 +21,7 @@
 
 
 #include <seastar/core/thread.hh>
+#include <seastar/core/sleep.hh>
 
 #include "tests/test_services.hh"
 #include <seastar/testing/test_case.hh>
@@ -141,3 +142,21 @@ SEASTAR_TEST_CASE(test_failed_sync_can_be_retried) {
         BOOST_REQUIRE(s->is_synced());
     });
 }
+
+SEASTAR_TEST_CASE(test_prewarmed_version_outlives_its_users) {
+    return seastar::async([] {
+        storage_service_for_tests ssft;
+        dummy_init dummy;
+        auto s = random_schema();
+        auto v = s->version();
+        s = local_schema_registry().get_or_load(v, [s] (table_schema_version) { return frozen_schema(s); });
+
+        local_schema_registry().prewarm(global_schema_ptr(s));
+        s = nullptr;
+
+        // Wait out the grace period. The version must still be resolvable,
+        // because prewarm() keeps it referenced.
+        seastar::sleep(std::chrono::milliseconds(1500)).get();
+        BOOST_REQUIRE(local_schema_registry().get_or_null(v));
+    });
+}
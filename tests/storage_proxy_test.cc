@@ -111,3 +111,25 @@ SEASTAR_TEST_CASE(test_get_restricted_ranges) {
         });
     });
 }
+
+SEASTAR_TEST_CASE(test_write_expiry_wheel_bucket_is_past_expiry) {
+    using sp = service::storage_proxy;
+    // The sweep for a wheel tick runs at an arbitrary point within it, so the
+    // earliest sweep which can fire an entry is at the start of the tick the
+    // entry is bucketed under. That must not precede the expiry itself --
+    // in particular for expiries landing mid-tick -- or the entry is skipped
+    // and waits a full wheel lap for the next visit.
+    auto base = sp::clock_type::time_point(1000 * sp::expiry_wheel_tick);
+    for (auto offset : {0 * sp::expiry_wheel_tick,
+                        sp::expiry_wheel_tick / 2,
+                        sp::expiry_wheel_tick - sp::clock_type::duration(1)}) {
+        auto expiry = base + offset;
+        auto bucket_tick = sp::expiry_wheel_tick_of(expiry);
+        auto earliest_sweep = sp::clock_type::time_point(bucket_tick * sp::expiry_wheel_tick);
+        BOOST_REQUIRE(earliest_sweep >= expiry);
+        // ...but also no more than one tick late, on top of the wheel's own
+        // granularity.
+        BOOST_REQUIRE(earliest_sweep - expiry <= sp::expiry_wheel_tick);
+    }
+    return make_ready_future<>();
+}
@@ -98,3 +98,34 @@ BOOST_AUTO_TEST_CASE(basic_streaming_histogram_test) {
     BOOST_REQUIRE(std::fabs(10.0 - hist.sum(50)) <= 0.01);
 }
 
+BOOST_AUTO_TEST_CASE(streaming_histogram_builder_test) {
+    // With fewer distinct points than bins, the builder must produce exactly
+    // what feeding the histogram directly would, since nothing gets merged.
+    utils::streaming_histogram_builder builder(5);
+    utils::streaming_histogram direct(5);
+    int32_t samples[] = {23, 19, 10, 19, 36, 23, 23};
+    for (auto p : samples) {
+        builder.update(p);
+        direct.update(p);
+    }
+    auto built = builder.build();
+    BOOST_REQUIRE(built.bin == direct.bin);
+
+    // Builders merge before folding; the merged result must still count
+    // every point once and respect the bin limit.
+    utils::streaming_histogram_builder b1(3);
+    utils::streaming_histogram_builder b2(3);
+    for (int32_t p = 0; p < 10; p++) {
+        b1.update(p * 2);
+        b2.update(p * 2 + 1);
+    }
+    b1.merge(b2);
+    auto merged = b1.build();
+    BOOST_REQUIRE_EQUAL(merged.bin.size(), 3);
+    uint64_t total = 0;
+    for (auto& e : merged.bin) {
+        total += e.second;
+    }
+    BOOST_REQUIRE_EQUAL(total, 20);
+}
+
@@ -556,6 +556,27 @@ BOOST_AUTO_TEST_CASE(test_timeuuid_type_validation) {
     test_validation_fails(timeuuid_type, from_hex("00"));
 }
 
+BOOST_AUTO_TEST_CASE(test_timeuuid_type_compare) {
+    // Timeuuids must sort by their embedded timestamp, not by raw bytes -
+    // the version nibble and time-hi bytes live in the middle of the layout.
+    auto ts = utils::UUID_gen::unix_timestamp(utils::UUID_gen::get_time_UUID());
+    std::vector<utils::UUID> uuids;
+    for (auto offset : {1000, -1000, 0, 1, -1, 500000, -500000}) {
+        uuids.push_back(utils::UUID_gen::get_time_UUID(ts + offset));
+    }
+    std::sort(uuids.begin(), uuids.end(), [] (const utils::UUID& a, const utils::UUID& b) {
+        return timeuuid_type->less(a.serialize(), b.serialize());
+    });
+    BOOST_REQUIRE(std::is_sorted(uuids.begin(), uuids.end(), [] (const utils::UUID& a, const utils::UUID& b) {
+        return a.timestamp() < b.timestamp();
+    }));
+
+    auto u = utils::UUID_gen::get_time_UUID(ts);
+    BOOST_REQUIRE_EQUAL(timeuuid_type->compare(u.serialize(), u.serialize()), 0);
+    BOOST_REQUIRE(timeuuid_type->compare(utils::UUID_gen::min_time_UUID(ts).serialize(),
+                                         utils::UUID_gen::max_time_UUID(ts).serialize()) < 0);
+}
+
 BOOST_AUTO_TEST_CASE(test_uuid_type_validation) {
     auto now = utils::UUID_gen::get_time_UUID();
     uuid_type->validate(now.serialize());
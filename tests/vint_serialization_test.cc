@@ -83,6 +83,25 @@ void check_roundtrip_sweep(std::size_t count, RandomEngine& rng) {
     with_random_samples<typename Vint::value_type>(rng, count, &check_roundtrip<Vint>);
 };
 
+// Check that decoding ignores trailing bytes in the view, as when decoding
+// from the middle of a larger buffer. This is the case that takes the
+// single-load fast path in unsigned_vint::deserialize().
+template <class Vint>
+void check_roundtrip_padded(typename Vint::value_type value) {
+    static std::array<int8_t, 16> encoding_buffer;
+    encoding_buffer.fill(int8_t(0xee));
+
+    const auto size = Vint::serialize(value, encoding_buffer.begin());
+    const auto deserialized = Vint::deserialize(bytes_view(encoding_buffer.data(), encoding_buffer.size()));
+    BOOST_REQUIRE_EQUAL(deserialized.value, value);
+    BOOST_REQUIRE_EQUAL(deserialized.size, size);
+};
+
+template <class Vint, class RandomEngine>
+void check_roundtrip_padded_sweep(std::size_t count, RandomEngine& rng) {
+    with_random_samples<typename Vint::value_type>(rng, count, &check_roundtrip_padded<Vint>);
+};
+
 
 auto& random_engine() {
     static std::random_device rd;
@@ -151,3 +170,11 @@ BOOST_AUTO_TEST_CASE(sanity_signed_examples) {
 BOOST_AUTO_TEST_CASE(sanity_signed_sweep) {
     check_roundtrip_sweep<signed_vint>(100'000, random_engine());
 }
+
+BOOST_AUTO_TEST_CASE(sanity_unsigned_padded_sweep) {
+    check_roundtrip_padded_sweep<unsigned_vint>(100'000, random_engine());
+}
+
+BOOST_AUTO_TEST_CASE(sanity_signed_padded_sweep) {
+    check_roundtrip_padded_sweep<signed_vint>(100'000, random_engine());
+}
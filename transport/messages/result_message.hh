@@ -190,6 +190,10 @@ public:
         return _result;
     }
 
+    virtual size_t serialized_size_hint() const override {
+        return _result.serialized_size_hint();
+    }
+
     virtual void accept(result_message::visitor& v) const override {
         v.visit(*this);
     }
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace cql_transport {
 namespace messages {
 
@@ -34,6 +36,12 @@ public:
 
     virtual void accept(visitor&) const = 0;
 
+    // Rough size of this message once serialized into a response body,
+    // used for pre-sizing the response buffer. Zero when unknown.
+    virtual size_t serialized_size_hint() const {
+        return 0;
+    }
+
     //
     // Message types:
     //
@@ -55,15 +55,33 @@ public:
     template<typename T>
     class placeholder;
 
-    response(int16_t stream, cql_binary_opcode opcode, const tracing::trace_state_ptr& tr_state_ptr)
+    // \param body_size_hint estimated size of the response body, when the
+    //        caller can provide one. Large responses then get a first body
+    //        chunk big enough for the whole body instead of growing to it
+    //        through a series of reallocations. Zero means "unknown".
+    response(int16_t stream, cql_binary_opcode opcode, const tracing::trace_state_ptr& tr_state_ptr, size_t body_size_hint = 0)
         : _stream{stream}
         , _opcode{opcode}
+        , _body(make_body(body_size_hint))
     {
-        if (tracing::should_return_id_in_response(tr_state_ptr)) {
-            auto i = _body.write_place_holder(utils::UUID::serialized_size());
-            tr_state_ptr->session_id().serialize(i);
-            set_frame_flag(cql_frame_flags::tracing);
-        }
+        maybe_write_tracing_id(tr_state_ptr);
+    }
+
+    // Reinitializes a pooled response for reuse; takes the constructor
+    // arguments. Called by response_pool() through make_response().
+    void reset(int16_t stream, cql_binary_opcode opcode, const tracing::trace_state_ptr& tr_state_ptr, size_t body_size_hint = 0) {
+        _stream = stream;
+        _opcode = opcode;
+        _flags = 0;
+        _body = make_body(body_size_hint);
+        maybe_write_tracing_id(tr_state_ptr);
+    }
+
+    // Returns the response to its idle state, releasing the body buffers
+    // so that pooled responses do not pin memory.
+    void reset() noexcept {
+        _flags = 0;
+        _body = bytes_ostream();
     }
 
     void set_frame_flag(cql_frame_flags flag) noexcept {
@@ -91,8 +109,9 @@ public:
     void write(const cql3::metadata& m, bool skip = false);
     void write(const cql3::prepared_metadata& m, uint8_t version);
 
-    // Make a non-owning scattered_message of the response. Remains valid as long
-    // as the response object is alive.
+    // Make a scattered_message of the response, transferring ownership of the
+    // body fragments to it. Leaves the body empty, so the response object does
+    // not need to stay alive while the message is being sent.
     scattered_message<char> make_message(uint8_t version, cql_compression compression);
 
     cql_binary_opcode opcode() const {
@@ -102,6 +121,23 @@ public:
         return _body.size();
     }
 private:
+    void maybe_write_tracing_id(const tracing::trace_state_ptr& tr_state_ptr) {
+        if (tracing::should_return_id_in_response(tr_state_ptr)) {
+            auto i = _body.write_place_holder(utils::UUID::serialized_size());
+            tr_state_ptr->session_id().serialize(i);
+            set_frame_flag(cql_frame_flags::tracing);
+        }
+    }
+
+    static bytes_ostream make_body(size_t size_hint) {
+        if (size_hint == 0) {
+            return bytes_ostream();
+        }
+        // Leave some slack for the result metadata and the row count
+        // preceding the row data.
+        return bytes_ostream(std::min<size_t>(size_hint + 128, bytes_ostream::max_chunk_size()));
+    }
+
     void compress(cql_compression compression);
     void compress_lz4();
     void compress_snappy();
@@ -144,4 +180,9 @@ public:
     }
 };
 
+template <typename... Args>
+response_ptr make_response(Args&&... args) {
+    return response_ptr(response_pool().get(std::forward<Args>(args)...));
+}
+
 }
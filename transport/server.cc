@@ -35,6 +35,7 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/reactor.hh>
 #include "utils/UUID.hh"
+#include "utils/memory_label.hh"
 #include <seastar/net/byteorder.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/net/byteorder.hh>
@@ -57,12 +58,23 @@
 #include "response.hh"
 #include "request.hh"
 
+#include "utils/latency.hh"
+
 #include "types/user.hh"
 
 namespace cql_transport {
 
 static logging::logger clogger("cql_server");
 
+utils::object_pool<cql_server::response>& response_pool() {
+    static thread_local utils::object_pool<cql_server::response> pool;
+    return pool;
+}
+
+void response_deleter::operator()(response* r) const noexcept {
+    response_pool().put(r);
+}
+
 cql_server::connection::processing_result::processing_result(response_type r)
     : cql_response(make_foreign(std::move(r.first)))
     , keyspace(r.second.is_dirty() ? make_foreign(std::make_unique<sstring>(std::move(r.second.get_raw_keyspace()))) : nullptr)
@@ -190,6 +202,19 @@ cql_server::cql_server(distributed<service::storage_proxy>& proxy, distributed<c
                             seastar::format("Holds an incrementing counter with the requests that ever blocked due to reaching the memory quota limit ({}B). "
                                             "The first derivative of this value shows how often we block due to memory exhaustion in the \"CQL transport\" component.", _max_request_size))),
 
+        sm::make_histogram("requests_latency", [this] { return _estimated_requests_latency.get_histogram(std::chrono::microseconds(100)); },
+                        sm::description(
+                            seastar::format("Histogram of request processing latency, from frame decode to response readiness, sampled on every {}th request.", request_latency_sample_rate))),
+
+        sm::make_derive("response_pool_allocations", [] { return response_pool().stats().allocations; },
+                        sm::description("Counts response objects acquired from the per-shard response pool.")),
+
+        sm::make_derive("response_pool_hits", [] { return response_pool().stats().hits; },
+                        sm::description("Counts response object acquisitions served from the pool freelist instead of the allocator.")),
+
+        sm::make_gauge("response_pool_size", [] { return response_pool().pooled(); },
+                        sm::description("Holds the number of idle response objects currently pooled on this shard.")),
+
     });
 }
 
@@ -367,6 +392,7 @@ future<cql_server::connection::processing_result>
 
     auto linearization_buffer = std::make_unique<bytes_ostream>();
     auto linearization_buffer_ptr = linearization_buffer.get();
+    auto mem_label = std::make_unique<utils::memory_label_guard>("transport");
     return futurize_apply([this, cqlop, stream, &fbuf, client_state, linearization_buffer_ptr] () mutable {
         // When using authentication, we need to ensure we are doing proper state transitions,
         // i.e. we cannot simply accept any query/exec ops unless auth is complete
@@ -467,7 +493,7 @@ future<cql_server::connection::processing_result>
         } catch (...) {
             return processing_result(std::make_pair(make_error(stream, exceptions::exception_code::SERVER_ERROR, "unknown error", client_state.get_trace_state()), client_state));
         }
-    });
+    }).finally([mem_label = std::move(mem_label)] {});
 }
 
 cql_server::connection::connection(cql_server& server, ipv4_addr server_addr, connected_socket&& fd, socket_address addr)
@@ -477,6 +503,7 @@ cql_server::connection::connection(cql_server& server, ipv4_addr server_addr, co
     , _read_buf(_fd.input())
     , _write_buf(_fd.output())
     , _client_state(service::client_state::external_tag{}, server._auth_service, addr)
+    , _home_shard(engine().cpu_id())
 {
     ++_server._total_connections;
     ++_server._current_connections;
@@ -508,6 +535,7 @@ future<> cql_server::connection::process()
             write_response(make_error(0, exceptions::exception_code::SERVER_ERROR, "unknown error", tracing::trace_state_ptr()));
         }
     }).finally([this] {
+        _pending_requests_abort.request_abort();
         return _pending_requests_gate.close().then([this] {
             _server._notifier->unregister_connection(this);
             return _ready_to_respond.finally([this] {
@@ -594,6 +622,11 @@ future<> cql_server::connection::process_request() {
             ++_server._requests_served;
             ++_server._requests_serving;
 
+            utils::latency_counter lc;
+            if (_server._requests_served % cql_server::request_latency_sample_rate == 0) {
+                lc.start();
+            }
+
             _pending_requests_gate.enter();
             auto leave = defer([this] { _pending_requests_gate.leave(); });
             // Replacing the immediately-invoked lambda below with just its body costs 5-10 usec extra per invocation.
@@ -612,7 +645,7 @@ future<> cql_server::connection::process_request() {
                             return _process_request_stage(this, istream, op, stream, service::client_state(service::client_state::request_copy_tag{}, client_state, ts), tracing_requested);
                         });
                     }
-                }().then_wrapped([this, buf = std::move(buf), mem_permit = std::move(mem_permit), leave = std::move(leave)] (future<processing_result> response_f) {
+                }().then_wrapped([this, lc, buf = std::move(buf), mem_permit = std::move(mem_permit), leave = std::move(leave)] (future<processing_result> response_f) mutable {
                   try {
                     auto response = response_f.get0();
                     update_client_state(response);
@@ -620,6 +653,9 @@ future<> cql_server::connection::process_request() {
                   } catch (...) {
                     clogger.error("request processing failed: {}", std::current_exception());
                   }
+                  if (lc.is_start()) {
+                    _server._estimated_requests_latency.add(std::chrono::duration_cast<std::chrono::microseconds>(lc.stop().latency()).count());
+                  }
                 });
             }();
 
@@ -652,6 +688,50 @@ void on_compression_buffer_use() {
     }
 }
 
+// Frames at least this large have their (de)compression run in the server's
+// compression scheduling group; the work is pure CPU time proportional to the
+// frame size, so for typical small frames the accounting overhead is not
+// worth it, while the multi-megabyte frames of bulk loads are exactly what
+// the CPU scheduler should be arbitrating.
+static constexpr size_t compression_offload_threshold = 16 * 1024;
+
+static fragmented_temporary_buffer uncompress_lz4(fragmented_temporary_buffer buf) {
+    auto linearization_buffer = bytes_ostream();
+    int32_t uncomp_len = request_reader(buf.get_istream(), linearization_buffer).read_int();
+    if (uncomp_len < 0) {
+        throw std::runtime_error("CQL frame uncompressed length is negative: " + std::to_string(uncomp_len));
+    }
+    buf.remove_prefix(4);
+    auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buf));
+  auto uncomp = output_buffer.make_fragmented_temporary_buffer(uncomp_len, fragmented_temporary_buffer::default_fragment_size, [&] (bytes_mutable_view out) {
+    auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()),
+                                   in.size(), out.size());
+    if (ret < 0) {
+        throw std::runtime_error("CQL frame LZ4 uncompression failure");
+    }
+    return out.size();
+  });
+    on_compression_buffer_use();
+    return uncomp;
+}
+
+static fragmented_temporary_buffer uncompress_snappy(fragmented_temporary_buffer buf) {
+    auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buf));
+    size_t uncomp_len;
+    if (snappy_uncompressed_length(reinterpret_cast<const char*>(in.data()), in.size(), &uncomp_len) != SNAPPY_OK) {
+        throw std::runtime_error("CQL frame Snappy uncompressed size is unknown");
+    }
+  auto uncomp = output_buffer.make_fragmented_temporary_buffer(uncomp_len, fragmented_temporary_buffer::default_fragment_size, [&] (bytes_mutable_view out) {
+    size_t output_len = out.size();
+    if (snappy_uncompress(reinterpret_cast<const char*>(in.data()), in.size(), reinterpret_cast<char*>(out.data()), &output_len) != SNAPPY_OK) {
+        throw std::runtime_error("CQL frame Snappy uncompression failure");
+    }
+    return output_len;
+  });
+    on_compression_buffer_use();
+    return uncomp;
+}
+
 }
 
 future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_frame(size_t length, uint8_t flags)
@@ -663,40 +743,23 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                 throw std::runtime_error("Truncated frame");
             }
             return _buffer_reader.read_exactly(_read_buf, length).then([this] (fragmented_temporary_buffer buf) {
-                auto linearization_buffer = bytes_ostream();
-                int32_t uncomp_len = request_reader(buf.get_istream(), linearization_buffer).read_int();
-                if (uncomp_len < 0) {
-                    throw std::runtime_error("CQL frame uncompressed length is negative: " + std::to_string(uncomp_len));
-                }
-                buf.remove_prefix(4);
-                auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buf));
-              auto uncomp = output_buffer.make_fragmented_temporary_buffer(uncomp_len, fragmented_temporary_buffer::default_fragment_size, [&] (bytes_mutable_view out) {
-                auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()),
-                                               in.size(), out.size());
-                if (ret < 0) {
-                    throw std::runtime_error("CQL frame LZ4 uncompression failure");
+                if (buf.size_bytes() >= compression_offload_threshold) {
+                    // The compression buffers are per reactor thread, not per
+                    // scheduling group, so running there is safe.
+                    return with_scheduling_group(_server._config.compression_scheduling_group, [buf = std::move(buf)] () mutable {
+                        return uncompress_lz4(std::move(buf));
+                    });
                 }
-                return out.size();
-              });
-                on_compression_buffer_use();
-                return uncomp;
+                return make_ready_future<fragmented_temporary_buffer>(uncompress_lz4(std::move(buf)));
             });
         } else if (_compression == cql_compression::snappy) {
             return _buffer_reader.read_exactly(_read_buf, length).then([this] (fragmented_temporary_buffer buf) {
-                auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buf));
-                size_t uncomp_len;
-                if (snappy_uncompressed_length(reinterpret_cast<const char*>(in.data()), in.size(), &uncomp_len) != SNAPPY_OK) {
-                    throw std::runtime_error("CQL frame Snappy uncompressed size is unknown");
+                if (buf.size_bytes() >= compression_offload_threshold) {
+                    return with_scheduling_group(_server._config.compression_scheduling_group, [buf = std::move(buf)] () mutable {
+                        return uncompress_snappy(std::move(buf));
+                    });
                 }
-              auto uncomp = output_buffer.make_fragmented_temporary_buffer(uncomp_len, fragmented_temporary_buffer::default_fragment_size, [&] (bytes_mutable_view out) {
-                size_t output_len = out.size();
-                if (snappy_uncompress(reinterpret_cast<const char*>(in.data()), in.size(), reinterpret_cast<char*>(out.data()), &output_len) != SNAPPY_OK) {
-                    throw std::runtime_error("CQL frame Snappy uncompression failure");
-                }
-                return output_len;
-              });
-                on_compression_buffer_use();
-                return uncomp;
+                return make_ready_future<fragmented_temporary_buffer>(uncompress_snappy(std::move(buf)));
             });
         } else {
             throw exceptions::protocol_exception(format("Unknown compression algorithm"));
@@ -707,6 +770,9 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
 
 unsigned cql_server::connection::pick_request_cpu()
 {
+    if (_shard_aware) {
+        return engine().cpu_id();
+    }
     if (_server._lb == cql_load_balance::round_robin) {
         return _request_cpu++ % smp::count;
     }
@@ -728,6 +794,17 @@ future<response_type> cql_server::connection::process_startup(uint16_t stream, r
              throw exceptions::protocol_exception(format("Unknown compression algorithm: {}", compression));
          }
     }
+    // A shard aware client routes each request to the shard owning the
+    // request's token using the parameters from the SUPPORTED message, and
+    // pins this connection to the shard which accepted it. Round-robining
+    // such a connection's requests across shards would undo the client's
+    // routing, so pinning disables server-side load balancing.
+    auto shard_aware_opt = options.find("SCYLLA_SHARD_AWARE");
+    if (shard_aware_opt != options.end()) {
+        auto value = shard_aware_opt->second;
+        std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+        _shard_aware = value == "true";
+    }
     auto& a = client_state.get_auth_service()->underlying_authenticator();
     if (a.require_authentication()) {
         return make_ready_future<response_type>(std::make_pair(make_autheticate(stream, a.qualified_java_name(), client_state.get_trace_state()), client_state));
@@ -767,7 +844,7 @@ cql_server::connection::init_cql_serialization_format() {
 future<response_type> cql_server::connection::process_query(uint16_t stream, request_reader in, service::client_state client_state)
 {
     auto query = in.read_long_string_view();
-    auto q_state = std::make_unique<cql_query_state>(client_state);
+    auto q_state = std::make_unique<cql_query_state>(client_state, abort_source_for_shard());
     auto& query_state = q_state->query_state;
     q_state->options = in.read_options(_version, _cql_serialization_format, this->timeout_config());
     auto& options = *q_state->options;
@@ -784,7 +861,7 @@ future<response_type> cql_server::connection::process_query(uint16_t stream, req
     return _server._query_processor.local().process(query, query_state, options).then([this, stream, &query_state, skip_metadata] (auto msg) {
          tracing::trace(query_state.get_trace_state(), "Done processing - preparing a result");
          return this->make_result(stream, msg, query_state.get_trace_state(), skip_metadata);
-    }).then([&query_state, q_state = std::move(q_state), this] (std::unique_ptr<cql_server::response> response) {
+    }).then([&query_state, q_state = std::move(q_state), this] (response_ptr response) {
         /* Keep q_state alive. */
         return make_ready_future<response_type>(std::make_pair(std::move(response), query_state.get_client_state()));
     });
@@ -801,6 +878,24 @@ future<response_type> cql_server::connection::process_prepare(uint16_t stream, r
     auto cpus = boost::irange(0u, smp::count);
     auto client_state = std::make_unique<service::client_state>(client_state_);
     const auto& cs = *client_state;
+
+    // The common case after a deploy is many clients preparing the same set of
+    // statements. The first PREPARE parses the statement once on every shard;
+    // all the following ones find it in the local cache, which also means it's
+    // already on every other shard, so skip re-preparing it once per shard for
+    // every client.
+    if (auto msg = _server._query_processor.local().get_stored_prepared_statement(query, cs.get_raw_keyspace(), false)) {
+        tracing::trace(cs.get_trace_state(), "Statement is already prepared on all shards. ID is [{}]", seastar::value_of([&msg] {
+            return messages::result_message::prepared::cql::get_id(msg);
+        }));
+        return futurize_apply([this, stream, msg = std::move(msg), &cs] {
+            return this->make_result(stream, msg, cs.get_trace_state());
+        }).then([client_state = std::move(client_state)] (response_ptr response) {
+            /* keep client_state alive */
+            return make_ready_future<response_type>(std::make_pair(std::move(response), *client_state));
+        });
+    }
+
     return parallel_for_each(cpus.begin(), cpus.end(), [this, query, cpu_id, &cs] (unsigned int c) mutable {
         if (c != cpu_id) {
             return smp::submit_to(c, [this, query, &cs] () mutable {
@@ -817,7 +912,7 @@ future<response_type> cql_server::connection::process_prepare(uint16_t stream, r
             }));
             return this->make_result(stream, msg, cs.get_trace_state());
         });
-    }).then([client_state = std::move(client_state)] (std::unique_ptr<cql_server::response> response) {
+    }).then([client_state = std::move(client_state)] (response_ptr response) {
         /* keep client_state alive */
         return make_ready_future<response_type>(std::make_pair(std::move(response), *client_state));
     });
@@ -841,7 +936,7 @@ future<response_type> cql_server::connection::process_execute(uint16_t stream, r
         throw exceptions::prepared_query_not_found_exception(id);
     }
 
-    auto q_state = std::make_unique<cql_query_state>(client_state);
+    auto q_state = std::make_unique<cql_query_state>(client_state, abort_source_for_shard());
     auto& query_state = q_state->query_state;
     if (_version == 1) {
         std::vector<cql3::raw_value_view> values;
@@ -877,7 +972,7 @@ future<response_type> cql_server::connection::process_execute(uint16_t stream, r
     return _server._query_processor.local().process_statement_prepared(std::move(prepared), std::move(cache_key), query_state, options, needs_authorization).then([this, stream, &query_state, skip_metadata] (auto msg) {
         tracing::trace(query_state.get_trace_state(), "Done processing - preparing a result");
         return this->make_result(stream, msg, query_state.get_trace_state(), skip_metadata);
-    }).then([&query_state, q_state = std::move(q_state), this] (std::unique_ptr<cql_server::response> response) {
+    }).then([&query_state, q_state = std::move(q_state), this] (response_ptr response) {
         /* Keep q_state alive. */
         tracing::stop_foreground_prepared(query_state.get_trace_state(), q_state->options.get());
         return make_ready_future<response_type>(std::make_pair(std::move(response), query_state.get_client_state()));
@@ -964,7 +1059,7 @@ cql_server::connection::process_batch(uint16_t stream, request_reader in, servic
         values.emplace_back(std::move(tmp));
     }
 
-    auto q_state = std::make_unique<cql_query_state>(client_state);
+    auto q_state = std::make_unique<cql_query_state>(client_state, abort_source_for_shard());
     auto& query_state = q_state->query_state;
     // #563. CQL v2 encodes query_options in v1 format for batch requests.
     q_state->options = std::make_unique<cql3::query_options>(cql3::query_options::make_batch_options(std::move(*in.read_options(_version < 3 ? 1 : _version, _cql_serialization_format, this->timeout_config())), std::move(values)));
@@ -977,7 +1072,7 @@ cql_server::connection::process_batch(uint16_t stream, request_reader in, servic
     auto batch = ::make_shared<cql3::statements::batch_statement>(cql3::statements::batch_statement::type(type), std::move(modifications), cql3::attributes::none(), _server._query_processor.local().get_cql_stats());
     return _server._query_processor.local().process_batch(batch, query_state, options, std::move(pending_authorization_entries)).then([this, stream, batch, &query_state] (auto msg) {
         return this->make_result(stream, msg, query_state.get_trace_state());
-    }).then([&query_state, q_state = std::move(q_state), this] (std::unique_ptr<cql_server::response> response) {
+    }).then([&query_state, q_state = std::move(q_state), this] (response_ptr response) {
         /* Keep q_state alive. */
         tracing::stop_foreground_prepared(query_state.get_trace_state(), q_state->options.get());
         return make_ready_future<response_type>(std::make_pair(std::move(response), query_state.get_client_state()));
@@ -996,9 +1091,9 @@ cql_server::connection::process_register(uint16_t stream, request_reader in, ser
     return make_ready_future<response_type>(std::make_pair(make_ready(stream, client_state.get_trace_state()), client_state));
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_unavailable_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t required, int32_t alive, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_unavailable_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t required, int32_t alive, const tracing::trace_state_ptr& tr_state)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1007,9 +1102,9 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_unavailable_e
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_read_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_read_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1019,12 +1114,12 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_read_timeout_
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_read_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_read_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state)
 {
     if (_version < 4) {
         return make_read_timeout_error(stream, err, std::move(msg), cl, received, blockfor, data_present, tr_state);
     }
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1035,9 +1130,9 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_read_failure_
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_mutation_write_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_mutation_write_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1047,12 +1142,12 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_mutation_writ
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_mutation_write_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_mutation_write_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state)
 {
     if (_version < 4) {
         return make_mutation_write_timeout_error(stream, err, std::move(msg), cl, received, blockfor, type, tr_state);
     }
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1063,9 +1158,9 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_mutation_writ
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_already_exists_error(int16_t stream, exceptions::exception_code err, sstring msg, sstring ks_name, sstring cf_name, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_already_exists_error(int16_t stream, exceptions::exception_code err, sstring msg, sstring ks_name, sstring cf_name, const tracing::trace_state_ptr& tr_state)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_string(ks_name);
@@ -1073,48 +1168,48 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_already_exist
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_unprepared_error(int16_t stream, exceptions::exception_code err, sstring msg, bytes id, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_unprepared_error(int16_t stream, exceptions::exception_code err, sstring msg, bytes id, const tracing::trace_state_ptr& tr_state)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_short_bytes(id);
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_error(int16_t stream, exceptions::exception_code err, sstring msg, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_error(int16_t stream, exceptions::exception_code err, sstring msg, const tracing::trace_state_ptr& tr_state)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::ERROR, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_ready(int16_t stream, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_ready(int16_t stream, const tracing::trace_state_ptr& tr_state)
 {
-    return std::make_unique<cql_server::response>(stream, cql_binary_opcode::READY, tr_state);
+    return make_response(stream, cql_binary_opcode::READY, tr_state);
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_autheticate(int16_t stream, const sstring& clz, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_autheticate(int16_t stream, const sstring& clz, const tracing::trace_state_ptr& tr_state)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::AUTHENTICATE, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::AUTHENTICATE, tr_state);
     response->write_string(clz);
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_auth_success(int16_t stream, bytes b, const tracing::trace_state_ptr& tr_state) {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::AUTH_SUCCESS, tr_state);
+response_ptr cql_server::connection::make_auth_success(int16_t stream, bytes b, const tracing::trace_state_ptr& tr_state) {
+    auto response = make_response(stream, cql_binary_opcode::AUTH_SUCCESS, tr_state);
     response->write_bytes(std::move(b));
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_auth_challenge(int16_t stream, bytes b, const tracing::trace_state_ptr& tr_state) {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::AUTH_CHALLENGE, tr_state);
+response_ptr cql_server::connection::make_auth_challenge(int16_t stream, bytes b, const tracing::trace_state_ptr& tr_state) {
+    auto response = make_response(stream, cql_binary_opcode::AUTH_CHALLENGE, tr_state);
     response->write_bytes(std::move(b));
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int16_t stream, const tracing::trace_state_ptr& tr_state)
+response_ptr cql_server::connection::make_supported(int16_t stream, const tracing::trace_state_ptr& tr_state)
 {
     std::multimap<sstring, sstring> opts;
     opts.insert({"CQL_VERSION", cql3::query_processor::CQL_VERSION});
@@ -1126,7 +1221,8 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
     opts.insert({"SCYLLA_SHARDING_ALGORITHM", part.cpu_sharding_algorithm_name()});
     opts.insert({"SCYLLA_SHARDING_IGNORE_MSB", format("{:d}", part.sharding_ignore_msb())});
     opts.insert({"SCYLLA_PARTITIONER", part.name()});
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::SUPPORTED, tr_state);
+    opts.insert({"SCYLLA_SHARD_AWARE", "true"});
+    auto response = make_response(stream, cql_binary_opcode::SUPPORTED, tr_state);
     response->write_string_multimap(opts);
     return response;
 }
@@ -1204,52 +1300,63 @@ public:
     }
 };
 
-std::unique_ptr<cql_server::response>
+response_ptr
 cql_server::connection::make_result(int16_t stream, shared_ptr<messages::result_message> msg, const tracing::trace_state_ptr& tr_state, bool skip_metadata)
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::RESULT, tr_state);
+    auto response = make_response(stream, cql_binary_opcode::RESULT, tr_state, msg->serialized_size_hint());
     fmt_visitor fmt{_version, *response, skip_metadata};
     msg->accept(fmt);
     return response;
 }
 
-std::unique_ptr<cql_server::response>
+response_ptr
 cql_server::connection::make_topology_change_event(const event::topology_change& event)
 {
-    auto response = std::make_unique<cql_server::response>(-1, cql_binary_opcode::EVENT, tracing::trace_state_ptr());
+    auto response = make_response(-1, cql_binary_opcode::EVENT, tracing::trace_state_ptr());
     response->write_string("TOPOLOGY_CHANGE");
     response->write_string(to_string(event.change));
     response->write_inet(event.node);
     return response;
 }
 
-std::unique_ptr<cql_server::response>
+response_ptr
 cql_server::connection::make_status_change_event(const event::status_change& event)
 {
-    auto response = std::make_unique<cql_server::response>(-1, cql_binary_opcode::EVENT, tracing::trace_state_ptr());
+    auto response = make_response(-1, cql_binary_opcode::EVENT, tracing::trace_state_ptr());
     response->write_string("STATUS_CHANGE");
     response->write_string(to_string(event.status));
     response->write_inet(event.node);
     return response;
 }
 
-std::unique_ptr<cql_server::response>
+response_ptr
 cql_server::connection::make_schema_change_event(const event::schema_change& event)
 {
-    auto response = std::make_unique<cql_server::response>(-1, cql_binary_opcode::EVENT, tracing::trace_state_ptr());
+    auto response = make_response(-1, cql_binary_opcode::EVENT, tracing::trace_state_ptr());
     response->write_string("SCHEMA_CHANGE");
     response->serialize(event, _version);
     return response;
 }
 
-void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, cql_compression compression)
+void cql_server::connection::write_response(foreign_ptr<response_ptr>&& response, cql_compression compression)
 {
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response)] () mutable {
-        auto message = response->make_message(_version, compression);
-        message.on_delete([response = std::move(response)] { });
-        return _write_buf.write(std::move(message)).then([this] {
-            return _write_buf.flush();
-        });
+        // make_message() transfers ownership of the body fragments to the
+        // message, so the response can go back to the pool right away
+        // instead of staying alive until the write completes.
+        auto send = [this] (scattered_message<char> message) {
+            return _write_buf.write(std::move(message)).then([this] {
+                return _write_buf.flush();
+            });
+        };
+        // Compressing a large response is the same CPU cost as uncompressing
+        // a large request; account it to the same scheduling group.
+        if (compression != cql_compression::none && response->size() >= compression_buffers::compression_offload_threshold) {
+            return with_scheduling_group(_server._config.compression_scheduling_group, [this, compression, response = std::move(response)] () mutable {
+                return response->make_message(_version, compression);
+            }).then(std::move(send));
+        }
+        return send(response->make_message(_version, compression));
     });
 }
 
@@ -1260,8 +1367,8 @@ scattered_message<char> cql_server::response::make_message(uint8_t version, cql_
     scattered_message<char> msg;
     auto frame = make_frame(version, _body.size());
     msg.append(std::move(frame));
-    for (auto&& fragment : _body.fragments()) {
-        msg.append_static(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+    for (auto&& fragment : std::move(_body).release()) {
+        msg.append(std::move(fragment));
     }
     return msg;
 }
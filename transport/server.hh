@@ -32,11 +32,14 @@
 #include <seastar/core/distributed.hh>
 #include "timeout_config.hh"
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/abort_source.hh>
 #include <memory>
 #include <boost/intrusive/list.hpp>
 #include <seastar/net/tls.hh>
 #include <seastar/core/metrics_registration.hh>
+#include "utils/estimated_histogram.hh"
 #include "utils/fragmented_temporary_buffer.hh"
+#include "utils/object_pool.hh"
 
 namespace scollectd {
 
@@ -51,6 +54,24 @@ namespace cql_transport {
 class request_reader;
 class response;
 
+// Responses are allocated on every request, so they come from a per-shard
+// object pool instead of straight from the allocator. The pool is resolved
+// at destruction time rather than captured in the deleter, which keeps
+// handles safe to destroy through foreign_ptr: the deleter runs on the
+// owning shard and returns the response to that shard's pool.
+utils::object_pool<response>& response_pool();
+
+struct response_deleter {
+    void operator()(response* r) const noexcept;
+};
+
+using response_ptr = std::unique_ptr<response, response_deleter>;
+
+// Acquires a response from the current shard's pool; takes the response
+// constructor arguments. Defined in response.hh.
+template <typename... Args>
+response_ptr make_response(Args&&... args);
+
 enum class cql_compression {
     none,
     lz4,
@@ -99,14 +120,18 @@ struct cql_query_state {
     service::query_state query_state;
     std::unique_ptr<cql3::query_options> options;
 
-    cql_query_state(service::client_state& client_state)
-        : query_state(client_state)
+    cql_query_state(service::client_state& client_state, seastar::abort_source* abort_source = nullptr)
+        : query_state(client_state, abort_source)
     { }
 };
 
 struct cql_server_config {
     ::timeout_config timeout_config;
     size_t max_request_size;
+    // Scheduling group in which (de)compression of large CQL frames runs, so
+    // that connections streaming bulk data compete with interactive requests
+    // through the CPU scheduler instead of monopolizing the reactor.
+    seastar::scheduling_group compression_scheduling_group;
 };
 
 class cql_server {
@@ -129,6 +154,13 @@ private:
     uint64_t _requests_served = 0;
     uint64_t _requests_serving = 0;
     uint64_t _requests_blocked_memory = 0;
+    // Every Nth request is timed from frame decode to CQL response readiness,
+    // covering the coordinator pipeline including any cross-shard hop.
+    // Compared against the storage_proxy and per-table latency histograms
+    // this isolates the transport/serialization stage, and sampling keeps
+    // the cost off the remaining requests. Always on.
+    static constexpr uint64_t request_latency_sample_rate = 128;
+    utils::estimated_histogram _estimated_requests_latency;
     cql_load_balance _lb;
     auth::service& _auth_service;
 public:
@@ -139,13 +171,13 @@ public:
     future<> stop();
 public:
     using response = cql_transport::response;
-    using response_type = std::pair<std::unique_ptr<cql_server::response>, service::client_state>;
+    using response_type = std::pair<response_ptr, service::client_state>;
 private:
     class fmt_visitor;
     friend class connection;
     class connection : public boost::intrusive::list_base_hook<> {
         struct processing_result {
-            foreign_ptr<std::unique_ptr<cql_server::response>> cql_response;
+            foreign_ptr<response_ptr> cql_response;
             foreign_ptr<std::unique_ptr<sstring>> keyspace;
             foreign_ptr<shared_ptr<auth::authenticated_user>> user;
             service::client_state::auth_state auth_state;
@@ -160,10 +192,20 @@ private:
         output_stream<char> _write_buf;
         fragmented_temporary_buffer::reader _buffer_reader;
         seastar::gate _pending_requests_gate;
+        // Signalled when the connection goes away, so that in-flight reads
+        // can give up instead of running to completion for a client which
+        // will never see the result. Only requests executing on the
+        // connection's home shard may observe it, see abort_source_for_shard().
+        seastar::abort_source _pending_requests_abort;
+        unsigned _home_shard;
         future<> _ready_to_respond = make_ready_future<>();
         cql_protocol_version_type _version = 0;
         cql_compression _compression = cql_compression::none;
         cql_serialization_format _cql_serialization_format = cql_serialization_format::latest();
+        // Set when the client declared itself shard aware in STARTUP. Such a
+        // client deliberately opened this connection to reach this shard, so
+        // requests are never forwarded to other shards for load balancing.
+        bool _shard_aware = false;
         service::client_state _client_state;
         std::unordered_map<uint16_t, cql_query_state> _query_states;
         unsigned _request_cpu = 0;
@@ -191,6 +233,12 @@ private:
         future<> shutdown();
     private:
         const ::timeout_config& timeout_config() { return _server.timeout_config(); }
+        // The abort source is a plain (non-atomic) object living on the
+        // connection's home shard; requests executing on other shards must
+        // not touch it.
+        seastar::abort_source* abort_source_for_shard() {
+            return engine().cpu_id() == _home_shard ? &_pending_requests_abort : nullptr;
+        }
         friend class process_request_executor;
         future<processing_result> process_request_one(fragmented_temporary_buffer::istream buf, uint8_t op, uint16_t stream, service::client_state client_state, tracing_request_type tracing_request);
         unsigned frame_size() const;
@@ -208,25 +256,25 @@ private:
         future<response_type> process_batch(uint16_t stream, request_reader in, service::client_state client_state);
         future<response_type> process_register(uint16_t stream, request_reader in, service::client_state client_state);
 
-        std::unique_ptr<cql_server::response> make_unavailable_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t required, int32_t alive, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_read_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_read_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_mutation_write_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_mutation_write_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_already_exists_error(int16_t stream, exceptions::exception_code err, sstring msg, sstring ks_name, sstring cf_name, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_unprepared_error(int16_t stream, exceptions::exception_code err, sstring msg, bytes id, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_error(int16_t stream, exceptions::exception_code err, sstring msg, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_ready(int16_t stream, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_supported(int16_t stream, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_result(int16_t stream, shared_ptr<cql_transport::messages::result_message> msg, const tracing::trace_state_ptr& tr_state, bool skip_metadata = false);
-        std::unique_ptr<cql_server::response> make_topology_change_event(const cql_transport::event::topology_change& event);
-        std::unique_ptr<cql_server::response> make_status_change_event(const cql_transport::event::status_change& event);
-        std::unique_ptr<cql_server::response> make_schema_change_event(const cql_transport::event::schema_change& event);
-        std::unique_ptr<cql_server::response> make_autheticate(int16_t, const sstring&, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_auth_success(int16_t, bytes, const tracing::trace_state_ptr& tr_state);
-        std::unique_ptr<cql_server::response> make_auth_challenge(int16_t, bytes, const tracing::trace_state_ptr& tr_state);
-
-        void write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, cql_compression compression = cql_compression::none);
+        response_ptr make_unavailable_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t required, int32_t alive, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_read_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_read_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_mutation_write_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_mutation_write_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t numfailures, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_already_exists_error(int16_t stream, exceptions::exception_code err, sstring msg, sstring ks_name, sstring cf_name, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_unprepared_error(int16_t stream, exceptions::exception_code err, sstring msg, bytes id, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_error(int16_t stream, exceptions::exception_code err, sstring msg, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_ready(int16_t stream, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_supported(int16_t stream, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_result(int16_t stream, shared_ptr<cql_transport::messages::result_message> msg, const tracing::trace_state_ptr& tr_state, bool skip_metadata = false);
+        response_ptr make_topology_change_event(const cql_transport::event::topology_change& event);
+        response_ptr make_status_change_event(const cql_transport::event::status_change& event);
+        response_ptr make_schema_change_event(const cql_transport::event::schema_change& event);
+        response_ptr make_autheticate(int16_t, const sstring&, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_auth_success(int16_t, bytes, const tracing::trace_state_ptr& tr_state);
+        response_ptr make_auth_challenge(int16_t, bytes, const tracing::trace_state_ptr& tr_state);
+
+        void write_response(foreign_ptr<response_ptr>&& response, cql_compression compression = cql_compression::none);
 
         void init_cql_serialization_format();
 
@@ -557,7 +557,7 @@ public:
         return make_value(db_clock::time_point(db_clock::duration(tmp)));
     }
     virtual bool less(bytes_view b1, bytes_view b2) const override {
-        return compare_unsigned(b1, b2);
+        return compare_unsigned(b1, b2) < 0;
     }
     virtual bool is_byte_order_comparable() const override {
         return true;
@@ -638,19 +638,30 @@ struct timeuuid_type_impl : public concrete_type<utils::UUID> {
         }
         return make_value(utils::UUID(msb, lsb));
     }
-    virtual bool less(bytes_view b1, bytes_view b2) const override {
+    virtual int32_t compare(bytes_view b1, bytes_view b2) const override {
         if (b1.empty()) {
-            return b2.empty() ? false : true;
+            return b2.empty() ? 0 : -1;
         }
         if (b2.empty()) {
-            return false;
+            return 1;
         }
         auto r = compare_bytes(b1, b2);
         if (r != 0) {
-            return r < 0;
-        } else {
-            return std::lexicographical_compare(b1.begin(), b1.end(), b2.begin(), b2.end());
+            return r;
+        }
+        // Note: the tie-break compares the raw bytes as signed values, to
+        // keep the ordering the two-way less() historically produced.
+        auto mm = std::mismatch(b1.begin(), b1.end(), b2.begin(), b2.end());
+        if (mm.first == b1.end()) {
+            return mm.second == b2.end() ? 0 : -1;
         }
+        if (mm.second == b2.end()) {
+            return 1;
+        }
+        return *mm.first < *mm.second ? -1 : 1;
+    }
+    virtual bool less(bytes_view b1, bytes_view b2) const override {
+        return compare(b1, b2) < 0;
     }
     virtual bool is_byte_order_equal() const override {
         return true;
@@ -703,19 +714,22 @@ struct timeuuid_type_impl : public concrete_type<utils::UUID> {
         return cql3::cql3_type::timeuuid;
     }
 private:
-    static int compare_bytes(bytes_view o1, bytes_view o2) {
-        auto compare_pos = [&] (unsigned pos, int mask, int ifequal) {
-            int d = (o1[pos] & mask) - (o2[pos] & mask);
-            return d ? d : ifequal;
+    // Reassemble the on-wire timeuuid layout (time_low, time_mid, time_hi)
+    // into an integer which sorts in timestamp order: version nibble first,
+    // then time-hi, time-mid and time-low. This replaces a chain of eight
+    // dependent byte compares with two key builds and one integer compare.
+    static uint64_t timeuuid_read_msb(bytes_view o) {
+        auto b = [&o] (unsigned pos) {
+            return uint64_t(uint8_t(o[pos]));
         };
-        return compare_pos(6, 0xf,
-            compare_pos(7, 0xff,
-                compare_pos(4, 0xff,
-                    compare_pos(5, 0xff,
-                        compare_pos(0, 0xff,
-                            compare_pos(1, 0xff,
-                                compare_pos(2, 0xff,
-                                    compare_pos(3, 0xff, 0))))))));
+        return (b(6) & 0xf) << 56 | b(7) << 48
+             | b(4) << 40 | b(5) << 32
+             | b(0) << 24 | b(1) << 16 | b(2) << 8 | b(3);
+    }
+    static int compare_bytes(bytes_view o1, bytes_view o2) {
+        auto t1 = timeuuid_read_msb(o1);
+        auto t2 = timeuuid_read_msb(o2);
+        return t1 < t2 ? -1 : t1 > t2 ? 1 : 0;
     }
     friend class uuid_type_impl;
 };
@@ -1116,27 +1130,30 @@ struct uuid_type_impl : concrete_type<utils::UUID> {
         }
         return make_value(utils::UUID(msb, lsb));
     }
-    virtual bool less(bytes_view b1, bytes_view b2) const override {
+    virtual int32_t compare(bytes_view b1, bytes_view b2) const override {
         if (b1.size() < 16) {
-            return b2.size() < 16 ? false : true;
+            return b2.size() < 16 ? 0 : -1;
         }
         if (b2.size() < 16) {
-            return false;
+            return 1;
         }
         auto v1 = (b1[6] >> 4) & 0x0f;
         auto v2 = (b2[6] >> 4) & 0x0f;
 
         if (v1 != v2) {
-            return v1 < v2;
+            return v1 < v2 ? -1 : 1;
         }
 
         if (v1 == 1) {
             auto c = timeuuid_type_impl::compare_bytes(b1, b2);
             if (c) {
-                return c < 0;
+                return c;
             }
         }
-        return less_unsigned(b1, b2);
+        return compare_unsigned(b1, b2);
+    }
+    virtual bool less(bytes_view b1, bytes_view b2) const override {
+        return compare(b1, b2) < 0;
     }
     // FIXME: isCompatibleWith(uuid)
     virtual bool is_byte_order_equal() const override {
@@ -451,6 +451,12 @@ public:
         return compare(v1, v2) == 0;
     }
     virtual int32_t compare(bytes_view v1, bytes_view v2) const {
+        // Falling back on less() costs two full comparisons per call; most
+        // types are byte-order comparable, for which a single unsigned
+        // comparison is the ordering by definition.
+        if (is_byte_order_comparable()) {
+            return compare_unsigned(v1, v2);
+        }
         if (less(v1, v2)) {
             return -1;
         } else if (less(v2, v1)) {
@@ -1328,6 +1334,8 @@ size_t collection_value_len(cql_serialization_format sf);
 void write_collection_size(bytes::iterator& out, int size, cql_serialization_format sf);
 void write_collection_value(bytes::iterator& out, cql_serialization_format sf, bytes_view val_bytes);
 void write_collection_value(bytes::iterator& out, cql_serialization_format sf, data_type type, const data_value& value);
+int read_collection_size(bytes_view& in, cql_serialization_format sf);
+bytes_view read_collection_value(bytes_view& in, cql_serialization_format sf);
 
 using user_type = shared_ptr<const user_type_impl>;
 using tuple_type = shared_ptr<const tuple_type_impl>;
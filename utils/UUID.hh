@@ -41,6 +41,10 @@ class UUID {
 private:
     int64_t most_sig_bits;
     int64_t least_sig_bits;
+
+    unsigned __int128 as_u128() const {
+        return (unsigned __int128)uint64_t(most_sig_bits) << 64 | uint64_t(least_sig_bits);
+    }
 public:
     UUID() : most_sig_bits(0), least_sig_bits(0) {}
     UUID(int64_t most_sig_bits, int64_t least_sig_bits)
@@ -93,12 +97,10 @@ public:
         return !(*this == v);
     }
 
+    // Lexicographical comparison of the unsigned msb/lsb pair, done as a
+    // single 128-bit compare to keep it branchless on the hot path.
     bool operator<(const UUID& v) const {
-         if (most_sig_bits != v.most_sig_bits) {
-             return uint64_t(most_sig_bits) < uint64_t(v.most_sig_bits);
-         } else {
-             return uint64_t(least_sig_bits) < uint64_t(v.least_sig_bits);
-         }
+        return as_u128() < v.as_u128();
     }
 
     bool operator>(const UUID& v) const {
@@ -32,22 +32,32 @@ bool validate(const uint8_t *data, size_t len) {
     // OR all bytes
     uint8_t orall = 0;
 
-    // Fast OR by 8-bytes and two independent streams
-    if (len >= 16) {
-        uint64_t or1 = 0, or2 = 0;
+    // Fast OR by 8-bytes and four independent streams
+    if (len >= 32) {
+        uint64_t or1 = 0, or2 = 0, or3 = 0, or4 = 0;
 
         do {
             or1 |= seastar::read_le<uint64_t>((const char *)data);
             or2 |= seastar::read_le<uint64_t>((const char *)data+8);
+            or3 |= seastar::read_le<uint64_t>((const char *)data+16);
+            or4 |= seastar::read_le<uint64_t>((const char *)data+24);
 
-            data += 16;
-            len -= 16;
-        } while (len >= 16);
+            data += 32;
+            len -= 32;
+        } while (len >= 32);
 
         // Idea from Benny Halevy <bhalevy@scylladb.com>
         // - 7-th bit set   ==> orall = !(non-zero) - 1 = 0 - 1 = 0xFF
         // - 7-th bit clear ==> orall = !0 - 1          = 1 - 1 = 0x00
-        orall = !((or1 | or2) & 0x8080808080808080ULL) - 1;
+        orall = !((or1 | or2 | or3 | or4) & 0x8080808080808080ULL) - 1;
+    }
+
+    // OR the remaining 8-byte words
+    while (len >= 8) {
+        orall |= !(seastar::read_le<uint64_t>((const char *)data) & 0x8080808080808080ULL) - 1;
+
+        data += 8;
+        len -= 8;
     }
 
     // OR remaining bytes
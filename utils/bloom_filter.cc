@@ -88,6 +88,38 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+void bloom_filter::is_present_many(const hashed_key* keys, size_t count, bool* results) {
+    // Resolve probes in chunks: compute all bit indices for a chunk up front
+    // and prefetch the words they touch before any of them is tested, so the
+    // dependent load chains of the individual probes overlap instead of being
+    // serviced one cache miss at a time.
+    static constexpr size_t chunk_size = 8;
+    const int64_t max = _bitset.size();
+    std::vector<size_t> indices;
+    indices.reserve(chunk_size * _hash_count);
+    size_t done = 0;
+    while (done != count) {
+        const size_t n = std::min(chunk_size, count - done);
+        indices.clear();
+        for (size_t k = 0; k != n; ++k) {
+            for_each_index(keys[done + k], _hash_count, max, _format, [&] (auto i) {
+                indices.push_back(i);
+                _bitset.prefetch(i);
+                return stop_iteration::no;
+            });
+        }
+        auto it = indices.begin();
+        for (size_t k = 0; k != n; ++k) {
+            bool present = true;
+            for (int h = 0; h != _hash_count; ++h, ++it) {
+                present = present && _bitset.test(*it);
+            }
+            results[done + k] = present;
+        }
+        done += n;
+    }
+}
+
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
@@ -75,6 +75,8 @@ public:
 
     virtual bool is_present(hashed_key key) override;
 
+    virtual void is_present_many(const hashed_key* keys, size_t count, bool* results) override;
+
     virtual void clear() override {
         _bitset.clear();
     }
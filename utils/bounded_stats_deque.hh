@@ -38,10 +38,12 @@
 
 #pragma once
 
-namespace utils {
-
+#include <algorithm>
+#include <cmath>
 #include <deque>
 
+namespace utils {
+
 /**
  * bounded threadsafe deque
  */
@@ -49,6 +51,8 @@ class bounded_stats_deque {
 private:
     std::deque<long> _deque;
     long _sum = 0;
+    // kept as a double: the samples are clock ticks, whose squares overflow long
+    double _sum_of_squares = 0;
     int _max_size;
 public:
     bounded_stats_deque(int size)
@@ -64,9 +68,11 @@ public:
             auto removed = _deque.front();
             _deque.pop_front();
             _sum -= removed;
+            _sum_of_squares -= double(removed) * removed;
         }
         _deque.push_back(i);
         _sum += i;
+        _sum_of_squares += double(i) * i;
     }
 
     long sum() {
@@ -77,6 +83,21 @@ public:
         return size() > 0 ? ((double) sum()) / size() : 0;
     }
 
+    // population variance over the window, maintained incrementally so
+    // that querying it is O(1) regardless of the window size
+    double variance() {
+        if (size() == 0) {
+            return 0;
+        }
+        auto m = mean();
+        // clamp: the two-pass identity can go slightly negative due to rounding
+        return std::max(_sum_of_squares / size() - m * m, 0.0);
+    }
+
+    double stddev() {
+        return std::sqrt(variance());
+    }
+
     const std::deque<long>& deque() const {
         return _deque;
     }
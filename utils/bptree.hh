@@ -0,0 +1,563 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "utils/allocation_strategy.hh"
+
+namespace utils {
+
+// A B+-tree map which keeps keys and values packed in multi-entry nodes
+// instead of one allocation per element. Compared with a red-black tree
+// (e.g. intrusive_set_external_comparator) this trades three pointers per
+// element for roughly one pointer per NodeSize elements, and makes ordered
+// scans walk contiguous arrays rather than chase per-node pointers.
+//
+// Nodes are allocated with the current allocation strategy and are
+// migratable, so the tree can live inside an LSA region: a migrated node
+// fixes up its parent's child slot (or the owning tree's root pointer),
+// its children's parent pointers and its siblings' links, following the
+// same back-reference pattern as managed_vector. As with other containers
+// over compacting allocators, iterators and references are invalidated by
+// memory compaction, so they must not be kept across deferring points.
+//
+// Comparators are external and passed to each operation, like in
+// intrusive_set_external_comparator, so that keys can be compared with a
+// schema-dependent ordering without storing the comparator in the tree.
+//
+// Erase does not rebalance: a node is reclaimed when it becomes empty and
+// an inner node left with a single child is collapsed into its parent.
+// Occupancy can therefore degrade below the classical 50% minimum under
+// adversarial deletion patterns, which is acceptable for the intended
+// users, where erase is rare compared to insertion and full clear.
+template <typename Key, typename T, unsigned NodeSize = 8>
+class bptree {
+    static_assert(NodeSize >= 4 && NodeSize % 2 == 0, "NodeSize must be an even number not smaller than 4");
+    static_assert(std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_assignable<Key>::value,
+        "keys stored in bptree need to be nothrow move-constructible and move-assignable");
+    static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+        "objects stored in bptree need to be nothrow move-constructible and move-assignable");
+
+    template <typename U>
+    union maybe_constructed {
+        maybe_constructed() { }
+        ~maybe_constructed() { }
+        U object;
+    };
+
+    struct inner_node;
+
+    struct node {
+        union {
+            inner_node* _parent; // when !_is_root
+            bptree* _tree; // when _is_root
+        };
+        uint8_t _count = 0;
+        const bool _is_leaf;
+        bool _is_root = false;
+
+        explicit node(bool is_leaf) noexcept : _parent(nullptr), _is_leaf(is_leaf) { }
+    };
+
+    struct inner_node final : node {
+        maybe_constructed<Key> _keys[NodeSize];
+        node* _children[NodeSize + 1];
+
+        inner_node() noexcept : node(false) { }
+        inner_node(inner_node&& o) noexcept : node(o) {
+            for (unsigned i = 0; i < this->_count; i++) {
+                new (&_keys[i].object) Key(std::move(o._keys[i].object));
+                o._keys[i].object.~Key();
+            }
+            for (unsigned i = 0; i <= this->_count; i++) {
+                _children[i] = o._children[i];
+                _children[i]->_parent = this;
+            }
+            o._count = 0;
+            if (this->_is_root) {
+                this->_tree->_root = this;
+            } else {
+                this->_parent->replace_child(&o, this);
+            }
+        }
+        ~inner_node() {
+            for (unsigned i = 0; i < this->_count; i++) {
+                _keys[i].object.~Key();
+            }
+        }
+
+        void replace_child(node* from, node* to) noexcept {
+            for (unsigned i = 0; i <= this->_count; i++) {
+                if (_children[i] == from) {
+                    _children[i] = to;
+                    return;
+                }
+            }
+        }
+    };
+
+    struct leaf_node final : node {
+        maybe_constructed<Key> _keys[NodeSize];
+        maybe_constructed<T> _values[NodeSize];
+        leaf_node* _prev = nullptr;
+        leaf_node* _next = nullptr;
+
+        leaf_node() noexcept : node(true) { }
+        leaf_node(leaf_node&& o) noexcept : node(o), _prev(o._prev), _next(o._next) {
+            for (unsigned i = 0; i < this->_count; i++) {
+                new (&_keys[i].object) Key(std::move(o._keys[i].object));
+                o._keys[i].object.~Key();
+                new (&_values[i].object) T(std::move(o._values[i].object));
+                o._values[i].object.~T();
+            }
+            o._count = 0;
+            if (_prev) {
+                _prev->_next = this;
+            }
+            if (_next) {
+                _next->_prev = this;
+            }
+            if (this->_is_root) {
+                this->_tree->_root = this;
+            } else {
+                this->_parent->replace_child(&o, this);
+            }
+        }
+        ~leaf_node() {
+            for (unsigned i = 0; i < this->_count; i++) {
+                _keys[i].object.~Key();
+                _values[i].object.~T();
+            }
+        }
+    };
+private:
+    node* _root = nullptr;
+    size_t _size = 0;
+private:
+    // First index i such that comp(key, _keys[i]); descending through
+    // _children[i] maintains the invariant that all keys in _children[i]
+    // compare not less than _keys[i - 1] and less than _keys[i].
+    template <typename K, typename Compare>
+    static unsigned upper_bound_index(const inner_node* n, const K& key, Compare& comp) {
+        unsigned i = 0;
+        while (i < n->_count && !comp(key, n->_keys[i].object)) {
+            i++;
+        }
+        return i;
+    }
+
+    // Makes room for a separator and a new right-hand child at position i,
+    // all-nothrow since the key is already materialized by the caller.
+    static void insert_separator_and_child(inner_node* p, unsigned i, Key k, node* right) noexcept {
+        if (p->_count > i) {
+            new (&p->_keys[p->_count].object) Key(std::move(p->_keys[p->_count - 1].object));
+            for (unsigned j = p->_count - 1; j > i; j--) {
+                p->_keys[j].object = std::move(p->_keys[j - 1].object);
+            }
+            p->_keys[i].object = std::move(k);
+        } else {
+            new (&p->_keys[i].object) Key(std::move(k));
+        }
+        for (unsigned j = p->_count + 1; j > i + 1; j--) {
+            p->_children[j] = p->_children[j - 1];
+        }
+        p->_children[i + 1] = right;
+        right->_parent = p;
+        p->_count++;
+    }
+
+    // Splits the full child at p->_children[i] in half. p must not be full.
+    // Only allocation and the separator key copy may throw, and they happen
+    // before any state is mutated.
+    void split_child(inner_node* p, unsigned i) {
+        node* child = p->_children[i];
+        if (child->_is_leaf) {
+            auto c = static_cast<leaf_node*>(child);
+            auto right = current_allocator().construct<leaf_node>();
+            constexpr unsigned keep = NodeSize / 2;
+            try {
+                insert_separator_and_child(p, i, Key(c->_keys[keep].object), right);
+            } catch (...) {
+                current_allocator().destroy(right);
+                throw;
+            }
+            for (unsigned j = keep; j < NodeSize; j++) {
+                new (&right->_keys[j - keep].object) Key(std::move(c->_keys[j].object));
+                c->_keys[j].object.~Key();
+                new (&right->_values[j - keep].object) T(std::move(c->_values[j].object));
+                c->_values[j].object.~T();
+            }
+            c->_count = keep;
+            right->_count = NodeSize - keep;
+            right->_next = c->_next;
+            if (right->_next) {
+                right->_next->_prev = right;
+            }
+            right->_prev = c;
+            c->_next = right;
+        } else {
+            auto c = static_cast<inner_node*>(child);
+            auto right = current_allocator().construct<inner_node>();
+            constexpr unsigned keep = NodeSize / 2;
+            // The median separator moves up instead of being copied.
+            insert_separator_and_child(p, i, std::move(c->_keys[keep].object), right);
+            c->_keys[keep].object.~Key();
+            for (unsigned j = keep + 1; j < NodeSize; j++) {
+                new (&right->_keys[j - keep - 1].object) Key(std::move(c->_keys[j].object));
+                c->_keys[j].object.~Key();
+            }
+            for (unsigned j = keep + 1; j <= NodeSize; j++) {
+                right->_children[j - keep - 1] = c->_children[j];
+                right->_children[j - keep - 1]->_parent = right;
+            }
+            c->_count = keep;
+            right->_count = NodeSize - keep - 1;
+        }
+    }
+
+    void grow_root() {
+        auto new_root = current_allocator().construct<inner_node>();
+        new_root->_children[0] = _root;
+        new_root->_is_root = true;
+        new_root->_tree = this;
+        node* old_root = _root;
+        old_root->_is_root = false;
+        old_root->_parent = new_root;
+        _root = new_root;
+        try {
+            split_child(new_root, 0);
+        } catch (...) {
+            // new_root may have been migrated, so re-read it through _root.
+            auto nr = static_cast<inner_node*>(_root);
+            _root = nr->_children[0];
+            _root->_is_root = true;
+            _root->_tree = this;
+            current_allocator().destroy(nr);
+            throw;
+        }
+    }
+
+    void remove_child(inner_node* p, node* c) {
+        unsigned i = 0;
+        while (p->_children[i] != c) {
+            i++;
+        }
+        unsigned nr_keys = p->_count;
+        unsigned ki = i == 0 ? 0 : i - 1;
+        for (unsigned j = ki; j + 1 < nr_keys; j++) {
+            p->_keys[j].object = std::move(p->_keys[j + 1].object);
+        }
+        p->_keys[nr_keys - 1].object.~Key();
+        for (unsigned j = i; j < nr_keys; j++) {
+            p->_children[j] = p->_children[j + 1];
+        }
+        p->_count--;
+        if (p->_count == 0) {
+            // Collapse the single-child node to keep search paths short.
+            node* only = p->_children[0];
+            if (p->_is_root) {
+                only->_is_root = true;
+                only->_tree = this;
+                _root = only;
+            } else {
+                only->_parent = p->_parent;
+                p->_parent->replace_child(p, only);
+            }
+            current_allocator().destroy(p);
+        }
+    }
+
+    void unlink_leaf(leaf_node* l) {
+        if (l->_prev) {
+            l->_prev->_next = l->_next;
+        }
+        if (l->_next) {
+            l->_next->_prev = l->_prev;
+        }
+        if (l->_is_root) {
+            _root = nullptr;
+        } else {
+            remove_child(l->_parent, l);
+        }
+        current_allocator().destroy(l);
+    }
+
+    void free_subtree(node* n) {
+        if (n->_is_leaf) {
+            current_allocator().destroy(static_cast<leaf_node*>(n));
+        } else {
+            auto p = static_cast<inner_node*>(n);
+            for (unsigned i = 0; i <= p->_count; i++) {
+                free_subtree(p->_children[i]);
+            }
+            current_allocator().destroy(p);
+        }
+    }
+
+    leaf_node* leftmost_leaf() const noexcept {
+        node* n = _root;
+        while (!n->_is_leaf) {
+            n = static_cast<inner_node*>(n)->_children[0];
+        }
+        return static_cast<leaf_node*>(n);
+    }
+
+    template <typename K, typename Compare>
+    leaf_node* leaf_for(const K& key, Compare& comp) const {
+        node* n = _root;
+        while (!n->_is_leaf) {
+            auto p = static_cast<inner_node*>(n);
+            n = p->_children[upper_bound_index(p, key, comp)];
+        }
+        return static_cast<leaf_node*>(n);
+    }
+public:
+    class iterator {
+        leaf_node* _node = nullptr;
+        unsigned _idx = 0;
+        friend class bptree;
+        friend class const_iterator;
+        iterator(leaf_node* n, unsigned idx) noexcept : _node(n), _idx(idx) { }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        const Key& key() const noexcept { return _node->_keys[_idx].object; }
+        T& operator*() const noexcept { return _node->_values[_idx].object; }
+        T* operator->() const noexcept { return &_node->_values[_idx].object; }
+        iterator& operator++() noexcept {
+            if (++_idx == _node->_count) {
+                _node = _node->_next;
+                _idx = 0;
+            }
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            auto it = *this;
+            operator++();
+            return it;
+        }
+        bool operator==(const iterator& o) const noexcept { return _node == o._node && _idx == o._idx; }
+        bool operator!=(const iterator& o) const noexcept { return !(*this == o); }
+    };
+
+    class const_iterator {
+        const leaf_node* _node = nullptr;
+        unsigned _idx = 0;
+        friend class bptree;
+        const_iterator(const leaf_node* n, unsigned idx) noexcept : _node(n), _idx(idx) { }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        const_iterator(const iterator& it) noexcept : _node(it._node), _idx(it._idx) { }
+        const Key& key() const noexcept { return _node->_keys[_idx].object; }
+        const T& operator*() const noexcept { return _node->_values[_idx].object; }
+        const T* operator->() const noexcept { return &_node->_values[_idx].object; }
+        const_iterator& operator++() noexcept {
+            if (++_idx == _node->_count) {
+                _node = _node->_next;
+                _idx = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            auto it = *this;
+            operator++();
+            return it;
+        }
+        bool operator==(const const_iterator& o) const noexcept { return _node == o._node && _idx == o._idx; }
+        bool operator!=(const const_iterator& o) const noexcept { return !(*this == o); }
+    };
+public:
+    bptree() = default;
+    bptree(const bptree&) = delete;
+    bptree(bptree&& o) noexcept : _root(o._root), _size(o._size) {
+        o._root = nullptr;
+        o._size = 0;
+        if (_root) {
+            _root->_tree = this;
+        }
+    }
+    bptree& operator=(bptree&& o) noexcept {
+        if (this != &o) {
+            this->~bptree();
+            new (this) bptree(std::move(o));
+        }
+        return *this;
+    }
+    ~bptree() {
+        clear();
+    }
+
+    bool empty() const noexcept { return _size == 0; }
+    size_t size() const noexcept { return _size; }
+
+    iterator begin() noexcept {
+        return _root ? iterator(leftmost_leaf(), 0) : end();
+    }
+    const_iterator begin() const noexcept {
+        return _root ? const_iterator(leftmost_leaf(), 0) : end();
+    }
+    iterator end() noexcept { return iterator(); }
+    const_iterator end() const noexcept { return const_iterator(); }
+
+    // Inserts a unique key. Returns the position of the inserted or the
+    // already existing element, like std::map::insert().
+    template <typename Compare>
+    std::pair<iterator, bool> insert(Key key, T value, Compare comp) {
+        if (!_root) {
+            auto l = current_allocator().construct<leaf_node>();
+            l->_is_root = true;
+            l->_tree = this;
+            _root = l;
+        } else if (_root->_count == NodeSize) {
+            grow_root();
+        }
+        node* n = _root;
+        while (!n->_is_leaf) {
+            auto p = static_cast<inner_node*>(n);
+            unsigned i = upper_bound_index(p, key, comp);
+            if (p->_children[i]->_count == NodeSize) {
+                // Split full nodes on the way down so that splits never
+                // need to propagate back up.
+                split_child(p, i);
+                if (!comp(key, p->_keys[i].object)) {
+                    i++;
+                }
+            }
+            n = p->_children[i];
+        }
+        auto l = static_cast<leaf_node*>(n);
+        unsigned i = 0;
+        while (i < l->_count && comp(l->_keys[i].object, key)) {
+            i++;
+        }
+        if (i < l->_count && !comp(key, l->_keys[i].object)) {
+            return std::make_pair(iterator(l, i), false);
+        }
+        if (i < l->_count) {
+            new (&l->_keys[l->_count].object) Key(std::move(l->_keys[l->_count - 1].object));
+            new (&l->_values[l->_count].object) T(std::move(l->_values[l->_count - 1].object));
+            for (unsigned j = l->_count - 1; j > i; j--) {
+                l->_keys[j].object = std::move(l->_keys[j - 1].object);
+                l->_values[j].object = std::move(l->_values[j - 1].object);
+            }
+            l->_keys[i].object = std::move(key);
+            l->_values[i].object = std::move(value);
+        } else {
+            new (&l->_keys[i].object) Key(std::move(key));
+            new (&l->_values[i].object) T(std::move(value));
+        }
+        l->_count++;
+        _size++;
+        return std::make_pair(iterator(l, i), true);
+    }
+
+    template <typename K, typename Compare>
+    iterator lower_bound(const K& key, Compare comp) {
+        if (!_root) {
+            return end();
+        }
+        auto l = leaf_for(key, comp);
+        unsigned i = 0;
+        while (i < l->_count && comp(l->_keys[i].object, key)) {
+            i++;
+        }
+        return i < l->_count ? iterator(l, i) : (l->_next ? iterator(l->_next, 0) : end());
+    }
+    template <typename K, typename Compare>
+    const_iterator lower_bound(const K& key, Compare comp) const {
+        return const_cast<bptree*>(this)->lower_bound(key, std::move(comp));
+    }
+
+    template <typename K, typename Compare>
+    iterator upper_bound(const K& key, Compare comp) {
+        if (!_root) {
+            return end();
+        }
+        auto l = leaf_for(key, comp);
+        unsigned i = 0;
+        while (i < l->_count && !comp(key, l->_keys[i].object)) {
+            i++;
+        }
+        return i < l->_count ? iterator(l, i) : (l->_next ? iterator(l->_next, 0) : end());
+    }
+    template <typename K, typename Compare>
+    const_iterator upper_bound(const K& key, Compare comp) const {
+        return const_cast<bptree*>(this)->upper_bound(key, std::move(comp));
+    }
+
+    template <typename K, typename Compare>
+    iterator find(const K& key, Compare comp) {
+        auto it = lower_bound(key, comp);
+        return it != end() && !comp(key, it.key()) ? it : end();
+    }
+    template <typename K, typename Compare>
+    const_iterator find(const K& key, Compare comp) const {
+        return const_cast<bptree*>(this)->find(key, std::move(comp));
+    }
+
+    // Erases the pointed-to element and returns the position of its
+    // successor.
+    iterator erase(iterator it) {
+        leaf_node* l = it._node;
+        unsigned i = it._idx;
+        for (unsigned j = i; j + 1 < l->_count; j++) {
+            l->_keys[j].object = std::move(l->_keys[j + 1].object);
+            l->_values[j].object = std::move(l->_values[j + 1].object);
+        }
+        l->_keys[l->_count - 1].object.~Key();
+        l->_values[l->_count - 1].object.~T();
+        l->_count--;
+        _size--;
+        if (i < l->_count) {
+            return iterator(l, i);
+        }
+        leaf_node* next = l->_next;
+        if (l->_count == 0) {
+            unlink_leaf(l);
+        }
+        return next ? iterator(next, 0) : end();
+    }
+
+    void clear() {
+        if (_root) {
+            free_subtree(_root);
+            _root = nullptr;
+        }
+        _size = 0;
+    }
+};
+
+}
@@ -52,6 +52,9 @@ class chunked_vector {
     utils::small_vector<chunk_ptr, 1> _chunks;
     size_t _size = 0;
     size_t _capacity = 0;
+    // Largest reserve() seen; chunks past _capacity are materialized on
+    // append rather than up front, and this sizes the tail chunk exactly.
+    size_t _reserved = 0;
 private:
     static size_t max_chunk_capacity() {
         return std::max(max_contiguous_allocation / sizeof(T), size_t(1));
@@ -62,7 +65,7 @@ private:
         }
     }
     void do_reserve_for_push_back();
-    void make_room(size_t n);
+    void make_room(size_t n, bool eager);
     chunk_ptr new_chunk(size_t n);
     T* addr(size_t i) const {
         return &_chunks[i / max_chunk_capacity()][i % max_chunk_capacity()];
@@ -144,9 +147,14 @@ public:
     void clear();
     void shrink_to_fit();
     void resize(size_t n);
+    // Ensures that appends up to n elements will not migrate existing
+    // elements. The backing chunks past the current one are materialized
+    // lazily as appends reach them, so reserving a huge capacity does not
+    // allocate it all up front.
     void reserve(size_t n) {
+        _reserved = std::max(_reserved, n);
         if (n > _capacity) {
-            make_room(n);
+            make_room(n, false);
         }
     }
 
@@ -271,7 +279,8 @@ template <typename T, size_t max_contiguous_allocation>
 chunked_vector<T, max_contiguous_allocation>::chunked_vector(chunked_vector&& x) noexcept
         : _chunks(std::exchange(x._chunks, {}))
         , _size(std::exchange(x._size, 0))
-        , _capacity(std::exchange(x._capacity, 0)) {
+        , _capacity(std::exchange(x._capacity, 0))
+        , _reserved(std::exchange(x._reserved, 0)) {
 }
 
 template <typename T, size_t max_contiguous_allocation>
@@ -345,7 +354,7 @@ chunked_vector<T, max_contiguous_allocation>::migrate(T* begin, T* end, T* resul
 
 template <typename T, size_t max_contiguous_allocation>
 void
-chunked_vector<T, max_contiguous_allocation>::make_room(size_t n) {
+chunked_vector<T, max_contiguous_allocation>::make_room(size_t n, bool eager) {
     // First, if the last chunk is below max_chunk_capacity(), enlarge it
 
     auto last_chunk_capacity_deficit = _chunks.size() * max_chunk_capacity() - _capacity;
@@ -365,9 +374,14 @@ chunked_vector<T, max_contiguous_allocation>::make_room(size_t n) {
     auto nr_chunks = (n + max_chunk_capacity() - 1) / max_chunk_capacity();
     _chunks.reserve(nr_chunks);
 
-    // Add more chunks as needed
+    // Add more chunks as needed. When not eager, materialize only the first
+    // chunk of an empty vector, so appends don't start from a small chunk
+    // and migrate; the remaining chunks are allocated as appends reach them.
 
     while (_capacity < n) {
+        if (!eager && !_chunks.empty()) {
+            break;
+        }
         auto now = std::min(n - _capacity, max_chunk_capacity());
         _chunks.push_back(new_chunk(now));
         _capacity += now;
@@ -379,13 +393,18 @@ void
 chunked_vector<T, max_contiguous_allocation>::do_reserve_for_push_back() {
     if (_capacity == 0) {
         // allocate a bit of room in case utilization will be low
-        reserve(boost::algorithm::clamp(512 / sizeof(T), 1, max_chunk_capacity()));
+        reserve(boost::algorithm::clamp(128 / sizeof(T), 1, max_chunk_capacity()));
     } else if (_capacity < max_chunk_capacity() / 2) {
         // exponential increase when only one chunk to reduce copying
         reserve(_capacity * 2);
     } else {
-        // add a chunk at a time later, since no copying will take place
-        reserve((_capacity / max_chunk_capacity() + 1) * max_chunk_capacity());
+        // add a chunk at a time, since no copying will take place; an
+        // outstanding reserve() sizes the tail chunk exactly
+        auto target = (_capacity / max_chunk_capacity() + 1) * max_chunk_capacity();
+        if (_reserved > _capacity && _reserved < target) {
+            target = _reserved;
+        }
+        make_room(target, true);
     }
 }
 
@@ -406,6 +425,7 @@ chunked_vector<T, max_contiguous_allocation>::resize(size_t n) {
 template <typename T, size_t max_contiguous_allocation>
 void
 chunked_vector<T, max_contiguous_allocation>::shrink_to_fit() {
+    _reserved = _size;
     if (_chunks.empty()) {
         return;
     }
@@ -414,7 +434,7 @@ chunked_vector<T, max_contiguous_allocation>::shrink_to_fit() {
         _capacity = _chunks.size() * max_chunk_capacity();
     }
 
-    auto overcapacity = _size - _capacity;
+    auto overcapacity = _capacity - _size;
     if (overcapacity) {
         auto new_last_chunk_capacity = _size - (_chunks.size() - 1) * max_chunk_capacity();
         // FIXME: realloc? maybe not worth the complication; only works for PODs
@@ -30,6 +30,11 @@
 namespace utils {
 
 void dynamic_bitset::set(size_t n) {
+    if (test(n)) {
+        return;
+    }
+    ++_block_counts[n / bits_per_block];
+    ++_count;
     for (auto& level : _bits) {
         auto idx = n / bits_per_int;
         auto old = level[idx];
@@ -42,6 +47,11 @@ void dynamic_bitset::set(size_t n) {
 }
 
 void dynamic_bitset::clear(size_t n) {
+    if (!test(n)) {
+        return;
+    }
+    --_block_counts[n / bits_per_block];
+    --_count;
     for (auto& level : _bits) {
         auto idx = n / bits_per_int;
         auto old = level[idx];
@@ -53,6 +63,56 @@ void dynamic_bitset::clear(size_t n) {
     }
 }
 
+size_t dynamic_bitset::rank(size_t n) const
+{
+    auto block = n / bits_per_block;
+    size_t r = 0;
+    for (size_t b = 0; b != block; ++b) {
+        r += _block_counts[b];
+    }
+    auto first_word = block * words_per_block;
+    auto last_word = n / bits_per_int;
+    for (auto w = first_word; w != last_word; ++w) {
+        r += __builtin_popcountll(_bits[0][w]);
+    }
+    if (n % bits_per_int) {
+        r += __builtin_popcountll(_bits[0][last_word] & mask_lower_bits(n % bits_per_int));
+    }
+    return r;
+}
+
+size_t dynamic_bitset::select(size_t k) const
+{
+    if (k >= _count) {
+        return npos;
+    }
+
+    size_t block = 0;
+    while (k >= _block_counts[block]) {
+        k -= _block_counts[block];
+        ++block;
+    }
+
+    auto w = block * words_per_block;
+    while (true) {
+        auto c = size_t(__builtin_popcountll(_bits[0][w]));
+        if (k < c) {
+            break;
+        }
+        k -= c;
+        ++w;
+    }
+
+    // Drop the k lowest set bits; the answer is then the lowest one left.
+    // A BMI2 pdep kernel could do this in one step, but it would tie the
+    // code to x86 for a loop that runs at most a handful of times here.
+    auto v = _bits[0][w];
+    while (k--) {
+        v &= v - 1;
+    }
+    return w * bits_per_int + count_trailing_zeros(v);
+}
+
 size_t dynamic_bitset::find_first_set() const
 {
     size_t pos = 0;
@@ -137,6 +197,7 @@ dynamic_bitset::dynamic_bitset(size_t nr_bits)
         _bits[level].resize(level_words);
         level_bits = level_words; // for next iteration
     }
+    _block_counts.resize(div_ceil(_bits[0].size(), words_per_block));
 }
 
 }
@@ -34,9 +34,14 @@ class dynamic_bitset {
     static constexpr size_t bits_per_int = std::numeric_limits<int_type>::digits;
     static constexpr int_type all_set = std::numeric_limits<int_type>::max();
     static constexpr unsigned level_shift = seastar::log2ceil(bits_per_int);
+    static constexpr size_t words_per_block = 8;
+    // Block size of the popcount summaries backing rank() and select().
+    static constexpr size_t bits_per_block = bits_per_int * words_per_block;
 private:
     std::vector<std::vector<int_type>> _bits; // level n+1 = 64:1 summary of level n
+    std::vector<uint16_t> _block_counts; // set bits per block of bits_per_block
     size_t _bits_count = 0;
+    size_t _count = 0; // total set bits
     unsigned _nlevels = 0;
 private:
     // For n in range 0..(bits_per_int-1), produces a mask with all bits < n set
@@ -71,6 +76,16 @@ public:
     void clear(size_t n);
 
     size_t size() const { return _bits_count; }
+    // Total number of set bits.
+    size_t count() const { return _count; }
+
+    // Number of set bits in positions [0, n). Walks only the per-block
+    // popcount summaries, so it's proportional to n / bits_per_block
+    // instead of n.
+    size_t rank(size_t n) const;
+    // Position of the k-th (0-based, in increasing order) set bit, or npos
+    // if fewer than k + 1 bits are set. Same complexity as rank().
+    size_t select(size_t k) const;
 
     size_t find_first_set() const;
     size_t find_next_set(size_t n) const;
@@ -71,6 +71,16 @@ struct i_filter {
     virtual void add(const bytes_view& key) = 0;
     virtual bool is_present(const bytes_view& key) = 0;
     virtual bool is_present(hashed_key) = 0;
+
+    // Batched variant of is_present(). results[i] is set to the presence of
+    // keys[i]. The default implementation probes one key at a time;
+    // implementations may override it to resolve the whole batch with
+    // memory-level parallelism.
+    virtual void is_present_many(const hashed_key* keys, size_t count, bool* results) {
+        for (size_t i = 0; i != count; ++i) {
+            results[i] = is_present(keys[i]);
+        }
+    }
     virtual void clear() = 0;
     virtual void close() = 0;
 
@@ -74,6 +74,12 @@ public:
         auto idx2 = idx;
         _storage[idx1] &= ~(int_type(1) << idx2);
     }
+    // Starts bringing the word holding the given bit into cache, so that a
+    // later test() of it doesn't stall on the load. Useful for resolving
+    // batches of independent probes with memory-level parallelism.
+    void prefetch(size_t idx) const {
+        __builtin_prefetch(&_storage[idx / bits_per_int()], 0, 3);
+    }
     void clear();
 
     const utils::chunked_vector<int_type>& get_storage() const {
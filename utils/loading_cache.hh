@@ -60,6 +60,7 @@ private:
     loading_cache_clock_type::time_point _last_read;
     lru_entry* _lru_entry_ptr = nullptr; /// MRU item is at the front, LRU - at the back
     size_t _size = 0;
+    bool _reloading = false;
 
 public:
     timestamped_val(value_type val)
@@ -108,6 +109,14 @@ public:
         return _lru_entry_ptr;
     }
 
+    bool reloading() const noexcept {
+        return _reloading;
+    }
+
+    void set_reloading(bool reloading) noexcept {
+        _reloading = reloading;
+    }
+
 private:
     void touch() noexcept {
         assert(_lru_entry_ptr);
@@ -233,7 +242,9 @@ enum class loading_cache_reload_enabled { no, yes };
 /// The get(key) or get_ptr(key) methods ensures that the "loader" callback is called only once for each cached entry regardless of how many
 /// callers are calling for the get_XXX(key) for the same "key" at the same time. Only after the value is evicted from the cache
 /// it's going to be "loaded" in the context of get_XXX(key). As long as the value is cached get_XXX(key) is going to return the
-/// cached value immediately and reload it in the background every "refresh" time period as described above.
+/// cached value immediately and reload it in the background every "refresh" time period as described above. In particular, a value
+/// whose "refresh" period has already passed is still served right away (stale-while-revalidate) while a single background reload
+/// is started for it, so readers never block on a refresh - only on the initial load or after an eviction.
 ///
 /// \tparam Key type of the cache key
 /// \tparam Tp type of the cached value
@@ -331,6 +342,23 @@ public:
         // We shouldn't be here if caching is disabled
         assert(caching_enabled());
 
+        // Serve cached values without ever blocking the reader: if the value is
+        // there but is already due for a refresh, return the stale value right
+        // away and refresh it in the background. Readers only block when the
+        // value is not in the cache at all (cold cache or after an eviction).
+        set_iterator it = set_find(k);
+        if (it != set_end()) {
+            timestamped_val_ptr ts_val_ptr = it->lru_entry_ptr()->timestamped_value_ptr();
+            if (ReloadEnabled == loading_cache_reload_enabled::yes && ts_val_ptr->loaded() + _refresh < loading_cache_clock_type::now()) {
+                LoadingSharedValuesStats::inc_stale_hits();
+                _logger.trace("{}: serving the stale value, refreshing in the background", k);
+                reload_in_background(ts_val_ptr);
+            } else {
+                LoadingSharedValuesStats::inc_hits();
+            }
+            return make_ready_future<value_ptr>(value_ptr(std::move(ts_val_ptr)));
+        }
+
         return _loading_values.get_or_load(k, [this, load = std::forward<LoadFunc>(load)] (const Key& k) mutable {
             return load(k).then([this] (value_type val) {
                 return ts_value_type(std::move(val));
@@ -502,7 +530,16 @@ private:
             return make_ready_future<>();
         }
 
+        // Single-flight: if a reload of this entry is already in progress there is no point in starting another one.
+        if (ts_value_ptr->reloading()) {
+            _logger.trace("{}: the reload is already in progress", key);
+            return make_ready_future<>();
+        }
+        ts_value_ptr->set_reloading(true);
+
         return _load(key).then_wrapped([this, ts_value_ptr = std::move(ts_value_ptr), &key] (auto&& f) mutable {
+            ts_value_ptr->set_reloading(false);
+
             // if the entry has been evicted by now - simply end here
             if (!ts_value_ptr->lru_entry_ptr()) {
                 _logger.trace("{}: entry was dropped during the reload", key);
@@ -527,6 +564,19 @@ private:
         });
     }
 
+    // Kick off a reload of the given entry without waiting for it to complete.
+    // Reloads are deduplicated: if one is already in flight for this entry the call is a no-op.
+    // Readers keep being served the current (stale) value until the reload succeeds.
+    void reload_in_background(timestamped_val_ptr ts_value_ptr) {
+        if (ts_value_ptr->reloading() || _timer_reads_gate.is_closed()) {
+            return;
+        }
+
+        with_gate(_timer_reads_gate, [this, ts_value_ptr = std::move(ts_value_ptr)] () mutable {
+            return reload(std::move(ts_value_ptr));
+        });
+    }
+
     void drop_expired() {
         auto now = loading_cache_clock_type::now();
         _lru_list.remove_and_dispose_if([now, this] (const ts_value_lru_entry& lru_entry) {
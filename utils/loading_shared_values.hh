@@ -41,6 +41,7 @@ struct do_nothing_loading_shared_values_stats {
     static void inc_misses() noexcept {} // Increase the number of times entry was not found
     static void inc_blocks() noexcept {} // Increase the number of times entry was not ready (>= misses)
     static void inc_evictions() noexcept {} // Increase the number of times entry was evicted
+    static void inc_stale_hits() noexcept {} // Increase the number of times a stale entry was served while being refreshed (loading_cache only)
 };
 
 // Entries stay around as long as there is any live external reference (entry_ptr) to them.
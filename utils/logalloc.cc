@@ -319,6 +319,9 @@ class tracker::impl {
     bool _reclaiming_enabled = true;
     size_t _reclamation_step = 1;
     bool _abort_on_bad_alloc = false;
+    // Occupancy fraction above which compact_on_idle() considers the shard
+    // defragmented enough and stops.
+    double _idle_compaction_target = 1.0;
 private:
     // Prevents tracker's reclaimer from running while live. Reclaimer may be
     // invoked synchronously with allocator. This guard ensures that this
@@ -353,6 +356,7 @@ public:
     size_t non_lsa_used_space();
     void set_reclamation_step(size_t step_in_segments) { _reclamation_step = step_in_segments; }
     size_t reclamation_step() const { return _reclamation_step; }
+    void set_idle_compaction_target_occupancy(double fraction) { _idle_compaction_target = fraction; }
     void enable_abort_on_bad_alloc() { _abort_on_bad_alloc = true; }
     bool should_abort_on_bad_alloc() const { return _abort_on_bad_alloc; }
 };
@@ -573,6 +577,12 @@ public:
         size_t segments_compacted;
         uint64_t memory_allocated;
         uint64_t memory_compacted;
+        // Traffic between the pool and the general allocator. These are the
+        // only points at which the physical placement of a segment's backing
+        // memory can change; segments recycled within the pool keep the
+        // placement given to them by the shard which first touched them.
+        size_t segments_allocated_from_system;
+        size_t segments_released_to_system;
     };
 private:
     stats _stats{};
@@ -631,6 +641,7 @@ size_t segment_pool::reclaim_segments(size_t target) {
         _lsa_owned_segments_bitmap.clear(src_idx);
         src->~segment();
         ::free(src);
+        ++_stats.segments_released_to_system;
         ++reclaimed_segments;
         --_free_segments;
     }
@@ -675,6 +686,7 @@ segment* segment_pool::allocate_segment(size_t reserve, size_t reclamation_step)
             auto seg = new (p) segment;
             auto idx = idx_from_segment(seg);
             _lsa_owned_segments_bitmap.set(idx);
+            ++_stats.segments_allocated_from_system;
             return seg;
         }
     } while (shard_tracker().get_impl().compact_and_evict(reclamation_step * segment::size));
@@ -803,6 +815,7 @@ class segment_pool {
             if (seg) {
                 delete seg;
                 _pool->_std_memory_available += segment::size;
+                ++_pool->_stats.segments_released_to_system;
             }
         }
     };
@@ -822,6 +835,7 @@ public:
             }
             std::unique_ptr<segment, segment_deleter> seg{new segment, segment_deleter(this)};
             _std_memory_available -= segment::size;
+            ++_stats.segments_allocated_from_system;
             _free_segments.push(std::move(seg));
         }
         ++_segments_in_use;
@@ -913,6 +927,8 @@ public:
         size_t segments_compacted;
         uint64_t memory_allocated;
         uint64_t memory_compacted;
+        size_t segments_allocated_from_system;
+        size_t segments_released_to_system;
     };
 private:
     stats _stats{};
@@ -1370,6 +1386,7 @@ public:
     //
     bool is_compactible() const {
         return _reclaiming_enabled
+            && compaction_enabled()
             && (_closed_occupancy.free_space() >= 2 * segment::size)
             && _segment_descs.contains_above_min();
     }
@@ -1672,6 +1689,10 @@ size_t tracker::reclamation_step() const {
     return _impl->reclamation_step();
 }
 
+void tracker::set_idle_compaction_target_occupancy(double fraction) {
+    _impl->set_idle_compaction_target_occupancy(fraction);
+}
+
 void tracker::enable_abort_on_bad_alloc() {
     return _impl->enable_abort_on_bad_alloc();
 }
@@ -1800,7 +1821,7 @@ void tracker::impl::full_compaction() {
     llogger.debug("Full compaction on all regions, {}", region_occupancy());
 
     for (region_impl* r : _regions) {
-        if (r->reclaiming_enabled()) {
+        if (r->reclaiming_enabled() && r->compaction_enabled()) {
             r->full_compaction();
         }
     }
@@ -1892,6 +1913,13 @@ reactor::idle_cpu_handler_result tracker::impl::compact_on_idle(reactor::work_wa
     boost::range::make_heap(_regions, cmp);
 
     while (!check_for_work()) {
+        // Stop once the shard is defragmented enough. Chasing the last
+        // percents has little benefit for peak-hour reclaims but keeps the
+        // CPU from going idle for as long as any region is compactible.
+        if (region_occupancy().used_fraction() >= _idle_compaction_target) {
+            return reactor::idle_cpu_handler_result::no_more_work;
+        }
+
         boost::range::pop_heap(_regions, cmp);
         region::impl* r = _regions.back();
 
@@ -2049,7 +2077,7 @@ bool segment_pool::migrate_segment(segment* src, segment* dst)
         src, dst, src_desc._region);
 
     {
-        if (!src_desc._region->reclaiming_enabled()) {
+        if (!src_desc._region->reclaiming_enabled() || !src_desc._region->compaction_enabled()) {
             llogger.trace("Cannot move segment {}", src);
             return false;
         }
@@ -2118,6 +2146,13 @@ tracker::impl::impl() {
 
         sm::make_derive("memory_allocated", [this] { return shard_segment_pool.statistics().memory_allocated; },
                         sm::description("Counts number of bytes which were requested from LSA allocator.")),
+
+        sm::make_derive("segments_allocated_from_system", [this] { return shard_segment_pool.statistics().segments_allocated_from_system; },
+                        sm::description("Counts a number of segments obtained from the general allocator. Together with segments_released_to_system this "
+                                        "measures the pool's traffic with the general allocator, the only point where the placement of a segment's backing memory can change.")),
+
+        sm::make_derive("segments_released_to_system", [this] { return shard_segment_pool.statistics().segments_released_to_system; },
+                        sm::description("Counts a number of segments returned to the general allocator.")),
     });
 }
 
@@ -2143,6 +2178,15 @@ region* region_group::get_largest_region() {
     return _maximal_rg->_regions.top()->_region;
 }
 
+void region_group::for_each_region(const std::function<void(region*)>& func) {
+    for (region_impl* ri : _regions) {
+        func(ri->_region);
+    }
+    for (region_group* rg : _subgroups) {
+        rg->for_each_region(func);
+    }
+}
+
 void
 region_group::add(region_group* child) {
     child->_subgroup_heap_handle = _subgroups.push(child);
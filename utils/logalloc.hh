@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <seastar/core/memory.hh>
 #include <seastar/core/reactor.hh>
@@ -348,6 +349,10 @@ public:
     // children.
     region* get_largest_region();
 
+    // Calls func with every region owned by this region group and,
+    // recursively, by its children.
+    void for_each_region(const std::function<void(region*)>& func);
+
     // Shutdown is mandatory for every user who has set a threshold
     // Can be called at most once.
     future<> shutdown() {
@@ -477,6 +482,12 @@ public:
     // Returns the minimum number of segments reclaimed during single reclamation cycle.
     size_t reclamation_step() const;
 
+    // Sets the occupancy fraction at which compact_on_idle() stops: once
+    // overall LSA occupancy is at or above this fraction the shard is
+    // considered defragmented enough. 1.0 (the default) compacts for as long
+    // as any region is compactible.
+    void set_idle_compaction_target_occupancy(double fraction);
+
     // Abort on allocation failure from LSA
     void enable_abort_on_bad_alloc();
 
@@ -547,6 +558,9 @@ public:
 class basic_region_impl : public allocation_strategy {
 protected:
     bool _reclaiming_enabled = true;
+    bool _compaction_enabled = true;
+    // Number of live region_pin guards, see below.
+    uint64_t _pin_count = 0;
 public:
     void set_reclaiming_enabled(bool enabled) {
         _reclaiming_enabled = enabled;
@@ -555,6 +569,26 @@ public:
     bool reclaiming_enabled() const {
         return _reclaiming_enabled;
     }
+
+    void set_compaction_enabled(bool enabled) {
+        _compaction_enabled = enabled;
+    }
+
+    bool compaction_enabled() const {
+        return _compaction_enabled && !_pin_count;
+    }
+
+    void pin() {
+        ++_pin_count;
+    }
+
+    void unpin() {
+        --_pin_count;
+    }
+
+    bool is_pinned() const {
+        return _pin_count != 0;
+    }
 };
 
 //
@@ -618,6 +652,22 @@ public:
     // Returns the reclaimability state of this region.
     bool reclaiming_enabled() const { return _impl->reclaiming_enabled(); }
 
+    // Changes whether this region's segments may be compacted or migrated.
+    // Unlike set_reclaiming_enabled(), this doesn't affect allocating
+    // sections, so it can stay off across deferring points while the region
+    // is still being read from and allocated in. Useful for regions whose
+    // contents are about to be freed wholesale, where moving objects around
+    // would be wasted work. Enabled by default.
+    void set_compaction_enabled(bool e) { _impl->set_compaction_enabled(e); }
+
+    // Returns whether this region's segments may be compacted or migrated.
+    bool compaction_enabled() const { return _impl->compaction_enabled(); }
+
+    // See region_pin.
+    void pin() { _impl->pin(); }
+    void unpin() { _impl->unpin(); }
+    bool is_pinned() const { return _impl->is_pinned(); }
+
     // Returns a value which is increased when this region is either compacted or
     // evicted from, which invalidates references into the region.
     // When the value returned by this method doesn't change, references remain valid.
@@ -656,6 +706,24 @@ struct reclaim_lock {
     }
 };
 
+// Pins the region's contents in place for the lifetime of the guard:
+// segments won't be compacted or migrated, so references into the region
+// stay valid. Unlike reclaim_lock, this doesn't interact with allocating
+// sections, so it can be held across deferring points while writers keep
+// allocating into the region; new objects simply go into new segments.
+// Pins are counted, so independent pins may overlap.
+struct region_pin {
+    region& _region;
+    region_pin(region& r)
+        : _region(r)
+    {
+        _region.pin();
+    }
+    ~region_pin() {
+        _region.unpin();
+    }
+};
+
 // Utility for running critical sections which need to lock some region and
 // also allocate LSA memory. The object learns from failures how much it
 // should reserve up front in order to not cause allocation failures.
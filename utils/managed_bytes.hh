@@ -23,6 +23,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <cstddef>
 #include <memory>
 #include "bytes.hh"
 #include "utils/allocation_strategy.hh"
@@ -108,21 +109,53 @@ public:
     };
 private:
     static constexpr size_t max_inline_size = 15;
+    static constexpr int8_t external_size = -1;
+    static constexpr int8_t external_size_with_prefix = -2;
     struct small_blob {
         bytes_view::value_type data[max_inline_size];
-        int8_t size; // -1 -> use blob_storage
+        int8_t size; // negative -> use blob_storage
+    };
+    // Layout when the value is external. The pointer uses only half of the
+    // in-object footprint, so the otherwise unused bytes cache a prefix of
+    // the value. This lets comparisons of differing values resolve without
+    // dereferencing the chunk chain. The prefix is valid only when
+    // small.size == external_size_with_prefix; handing out mutable access
+    // to the data invalidates it.
+    static constexpr size_t max_prefix_size = 7;
+    struct [[gnu::packed]] external_blob {
+        blob_storage::ref_type ptr;
+        bytes_view::value_type prefix[max_prefix_size];
+        int8_t size;
     };
     union u {
         u() {}
         ~u() {}
         blob_storage::ref_type ptr;
         small_blob small;
+        external_blob external;
     } _u;
     static_assert(sizeof(small_blob) > sizeof(blob_storage*), "inline size too small");
+    static_assert(sizeof(external_blob) == sizeof(small_blob), "external layout must not grow the object");
+    static_assert(offsetof(external_blob, size) == offsetof(small_blob, size), "size byte must overlap");
 private:
     bool external() const {
         return _u.small.size < 0;
     }
+    bool has_prefix() const {
+        return _u.small.size == external_size_with_prefix;
+    }
+    void cache_prefix() noexcept {
+        // External values don't fit in the inline buffer, so the first
+        // fragment is always at least max_inline_size + 1 bytes long and the
+        // copy below never reads past it.
+        memcpy(_u.external.prefix, _u.ptr->data, max_prefix_size);
+        _u.external.size = external_size_with_prefix;
+    }
+    void invalidate_prefix() noexcept {
+        if (has_prefix()) {
+            _u.external.size = external_size;
+        }
+    }
     size_t max_seg(allocation_strategy& alctr) {
         return alctr.preferred_max_contiguous_allocation() - sizeof(blob_storage);
     }
@@ -177,7 +210,7 @@ public:
         if (size <= max_inline_size) {
             _u.small.size = size;
         } else {
-            _u.small.size = -1;
+            _u.small.size = external_size;
             auto& alctr = current_allocator();
             auto maxseg = max_seg(alctr);
             auto now = std::min(size_t(size), maxseg);
@@ -220,6 +253,7 @@ public:
             b = b->next;
         }
         assert(!b);
+        cache_prefix();
     }
 
     managed_bytes(std::initializer_list<bytes::value_type> b) : managed_bytes(b.begin(), b.size()) {}
@@ -264,6 +298,7 @@ public:
             offs_dst += now; size_dst -= now;
         }
         assert(size_src == 0 && size_dst == 0);
+        cache_prefix();
     }
 
     managed_bytes(managed_bytes&& o) noexcept
@@ -301,6 +336,10 @@ public:
         if (!external()) {
             return bytes_view(*this) == bytes_view(o);
         } else {
+            if (has_prefix() && o.has_prefix()
+                    && memcmp(_u.external.prefix, o._u.external.prefix, max_prefix_size) != 0) {
+                return false;
+            }
             auto a = _u.ptr;
             auto a_data = a->data;
             auto a_remain = a->frag_size;
@@ -351,6 +390,7 @@ public:
     };
 
     bytes_view::value_type& operator[](size_type index) {
+        invalidate_prefix();
         return value_at_index(index);
     }
 
@@ -390,6 +430,7 @@ public:
     blob_storage::char_type* data() {
         if (external()) {
             assert(!_u.ptr->next);  // must be linearized
+            invalidate_prefix();
             return _u.ptr->data;
         } else {
             return _u.small.data;
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/core/future.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/memory.hh>
+#include <seastar/core/sstring.hh>
+#include <memory>
+#include <unordered_map>
+#include "seastarx.hh"
+
+namespace utils {
+
+// Approximate per-subsystem accounting of non-LSA memory.
+//
+// LSA regions already attribute their memory to an owner through
+// region_impl, but allocations made outside LSA — rpc buffers, result
+// sets, parser state — are invisible when a shard is running out of
+// memory. A memory_label_guard attributes the net change of the shard's
+// live bytes over its lifetime to a label, and the per-label aggregates
+// are exported through the REST API (/system/memory_label_accounting),
+// so finding the growing subsystem does not require a core dump.
+//
+// This is scope-delta accounting, not allocation interception. Memory
+// allocated inside a labeled scope but freed outside it (or the other
+// way around) stays attributed to the label, and allocations made by
+// other tasks which run while a labeled operation is suspended are
+// misattributed to it. The counters are trends, not exact figures —
+// enough to tell which subsystem grows, which is what matters when a
+// shard approaches OOM. Exact attribution would need allocation hooks
+// in the seastar allocator. With the default (non-seastar) allocator
+// memory::stats() reports no free memory and all deltas read as zero.
+
+class memory_label_registry {
+public:
+    struct stats {
+        int64_t net_bytes = 0;
+        uint64_t scopes = 0;
+    };
+    using map_type = std::unordered_map<sstring, stats>;
+private:
+    map_type _labels;
+public:
+    static memory_label_registry& local() {
+        static thread_local memory_label_registry registry;
+        return registry;
+    }
+    stats& get(const sstring& label) {
+        return _labels[label];
+    }
+    const map_type& all() const {
+        return _labels;
+    }
+};
+
+class memory_label_guard {
+    memory_label_registry::stats& _stats;
+    int64_t _live_at_entry;
+private:
+    static int64_t live_bytes() {
+        auto s = memory::stats();
+        return int64_t(s.total_memory()) - int64_t(s.free_memory());
+    }
+public:
+    explicit memory_label_guard(const sstring& label)
+        : _stats(memory_label_registry::local().get(label))
+        , _live_at_entry(live_bytes())
+    { }
+    memory_label_guard(const memory_label_guard&) = delete;
+    memory_label_guard& operator=(const memory_label_guard&) = delete;
+    ~memory_label_guard() {
+        _stats.net_bytes += live_bytes() - _live_at_entry;
+        ++_stats.scopes;
+    }
+};
+
+// Attributes the net live-bytes change of a whole asynchronous operation,
+// from invocation until the returned future resolves, to the label.
+template <typename Func>
+inline futurize_t<std::result_of_t<Func()>> with_memory_label(const sstring& label, Func&& func) {
+    auto guard = std::make_unique<memory_label_guard>(label);
+    return futurize_apply(std::forward<Func>(func)).finally([guard = std::move(guard)] {});
+}
+
+}
@@ -167,6 +167,13 @@ void hash3_x64_128(InputIterator in, uint32_t length, uint64_t seed, std::array<
 
 void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t, 2>& result);
 
+// Hashes four keys in one call, producing for each lane the same result as
+// hash3_x64_128() of the corresponding key. The four mixing chains are
+// advanced in lockstep, hiding the latency of each other's multiplies, which
+// makes batch hashing considerably cheaper than four one-at-a-time calls.
+void hash3_x64_128_batch(const std::array<bytes_view, 4>& keys, uint64_t seed,
+        std::array<std::array<uint64_t, 2>, 4>& results);
+
 } // namespace murmur_hash
 
 } // namespace utils
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2019 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+struct object_pool_stats {
+    uint64_t allocations = 0; // total acquisitions
+    uint64_t hits = 0;        // acquisitions served from the freelist
+    uint64_t discards = 0;    // returns dropped because the freelist was full
+};
+
+// A typed pool of reusable objects for types which are allocated and freed
+// at a high rate on the hot path. Instead of returning the memory to the
+// allocator, released objects are kept on a bounded freelist and handed out
+// again by the next acquisition, skipping both the allocation and the
+// constructor of a cold object.
+//
+// T must provide:
+//  - void reset() noexcept: returns the object to an idle state, releasing
+//    any resources it holds, so that pooled objects don't pin memory.
+//    Called when an object enters the freelist.
+//  - void reset(Args...): reinitializes an idle object, taking the same
+//    arguments as the constructor. Called when an object leaves the
+//    freelist.
+//
+// The pool is not thread-safe and is meant to be instantiated per shard,
+// either as a member of a per-shard service or as a thread-local.
+template <typename T>
+class object_pool {
+    std::vector<T*> _free;
+    size_t _max_pooled;
+    object_pool_stats _stats;
+public:
+    // Returns the object to the pool. A default-constructed deleter (as
+    // made by ptr{}) deletes instead, for handles adopting unpooled
+    // objects.
+    class deleter {
+        object_pool* _pool = nullptr;
+    public:
+        deleter() = default;
+        explicit deleter(object_pool* pool) noexcept : _pool(pool) { }
+        void operator()(T* obj) const noexcept {
+            if (_pool) {
+                _pool->put(obj);
+            } else {
+                delete obj;
+            }
+        }
+    };
+    // RAII handle which returns the object to the pool on destruction.
+    using ptr = std::unique_ptr<T, deleter>;
+public:
+    explicit object_pool(size_t max_pooled = 512) : _max_pooled(max_pooled) {
+        _free.reserve(_max_pooled);
+    }
+    object_pool(const object_pool&) = delete;
+    object_pool(object_pool&&) = delete; // handles keep a back-pointer
+    ~object_pool() {
+        for (auto obj : _free) {
+            delete obj;
+        }
+    }
+
+    // Acquires an object, either by resetting a pooled one or by
+    // constructing a new one when the freelist is empty.
+    template <typename... Args>
+    T* get(Args&&... args) {
+        ++_stats.allocations;
+        if (!_free.empty()) {
+            T* obj = _free.back();
+            _free.pop_back();
+            ++_stats.hits;
+            try {
+                obj->reset(std::forward<Args>(args)...);
+            } catch (...) {
+                delete obj;
+                throw;
+            }
+            return obj;
+        }
+        return new T(std::forward<Args>(args)...);
+    }
+
+    // Returns an object acquired from get(). Never allocates; the freelist
+    // storage is reserved up front.
+    void put(T* obj) noexcept {
+        if (_free.size() < _max_pooled) {
+            obj->reset();
+            _free.push_back(obj);
+        } else {
+            ++_stats.discards;
+            delete obj;
+        }
+    }
+
+    // get() wrapped in an RAII handle.
+    template <typename... Args>
+    ptr allocate(Args&&... args) {
+        return ptr(get(std::forward<Args>(args)...), deleter(this));
+    }
+
+    const object_pool_stats& stats() const { return _stats; }
+    size_t pooled() const { return _free.size(); }
+};
+
+}
@@ -41,7 +41,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace utils {
 
@@ -246,4 +250,69 @@ struct streaming_histogram {
 #endif
 };
 
+/**
+ * Builder front-end for streaming_histogram.
+ *
+ * streaming_histogram::update() pays an O(bins) closest-pair scan whenever a
+ * new distinct point arrives with the bin limit reached, which is too
+ * expensive to run per cell on the write path. The builder instead counts
+ * exact points in a flat hash spool at O(1) per update and folds them into
+ * the real histogram only when the spool fills up or the histogram is finally
+ * built, so the scan cost is paid per distinct point rather than per cell.
+ * Tombstone drop times have second granularity, so a flush of deletes
+ * clustered in time produces few distinct points and the spool rarely
+ * overflows. Merging two builders is a plain spool merge.
+ */
+struct streaming_histogram_builder {
+    static constexpr uint32_t max_spool_size = 1024;
+
+    // Exact point counts, folded into hist on overflow.
+    std::unordered_map<int32_t, uint64_t> spool;
+    streaming_histogram hist;
+
+    streaming_histogram_builder(int max_bin_size = 0)
+        : hist(max_bin_size) {
+    }
+
+    void update(int32_t p) {
+        update(p, 1);
+    }
+
+    void update(int32_t p, uint64_t m) {
+        auto r = spool.emplace(p, m);
+        if (!r.second) {
+            r.first->second += m;
+        } else if (spool.size() >= max_spool_size) {
+            flush_spool();
+        }
+    }
+
+    void merge(streaming_histogram_builder& other) {
+        for (auto& e : other.spool) {
+            update(e.first, e.second);
+        }
+        hist.merge(other.hist);
+    }
+
+    /**
+     * Folds any spooled points and returns the final bounded-size histogram.
+     */
+    streaming_histogram build() {
+        flush_spool();
+        return std::move(hist);
+    }
+
+private:
+    void flush_spool() {
+        // Fold in increasing point order; the closest-pair bin merging
+        // behaves best on sorted input and the result is deterministic.
+        auto points = std::vector<std::pair<int32_t, uint64_t>>(spool.begin(), spool.end());
+        std::sort(points.begin(), points.end());
+        for (auto& p : points) {
+            hist.update(p.first, p.second);
+        }
+        spool.clear();
+    }
+};
+
 }
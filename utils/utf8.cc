@@ -212,6 +212,18 @@ bool validate(const uint8_t *data, size_t len) {
         while (len >= 16) {
             const uint8x16_t input = vld1q_u8(data);
 
+            // Fast path for ASCII-only chunks. If neither this chunk nor
+            // the previous one has the high bit set anywhere, all range
+            // indices below would come out zero and no sequence can
+            // straddle the chunk boundary, so skip the table lookups.
+            if (vmaxvq_u8(vorrq_u8(input, prev_input)) < 0x80) {
+                prev_input = input;
+                prev_first_len = vdupq_n_u8(0);
+                data += 16;
+                len -= 16;
+                continue;
+            }
+
             // high_nibbles = input >> 4
             const uint8x16_t high_nibbles = vshrq_n_u8(input, 4);
 
@@ -386,6 +398,18 @@ bool validate(const uint8_t *data, size_t len) {
         while (len >= 16) {
             const __m128i input = _mm_lddqu_si128((const __m128i *)data);
 
+            // Fast path for ASCII-only chunks. If neither this chunk nor
+            // the previous one has the high bit set anywhere, all range
+            // indices below would come out zero and no sequence can
+            // straddle the chunk boundary, so skip the table lookups.
+            if (_mm_movemask_epi8(_mm_or_si128(input, prev_input)) == 0) {
+                prev_input = input;
+                prev_first_len = _mm_set1_epi8(0);
+                data += 16;
+                len -= 16;
+                continue;
+            }
+
             // high_nibbles = input >> 4
             const __m128i high_nibbles =
                 _mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0F));
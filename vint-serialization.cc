@@ -42,9 +42,11 @@
 #include "vint-serialization.hh"
 
 #include <seastar/core/bitops.hh>
+#include <seastar/net/byteorder.hh>
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <limits>
 #include <type_traits>
 
@@ -105,9 +107,19 @@ static void encode(uint64_t value, vint_size_type size, bytes::iterator out) {
     // `size` is always in the range [1, 9].
     const auto extra_bytes_size = size - 1;
 
-    for (vint_size_type i = 0; i <= extra_bytes_size; ++i) {
-        buffer[extra_bytes_size - i] = static_cast<int8_t>(value & 0xff);
-        value >>= 8;
+    if (size <= 8) {
+        // The encoding is the value in big-endian order, so all of its bytes
+        // can be put in place with a single shift, byte swap and store; the
+        // mirror image of the unaligned load in deserialize(). A 9-byte vint
+        // keeps the loop below, as its value does not fit the register
+        // alongside the shift.
+        const uint64_t be = seastar::net::hton(value << (8 * (8 - size)));
+        std::memcpy(buffer.data(), &be, 8);
+    } else {
+        for (vint_size_type i = 0; i <= extra_bytes_size; ++i) {
+            buffer[extra_bytes_size - i] = static_cast<int8_t>(value & 0xff);
+            value >>= 8;
+        }
     }
 
     buffer[0] |= ~first_byte_value_mask(extra_bytes_size);
@@ -149,6 +161,22 @@ unsigned_vint::deserialized_type unsigned_vint::deserialize(bytes_view v) {
     // Extract the bits not used for counting bytes.
     auto result = uint64_t(first_byte) & first_byte_value_mask(extra_bytes_size);
 
+    // The extra bytes are simply the value in big-endian order, so when the
+    // buffer extends at least 8 bytes past the first one they can all be
+    // picked up with a single unaligned load instead of a byte-at-a-time
+    // loop with a data-dependent trip count.
+    if (v.size() > 8) {
+        uint64_t extra;
+        std::memcpy(&extra, v.data() + 1, 8);
+        extra = seastar::net::ntoh(extra);
+        // A 9-byte vint carries no value bits in its first byte (result is
+        // zero here) and the plain shift below would be undefined for it,
+        // so mask the shift count; the resulting shift by zero is harmless.
+        result <<= (8 * extra_bytes_size) & 63;
+        result |= extra >> (8 * (8 - extra_bytes_size));
+        return deserialized_type{result, total_size};
+    }
+
     for (vint_size_type index = 0; index < extra_bytes_size; ++index) {
         result <<= 8;
         result |= (uint64_t(v[index + 1]) & uint64_t(0xff));
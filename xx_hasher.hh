@@ -25,6 +25,7 @@
 #include "utils/serialization.hh"
 
 #include <xxHash/xxhash.h>
+#include <algorithm>
 #include <array>
 
 class xx_hasher {
@@ -63,3 +64,68 @@ private:
         serialize_int64(out, finalize_uint64());
     }
 };
+
+// Digest-compatible variant of xx_hasher which stages updates in a local
+// buffer and feeds the XXH64 state one buffer at a time. Digest reads hash
+// a query::result as a long sequence of small cell values, so most of the
+// digest cost is per-update overhead rather than hashing; staging pays
+// that overhead once per buffer instead of once per cell. XXH64 is a
+// streaming hash whose result does not depend on how the input is split
+// across update() calls, so this produces exactly the same digest as
+// xx_hasher and needs no cross-node negotiation.
+class xx_hasher_wide {
+    static constexpr size_t digest_size = 16;
+    static constexpr size_t buffer_size = 512;
+    XXH64_state_t _state;
+    std::array<char, buffer_size> _buffer;
+    size_t _buffered = 0;
+
+public:
+    explicit xx_hasher_wide(uint64_t seed = 0) noexcept {
+        XXH64_reset(&_state, seed);
+    }
+
+    void update(const char* ptr, size_t length) {
+        if (length >= buffer_size) {
+            drain();
+            XXH64_update(&_state, ptr, length);
+            return;
+        }
+        if (_buffered + length > buffer_size) {
+            drain();
+        }
+        std::copy_n(ptr, length, _buffer.data() + _buffered);
+        _buffered += length;
+    }
+
+    bytes finalize() {
+        bytes digest{bytes::initialized_later(), digest_size};
+        serialize_to(digest.begin());
+        return digest;
+    }
+
+    std::array<uint8_t, digest_size> finalize_array() {
+        std::array<uint8_t, digest_size> digest;
+        serialize_to(digest.begin());
+        return digest;
+    }
+
+    uint64_t finalize_uint64() {
+        drain();
+        return XXH64_digest(&_state);
+    }
+
+private:
+    void drain() {
+        if (_buffered) {
+            XXH64_update(&_state, _buffer.data(), _buffered);
+            _buffered = 0;
+        }
+    }
+
+    template<typename OutIterator>
+    void serialize_to(OutIterator&& out) {
+        serialize_int64(out, 0);
+        serialize_int64(out, finalize_uint64());
+    }
+};